@@ -56,6 +56,7 @@
 #include <utility>
 #include <vector>
 
+#include <ndn-cxx/compact-name.hpp>
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/delegation.hpp>
 #include <ndn-cxx/delegation-list.hpp>
@@ -100,6 +101,7 @@ using ndn::nullopt;
 using ndn::to_string;
 
 using ndn::Block;
+using ndn::CompactName;
 using ndn::Data;
 using ndn::Delegation;
 using ndn::DelegationList;
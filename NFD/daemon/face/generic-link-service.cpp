@@ -43,7 +43,9 @@ GenericLinkService::Options::Options()
   , allowCongestionMarking(false)
   , baseCongestionMarkingInterval(time::milliseconds(100)) // Interval from RFC 8289 (CoDel)
   , defaultCongestionThreshold(65536) // This default value works well for a queue capacity of 200KiB
+  , congestionSojournTarget(0)
   , allowSelfLearning(false)
+  , allowBarePackets(false)
 {
 }
 
@@ -56,6 +58,7 @@ GenericLinkService::GenericLinkService(const GenericLinkService::Options& option
   , m_nextMarkTime(time::steady_clock::TimePoint::max())
   , m_lastMarkTime(time::steady_clock::TimePoint::min())
   , m_nMarkedSinceInMarkingState(0)
+  , m_firstAboveTime(time::steady_clock::TimePoint::max())
 {
   m_reassembler.beforeTimeout.connect(bind([this] { ++this->nReassemblyTimeouts; }));
   m_reliability.onDroppedInterest.connect([this] (const Interest& i) { this->notifyDroppedInterest(i); });
@@ -104,6 +107,11 @@ GenericLinkService::sendLpPacket(lp::Packet&& pkt)
 void
 GenericLinkService::doSendInterest(const Interest& interest)
 {
+  if (this->canSendBare(interest, interest.wireEncode())) {
+    this->sendBarePacket(interest.wireEncode());
+    return;
+  }
+
   lp::Packet lpPacket(interest.wireEncode());
 
   encodeLpFields(interest, lpPacket);
@@ -114,6 +122,11 @@ GenericLinkService::doSendInterest(const Interest& interest)
 void
 GenericLinkService::doSendData(const Data& data)
 {
+  if (this->canSendBare(data, data.wireEncode())) {
+    this->sendBarePacket(data.wireEncode());
+    return;
+  }
+
   lp::Packet lpPacket(data.wireEncode());
 
   encodeLpFields(data, lpPacket);
@@ -166,6 +179,44 @@ GenericLinkService::encodeLpFields(const ndn::PacketBase& netPkt, lp::Packet& lp
   else {
     lpPacket.add<lp::HopCountTagField>(0);
   }
+
+  shared_ptr<lp::CentralityTag> centralityTag = netPkt.getTag<lp::CentralityTag>();
+  if (centralityTag != nullptr) {
+    lpPacket.add<lp::CentralityTagField>(*centralityTag);
+  }
+}
+
+bool
+GenericLinkService::canSendBare(const ndn::PacketBase& netPkt, const Block& wire) const
+{
+  if (!m_options.allowBarePackets ||
+      m_options.reliabilityOptions.isEnabled ||
+      m_options.allowCongestionMarking) {
+    return false;
+  }
+
+  const ssize_t mtu = this->getTransport()->getMtu();
+  if (mtu != MTU_UNLIMITED && wire.size() > static_cast<size_t>(mtu)) {
+    return false;
+  }
+
+  // must agree with encodeLpFields
+  if (m_options.allowLocalFields && netPkt.getTag<lp::IncomingFaceIdTag>() != nullptr) {
+    return false;
+  }
+  if (m_options.allowSelfLearning && (netPkt.getTag<lp::NonDiscoveryTag>() != nullptr ||
+                                      netPkt.getTag<lp::PrefixAnnouncementTag>() != nullptr)) {
+    return false;
+  }
+  return netPkt.getTag<lp::CongestionMarkTag>() == nullptr &&
+         netPkt.getTag<lp::HopCountTag>() == nullptr &&
+         netPkt.getTag<lp::CentralityTag>() == nullptr;
+}
+
+void
+GenericLinkService::sendBarePacket(const Block& wire)
+{
+  this->sendPacket(Transport::Packet(Block(wire)));
 }
 
 void
@@ -240,28 +291,53 @@ GenericLinkService::assignSequences(std::vector<lp::Packet>& pkts)
 void
 GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
 {
-  ssize_t sendQueueLength = getTransport()->getSendQueueLength();
-  // This operation requires that the transport supports retrieving current send queue length
-  if (sendQueueLength < 0) {
-    return;
-  }
+  const auto now = time::steady_clock::now();
+  bool isCongested = false;
+
+  time::nanoseconds sojournTime = m_options.congestionSojournTarget > time::nanoseconds::zero() ?
+                                  getTransport()->getSendQueueSojournTime() :
+                                  time::nanoseconds(QUEUE_UNSUPPORTED);
+  if (sojournTime >= time::nanoseconds::zero()) {
+    // CoDel-style: congested if sojourn time stays above target for a whole marking interval
+    if (sojournTime < m_options.congestionSojournTarget) {
+      m_firstAboveTime = time::steady_clock::TimePoint::max();
+    }
+    else if (m_firstAboveTime == time::steady_clock::TimePoint::max()) {
+      m_firstAboveTime = now;
+    }
+    isCongested = m_firstAboveTime != time::steady_clock::TimePoint::max() &&
+                  now >= m_firstAboveTime + m_options.baseCongestionMarkingInterval;
 
-  // To avoid overflowing the queue, set the congestion threshold to at least half of the send
-  // queue capacity.
-  size_t congestionThreshold = m_options.defaultCongestionThreshold;
-  if (getTransport()->getSendQueueCapacity() >= 0) {
-    congestionThreshold = std::min(congestionThreshold,
-                                   static_cast<size_t>(getTransport()->getSendQueueCapacity()) /
-                                                       DEFAULT_CONGESTION_THRESHOLD_DIVISOR);
+    if (sojournTime > time::nanoseconds::zero()) {
+      NFD_LOG_FACE_TRACE("sojourn=" << sojournTime << " target=" << m_options.congestionSojournTarget);
+    }
   }
+  else {
+    ssize_t sendQueueLength = getTransport()->getSendQueueLength();
+    // This operation requires that the transport supports retrieving current send queue length
+    if (sendQueueLength < 0) {
+      return;
+    }
+
+    // To avoid overflowing the queue, set the congestion threshold to at least half of the send
+    // queue capacity.
+    ssize_t sendQueueCapacity = getTransport()->getSendQueueCapacity();
+    size_t congestionThreshold = m_options.defaultCongestionThreshold;
+    if (sendQueueCapacity >= 0) {
+      congestionThreshold = std::min(congestionThreshold,
+                                     static_cast<size_t>(sendQueueCapacity) /
+                                                         DEFAULT_CONGESTION_THRESHOLD_DIVISOR);
+    }
+
+    if (sendQueueLength > 0) {
+      NFD_LOG_FACE_TRACE("txqlen=" << sendQueueLength << " threshold=" << congestionThreshold <<
+                         " capacity=" << sendQueueCapacity);
+    }
 
-  if (sendQueueLength > 0) {
-    NFD_LOG_FACE_TRACE("txqlen=" << sendQueueLength << " threshold=" << congestionThreshold <<
-                       " capacity=" << getTransport()->getSendQueueCapacity());
+    isCongested = static_cast<size_t>(sendQueueLength) > congestionThreshold;
   }
 
-  if (static_cast<size_t>(sendQueueLength) > congestionThreshold) { // Send queue is congested
-    const auto now = time::steady_clock::now();
+  if (isCongested) { // Send queue is congested
     if (now >= m_nextMarkTime || now >= m_lastMarkTime + m_options.baseCongestionMarkingInterval) {
       // Mark at most one initial packet per baseCongestionMarkingInterval
       if (m_nMarkedSinceInMarkingState == 0) {
@@ -284,7 +360,7 @@ GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
   }
   else if (m_nextMarkTime != time::steady_clock::TimePoint::max()) {
     // Congestion incident has ended, so reset
-    NFD_LOG_FACE_DEBUG("Send queue length dropped below congestion threshold");
+    NFD_LOG_FACE_DEBUG("Send queue dropped below congestion threshold");
     m_nextMarkTime = time::steady_clock::TimePoint::max();
     m_nMarkedSinceInMarkingState = 0;
   }
@@ -293,6 +369,12 @@ GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
 void
 GenericLinkService::doReceivePacket(Transport::Packet&& packet)
 {
+  if (packet.packet.type() == tlv::Interest || packet.packet.type() == tlv::Data) {
+    // bare network-layer packet: no link protocol field, nothing to reassemble
+    this->decodeNetPacket(packet.packet, lp::Packet());
+    return;
+  }
+
   try {
     lp::Packet pkt(packet.packet);
 
@@ -368,6 +450,10 @@ GenericLinkService::decodeInterest(const Block& netPkt, const lp::Packet& firstP
     interest->setTag(make_shared<lp::HopCountTag>(firstPkt.get<lp::HopCountTagField>() + 1));
   }
 
+  if (firstPkt.has<lp::CentralityTagField>()) {
+    interest->setTag(make_shared<lp::CentralityTag>(firstPkt.get<lp::CentralityTagField>()));
+  }
+
   if (firstPkt.has<lp::NextHopFaceIdField>()) {
     if (m_options.allowLocalFields) {
       interest->setTag(make_shared<lp::NextHopFaceIdTag>(firstPkt.get<lp::NextHopFaceIdField>()));
@@ -415,13 +501,19 @@ GenericLinkService::decodeData(const Block& netPkt, const lp::Packet& firstPkt)
 {
   BOOST_ASSERT(netPkt.type() == tlv::Data);
 
-  // forwarding expects Data to be created with make_shared
-  auto data = make_shared<Data>(netPkt);
+  // forwarding expects Data to be created with make_shared;
+  // the signature is decoded only if something on the forwarding path asks for it
+  auto data = make_shared<Data>();
+  data->wireDecode(netPkt, true);
 
   if (firstPkt.has<lp::HopCountTagField>()) {
     data->setTag(make_shared<lp::HopCountTag>(firstPkt.get<lp::HopCountTagField>() + 1));
   }
 
+  if (firstPkt.has<lp::CentralityTagField>()) {
+    data->setTag(make_shared<lp::CentralityTag>(firstPkt.get<lp::CentralityTagField>()));
+  }
+
   if (firstPkt.has<lp::NackField>()) {
     ++this->nInNetInvalid;
     NFD_LOG_FACE_WARN("received Nack with Data: DROP");
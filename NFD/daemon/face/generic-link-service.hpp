@@ -137,9 +137,29 @@ public:
      */
     size_t defaultCongestionThreshold;
 
+    /** \brief sojourn time target for CoDel-style congestion detection
+     *
+     *  If positive and the transport reports send queue sojourn time, the send queue is
+     *  considered congested once the oldest queued packet has waited longer than this target
+     *  for at least baseCongestionMarkingInterval; queue length is not consulted.
+     *  Otherwise, congestion is detected by comparing queue length with the threshold.
+     */
+    time::nanoseconds congestionSojournTarget;
+
     /** \brief enables self-learning forwarding support
      */
     bool allowSelfLearning;
+
+    /** \brief enables sending Interest and Data without LpPacket header
+     *
+     *  If enabled, an Interest or Data that needs no link protocol field and fits in the MTU
+     *  is sent as a bare network-layer TLV. This is not used when reliability or congestion
+     *  marking is enabled. A HopCount field is only sent for packets that carry a HopCountTag,
+     *  so packets originated on this forwarder are not hop-counted.
+     *
+     *  Bare network-layer packets are always accepted on receipt, regardless of this option.
+     */
+    bool allowBarePackets;
   };
 
   /** \brief counters provided by GenericLinkService
@@ -197,6 +217,14 @@ private: // send path
   void
   encodeLpFields(const ndn::PacketBase& netPkt, lp::Packet& lpPacket);
 
+  /** \brief determine whether \p netPkt can be sent without LpPacket header
+   *  \param netPkt network-layer packet, for which encodeLpFields would add no field
+   *         other than HopCount
+   *  \param wire wire encoding of \p netPkt
+   */
+  bool
+  canSendBare(const ndn::PacketBase& netPkt, const Block& wire) const;
+
   /** \brief send a complete network layer packet
    *  \param pkt LpPacket containing a complete network layer packet
    *  \param isInterest whether the network layer packet is an Interest
@@ -204,6 +232,12 @@ private: // send path
   void
   sendNetPacket(lp::Packet&& pkt, bool isInterest);
 
+  /** \brief send a network layer packet without LpPacket header
+   *  \pre canSendBare(netPkt, wire)
+   */
+  void
+  sendBarePacket(const Block& wire);
+
   /** \brief assign a sequence number to an LpPacket
    */
   void
@@ -289,6 +323,8 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   time::steady_clock::TimePoint m_lastMarkTime;
   /// number of marked packets in the current incident of congestion
   size_t m_nMarkedSinceInMarkingState;
+  /// Time sojourn time rose above congestionSojournTarget, or TimePoint::max() if below target
+  time::steady_clock::TimePoint m_firstAboveTime;
 
   friend class LpReliability;
 };
@@ -132,6 +132,12 @@ Transport::getSendQueueLength()
   return QUEUE_UNSUPPORTED;
 }
 
+time::nanoseconds
+Transport::getSendQueueSojournTime()
+{
+  return time::nanoseconds(QUEUE_UNSUPPORTED);
+}
+
 bool
 Transport::canChangePersistencyTo(ndn::nfd::FacePersistency newPersistency) const
 {
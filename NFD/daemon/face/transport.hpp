@@ -293,6 +293,13 @@ public: // dynamic properties
   virtual ssize_t
   getSendQueueLength();
 
+  /** \return how long the oldest packet in the send queue has been waiting,
+   *          or zero if the send queue is empty
+   *  \retval negative duration transport does not support sojourn time retrieval
+   */
+  virtual time::nanoseconds
+  getSendQueueSojournTime();
+
 protected: // properties to be set by subclass
   void
   setLocalUri(const FaceUri& uri);
@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cache-placement-policy.hpp"
+#include "core/random.hpp"
+
+#include <ndn-cxx/lp/tags.hpp>
+#include <boost/range/adaptor/map.hpp>
+#include <boost/range/algorithm/copy.hpp>
+
+namespace nfd {
+namespace fw {
+
+std::ostream&
+operator<<(std::ostream& os, CachePlacementDecision d)
+{
+  switch (d) {
+    case CachePlacementDecision::BYPASS:
+      return os << "bypass";
+    case CachePlacementDecision::CACHE:
+      return os << "cache";
+  }
+  return os << static_cast<int>(d);
+}
+
+CachePlacementPolicy::Registry&
+CachePlacementPolicy::getRegistry()
+{
+  static Registry registry;
+  return registry;
+}
+
+unique_ptr<CachePlacementPolicy>
+CachePlacementPolicy::create(const std::string& policyName)
+{
+  Registry& registry = getRegistry();
+  auto i = registry.find(policyName);
+  return i == registry.end() ? nullptr : i->second();
+}
+
+std::set<std::string>
+CachePlacementPolicy::getPolicyNames()
+{
+  std::set<std::string> policyNames;
+  boost::copy(getRegistry() | boost::adaptors::map_keys,
+              std::inserter(policyNames, policyNames.end()));
+  return policyNames;
+}
+
+/** \return HopCount of \p pkt, or zero if it has none
+ */
+static uint64_t
+getHopCount(const ndn::TagHost& pkt)
+{
+  shared_ptr<lp::HopCountTag> hopCountTag = pkt.getTag<lp::HopCountTag>();
+  return hopCountTag == nullptr ? 0 : hopCountTag->get();
+}
+
+const std::string CacheEverywherePlacementPolicy::POLICY_NAME("everywhere");
+NFD_REGISTER_CACHE_PLACEMENT_POLICY(CacheEverywherePlacementPolicy);
+
+CachePlacementDecision
+CacheEverywherePlacementPolicy::decide(const Face& inFace, const Data& data,
+                                       const pit::DataMatchResult& pitMatches)
+{
+  return CachePlacementDecision::CACHE;
+}
+
+const std::string LeaveCopyDownPlacementPolicy::POLICY_NAME("lcd");
+NFD_REGISTER_CACHE_PLACEMENT_POLICY(LeaveCopyDownPlacementPolicy);
+
+CachePlacementDecision
+LeaveCopyDownPlacementPolicy::decide(const Face& inFace, const Data& data,
+                                     const pit::DataMatchResult& pitMatches)
+{
+  if (getHopCount(data) == 1) {
+    return CachePlacementDecision::CACHE;
+  }
+  return CachePlacementDecision::BYPASS;
+}
+
+const std::string ProbCachePlacementPolicy::POLICY_NAME("probcache");
+NFD_REGISTER_CACHE_PLACEMENT_POLICY(ProbCachePlacementPolicy);
+
+ProbCachePlacementPolicy::ProbCachePlacementPolicy()
+  : m_timesInWindow(10.0)
+{
+}
+
+double
+ProbCachePlacementPolicy::getProbability(const Data& data,
+                                         const pit::DataMatchResult& pitMatches) const
+{
+  // hops from the producer or the ContentStore that has the Data
+  uint64_t x = getHopCount(data);
+  if (x == 0) {
+    return 0.0;
+  }
+
+  // hops to the farthest pending consumer
+  uint64_t y = 0;
+  for (const shared_ptr<pit::Entry>& pitEntry : pitMatches) {
+    for (const pit::InRecord& inRecord : pitEntry->getInRecords()) {
+      y = std::max(y, getHopCount(inRecord.getInterest()));
+    }
+  }
+
+  double c = static_cast<double>(x + y);
+  double timesIn = (y + 1) / m_timesInWindow;
+  double cacheWeight = x / c;
+  return std::min(1.0, timesIn * cacheWeight);
+}
+
+CachePlacementDecision
+ProbCachePlacementPolicy::decide(const Face& inFace, const Data& data,
+                                 const pit::DataMatchResult& pitMatches)
+{
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  if (dist(getGlobalRng()) < this->getProbability(data, pitMatches)) {
+    return CachePlacementDecision::CACHE;
+  }
+  return CachePlacementDecision::BYPASS;
+}
+
+const std::string BetweennessPlacementPolicy::POLICY_NAME("betweenness");
+NFD_REGISTER_CACHE_PLACEMENT_POLICY(BetweennessPlacementPolicy);
+
+BetweennessPlacementPolicy::BetweennessPlacementPolicy()
+  : m_centrality(0)
+{
+}
+
+void
+BetweennessPlacementPolicy::afterReceiveInterest(const Face& inFace, const Interest& interest)
+{
+  shared_ptr<lp::CentralityTag> centralityTag = interest.getTag<lp::CentralityTag>();
+  if (centralityTag == nullptr || centralityTag->get() < m_centrality) {
+    interest.setTag(make_shared<lp::CentralityTag>(m_centrality));
+  }
+}
+
+void
+BetweennessPlacementPolicy::afterContentStoreHit(const Interest& interest, const Data& data)
+{
+  // the Interest has collected the highest centrality from the consumer to here
+  shared_ptr<lp::CentralityTag> centralityTag = interest.getTag<lp::CentralityTag>();
+  data.setTag(make_shared<lp::CentralityTag>(centralityTag == nullptr ? m_centrality :
+                                                                         centralityTag->get()));
+}
+
+CachePlacementDecision
+BetweennessPlacementPolicy::decide(const Face& inFace, const Data& data,
+                                   const pit::DataMatchResult& pitMatches)
+{
+  shared_ptr<lp::CentralityTag> centralityTag = data.getTag<lp::CentralityTag>();
+  if (centralityTag == nullptr) {
+    // Data comes from the producer: the pending Interests have collected the highest centrality
+    uint64_t highest = m_centrality;
+    for (const shared_ptr<pit::Entry>& pitEntry : pitMatches) {
+      for (const pit::InRecord& inRecord : pitEntry->getInRecords()) {
+        shared_ptr<lp::CentralityTag> tag = inRecord.getInterest().getTag<lp::CentralityTag>();
+        if (tag != nullptr) {
+          highest = std::max(highest, tag->get());
+        }
+      }
+    }
+    centralityTag = make_shared<lp::CentralityTag>(highest);
+    data.setTag(centralityTag);
+  }
+
+  if (m_centrality >= centralityTag->get()) {
+    return CachePlacementDecision::CACHE;
+  }
+  return CachePlacementDecision::BYPASS;
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,254 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_CACHE_PLACEMENT_POLICY_HPP
+#define NFD_DAEMON_FW_CACHE_PLACEMENT_POLICY_HPP
+
+#include "face/face.hpp"
+#include "table/pit.hpp"
+
+namespace nfd {
+namespace fw {
+
+/** \brief a decision made by CachePlacementPolicy
+ */
+enum class CachePlacementDecision {
+  BYPASS, ///< the Data should be forwarded without being cached
+  CACHE   ///< the Data should be cached in the ContentStore
+};
+
+std::ostream&
+operator<<(std::ostream& os, CachePlacementDecision d);
+
+/** \brief determines whether an incoming Data is cached on this forwarder
+ *
+ *  Every forwarder on the path of a Data normally admits it into the ContentStore, so that
+ *  on-path caches hold many copies of the same popular Data. A cache placement policy lets
+ *  forwarders coordinate, so that Data is cached at fewer and better chosen places.
+ *
+ *  Forwarding pipelines consult this policy before inserting a solicited Data into the
+ *  ContentStore. The replacement policy of the ContentStore is not affected.
+ *  Unsolicited Data is admitted by UnsolicitedDataPolicy instead.
+ */
+class CachePlacementPolicy : noncopyable
+{
+public:
+  virtual
+  ~CachePlacementPolicy() = default;
+
+  /** \brief invoked when an Interest is received, before the ContentStore lookup
+   *
+   *  The policy may attach tags to \p interest, which are carried to the upstream.
+   */
+  virtual void
+  afterReceiveInterest(const Face& inFace, const Interest& interest)
+  {
+  }
+
+  /** \brief invoked when an Interest is satisfied from the ContentStore
+   *
+   *  The policy may attach tags to \p data, which are carried to the downstream.
+   */
+  virtual void
+  afterContentStoreHit(const Interest& interest, const Data& data)
+  {
+  }
+
+  /** \brief decides whether \p data, which satisfies \p pitMatches, is cached
+   *
+   *  The policy may attach tags to \p data, which are carried to the downstreams.
+   */
+  virtual CachePlacementDecision
+  decide(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) = 0;
+
+public: // registry
+  template<typename P>
+  static void
+  registerPolicy(const std::string& policyName = P::POLICY_NAME)
+  {
+    Registry& registry = getRegistry();
+    BOOST_ASSERT(registry.count(policyName) == 0);
+    registry[policyName] = [] { return make_unique<P>(); };
+  }
+
+  /** \return a CachePlacementPolicy identified by \p policyName,
+   *          or nullptr if \p policyName is unknown
+   */
+  static unique_ptr<CachePlacementPolicy>
+  create(const std::string& policyName);
+
+  /** \return a list of available policy names
+   */
+  static std::set<std::string>
+  getPolicyNames();
+
+private:
+  typedef std::function<unique_ptr<CachePlacementPolicy>()> CreateFunc;
+  typedef std::map<std::string, CreateFunc> Registry; // indexed by policy name
+
+  static Registry&
+  getRegistry();
+};
+
+/** \brief caches every Data (leave copy everywhere)
+ */
+class CacheEverywherePlacementPolicy : public CachePlacementPolicy
+{
+public:
+  CachePlacementDecision
+  decide(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) final;
+
+public:
+  static const std::string POLICY_NAME;
+};
+
+/** \brief Leave Copy Down
+ *
+ *  Data is cached only one hop below the place where it was found, i.e., by the forwarder
+ *  that receives it directly from the producer's forwarder or from a ContentStore hit.
+ *  Each further request for the Data moves a copy one hop closer to the consumers
+ *  (Laoutaris et al., "The LCD interconnection of LRU caches", 2006).
+ *
+ *  The distance is taken from the HopCount field, which is reset when Data leaves a
+ *  ContentStore or the producer's forwarder. Faces that send bare packets do not convey
+ *  HopCount, so Data received from them is not cached.
+ */
+class LeaveCopyDownPlacementPolicy : public CachePlacementPolicy
+{
+public:
+  CachePlacementDecision
+  decide(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) final;
+
+public:
+  static const std::string POLICY_NAME;
+};
+
+/** \brief ProbCache
+ *
+ *  Data is cached with probability TimesIn * CacheWeight, where CacheWeight = x / c grows
+ *  with the distance x from the source of the Data along a path of c hops, and
+ *  TimesIn = N / (Ttw * Nx) is the capacity N of the caches from this forwarder to the
+ *  consumer, relative to Ttw times the capacity Nx of this cache. Caches thus share the
+ *  path fairly, and copies are pushed towards the consumer (Psaras et al., "Probabilistic
+ *  In-Network Caching for Information-Centric Networks", 2012).
+ *
+ *  x is the HopCount of Data, and the distance to the consumer is the HopCount of the
+ *  pending Interest. The caches on the path are assumed to have the capacity of this one,
+ *  so that N / Nx is the number of forwarders from this forwarder to the consumer.
+ */
+class ProbCachePlacementPolicy : public CachePlacementPolicy
+{
+public:
+  ProbCachePlacementPolicy();
+
+  CachePlacementDecision
+  decide(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) final;
+
+  /** \brief sets Ttw, the number of Data the path should be able to cache, default 10
+   */
+  void
+  setTimesInWindow(double timesInWindow)
+  {
+    BOOST_ASSERT(timesInWindow > 0);
+    m_timesInWindow = timesInWindow;
+  }
+
+  /** \return probability that \p data, which satisfies \p pitMatches, is cached
+   */
+  double
+  getProbability(const Data& data, const pit::DataMatchResult& pitMatches) const;
+
+public:
+  static const std::string POLICY_NAME;
+
+private:
+  double m_timesInWindow;
+};
+
+/** \brief caches Data at the most central forwarder on the path
+ *
+ *  Every forwarder has a centrality, normally its betweenness centrality in the topology.
+ *  Interests carry the highest centrality among the forwarders they pass, and Data carries
+ *  it back from where it is found. A forwarder caches the Data if no forwarder on the path is
+ *  more central than itself (Chai et al., "Cache 'Less for More' in Information-Centric
+ *  Networks", 2012).
+ */
+class BetweennessPlacementPolicy : public CachePlacementPolicy
+{
+public:
+  BetweennessPlacementPolicy();
+
+  void
+  afterReceiveInterest(const Face& inFace, const Interest& interest) final;
+
+  void
+  afterContentStoreHit(const Interest& interest, const Data& data) final;
+
+  CachePlacementDecision
+  decide(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) final;
+
+  /** \brief sets the centrality of this forwarder
+   */
+  void
+  setCentrality(uint64_t centrality)
+  {
+    m_centrality = centrality;
+  }
+
+  uint64_t
+  getCentrality() const
+  {
+    return m_centrality;
+  }
+
+public:
+  static const std::string POLICY_NAME;
+
+private:
+  uint64_t m_centrality;
+};
+
+/** \brief the default CachePlacementPolicy
+ */
+typedef CacheEverywherePlacementPolicy DefaultCachePlacementPolicy;
+
+} // namespace fw
+} // namespace nfd
+
+/** \brief registers a cache placement policy
+ *  \param P a subclass of nfd::fw::CachePlacementPolicy;
+ *           P::POLICY_NAME must be a string that contains policy name
+ */
+#define NFD_REGISTER_CACHE_PLACEMENT_POLICY(P)                     \
+static class NfdAuto ## P ## CachePlacementPolicyRegistrationClass \
+{                                                                  \
+public:                                                            \
+  NfdAuto ## P ## CachePlacementPolicyRegistrationClass()          \
+  {                                                                \
+    ::nfd::fw::CachePlacementPolicy::registerPolicy<P>();          \
+  }                                                                \
+} g_nfdAuto ## P ## CachePlacementPolicyRegistrationVariable
+
+#endif // NFD_DAEMON_FW_CACHE_PLACEMENT_POLICY_HPP
@@ -29,6 +29,7 @@
 #include "strategy.hpp"
 #include "core/logger.hpp"
 #include "table/cleanup.hpp"
+#include "table/cs-retrieval-cost.hpp"
 #include <ndn-cxx/lp/tags.hpp>
 
 #include "face/null-face.hpp"
@@ -43,8 +44,45 @@ getDefaultStrategyName()
   return fw::BestRouteStrategy2::getStrategyName();
 }
 
+static name_tree::HashtableOptions
+getNameTreeOptions()
+{
+  name_tree::HashtableOptions options(1024);
+  options.layout = name_tree::HashtableLayout::OPEN_ADDRESSING;
+  return options;
+}
+
+/** \brief measures the cost of retrieving \p data, which satisfies \p pitMatches, from \p inFace
+ */
+static cs::RetrievalCost
+getRetrievalCost(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches)
+{
+  cs::RetrievalCost cost;
+
+  shared_ptr<lp::HopCountTag> hopCountTag = data.getTag<lp::HopCountTag>();
+  if (hopCountTag != nullptr) {
+    cost.hopCount = hopCountTag->get();
+  }
+
+  // a retransmission renews the out-record, so the latency is measured from the last one
+  auto now = time::steady_clock::now();
+  for (const shared_ptr<pit::Entry>& pitEntry : pitMatches) {
+    auto outRecord = pitEntry->getOutRecord(inFace);
+    if (outRecord != pitEntry->out_end()) {
+      time::nanoseconds latency = now - outRecord->getLastRenewed();
+      if (cost.latency < time::nanoseconds::zero() || latency < cost.latency) {
+        cost.latency = latency;
+      }
+    }
+  }
+
+  return cost;
+}
+
 Forwarder::Forwarder()
   : m_unsolicitedDataPolicy(new fw::DefaultUnsolicitedDataPolicy())
+  , m_cachePlacementPolicy(new fw::DefaultCachePlacementPolicy())
+  , m_nameTree(getNameTreeOptions())
   , m_fib(m_nameTree)
   , m_pit(m_nameTree)
   , m_measurements(m_nameTree)
@@ -52,6 +90,7 @@ Forwarder::Forwarder()
   , m_csFace(face::makeNullFace(FaceUri("contentstore://")))
 {
   getFaceTable().addReserved(m_csFace, face::FACEID_CONTENT_STORE);
+  m_cs.setProfiler(&m_profiler);
 
   m_faceTable.afterAdd.connect([this] (Face& face) {
     face.afterReceiveInterest.connect(
@@ -84,6 +123,8 @@ Forwarder::~Forwarder() = default;
 void
 Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
 {
+  PipelineProfiler::ScopedTimer timer(&m_profiler, PipelineStage::INCOMING_INTEREST);
+
   // receive Interest
   NFD_LOG_DEBUG("onIncomingInterest face=" << inFace.getId() <<
                 " interest=" << interest.getName());
@@ -101,7 +142,12 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
   }
 
   // detect duplicate Nonce with Dead Nonce List
-  bool hasDuplicateNonceInDnl = m_deadNonceList.has(interest.getName(), interest.getNonce());
+  bool hasDuplicateNonceInDnl = false;
+  {
+    PipelineProfiler::ScopedTimer dnlTimer(&m_profiler, PipelineStage::DEAD_NONCE_LIST);
+    hasDuplicateNonceInDnl = m_deadNonceList.has(name_tree::getHashes(interest).back(),
+                                                 interest.getNonce());
+  }
   if (hasDuplicateNonceInDnl) {
     // goto Interest loop pipeline
     this->onInterestLoop(inFace, interest);
@@ -116,8 +162,14 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
     const_cast<Interest&>(interest).setForwardingHint({});
   }
 
+  m_cachePlacementPolicy->afterReceiveInterest(inFace, interest);
+
   // PIT insert
-  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest).first;
+  shared_ptr<pit::Entry> pitEntry;
+  {
+    PipelineProfiler::ScopedTimer pitTimer(&m_profiler, PipelineStage::PIT_INSERT);
+    pitEntry = m_pit.insert(interest).first;
+  }
 
   // detect duplicate Nonce in PIT entry
   int dnw = fw::findDuplicateNonce(*pitEntry, interest.getNonce(), inFace);
@@ -135,12 +187,13 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
   // is pending?
   if (!pitEntry->hasInRecords()) {
     if (m_csFromNdnSim == nullptr) {
+      PipelineProfiler::ScopedTimer csTimer(&m_profiler, PipelineStage::CS_FIND);
       m_cs.find(interest,
                 bind(&Forwarder::onContentStoreHit, this, ref(inFace), pitEntry, _1, _2),
                 bind(&Forwarder::onContentStoreMiss, this, ref(inFace), pitEntry, _1));
     }
     else {
-      shared_ptr<Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
+      shared_ptr<const Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
       if (match != nullptr) {
         this->onContentStoreHit(inFace, pitEntry, interest, *match);
       }
@@ -186,6 +239,7 @@ void
 Forwarder::onContentStoreMiss(const Face& inFace, const shared_ptr<pit::Entry>& pitEntry,
                               const Interest& interest)
 {
+  PipelineProfiler::ScopedTimer timer(&m_profiler, PipelineStage::CS_MISS);
   NFD_LOG_DEBUG("onContentStoreMiss interest=" << interest.getName());
   ++m_counters.nCsMisses;
 
@@ -220,11 +274,13 @@ void
 Forwarder::onContentStoreHit(const Face& inFace, const shared_ptr<pit::Entry>& pitEntry,
                              const Interest& interest, const Data& data)
 {
+  PipelineProfiler::ScopedTimer timer(&m_profiler, PipelineStage::CS_HIT);
   NFD_LOG_DEBUG("onContentStoreHit interest=" << interest.getName());
   ++m_counters.nCsHits;
 
   data.setTag(make_shared<lp::IncomingFaceIdTag>(face::FACEID_CONTENT_STORE));
   // XXX should we lookup PIT for other Interests that also match csMatch?
+  m_cachePlacementPolicy->afterContentStoreHit(interest, data);
 
   pitEntry->isSatisfied = true;
   pitEntry->dataFreshnessPeriod = data.getFreshnessPeriod();
@@ -251,7 +307,10 @@ Forwarder::onOutgoingInterest(const shared_ptr<pit::Entry>& pitEntry, Face& outF
   pitEntry->insertOrUpdateOutRecord(outFace, interest);
 
   // send Interest
-  outFace.sendInterest(interest);
+  {
+    PipelineProfiler::ScopedTimer sendTimer(&m_profiler, PipelineStage::FACE_SEND);
+    outFace.sendInterest(interest);
+  }
   ++m_counters.nOutInterests;
 }
 
@@ -276,6 +335,8 @@ Forwarder::onInterestFinalize(const shared_ptr<pit::Entry>& pitEntry)
 void
 Forwarder::onIncomingData(Face& inFace, const Data& data)
 {
+  PipelineProfiler::ScopedTimer timer(&m_profiler, PipelineStage::INCOMING_DATA);
+
   // receive Data
   NFD_LOG_DEBUG("onIncomingData face=" << inFace.getId() << " data=" << data.getName());
   data.setTag(make_shared<lp::IncomingFaceIdTag>(inFace.getId()));
@@ -299,14 +360,27 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     return;
   }
 
-  shared_ptr<Data> dataCopyWithoutTag = make_shared<Data>(data);
-  dataCopyWithoutTag->removeTag<lp::HopCountTag>();
+  // CS insert, unless the Data is to be cached elsewhere on the path
+  fw::CachePlacementDecision decision = m_cachePlacementPolicy->decide(inFace, data, pitMatches);
+  if (decision == fw::CachePlacementDecision::CACHE) {
+    PipelineProfiler::ScopedTimer csTimer(&m_profiler, PipelineStage::CS_INSERT);
+    shared_ptr<Data> dataCopyWithoutTag = make_shared<Data>(data);
+    dataCopyWithoutTag->removeTag<lp::HopCountTag>();
+    dataCopyWithoutTag->removeTag<lp::CentralityTag>();
+    if (m_csFromNdnSim == nullptr && m_cs.getPolicy()->needsRetrievalCost()) {
+      dataCopyWithoutTag->setTag(make_shared<cs::RetrievalCostTag>(
+        getRetrievalCost(inFace, data, pitMatches)));
+    }
 
-  // CS insert
-  if (m_csFromNdnSim == nullptr)
-    m_cs.insert(*dataCopyWithoutTag);
-  else
-    m_csFromNdnSim->Add(dataCopyWithoutTag);
+    if (m_csFromNdnSim == nullptr)
+      m_cs.insert(*dataCopyWithoutTag);
+    else
+      m_csFromNdnSim->Add(dataCopyWithoutTag);
+  }
+  else {
+    NFD_LOG_DEBUG("onIncomingData face=" << inFace.getId() << " data=" << data.getName() <<
+                  " placement=" << decision);
+  }
 
   // when only one PIT entry is matched, trigger strategy: after receive Data
   if (pitMatches.size() == 1) {
@@ -401,6 +475,8 @@ Forwarder::onDataUnsolicited(Face& inFace, const Data& data)
 void
 Forwarder::onOutgoingData(const Data& data, Face& outFace)
 {
+  PipelineProfiler::ScopedTimer timer(&m_profiler, PipelineStage::OUTGOING_DATA);
+
   if (outFace.getId() == face::INVALID_FACEID) {
     NFD_LOG_WARN("onOutgoingData face=invalid data=" << data.getName());
     return;
@@ -420,7 +496,10 @@ Forwarder::onOutgoingData(const Data& data, Face& outFace)
   // TODO traffic manager
 
   // send Data
-  outFace.sendData(data);
+  {
+    PipelineProfiler::ScopedTimer sendTimer(&m_profiler, PipelineStage::FACE_SEND);
+    outFace.sendData(data);
+  }
   ++m_counters.nOutData;
 }
 
@@ -527,7 +606,10 @@ Forwarder::onOutgoingNack(const shared_ptr<pit::Entry>& pitEntry, const Face& ou
   pitEntry->deleteInRecord(outFace);
 
   // send Nack on face
-  const_cast<Face&>(outFace).sendNack(nackPkt);
+  {
+    PipelineProfiler::ScopedTimer sendTimer(&m_profiler, PipelineStage::FACE_SEND);
+    const_cast<Face&>(outFace).sendNack(nackPkt);
+  }
   ++m_counters.nOutNacks;
 }
 
@@ -549,10 +631,10 @@ Forwarder::setExpiryTimer(const shared_ptr<pit::Entry>& pitEntry, time::millisec
 }
 
 static inline void
-insertNonceToDnl(DeadNonceList& dnl, const pit::Entry& pitEntry,
+insertNonceToDnl(DeadNonceList& dnl, name_tree::HashValue nameHash,
                  const pit::OutRecord& outRecord)
 {
-  dnl.add(pitEntry.getName(), outRecord.getLastNonce());
+  dnl.add(nameHash, outRecord.getLastNonce());
 }
 
 void
@@ -571,17 +653,19 @@ Forwarder::insertDeadNonceList(pit::Entry& pitEntry, Face* upstream)
   }
 
   // Dead Nonce List insert
+  PipelineProfiler::ScopedTimer dnlTimer(&m_profiler, PipelineStage::DEAD_NONCE_LIST);
+  name_tree::HashValue nameHash = name_tree::getHashes(pitEntry.getInterest()).back();
   if (upstream == nullptr) {
     // insert all outgoing Nonces
     const pit::OutRecordCollection& outRecords = pitEntry.getOutRecords();
     std::for_each(outRecords.begin(), outRecords.end(),
-                  bind(&insertNonceToDnl, ref(m_deadNonceList), cref(pitEntry), _1));
+                  bind(&insertNonceToDnl, ref(m_deadNonceList), nameHash, _1));
   }
   else {
     // insert outgoing Nonce of a specific face
     pit::OutRecordCollection::iterator outRecord = pitEntry.getOutRecord(*upstream);
     if (outRecord != pitEntry.getOutRecords().end()) {
-      m_deadNonceList.add(pitEntry.getName(), outRecord->getLastNonce());
+      m_deadNonceList.add(nameHash, outRecord->getLastNonce());
     }
   }
 }
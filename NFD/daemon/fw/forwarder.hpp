@@ -29,8 +29,10 @@
 #include "core/common.hpp"
 #include "core/scheduler.hpp"
 #include "forwarder-counters.hpp"
+#include "pipeline-profiler.hpp"
 #include "face-table.hpp"
 #include "unsolicited-data-policy.hpp"
+#include "cache-placement-policy.hpp"
 #include "table/fib.hpp"
 #include "table/pit.hpp"
 #include "table/cs.hpp"
@@ -65,6 +67,16 @@ public:
     return m_counters;
   }
 
+  /** \brief get the per-stage latency histograms of forwarding pipelines
+   *
+   *  The profiler is disabled by default; enable it with PipelineProfiler::setEnabled.
+   */
+  PipelineProfiler&
+  getProfiler()
+  {
+    return m_profiler;
+  }
+
 public: // faces and policies
   FaceTable&
   getFaceTable()
@@ -105,6 +117,19 @@ public: // faces and policies
     m_unsolicitedDataPolicy = std::move(policy);
   }
 
+  fw::CachePlacementPolicy&
+  getCachePlacementPolicy() const
+  {
+    return *m_cachePlacementPolicy;
+  }
+
+  void
+  setCachePlacementPolicy(unique_ptr<fw::CachePlacementPolicy> policy)
+  {
+    BOOST_ASSERT(policy != nullptr);
+    m_cachePlacementPolicy = std::move(policy);
+  }
+
 public: // forwarding entrypoints and tables
   /** \brief start incoming Interest processing
    *  \param face face on which Interest is received
@@ -286,14 +311,17 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   dispatchToStrategy(pit::Entry& pitEntry, Function trigger)
 #endif
   {
+    PipelineProfiler::ScopedTimer timer(&m_profiler, PipelineStage::STRATEGY);
     trigger(m_strategyChoice.findEffectiveStrategy(pitEntry));
   }
 
 private:
   ForwarderCounters m_counters;
+  PipelineProfiler m_profiler;
 
   FaceTable m_faceTable;
   unique_ptr<fw::UnsolicitedDataPolicy> m_unsolicitedDataPolicy;
+  unique_ptr<fw::CachePlacementPolicy> m_cachePlacementPolicy;
 
   NameTree           m_nameTree;
   Fib                m_fib;
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pipeline-profiler.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace nfd {
+
+uint64_t
+readCycleCounter()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t value;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+  return value;
+#else
+  return static_cast<uint64_t>(time::duration_cast<time::nanoseconds>(
+           time::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+void
+LatencyHistogram::add(uint64_t cycles)
+{
+  size_t bucket = cycles <= 1 ? 0 : 63 - __builtin_clzll(cycles);
+  ++m_buckets[bucket];
+  ++m_nSamples;
+  m_sum += cycles;
+  m_max = std::max(m_max, cycles);
+}
+
+void
+LatencyHistogram::reset()
+{
+  *this = LatencyHistogram();
+}
+
+uint64_t
+LatencyHistogram::getQuantile(double q) const
+{
+  BOOST_ASSERT(q >= 0.0 && q <= 1.0);
+  if (m_nSamples == 0) {
+    return 0;
+  }
+
+  uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * m_nSamples)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < N_BUCKETS; ++i) {
+    seen += m_buckets[i];
+    if (seen >= rank) {
+      // the upper boundary of the last bucket overflows, and m_max is tighter anyway
+      return i + 1 < N_BUCKETS ? std::min(m_max, (uint64_t(2) << i) - 1) : m_max;
+    }
+  }
+  return m_max;
+}
+
+std::ostream&
+operator<<(std::ostream& os, PipelineStage stage)
+{
+  switch (stage) {
+    case PipelineStage::INCOMING_INTEREST:
+      return os << "IncomingInterest";
+    case PipelineStage::DEAD_NONCE_LIST:
+      return os << "DeadNonceList";
+    case PipelineStage::PIT_INSERT:
+      return os << "PitInsert";
+    case PipelineStage::CS_FIND:
+      return os << "CsFind";
+    case PipelineStage::CS_MISS:
+      return os << "ContentStoreMiss";
+    case PipelineStage::CS_HIT:
+      return os << "ContentStoreHit";
+    case PipelineStage::STRATEGY:
+      return os << "Strategy";
+    case PipelineStage::INCOMING_DATA:
+      return os << "IncomingData";
+    case PipelineStage::CS_INSERT:
+      return os << "CsInsert";
+    case PipelineStage::OUTGOING_DATA:
+      return os << "OutgoingData";
+    case PipelineStage::FACE_SEND:
+      return os << "FaceSend";
+    case PipelineStage::POLICY_AFTER_INSERT:
+      return os << "PolicyAfterInsert";
+    case PipelineStage::POLICY_AFTER_REFRESH:
+      return os << "PolicyAfterRefresh";
+    case PipelineStage::POLICY_BEFORE_ERASE:
+      return os << "PolicyBeforeErase";
+    case PipelineStage::POLICY_BEFORE_USE:
+      return os << "PolicyBeforeUse";
+  }
+  return os << static_cast<int>(stage);
+}
+
+void
+PipelineProfiler::reset()
+{
+  for (LatencyHistogram& histogram : m_histograms) {
+    histogram.reset();
+  }
+}
+
+} // namespace nfd
@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_PIPELINE_PROFILER_HPP
+#define NFD_DAEMON_FW_PIPELINE_PROFILER_HPP
+
+#include "core/common.hpp"
+
+#include <array>
+
+namespace nfd {
+
+/** \brief reads a monotonic counter that ticks at a constant rate
+ *
+ *  This is the time stamp counter on x86 and the virtual counter on AArch64, which take a few
+ *  nanoseconds to read. On other architectures, it falls back to nanoseconds of steady_clock.
+ */
+uint64_t
+readCycleCounter();
+
+/** \brief a histogram of durations in cycles, with power-of-two bucket boundaries
+ *
+ *  Bucket 0 counts durations of 0 or 1 cycle; bucket i > 0 counts durations in [2^i, 2^(i+1)).
+ */
+class LatencyHistogram
+{
+public:
+  static constexpr size_t N_BUCKETS = 64;
+
+  void
+  add(uint64_t cycles);
+
+  void
+  reset();
+
+  uint64_t
+  getNSamples() const
+  {
+    return m_nSamples;
+  }
+
+  uint64_t
+  getSum() const
+  {
+    return m_sum;
+  }
+
+  uint64_t
+  getMax() const
+  {
+    return m_max;
+  }
+
+  uint64_t
+  getBucket(size_t i) const
+  {
+    return m_buckets.at(i);
+  }
+
+  /** \return upper boundary of the bucket that contains the q-quantile, or 0 if there is no sample
+   *  \pre 0 <= q <= 1
+   */
+  uint64_t
+  getQuantile(double q) const;
+
+private:
+  std::array<uint64_t, N_BUCKETS> m_buckets{};
+  uint64_t m_nSamples = 0;
+  uint64_t m_sum = 0;
+  uint64_t m_max = 0;
+};
+
+/** \brief stages of the forwarding pipelines measured by PipelineProfiler
+ *
+ *  Durations are inclusive: a stage that synchronously invokes another stage, such as
+ *  INCOMING_INTEREST invoking CS_FIND and then CS_MISS and STRATEGY, includes its time.
+ */
+enum class PipelineStage {
+  INCOMING_INTEREST,    ///< Forwarder::onIncomingInterest
+  DEAD_NONCE_LIST,      ///< Dead Nonce List query and insertion
+  PIT_INSERT,           ///< Pit::insert
+  CS_FIND,              ///< Cs::find
+  CS_MISS,              ///< Forwarder::onContentStoreMiss
+  CS_HIT,               ///< Forwarder::onContentStoreHit
+  STRATEGY,             ///< Forwarder::dispatchToStrategy
+  INCOMING_DATA,        ///< Forwarder::onIncomingData
+  CS_INSERT,            ///< Cs::insert
+  OUTGOING_DATA,        ///< Forwarder::onOutgoingData
+  FACE_SEND,            ///< Face::sendInterest, Face::sendData, and Face::sendNack
+  POLICY_AFTER_INSERT,  ///< cs::Policy::afterInsert
+  POLICY_AFTER_REFRESH, ///< cs::Policy::afterRefresh
+  POLICY_BEFORE_ERASE,  ///< cs::Policy::beforeErase
+  POLICY_BEFORE_USE     ///< cs::Policy::beforeUse
+};
+
+std::ostream&
+operator<<(std::ostream& os, PipelineStage stage);
+
+/** \brief per-stage latency histograms of a forwarder
+ *
+ *  The profiler is disabled by default, in which case each measured stage costs one branch.
+ */
+class PipelineProfiler : noncopyable
+{
+public:
+  static constexpr size_t N_STAGES = static_cast<size_t>(PipelineStage::POLICY_BEFORE_USE) + 1;
+
+  /** \brief measures the lifetime of this object as a stage
+   */
+  class ScopedTimer : noncopyable
+  {
+  public:
+    /** \param profiler the profiler to record into; nullptr or a disabled profiler records nothing
+     */
+    ScopedTimer(PipelineProfiler* profiler, PipelineStage stage)
+      : m_profiler(profiler != nullptr && profiler->isEnabled() ? profiler : nullptr)
+      , m_stage(stage)
+      , m_start(m_profiler != nullptr ? readCycleCounter() : 0)
+    {
+    }
+
+    ~ScopedTimer()
+    {
+      if (m_profiler != nullptr) {
+        m_profiler->record(m_stage, readCycleCounter() - m_start);
+      }
+    }
+
+  private:
+    PipelineProfiler* m_profiler;
+    PipelineStage m_stage;
+    uint64_t m_start;
+  };
+
+  bool
+  isEnabled() const
+  {
+    return m_isEnabled;
+  }
+
+  void
+  setEnabled(bool isEnabled)
+  {
+    m_isEnabled = isEnabled;
+  }
+
+  void
+  record(PipelineStage stage, uint64_t cycles)
+  {
+    m_histograms[static_cast<size_t>(stage)].add(cycles);
+  }
+
+  const LatencyHistogram&
+  get(PipelineStage stage) const
+  {
+    return m_histograms[static_cast<size_t>(stage)];
+  }
+
+  /** \brief clears all histograms
+   */
+  void
+  reset();
+
+private:
+  bool m_isEnabled = false;
+  std::array<LatencyHistogram, N_STAGES> m_histograms;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_PIPELINE_PROFILER_HPP
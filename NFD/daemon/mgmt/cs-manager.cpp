@@ -50,6 +50,19 @@ CsManager::changeConfig(const ControlParameters& parameters,
 {
   using ndn::nfd::CsFlagBit;
 
+  // validate the policy name before changing anything else
+  unique_ptr<cs::Policy> policy;
+  if (parameters.hasCsPolicy()) {
+    policy = cs::Policy::create(parameters.getCsPolicy());
+    if (policy == nullptr) {
+      return done(ControlResponse(404, "Content Store replacement policy not found"));
+    }
+  }
+
+  if (policy != nullptr && policy->getName() != m_cs.getPolicy()->getName()) {
+    m_cs.setPolicy(std::move(policy));
+  }
+
   if (parameters.hasCapacity()) {
     m_cs.setLimit(parameters.getCapacity());
   }
@@ -66,6 +79,7 @@ CsManager::changeConfig(const ControlParameters& parameters,
   body.setCapacity(m_cs.getLimit());
   body.setFlagBit(CsFlagBit::BIT_CS_ENABLE_ADMIT, m_cs.shouldAdmit(), false);
   body.setFlagBit(CsFlagBit::BIT_CS_ENABLE_SERVE, m_cs.shouldServe(), false);
+  body.setCsPolicy(m_cs.getPolicy()->getName());
   done(ControlResponse(200, "OK").setBody(body.wireEncode()));
 }
 
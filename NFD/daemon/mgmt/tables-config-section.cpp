@@ -29,6 +29,7 @@
 namespace nfd {
 
 const size_t TablesConfigSection::DEFAULT_CS_MAX_PACKETS = 65536;
+const double TablesConfigSection::DEFAULT_CS_EVICTION_TARGET = 1.0;
 
 TablesConfigSection::TablesConfigSection(Forwarder& forwarder)
   : m_forwarder(forwarder)
@@ -51,8 +52,10 @@ TablesConfigSection::ensureConfigured()
   }
 
   m_forwarder.getCs().setLimit(DEFAULT_CS_MAX_PACKETS);
+  m_forwarder.getCs().setEvictionTarget(DEFAULT_CS_EVICTION_TARGET);
   // Don't set default cs_policy because it's already created by CS itself.
   m_forwarder.setUnsolicitedDataPolicy(make_unique<fw::DefaultUnsolicitedDataPolicy>());
+  m_forwarder.setCachePlacementPolicy(make_unique<fw::DefaultCachePlacementPolicy>());
 
   m_isConfigured = true;
 }
@@ -66,6 +69,18 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
     nCsMaxPackets = ConfigFile::parseNumber<size_t>(*csMaxPacketsNode, "cs_max_packets", "tables");
   }
 
+  double csEvictionTarget = DEFAULT_CS_EVICTION_TARGET;
+  OptionalConfigSection csEvictionTargetNode = section.get_child_optional("cs_eviction_target");
+  if (csEvictionTargetNode) {
+    csEvictionTarget = ConfigFile::parseNumber<double>(*csEvictionTargetNode, "cs_eviction_target",
+                                                       "tables");
+    if (!(csEvictionTarget > 0.0 && csEvictionTarget <= 1.0)) {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error(
+        "Invalid value \"" + csEvictionTargetNode->get_value<std::string>() +
+        "\" for option \"cs_eviction_target\" in \"tables\" section"));
+    }
+  }
+
   unique_ptr<cs::Policy> csPolicy;
   OptionalConfigSection csPolicyNode = section.get_child_optional("cs_policy");
   if (csPolicyNode) {
@@ -91,6 +106,20 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
     unsolicitedDataPolicy = make_unique<fw::DefaultUnsolicitedDataPolicy>();
   }
 
+  unique_ptr<fw::CachePlacementPolicy> cachePlacementPolicy;
+  OptionalConfigSection cachePlacementPolicyNode = section.get_child_optional("cs_placement_policy");
+  if (cachePlacementPolicyNode) {
+    std::string policyName = cachePlacementPolicyNode->get_value<std::string>();
+    cachePlacementPolicy = fw::CachePlacementPolicy::create(policyName);
+    if (cachePlacementPolicy == nullptr) {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error(
+        "Unknown cs_placement_policy \"" + policyName + "\" in \"tables\" section"));
+    }
+  }
+  else {
+    cachePlacementPolicy = make_unique<fw::DefaultCachePlacementPolicy>();
+  }
+
   OptionalConfigSection strategyChoiceSection = section.get_child_optional("strategy_choice");
   if (strategyChoiceSection) {
     processStrategyChoiceSection(*strategyChoiceSection, isDryRun);
@@ -110,8 +139,10 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
   if (cs.size() == 0 && csPolicy != nullptr) {
     cs.setPolicy(std::move(csPolicy));
   }
+  cs.setEvictionTarget(csEvictionTarget);
 
   m_forwarder.setUnsolicitedDataPolicy(std::move(unsolicitedDataPolicy));
+  m_forwarder.setCachePlacementPolicy(std::move(cachePlacementPolicy));
 
   m_isConfigured = true;
 }
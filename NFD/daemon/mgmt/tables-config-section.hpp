@@ -39,6 +39,7 @@ namespace nfd {
  *  {
  *    cs_max_packets 65536
  *    cs_policy priority_fifo
+ *    cs_eviction_target 1.0
  *    cs_unsolicited_policy drop-all
  *
  *    strategy_choice
@@ -58,7 +59,7 @@ namespace nfd {
  *  \endcode
  *
  *  During a configuration reload,
- *  \li cs_max_packets, cs_policy, and cs_unsolicited_policy are applied;
+ *  \li cs_max_packets, cs_policy, cs_eviction_target, and cs_unsolicited_policy are applied;
  *      defaults are used if an option is omitted.
  *  \li strategy_choice entries are inserted, but old entries are not deleted.
  *  \li network_region is applied; it's kept unchanged if the section is omitted.
@@ -93,6 +94,7 @@ private:
 
 private:
   static const size_t DEFAULT_CS_MAX_PACKETS;
+  static const double DEFAULT_CS_EVICTION_TARGET;
 
   Forwarder& m_forwarder;
 
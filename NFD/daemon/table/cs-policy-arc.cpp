@@ -0,0 +1,375 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-arc.hpp"
+#include "cs.hpp"
+#include "memory-usage.hpp"
+#include "name-tree-hashtable.hpp"
+
+namespace nfd {
+namespace cs {
+namespace arc {
+
+const std::string ArcPolicy::POLICY_NAME = "arc";
+NFD_REGISTER_CS_POLICY(ArcPolicy);
+
+const ArcPolicy::NodeIndex ArcPolicy::NONE = std::numeric_limits<NodeIndex>::max();
+
+ArcPolicy::ArcPolicy()
+  : Policy(POLICY_NAME)
+  , m_freeList(NONE)
+  , m_target(0)
+{
+}
+
+void
+ArcPolicy::doAfterInsert(iterator i)
+{
+  size_t c = this->getLimit();
+  size_t hash = getHash(i);
+  ListId admitTo = T1;
+  bool isB2Hit = false;
+
+  auto ghost = m_ghosts.find(hash);
+  if (ghost != m_ghosts.end()) {
+    // Case II and III: adapt the target towards the list the ghost came from
+    NodeIndex n = ghost->second;
+    size_t b1 = m_lists[B1].size;
+    size_t b2 = m_lists[B2].size;
+    isB2Hit = m_nodes[n].list == B2;
+    if (isB2Hit) {
+      size_t delta = std::max<size_t>(b1 / b2, 1);
+      m_target = m_target > delta ? m_target - delta : 0;
+    }
+    else {
+      size_t delta = std::max<size_t>(b2 / b1, 1);
+      m_target = std::min(m_target + delta, c);
+    }
+    m_ghosts.erase(ghost);
+    this->releaseNode(n);
+    admitTo = T2;
+  }
+  else if (m_lists[T1].size + m_lists[B1].size >= c) {
+    // Case IV.A
+    if (m_lists[B1].size > 0) {
+      this->dropGhost(B1);
+    }
+    else if (m_lists[T1].size > 0 && this->size() > c) {
+      // T1 fills the cache: its LRU entry leaves without a ghost
+      NodeIndex n = m_lists[T1].lru;
+      iterator victim = m_nodes[n].entry;
+      m_cached.erase(&*victim);
+      this->releaseNode(n);
+      this->emitSignal(beforeEvict, victim);
+    }
+  }
+  else if (m_lists[B2].size > 0 &&
+           m_lists[T1].size + m_lists[T2].size + m_lists[B1].size + m_lists[B2].size >= 2 * c) {
+    // Case IV.B
+    this->dropGhost(B2);
+  }
+
+  // i is in CS but not yet on T1 or T2, so it cannot be chosen by replace()
+  while (this->size() > c && m_lists[T1].size + m_lists[T2].size > 0) {
+    this->replace(isB2Hit);
+  }
+
+  if (this->size() > c) {
+    this->emitSignal(beforeEvict, i);
+  }
+  else {
+    this->admit(admitTo, i, hash);
+  }
+  this->trimGhosts();
+}
+
+void
+ArcPolicy::doAfterRefresh(iterator i)
+{
+  this->promote(i);
+}
+
+void
+ArcPolicy::doBeforeErase(iterator i)
+{
+  auto found = m_cached.find(&*i);
+  BOOST_ASSERT(found != m_cached.end());
+  NodeIndex n = found->second;
+  m_cached.erase(found);
+  this->releaseNode(n);
+}
+
+void
+ArcPolicy::doBeforeUse(iterator i)
+{
+  this->promote(i);
+}
+
+void
+ArcPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+  while (this->size() > this->getLimit()) {
+    BOOST_ASSERT(m_lists[T1].size + m_lists[T2].size > 0);
+    this->replace(false);
+  }
+  m_target = std::min(m_target, this->getLimit());
+  this->trimGhosts();
+}
+
+std::vector<iterator>
+ArcPolicy::doListEntries() const
+{
+  std::vector<iterator> entries;
+  entries.reserve(m_cached.size());
+  for (ListId id : {T1, T2}) {
+    for (NodeIndex n = m_lists[id].lru; n != NONE; n = m_nodes[n].next) {
+      entries.push_back(m_nodes[n].entry);
+    }
+  }
+  return entries;
+}
+
+// snapshot record sections
+enum : uint64_t {
+  SNAPSHOT_T1 = 0,
+  SNAPSHOT_T2 = 1
+};
+
+Block
+ArcPolicy::doSaveState() const
+{
+  // ghost lists keep only name hashes, so they are not saved and start empty after loading
+  Block state(snapshot::tlv::PolicyState);
+  state.push_back(snapshot::makeRealBlock(snapshot::tlv::Parameter, m_target));
+  for (ListId id : {T1, T2}) {
+    for (NodeIndex n = m_lists[id].lru; n != NONE; n = m_nodes[n].next) {
+      state.push_back(snapshot::Record(id == T1 ? SNAPSHOT_T1 : SNAPSHOT_T2,
+                                       m_nodes[n].entry->getName()).wireEncode());
+    }
+  }
+  state.encode();
+  return state;
+}
+
+bool
+ArcPolicy::doLoadState(const Block& state, const SnapshotIndex& index)
+{
+  std::vector<double> parameters;
+  std::vector<std::pair<ListId, iterator>> entries;
+  std::set<const Entry*> seen;
+
+  for (const Block& element : state.elements()) {
+    if (element.type() == snapshot::tlv::Parameter) {
+      parameters.push_back(snapshot::readReal(element));
+      continue;
+    }
+    if (element.type() != snapshot::tlv::Record) {
+      continue;
+    }
+
+    snapshot::Record record(element);
+    if (record.section != SNAPSHOT_T1 && record.section != SNAPSHOT_T2) {
+      return false;
+    }
+    auto found = index.find(record.name);
+    if (found == index.end() || !seen.insert(&*found->second).second) {
+      return false;
+    }
+    entries.emplace_back(record.section == SNAPSHOT_T1 ? T1 : T2, found->second);
+  }
+  if (parameters.size() != 1 || parameters[0] < 0 || entries.size() != index.size()) {
+    return false;
+  }
+
+  m_nodes.clear();
+  m_freeList = NONE;
+  std::fill(std::begin(m_lists), std::end(m_lists), List());
+  m_cached.clear();
+  m_ghosts.clear();
+  m_target = std::min(static_cast<size_t>(parameters[0]), this->getLimit());
+
+  m_nodes.reserve(entries.size());
+  for (const auto& entry : entries) {
+    this->admit(entry.first, entry.second, getHash(entry.second));
+  }
+  return true;
+}
+
+size_t
+ArcPolicy::doGetMemoryUsage() const
+{
+  using namespace memory_usage;
+
+  return m_nodes.capacity() * sizeof(Node) +
+         m_cached.size() * (sizeof(std::pair<const Entry*, NodeIndex>) + HASH_NODE_OVERHEAD) +
+         m_ghosts.size() * (sizeof(std::pair<size_t, NodeIndex>) + HASH_NODE_OVERHEAD) +
+         (m_cached.bucket_count() + m_ghosts.bucket_count()) * sizeof(void*);
+}
+
+ArcPolicy::NodeIndex
+ArcPolicy::allocateNode()
+{
+  if (m_freeList != NONE) {
+    NodeIndex n = m_freeList;
+    m_freeList = m_nodes[n].next;
+    return n;
+  }
+
+  BOOST_ASSERT(m_nodes.size() < NONE);
+  m_nodes.emplace_back();
+  return static_cast<NodeIndex>(m_nodes.size() - 1);
+}
+
+void
+ArcPolicy::releaseNode(NodeIndex n)
+{
+  this->unlink(n);
+  m_nodes[n].next = m_freeList;
+  m_freeList = n;
+}
+
+void
+ArcPolicy::unlink(NodeIndex n)
+{
+  Node& node = m_nodes[n];
+  List& list = m_lists[node.list];
+
+  if (node.prev != NONE) {
+    m_nodes[node.prev].next = node.next;
+  }
+  else {
+    list.lru = node.next;
+  }
+
+  if (node.next != NONE) {
+    m_nodes[node.next].prev = node.prev;
+  }
+  else {
+    list.mru = node.prev;
+  }
+
+  --list.size;
+}
+
+void
+ArcPolicy::pushMru(ListId id, NodeIndex n)
+{
+  Node& node = m_nodes[n];
+  List& list = m_lists[id];
+
+  node.list = id;
+  node.prev = list.mru;
+  node.next = NONE;
+  if (list.mru != NONE) {
+    m_nodes[list.mru].next = n;
+  }
+  else {
+    list.lru = n;
+  }
+  list.mru = n;
+  ++list.size;
+}
+
+void
+ArcPolicy::admit(ListId id, iterator i, size_t hash)
+{
+  NodeIndex n = this->allocateNode();
+  m_nodes[n].entry = i;
+  m_nodes[n].hash = hash;
+  this->pushMru(id, n);
+
+  bool isNew = m_cached.emplace(&*i, n).second;
+  BOOST_ASSERT(isNew);
+  (void)isNew;
+}
+
+void
+ArcPolicy::promote(iterator i)
+{
+  auto found = m_cached.find(&*i);
+  BOOST_ASSERT(found != m_cached.end());
+  this->unlink(found->second);
+  this->pushMru(T2, found->second);
+}
+
+void
+ArcPolicy::replace(bool isB2Hit)
+{
+  size_t t1 = m_lists[T1].size;
+  bool shouldEvictT1 = m_lists[T2].size == 0 ||
+                       (t1 > 0 && (t1 > m_target || (isB2Hit && t1 == m_target)));
+  ListId from = shouldEvictT1 ? T1 : T2;
+  ListId ghostList = shouldEvictT1 ? B1 : B2;
+
+  NodeIndex n = m_lists[from].lru;
+  BOOST_ASSERT(n != NONE);
+  iterator victim = m_nodes[n].entry;
+  m_cached.erase(&*victim);
+  this->unlink(n);
+
+  // a colliding hash is either the same name or indistinguishable from it: keep the newer ghost
+  auto ghost = m_ghosts.emplace(m_nodes[n].hash, n);
+  if (!ghost.second) {
+    this->releaseNode(ghost.first->second);
+    ghost.first->second = n;
+  }
+  this->pushMru(ghostList, n);
+
+  this->emitSignal(beforeEvict, victim);
+}
+
+void
+ArcPolicy::dropGhost(ListId id)
+{
+  NodeIndex n = m_lists[id].lru;
+  BOOST_ASSERT(n != NONE);
+  m_ghosts.erase(m_nodes[n].hash);
+  this->releaseNode(n);
+}
+
+void
+ArcPolicy::trimGhosts()
+{
+  size_t c = this->getLimit();
+  while (m_lists[B1].size > 0 && m_lists[T1].size + m_lists[B1].size > c) {
+    this->dropGhost(B1);
+  }
+  while (m_lists[B2].size > 0 &&
+         m_lists[T1].size + m_lists[T2].size + m_lists[B1].size + m_lists[B2].size > 2 * c) {
+    this->dropGhost(B2);
+  }
+}
+
+size_t
+ArcPolicy::getHash(iterator i)
+{
+  // reuses the hashes cached on the Data by NameTree lookups in the forwarding pipeline
+  return name_tree::getHashes(i->getData()).back();
+}
+
+} // namespace arc
+} // namespace cs
+} // namespace nfd
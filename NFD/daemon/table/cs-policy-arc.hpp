@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_ARC_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_ARC_HPP
+
+#include "cs-policy.hpp"
+
+#include <unordered_map>
+
+namespace nfd {
+namespace cs {
+namespace arc {
+
+/** \brief ARC cs replacement policy
+ *
+ *  Adaptive Replacement Cache (Megiddo and Modha, FAST 2003) keeps cached entries in two LRU
+ *  lists: T1 holds entries used once since they entered the cache, and T2 holds entries used
+ *  at least twice. Two ghost lists, B1 and B2, remember entries recently evicted from T1 and T2.
+ *  A miss that hits a ghost moves the target size of T1 towards the list the ghost came from,
+ *  so the policy adapts between recency and frequency without a fixed split.
+ *
+ *  Ghost entries store only the hash of the Data name, which the forwarding pipeline has
+ *  already computed for NameTree lookups. A hash collision can therefore make an unseen name
+ *  look like a ghost hit, which only affects the adaptation of the target size.
+ *
+ *  List nodes are kept in a pool and linked by index, so that after the pool has grown to
+ *  its working size every operation takes constant time and does not allocate list nodes.
+ */
+class ArcPolicy : public Policy
+{
+public:
+  ArcPolicy();
+
+public:
+  static const std::string POLICY_NAME;
+
+  /** \brief identifies one of the four lists
+   */
+  enum ListId : uint8_t {
+    T1,
+    T2,
+    B1,
+    B2,
+    N_LISTS
+  };
+
+  /** \return number of nodes on list \p id
+   */
+  size_t
+  getListSize(ListId id) const
+  {
+    return m_lists[id].size;
+  }
+
+  /** \return target size of T1
+   */
+  size_t
+  getTarget() const
+  {
+    return m_target;
+  }
+
+private:
+  virtual void
+  doAfterInsert(iterator i) override;
+
+  virtual void
+  doAfterRefresh(iterator i) override;
+
+  virtual void
+  doBeforeErase(iterator i) override;
+
+  virtual void
+  doBeforeUse(iterator i) override;
+
+  virtual void
+  evictEntries() override;
+
+  virtual std::vector<iterator>
+  doListEntries() const override;
+
+  virtual Block
+  doSaveState() const override;
+
+  virtual bool
+  doLoadState(const Block& state, const SnapshotIndex& index) override;
+
+  virtual size_t
+  doGetMemoryUsage() const override;
+
+private:
+  typedef uint32_t NodeIndex;
+  static const NodeIndex NONE;
+
+  struct Node
+  {
+    iterator entry;     ///< cached entry, valid on T1 and T2
+    size_t hash;        ///< hash of the Data name
+    NodeIndex prev;     ///< towards LRU end
+    NodeIndex next;     ///< towards MRU end, or next free node
+    ListId list;
+  };
+
+  struct List
+  {
+    NodeIndex lru = NONE;
+    NodeIndex mru = NONE;
+    size_t size = 0;
+  };
+
+  /** \brief takes a node from the pool, or grows the pool
+   */
+  NodeIndex
+  allocateNode();
+
+  /** \brief unlinks node \p n from its list and returns it to the pool
+   */
+  void
+  releaseNode(NodeIndex n);
+
+  void
+  unlink(NodeIndex n);
+
+  /** \brief links node \p n at the MRU end of list \p id
+   */
+  void
+  pushMru(ListId id, NodeIndex n);
+
+  /** \brief adds entry \p i at the MRU end of cached list \p id
+   */
+  void
+  admit(ListId id, iterator i, size_t hash);
+
+  /** \brief moves a cached entry to the MRU end of T2
+   */
+  void
+  promote(iterator i);
+
+  /** \brief evicts the LRU entry of T1 or T2 and remembers it in B1 or B2
+   *  \param isB2Hit whether the insertion that caused the replacement hit B2
+   */
+  void
+  replace(bool isB2Hit);
+
+  /** \brief drops the LRU ghost of list \p id
+   */
+  void
+  dropGhost(ListId id);
+
+  /** \brief keeps |T1|+|B1| <= c and |T1|+|T2|+|B1|+|B2| <= 2c
+   */
+  void
+  trimGhosts();
+
+  static size_t
+  getHash(iterator i);
+
+private:
+  std::vector<Node> m_nodes;
+  NodeIndex m_freeList;
+  List m_lists[N_LISTS];
+  std::unordered_map<const Entry*, NodeIndex> m_cached; ///< nodes on T1 and T2
+  std::unordered_map<size_t, NodeIndex> m_ghosts;       ///< nodes on B1 and B2, by name hash
+  size_t m_target; ///< target size of T1, called p in the paper
+};
+
+} // namespace arc
+
+using arc::ArcPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_ARC_HPP
@@ -1,6 +1,7 @@
 #include "cs-policy-ccp.hpp"
 #include "cs.hpp"
 #include "core/logger.hpp"
+#include "memory-usage.hpp"
 
 #include "ns3/simulator.h"
 
@@ -20,7 +21,17 @@ NFD_REGISTER_CS_POLICY(CcpPolicy);
 CcpPolicy::CcpPolicy()
   : Policy(POLICY_NAME)
 {
-  ns3::Simulator::Schedule(ns3::Seconds(T), &CcpPolicy::update, this);
+  m_updateEvent = ns3::Simulator::Schedule(ns3::Seconds(T), &CcpPolicy::update, this);
+}
+
+CcpPolicy::~CcpPolicy()
+{
+  // the policy may be replaced while the simulation is running
+  ns3::Simulator::Cancel(m_updateEvent);
+
+  for (CpInfo* info : m_queue) {
+    delete info;
+  }
 }
 
 void
@@ -54,11 +65,15 @@ CcpPolicy::doBeforeErase(iterator i)
 {
   NFD_LOG_INFO("doBeforeErase " << i->getName());
 
-  // auto iter = m_cpInfos.find(i);
-  // m_cpInfos.erase(iter);
+  auto iter = m_cpInfos.find(i->getName());
+  if (iter == m_cpInfos.end()) {
+    return;
+  }
 
-  // auto list_iter = std::find(m_queue.begin(), m_queue.end(), iter->second);
-  // m_queue.erase(list_iter);
+  CpInfo* info = iter->second;
+  m_cpInfos.erase(iter);
+  m_queue.remove(info);
+  delete info;
 }
 
 void
@@ -73,20 +88,94 @@ void
 CcpPolicy::evictEntries()
 {
   BOOST_ASSERT(this->getCs() != nullptr);
-  while (this->getCs()->size() > this->getLimit()) {
-    BOOST_ASSERT(!m_queue.empty());
+  this->evictBatch([this] {
+      BOOST_ASSERT(!m_queue.empty());
+
+      auto cpinfo =  m_queue.front();
+      m_queue.pop_front();
+
+      iterator i = cpinfo->entry;
+      m_cpInfos.erase(i->getName());
+      delete cpinfo;
+
+      NFD_LOG_INFO("evictEntries " << i->getName());
+      return i;
+    });
+  m_queue.sort(compare);
+}
 
-    auto cpinfo =  m_queue.front();
-    m_queue.pop_front();
+Block
+CcpPolicy::doSaveState() const
+{
+  Block state(snapshot::tlv::PolicyState);
+  for (const CpInfo* info : m_queue) {
+    state.push_back(snapshot::Record(0, info->entry->getName(), {info->p,
+                                     static_cast<double>(info->n)}).wireEncode());
+  }
+  state.encode();
+  return state;
+}
 
-    iterator i = cpinfo->entry;
-    m_cpInfos.erase(i->getName());
+bool
+CcpPolicy::doLoadState(const Block& state, const SnapshotIndex& index)
+{
+  std::vector<snapshot::Record> records;
+  std::set<Name> names;
+  for (const Block& element : state.elements()) {
+    if (element.type() != snapshot::tlv::Record) {
+      continue;
+    }
+    records.emplace_back(element);
+    const snapshot::Record& record = records.back();
+    if (record.values.size() != 2 || index.count(record.name) == 0 ||
+        !names.insert(record.name).second) {
+      return false;
+    }
+  }
+  if (records.size() != index.size()) {
+    return false;
+  }
 
-    NFD_LOG_INFO("evictEntries " << i->getName());
+  // m_queue is kept sorted by p, and the records were written in that order
+  for (const snapshot::Record& record : records) {
+    CpInfo *info = new CpInfo;
+    info->p = record.values[0];
+    info->n = static_cast<uint32_t>(record.values[1]);
+    info->entry = index.at(record.name);
 
-    this->emitSignal(beforeEvict, i);
+    m_cpInfos.insert({record.name, info});
+    m_queue.push_back(info);
   }
-  m_queue.sort(compare);
+  return true;
+}
+
+std::vector<iterator>
+CcpPolicy::doListEntries() const
+{
+  // m_queue is sorted by p, and evictEntries pops from the front
+  std::vector<iterator> entries;
+  entries.reserve(m_queue.size());
+  for (const CpInfo* info : m_queue) {
+    entries.push_back(info->entry);
+  }
+  return entries;
+}
+
+void
+CcpPolicy::doAfterInsertBulk(const std::vector<iterator>& entries)
+{
+  // append everything first, so that m_queue is sorted once rather than after every insertion
+  for (iterator i : entries) {
+    CpInfo *info = new CpInfo;
+    info->p = 0;
+    info->n = 1;
+    info->entry = i;
+
+    m_cpInfos.insert({i->getName(), info});
+    m_queue.push_back(info);
+  }
+
+  this->evictEntries();
 }
 
 void 
@@ -105,7 +194,7 @@ CcpPolicy::update()
 
   m_queue.sort(compare);
 
-  ns3::Simulator::Schedule(ns3::Seconds(T), &CcpPolicy::update, this);
+  m_updateEvent = ns3::Simulator::Schedule(ns3::Seconds(T), &CcpPolicy::update, this);
 }
 
 void 
@@ -118,6 +207,20 @@ CcpPolicy::print()
 	NFD_LOG_INFO(" " );
 }
 
+
+size_t
+CcpPolicy::doGetMemoryUsage() const
+{
+  using namespace memory_usage;
+
+  // CpInfo objects are owned by the queue, and indexed by name in m_cpInfos
+  size_t usage = m_queue.size() * (sizeof(CpInfo*) + LIST_NODE_OVERHEAD + sizeof(CpInfo));
+  for (const auto& cpInfo : m_cpInfos) {
+    usage += sizeof(cpInfo) + TREE_NODE_OVERHEAD + getHeapSize(cpInfo.first);
+  }
+  return usage;
+}
+
 } // namespace ccp
 } // namespace cs
 } // namespace nfd
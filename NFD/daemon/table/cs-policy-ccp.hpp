@@ -3,6 +3,8 @@
 
 #include "cs-policy.hpp"
 
+#include "ns3/event-id.h"
+
 #include <map>
 #include <list>
 
@@ -25,6 +27,9 @@ class CcpPolicy : public Policy
 public:
   CcpPolicy();
 
+  virtual
+  ~CcpPolicy();
+
 public:
   static const std::string POLICY_NAME;
 
@@ -44,6 +49,21 @@ private:
   void
   evictEntries() override;
 
+  Block
+  doSaveState() const override;
+
+  bool
+  doLoadState(const Block& state, const SnapshotIndex& index) override;
+
+  std::vector<iterator>
+  doListEntries() const override;
+
+  void
+  doAfterInsertBulk(const std::vector<iterator>& entries) override;
+
+  size_t
+  doGetMemoryUsage() const override;
+
   void update();
 
   void print();
@@ -51,6 +71,7 @@ private:
 private:
   std::list<CpInfo*> m_queue;
   std::map<Name, CpInfo*> m_cpInfos;
+  ns3::EventId m_updateEvent;
 };
 
 } // namespace ccp
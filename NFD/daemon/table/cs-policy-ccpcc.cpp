@@ -1,6 +1,7 @@
 #include "cs-policy-ccpcc.hpp"
 #include "cs.hpp"
 #include "core/logger.hpp"
+#include "memory-usage.hpp"
 
 #include "ns3/simulator.h"
 
@@ -28,7 +29,8 @@ CcpccPolicy::doAfterInsert(iterator i)
 {
   NFD_LOG_INFO("doAfterInsert " << i->getName());
 
-  const Name &prefix = i->getData().getName().getPrefix(-1);
+  CompactName name(i->getName());
+  CompactName prefix = name.getPrefix(name.size() - 1);
   auto iter = m_congInfos.find(prefix);
   if (iter == m_congInfos.end()) {
    iter = m_congInfos.insert({prefix, 0}).first;
@@ -40,20 +42,21 @@ CcpccPolicy::doAfterInsert(iterator i)
 
   double history_p = 0;
   uint32_t history_n = 0;
-  if (m_historyCpInfos.count(i->getName()) == 1) {
-    history_p = m_historyCpInfos[i->getName()].p;
-    history_n = m_historyCpInfos[i->getName()].n;
+  auto history = m_historyCpInfos.find(name);
+  if (history != m_historyCpInfos.end()) {
+    history_p = history->second.p;
+    history_n = history->second.n;
 
-    m_historyCpInfos.erase(i->getName());
+    m_historyCpInfos.erase(history);
   }
 
   double a = 1 + c * T;
   double cur_p = u_a * (a * history_n + history_p) / (a + 1) + u_b * iter->second;
-  if (this->getCs()->size() == this->getLimit() && cur_p <= m_queue.front()->p) {
+  if (this->size() == this->getLimit() && cur_p <= m_queue.front()->p) {
     HistoryCpInfo history_info;
     history_info.n = history_n + 1;
     history_info.p = history_p;
-    m_historyCpInfos.insert({i->getName(), history_info});
+    m_historyCpInfos.insert({std::move(name), history_info});
 
     NFD_LOG_INFO("<cur_p = " << cur_p << "> min_p = " << m_queue.front()->p);
     print();
@@ -63,12 +66,12 @@ CcpccPolicy::doAfterInsert(iterator i)
   } 
 
   CpInfo *info = new CpInfo;
-  info->prefix = prefix;
+  info->prefix = std::move(prefix);
   info->p = cur_p;
   info->n = 1;
   info->entry = i;
   
-  m_cpInfos.insert({i->getName(), info});
+  m_cpInfos.insert({std::move(name), info});
   m_queue.push_back(info);
   m_queue.sort(compare);
 
@@ -109,7 +112,7 @@ void
 CcpccPolicy::evictEntries()
 {
   BOOST_ASSERT(this->getCs() != nullptr);
-  while (this->getCs()->size() > this->getLimit()) {
+  while (this->size() > this->getLimit()) {
     BOOST_ASSERT(!m_queue.empty());
 
     auto cpinfo =  m_queue.front();
@@ -170,6 +173,29 @@ CcpccPolicy::print()
 	NFD_LOG_INFO(" " );
 }
 
+
+size_t
+CcpccPolicy::doGetMemoryUsage() const
+{
+  using namespace memory_usage;
+
+  // CpInfo objects are owned by the queue, and indexed by name in m_cpInfos
+  size_t usage = 0;
+  for (const CpInfo* info : m_queue) {
+    usage += sizeof(CpInfo*) + LIST_NODE_OVERHEAD + sizeof(CpInfo) + getHeapSize(info->prefix);
+  }
+  for (const auto& cpInfo : m_cpInfos) {
+    usage += sizeof(cpInfo) + TREE_NODE_OVERHEAD + getHeapSize(cpInfo.first);
+  }
+  for (const auto& history : m_historyCpInfos) {
+    usage += sizeof(history) + TREE_NODE_OVERHEAD + getHeapSize(history.first);
+  }
+  for (const auto& congInfo : m_congInfos) {
+    usage += sizeof(congInfo) + TREE_NODE_OVERHEAD + getHeapSize(congInfo.first);
+  }
+  return usage;
+}
+
 } // namespace ccpcc
 } // namespace cs
 } // namespace nfd
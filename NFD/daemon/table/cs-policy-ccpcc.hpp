@@ -18,7 +18,7 @@ const double c = 0.5;
 const int T = 2;
 
 struct CpInfo {
-  Name prefix;
+  CompactName prefix;
   double p;
   uint32_t n;
   iterator entry;
@@ -54,15 +54,18 @@ private:
   void
   evictEntries() override;
 
+  size_t
+  doGetMemoryUsage() const override;
+
   void update();
 
   void print();
 
 private:
   std::list<CpInfo*> m_queue;
-  std::map<Name, CpInfo*> m_cpInfos;
-  std::map<Name, HistoryCpInfo> m_historyCpInfos;
-  std::map<Name, uint32_t> m_congInfos;
+  std::map<CompactName, CpInfo*> m_cpInfos;
+  std::map<CompactName, HistoryCpInfo> m_historyCpInfos;
+  std::map<CompactName, uint32_t> m_congInfos;
 };
 
 } // namespace ccpcc
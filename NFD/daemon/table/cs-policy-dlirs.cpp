@@ -1,6 +1,9 @@
 #include "cs-policy-dlirs.hpp"
 #include "cs.hpp"
 #include "core/logger.hpp"
+#include "memory-usage.hpp"
+
+#include <unordered_set>
 
 NFD_LOG_INIT("DlirsPolicy");
 
@@ -21,11 +24,12 @@ DlirsPolicy::DlirsPolicy()
 
 void
 DlirsPolicy::setLimit(size_t nMaxEntries){
-	Policy::setLimit(nMaxEntries);
 	cacheSize = nMaxEntries;
-	hirSize_ = 1 + (int)(nMaxEntries / 100);
+	hirSize_ = std::min(cacheSize, 1 + (int)(nMaxEntries / 100));
 	lirSize_ = cacheSize - hirSize_;
 	NFD_LOG_INFO("HIR size is "<<hirSize_<<", LIR size is "<<lirSize_<<", total size is "<<cacheSize);
+	// sizes are set first, so that evictEntries fits the entries into them
+	Policy::setLimit(nMaxEntries);
 }
 
 void
@@ -53,6 +57,10 @@ DlirsPolicy::doAfterInsert(iterator i)
 		stackS_.debugToString("LRU stack S");
         listQ_.debugToString("LRU list Q");
 	}
+	else if (curhir == 0) {
+		NFD_LOG_INFO("No ResidentHIR to replace, evict the new entry");
+		this->emitSignal(beforeEvict, i);
+	}
 	else{
 		removeNHIR(curhir + curlir + curnhir - 2 * cacheSize);
 		NFD_LOG_INFO("ResidentHIR and LIR are full, remove a ResidentHIR" );		
@@ -213,10 +221,140 @@ DlirsPolicy::doBeforeUse(iterator i)
 	// hitTimes_++;
 }
 
+/** \brief fits resident entries into lirSize_ and hirSize_ after the hard limit changes
+ */
 void 
 DlirsPolicy::evictEntries() 
 {
-	
+	NFD_LOG_INFO("Evict Entries Function" );
+	NFD_LOG_INFO("HIR size is "<<hirSize_<<", LIR size is "<<lirSize_<<", total size is "<<cacheSize);
+	NFD_LOG_INFO("Cur HIR size is "<<curhir<<", cur LIR size is "<<curlir<<", cur nhir is "<<curnhir);
+
+	// demote the bottom LIR entries of stack S, as changeLIRtoHIR does
+	while (curlir > lirSize_) {
+		stackS_.setBottomState(EntryInfo::kresidentHIR);
+		stackS_.set_isDemotedByLocation(BottomLocation, true);
+		listQ_.pushToEnd(stackS_.getBottomEntry());
+		curnhir -= stackS_.stackPruning();
+		curlir--, curhir++;
+		hir_lir++;
+	}
+
+	// promote the newest ResidentHIR entries into free LIR slots, as changeHIRtoLIR does
+	while (curhir > hirSize_ && curlir < lirSize_) {
+		EntryPair HIRentry = listQ_.getAndRemoveFrontEntry();
+		bool flag = HIRentry.first->get_isDemoted();
+		LRUStackSLocation location = stackS_.find(HIRentry.first->getName());
+		if(location != InvalidLocation) {
+			stackS_.setStateByLocation(location, EntryInfo::kLIR);
+			stackS_.set_isDemotedByLocation(location, false);
+		}
+		else {
+			HIRentry.first->setState(EntryInfo::kLIR);
+			HIRentry.first->set_isDemoted(false);
+			stackS_.pushEntry(HIRentry);
+		}
+		curhir--, curlir++;
+		if(flag) hir_lir--;
+	}
+
+	removeHIR(curhir - hirSize_);
+	removeNHIR(curhir + curlir + curnhir - 2 * cacheSize);
+	NFD_LOG_INFO("After evictEntries, cur HIR size is "<<curhir<<", cur LIR size is "<<curlir<<", cur nhir is "<<curnhir);
+}
+
+// snapshot record sections
+enum : uint64_t {
+	SNAPSHOT_STACK_S = 0,
+	SNAPSHOT_LIST_Q = 1
+};
+
+Block
+DlirsPolicy::doSaveState() const
+{
+	Block state(snapshot::tlv::PolicyState);
+	for (int parameter : {cacheSize, lirSize_, hirSize_, curlir, curhir, curnhir, hir_lir}) {
+		state.push_back(snapshot::makeRealBlock(snapshot::tlv::Parameter, parameter));
+	}
+
+	for (const EntryPair& item : stackS_.container_) {
+		state.push_back(snapshot::Record(SNAPSHOT_STACK_S, item.first->getName().toName(),
+		                                 {static_cast<double>(item.first->getState()),
+		                                  static_cast<double>(item.first->get_isDemoted())}).wireEncode());
+	}
+	for (const EntryPair& item : listQ_.container_) {
+		state.push_back(snapshot::Record(SNAPSHOT_LIST_Q, item.first->getName().toName(),
+		                                 {static_cast<double>(item.first->getState()),
+		                                  static_cast<double>(item.first->get_isDemoted())}).wireEncode());
+	}
+	state.encode();
+	return state;
+}
+
+bool
+DlirsPolicy::doLoadState(const Block& state, const SnapshotIndex& index)
+{
+	std::vector<double> parameters;
+	std::map<Name, std::shared_ptr<EntryInfo>> infos; // S and Q share one EntryInfo per Name
+	std::set<Name> residents;
+	LRUStackS stackS;
+	LRUListQ listQ;
+
+	for (const Block& element : state.elements()) {
+		if (element.type() == snapshot::tlv::Parameter) {
+			parameters.push_back(snapshot::readReal(element));
+			continue;
+		}
+		if (element.type() != snapshot::tlv::Record) {
+			continue;
+		}
+
+		snapshot::Record record(element);
+		if (record.values.size() != 2 || record.values[0] < EntryInfo::kLIR ||
+		    record.values[0] >= EntryInfo::kInvalid) {
+			return false;
+		}
+		auto entryState = static_cast<EntryInfo::EntryState>(record.values[0]);
+
+		// non-resident HIR entries are not in CS; their iterator is never dereferenced
+		iterator i{};
+		if (entryState != EntryInfo::knonResidentHIR) {
+			auto found = index.find(record.name);
+			if (found == index.end()) {
+				return false;
+			}
+			i = found->second;
+			residents.insert(record.name);
+		}
+
+		std::shared_ptr<EntryInfo>& info = infos[record.name];
+		if (info == nullptr) {
+			info = std::make_shared<EntryInfo>(record.name, entryState);
+			info->set_isDemoted(record.values[1] != 0);
+		}
+
+		if (record.section == SNAPSHOT_STACK_S) {
+			stackS.pushEntry({info, i});
+		}
+		else if (record.section == SNAPSHOT_LIST_Q) {
+			listQ.pushToEnd({info, i});
+		}
+	}
+
+	if (parameters.size() != 7 || residents.size() != index.size()) {
+		return false;
+	}
+
+	cacheSize = static_cast<int>(parameters[0]);
+	lirSize_ = static_cast<int>(parameters[1]);
+	hirSize_ = static_cast<int>(parameters[2]);
+	curlir = static_cast<int>(parameters[3]);
+	curhir = static_cast<int>(parameters[4]);
+	curnhir = static_cast<int>(parameters[5]);
+	hir_lir = static_cast<int>(parameters[6]);
+	stackS_ = std::move(stackS);
+	listQ_ = std::move(listQ);
+	return true;
 }
 
 void 
@@ -237,6 +375,45 @@ DlirsPolicy::hitHIRInStackS(LRUStackSLocation location, iterator i)
 	curnhir -= a;
 }
 
+std::vector<iterator>
+DlirsPolicy::doListEntries() const
+{
+	// resident HIR entries in list Q go first, then LIR entries from the bottom of stack S
+	std::vector<iterator> entries;
+	for (const EntryPair& item : listQ_.container_) {
+		entries.push_back(item.second);
+	}
+	for (const EntryPair& item : stackS_.container_) {
+		if (item.first->getState() == EntryInfo::kLIR)
+			entries.push_back(item.second);
+	}
+	return entries;
+}
+
+void
+DlirsPolicy::doAfterInsertBulk(const std::vector<iterator>& entries)
+{
+	// the hottest entries become LIR and the coldest ones resident HIR;
+	// unlike doAfterInsert, nothing needs to be looked up in stack S
+	size_t nLir = std::min<size_t>(entries.size(), std::max(lirSize_ - curlir, 0));
+	size_t nHir = std::min<size_t>(entries.size() - nLir, std::max(hirSize_ - curhir, 0));
+	size_t nEvict = entries.size() - nLir - nHir;
+	NFD_LOG_INFO("After Insert Bulk Function, LIR " << nLir << ", HIR " << nHir << ", evict " << nEvict);
+
+	curlir += nLir;
+	curhir += nHir;
+
+	for (size_t k = nEvict; k < nEvict + nHir; ++k) {
+		listQ_.pushToEnd({std::make_shared<EntryInfo>(entries[k]->getName(), EntryInfo::kresidentHIR), entries[k]});
+	}
+	for (size_t k = nEvict + nHir; k < entries.size(); ++k) {
+		stackS_.pushEntry({std::make_shared<EntryInfo>(entries[k]->getName(), EntryInfo::kLIR), entries[k]});
+	}
+	for (size_t k = 0; k < nEvict; ++k) {
+		this->emitSignal(beforeEvict, entries[k]);
+	}
+}
+
 void 
 DlirsPolicy::addAResidentHIREntry(iterator i)
 {
@@ -364,12 +541,39 @@ LRUStack::debugToString(std::string const& name)
 	NFD_LOG_INFO("#############" << name << "#############" );
     std::for_each( container_.begin(), container_.end(), [](EntryPair& item)
       { 
-        NFD_LOG_INFO("<" << item.first->getName().toUri() << " , " <<
+        NFD_LOG_INFO("<" << item.first->getName() << " , " <<
         item.first->returnStateStr(item.first->getState()) << ">");
         } );
     NFD_LOG_INFO(" " );
   }
 
+
+/** \brief adds the stack slots to the usage, and collects the EntryInfos they point to
+ *
+ *  An EntryInfo may be on both stack S and list Q, and is counted once.
+ */
+static size_t
+getStackMemoryUsage(const LRUStack& stack, std::unordered_set<EntryInfo*>& infos)
+{
+  for (const EntryPair& pair : stack.container_) {
+    infos.insert(pair.first.get());
+  }
+  return stack.container_.capacity() * sizeof(EntryPair);
+}
+
+size_t
+DlirsPolicy::doGetMemoryUsage() const
+{
+  using namespace memory_usage;
+
+  std::unordered_set<EntryInfo*> infos;
+  size_t usage = getStackMemoryUsage(stackS_, infos) + getStackMemoryUsage(listQ_, infos);
+  for (EntryInfo* info : infos) {
+    usage += sizeof(EntryInfo) + SHARED_PTR_OVERHEAD + getHeapSize(info->getName());
+  }
+  return usage;
+}
+
 } // namespace lru
 } // namespace cs
 } // namespace nfd
@@ -28,7 +28,7 @@ public:
 		kInvalid
 	};
 
-	EntryInfo(Name name, EntryState state) :
+	EntryInfo(const CompactName& name, EntryState state) :
 		m_name(name),
 		m_state(state),
     m_isDemoted(false)
@@ -46,7 +46,7 @@ public:
 		return m_state;
 	}
 
-	const Name& getName(){
+	const CompactName& getName(){
 		return m_name;
 	}
 
@@ -70,7 +70,7 @@ public:
   }
 
 private:
-	Name m_name;
+	CompactName m_name;
 	EntryState m_state;
   bool m_isDemoted = false;
 };
@@ -92,11 +92,11 @@ public:
 
   void debugToString(std::string const& name);
   
-  LRUStackLocation find(const Name &name)
+  LRUStackLocation find(const CompactName &name)
   {
     LRUStackLocation location = InvalidLocation;
     int step = 0;
-    for(auto it : container_)
+    for(const auto& it : container_)
     {
       if (it.first->getName() == name)
       {
@@ -196,7 +196,7 @@ public:
   int stackPruning()       //栈剪枝，当栈底部的lir条目移至stack首部，则如果底部的条目不是lir条目，必须移除
   {                         //因为栈底的hir和non-hir条目需保证栈底部为lir条目
     int delnhir = 0;
-    while (true)
+    while (getContainerSize() > 0)
     {
       EntryInfo::EntryState state = getBottomState();
       assert(state != EntryInfo::kInvalid);
@@ -215,7 +215,7 @@ public:
     return delnhir;
   }
 
-  bool findAndSetState(const Name &name, EntryInfo::EntryState state)
+  bool findAndSetState(const CompactName &name, EntryInfo::EntryState state)
   {
     LRUStackSLocation location = find(name);
     if(location != InvalidLocation){
@@ -225,7 +225,7 @@ public:
     return false;
   }
   
-  void findAndRemove(const Name &name) 
+  void findAndRemove(const CompactName &name) 
   {
 		LRUStackSLocation location = find(name);
 		if(location != InvalidLocation)
@@ -248,7 +248,7 @@ public:
     movToTop(location, i);
   }
 
-  void findAndRemove(const Name &name) 
+  void findAndRemove(const CompactName &name) 
   {
 		LRUListQLocation location = find(name);
 		if(location != InvalidLocation)
@@ -296,6 +296,16 @@ private:
 private:
 	void evictEntries() override;
 
+	Block doSaveState() const override;
+
+	bool doLoadState(const Block& state, const SnapshotIndex& index) override;
+
+	std::vector<iterator> doListEntries() const override;
+
+	void doAfterInsertBulk(const std::vector<iterator>& entries) override;
+
+	size_t doGetMemoryUsage() const override;
+
 	void hitHIRInStackS(LRUStackSLocation location, iterator i);
 
 	void addAResidentHIREntry(iterator i);
@@ -0,0 +1,361 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-gdsf.hpp"
+#include "cs.hpp"
+#include "cs-retrieval-cost.hpp"
+#include "memory-usage.hpp"
+
+#include <ndn-cxx/lp/tags.hpp>
+
+namespace nfd {
+namespace cs {
+namespace gdsf {
+
+const std::string GdsfPolicy::POLICY_NAME = "gdsf";
+NFD_REGISTER_CS_POLICY(GdsfPolicy);
+
+const GdsfPolicy::NodeIndex GdsfPolicy::NONE = std::numeric_limits<NodeIndex>::max();
+
+/** \brief weight of a new sample in the moving average of latency per hop
+ */
+static const double LATENCY_PER_HOP_GAIN = 0.125;
+
+GdsfPolicy::GdsfPolicy()
+  : Policy(POLICY_NAME)
+  , m_freeList(NONE)
+  , m_metric(COST_HOP_COUNT)
+  , m_inflation(0)
+  , m_latencyPerHop(1)
+  , m_sequence(0)
+{
+}
+
+double
+GdsfPolicy::getPriority(iterator i) const
+{
+  auto found = m_index.find(&*i);
+  BOOST_ASSERT(found != m_index.end());
+  return m_nodes[found->second].priority;
+}
+
+void
+GdsfPolicy::doAfterInsert(iterator i)
+{
+  double costPerByte = this->getCostPerByte(i);
+  this->admit(i, m_inflation + costPerByte, costPerByte, 1);
+  this->evictEntries();
+}
+
+void
+GdsfPolicy::doAfterRefresh(iterator i)
+{
+  this->touch(i);
+}
+
+void
+GdsfPolicy::doBeforeErase(iterator i)
+{
+  auto found = m_index.find(&*i);
+  BOOST_ASSERT(found != m_index.end());
+  NodeIndex n = found->second;
+  m_index.erase(found);
+  this->remove(n);
+}
+
+void
+GdsfPolicy::doBeforeUse(iterator i)
+{
+  this->touch(i);
+}
+
+void
+GdsfPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+  this->evictBatch([this] {
+      BOOST_ASSERT(!m_heap.empty());
+      NodeIndex n = m_heap.front();
+      iterator victim = m_nodes[n].entry;
+      m_inflation = m_nodes[n].priority;
+
+      m_index.erase(&*victim);
+      this->remove(n);
+      return victim;
+    });
+}
+
+std::vector<iterator>
+GdsfPolicy::doListEntries() const
+{
+  std::vector<NodeIndex> order(m_heap);
+  std::sort(order.begin(), order.end(),
+            [this] (NodeIndex a, NodeIndex b) { return this->isBefore(a, b); });
+
+  std::vector<iterator> entries;
+  entries.reserve(order.size());
+  for (NodeIndex n : order) {
+    entries.push_back(m_nodes[n].entry);
+  }
+  return entries;
+}
+
+// snapshot record sections
+enum : uint64_t {
+  SNAPSHOT_ENTRY = 0
+};
+
+Block
+GdsfPolicy::doSaveState() const
+{
+  std::vector<NodeIndex> order(m_heap);
+  std::sort(order.begin(), order.end(),
+            [this] (NodeIndex a, NodeIndex b) { return this->isBefore(a, b); });
+
+  Block state(snapshot::tlv::PolicyState);
+  state.push_back(snapshot::makeRealBlock(snapshot::tlv::Parameter, m_inflation));
+  state.push_back(snapshot::makeRealBlock(snapshot::tlv::Parameter, m_latencyPerHop));
+  for (NodeIndex n : order) {
+    const Node& node = m_nodes[n];
+    state.push_back(snapshot::Record(SNAPSHOT_ENTRY, node.entry->getName(),
+                                     {node.priority, node.costPerByte,
+                                      static_cast<double>(node.frequency)}).wireEncode());
+  }
+  state.encode();
+  return state;
+}
+
+bool
+GdsfPolicy::doLoadState(const Block& state, const SnapshotIndex& index)
+{
+  std::vector<double> parameters;
+  std::vector<std::pair<iterator, std::vector<double>>> entries;
+  std::set<const Entry*> seen;
+
+  for (const Block& element : state.elements()) {
+    if (element.type() == snapshot::tlv::Parameter) {
+      parameters.push_back(snapshot::readReal(element));
+      continue;
+    }
+    if (element.type() != snapshot::tlv::Record) {
+      continue;
+    }
+
+    snapshot::Record record(element);
+    if (record.section != SNAPSHOT_ENTRY || record.values.size() != 3 ||
+        !(record.values[1] >= 0) || !(record.values[2] >= 1)) {
+      return false;
+    }
+    auto found = index.find(record.name);
+    if (found == index.end() || !seen.insert(&*found->second).second) {
+      return false;
+    }
+    entries.emplace_back(found->second, std::move(record.values));
+  }
+  if (parameters.size() != 2 || !(parameters[1] > 0) || entries.size() != index.size()) {
+    return false;
+  }
+
+  m_nodes.clear();
+  m_freeList = NONE;
+  m_heap.clear();
+  m_index.clear();
+  m_inflation = parameters[0];
+  m_latencyPerHop = parameters[1];
+
+  // records are in eviction order, so the heap is built in sequence order as well
+  m_nodes.reserve(entries.size());
+  m_heap.reserve(entries.size());
+  for (const auto& entry : entries) {
+    this->admit(entry.first, entry.second[0], entry.second[1],
+                static_cast<uint32_t>(entry.second[2]));
+  }
+  return true;
+}
+
+bool
+GdsfPolicy::doNeedsRetrievalCost() const
+{
+  return true;
+}
+
+size_t
+GdsfPolicy::doGetMemoryUsage() const
+{
+  using namespace memory_usage;
+
+  return m_nodes.capacity() * sizeof(Node) + m_heap.capacity() * sizeof(NodeIndex) +
+         m_index.size() * (sizeof(std::pair<const Entry*, NodeIndex>) + HASH_NODE_OVERHEAD) +
+         m_index.bucket_count() * sizeof(void*);
+}
+
+GdsfPolicy::NodeIndex
+GdsfPolicy::allocateNode()
+{
+  if (m_freeList != NONE) {
+    NodeIndex n = m_freeList;
+    m_freeList = m_nodes[n].heapPosition;
+    return n;
+  }
+
+  BOOST_ASSERT(m_nodes.size() < NONE);
+  m_nodes.emplace_back();
+  return static_cast<NodeIndex>(m_nodes.size() - 1);
+}
+
+void
+GdsfPolicy::releaseNode(NodeIndex n)
+{
+  m_nodes[n].heapPosition = m_freeList;
+  m_freeList = n;
+}
+
+void
+GdsfPolicy::admit(iterator i, double priority, double costPerByte, uint32_t frequency)
+{
+  NodeIndex n = this->allocateNode();
+  Node& node = m_nodes[n];
+  node.entry = i;
+  node.priority = priority;
+  node.costPerByte = costPerByte;
+  node.frequency = frequency;
+  node.sequence = m_sequence++;
+
+  m_heap.push_back(n);
+  node.heapPosition = m_heap.size() - 1;
+  this->siftUp(node.heapPosition);
+
+  bool isNew = m_index.emplace(&*i, n).second;
+  BOOST_ASSERT(isNew);
+  (void)isNew;
+}
+
+void
+GdsfPolicy::touch(iterator i)
+{
+  auto found = m_index.find(&*i);
+  BOOST_ASSERT(found != m_index.end());
+  Node& node = m_nodes[found->second];
+
+  if (node.frequency < std::numeric_limits<uint32_t>::max()) {
+    ++node.frequency;
+  }
+  node.priority = m_inflation + node.frequency * node.costPerByte;
+  node.sequence = m_sequence++;
+
+  // L is at most the lowest priority in the heap, so the priority normally only increases
+  this->siftUp(node.heapPosition);
+  this->siftDown(node.heapPosition);
+}
+
+void
+GdsfPolicy::remove(NodeIndex n)
+{
+  uint32_t position = m_nodes[n].heapPosition;
+  NodeIndex last = m_heap.back();
+  m_heap.pop_back();
+
+  if (last != n) {
+    this->place(position, last);
+    this->siftUp(position);
+    this->siftDown(m_nodes[last].heapPosition);
+  }
+  this->releaseNode(n);
+}
+
+void
+GdsfPolicy::siftUp(uint32_t position)
+{
+  NodeIndex n = m_heap[position];
+  while (position > 0) {
+    uint32_t parent = (position - 1) / 2;
+    if (!this->isBefore(n, m_heap[parent])) {
+      break;
+    }
+    this->place(position, m_heap[parent]);
+    position = parent;
+  }
+  this->place(position, n);
+}
+
+void
+GdsfPolicy::siftDown(uint32_t position)
+{
+  NodeIndex n = m_heap[position];
+  uint32_t size = m_heap.size();
+  while (true) {
+    uint32_t child = 2 * position + 1;
+    if (child >= size) {
+      break;
+    }
+    if (child + 1 < size && this->isBefore(m_heap[child + 1], m_heap[child])) {
+      ++child;
+    }
+    if (!this->isBefore(m_heap[child], n)) {
+      break;
+    }
+    this->place(position, m_heap[child]);
+    position = child;
+  }
+  this->place(position, n);
+}
+
+double
+GdsfPolicy::getCostPerByte(iterator i)
+{
+  const Data& data = i->getData();
+
+  RetrievalCost cost;
+  shared_ptr<RetrievalCostTag> costTag = data.getTag<RetrievalCostTag>();
+  if (costTag != nullptr) {
+    cost = costTag->get();
+  }
+  else {
+    // unsolicited Data is inserted with the HopCountTag from its incoming face
+    shared_ptr<lp::HopCountTag> hopCountTag = data.getTag<lp::HopCountTag>();
+    if (hopCountTag != nullptr) {
+      cost.hopCount = hopCountTag->get();
+    }
+  }
+
+  double hops = 1.0 + cost.hopCount;
+  double c = hops;
+  if (m_metric == COST_LATENCY) {
+    if (cost.latency >= time::nanoseconds::zero()) {
+      c = time::duration_cast<time::microseconds>(cost.latency).count() / 1000.0;
+      m_latencyPerHop += LATENCY_PER_HOP_GAIN * (c / hops - m_latencyPerHop);
+    }
+    else {
+      c = m_latencyPerHop * hops;
+    }
+  }
+
+  size_t size = data.hasWire() ? data.wireEncode().size() : 1;
+  return c / std::max<size_t>(size, 1);
+}
+
+} // namespace gdsf
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_GDSF_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_GDSF_HPP
+
+#include "cs-policy.hpp"
+
+#include <unordered_map>
+
+namespace nfd {
+namespace cs {
+namespace gdsf {
+
+/** \brief cost-aware GreedyDual-Size-Frequency cs replacement policy
+ *
+ *  Every entry has a priority H = L + F * C / S, where F is the number of times the entry has
+ *  been inserted or used since it entered the CS, C is the cost of retrieving it again, S is
+ *  the size of the Data packet, and L is an inflation value. The entry with the lowest
+ *  priority is evicted, and L becomes its priority, so that entries which have not been used
+ *  for a while age relative to newly inserted or used ones (Cherkasova, HP Labs 1998).
+ *
+ *  The cost comes from the RetrievalCostTag that the forwarder attaches to Data: either the
+ *  number of hops to the producer or upstream cache, or the time it took to fetch the Data.
+ *  Routers close to consumers thus keep content that is far from its producer, which lowers
+ *  network-wide latency rather than only the local miss ratio.
+ *
+ *  Entries are kept in an indexed binary heap, so that insertion, use, and eviction take
+ *  O(log n) time. Entries with equal priorities are evicted in LRU order.
+ */
+class GdsfPolicy : public Policy
+{
+public:
+  GdsfPolicy();
+
+public:
+  static const std::string POLICY_NAME;
+
+  enum CostMetric {
+    /** \brief C is the number of hops to the producer or upstream cache, plus one
+     */
+    COST_HOP_COUNT,
+    /** \brief C is the retrieval latency in milliseconds
+     *
+     *  For Data without a measured latency, e.g., unsolicited Data, the latency is estimated
+     *  from its hop count and the average latency per hop of the other Data.
+     */
+    COST_LATENCY
+  };
+
+  /** \brief sets the cost metric, default COST_HOP_COUNT
+   *
+   *  Only entries inserted afterwards use the new metric.
+   */
+  void
+  setCostMetric(CostMetric metric)
+  {
+    m_metric = metric;
+  }
+
+  CostMetric
+  getCostMetric() const
+  {
+    return m_metric;
+  }
+
+  /** \return inflation value L
+   */
+  double
+  getInflation() const
+  {
+    return m_inflation;
+  }
+
+  /** \return priority H of cached entry \p i
+   */
+  double
+  getPriority(iterator i) const;
+
+private:
+  virtual void
+  doAfterInsert(iterator i) override;
+
+  virtual void
+  doAfterRefresh(iterator i) override;
+
+  virtual void
+  doBeforeErase(iterator i) override;
+
+  virtual void
+  doBeforeUse(iterator i) override;
+
+  virtual void
+  evictEntries() override;
+
+  virtual std::vector<iterator>
+  doListEntries() const override;
+
+  virtual Block
+  doSaveState() const override;
+
+  virtual bool
+  doLoadState(const Block& state, const SnapshotIndex& index) override;
+
+  virtual bool
+  doNeedsRetrievalCost() const override;
+
+  virtual size_t
+  doGetMemoryUsage() const override;
+
+private:
+  typedef uint32_t NodeIndex;
+  static const NodeIndex NONE;
+
+  struct Node
+  {
+    iterator entry;
+    double priority;
+    double costPerByte;   ///< C / S
+    uint32_t frequency;
+    uint32_t heapPosition; ///< position in m_heap, or next free node
+    uint64_t sequence;     ///< when the priority was last set, to break ties
+  };
+
+  NodeIndex
+  allocateNode();
+
+  void
+  releaseNode(NodeIndex n);
+
+  /** \brief adds entry \p i to the heap
+   */
+  void
+  admit(iterator i, double priority, double costPerByte, uint32_t frequency);
+
+  /** \brief counts a use of the entry and raises its priority
+   */
+  void
+  touch(iterator i);
+
+  /** \brief removes node \p n from the heap and releases it
+   */
+  void
+  remove(NodeIndex n);
+
+  bool
+  isBefore(NodeIndex a, NodeIndex b) const
+  {
+    const Node& x = m_nodes[a];
+    const Node& y = m_nodes[b];
+    return x.priority < y.priority || (x.priority == y.priority && x.sequence < y.sequence);
+  }
+
+  void
+  place(uint32_t position, NodeIndex n)
+  {
+    m_heap[position] = n;
+    m_nodes[n].heapPosition = position;
+  }
+
+  void
+  siftUp(uint32_t position);
+
+  void
+  siftDown(uint32_t position);
+
+  /** \return C / S of entry \p i
+   */
+  double
+  getCostPerByte(iterator i);
+
+private:
+  std::vector<Node> m_nodes;
+  NodeIndex m_freeList;
+  std::vector<NodeIndex> m_heap; ///< binary min-heap of node indices
+  std::unordered_map<const Entry*, NodeIndex> m_index;
+
+  CostMetric m_metric;
+  double m_inflation;
+  double m_latencyPerHop; ///< moving average, in milliseconds
+  uint64_t m_sequence;
+};
+
+} // namespace gdsf
+
+using gdsf::GdsfPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_GDSF_HPP
@@ -1,6 +1,9 @@
 #include "cs-policy-lirs.hpp"
 #include "cs.hpp"
 #include "core/logger.hpp"
+#include "memory-usage.hpp"
+
+#include <unordered_set>
 
 NFD_LOG_INIT("LirsPolicy");
 
@@ -18,14 +21,6 @@ LirsPolicy::LirsPolicy()
   cacheSize(10)   
 {}
 
-void
-LirsPolicy::setLimit(size_t nMaxEntries){
-	Policy::setLimit(nMaxEntries);
-	hirSize_ = 1 + (int)(nMaxEntries / 100);
-	lirSize_ = nMaxEntries - hirSize_;
-	cacheSize = (int)nMaxEntries;
-}
-
 void
 LirsPolicy::doAfterInsert(iterator i)
 {
@@ -46,6 +41,10 @@ LirsPolicy::doAfterInsert(iterator i)
 		stackS_.debugToString("LRU stack S");
         listQ_.debugToString("LRU list Q");
 	}
+	else if (listQ_.getSize() == 0) {
+		NFD_LOG_INFO("No ResidentHIR to replace, evict the new entry");
+		this->emitSignal(beforeEvict, i);
+	}
 	else{		
 		// for(auto it = stackS_.container_.begin(); it != stackS_.container_.end(); ) {
 		// 	if(stackS_.getSize() <= 2 * cacheSize) break;
@@ -192,8 +191,171 @@ LirsPolicy::doBeforeUse(iterator i)
 	// hitTimes_++;
 }
 
+/** \brief shrinks or grows the cache to the hard limit
+ *
+ *  lirSize_ and hirSize_ count free LIR and ResidentHIR slots, so they are derived from
+ *  the current occupancy rather than reset, and the excess is evicted when the limit shrinks.
+ */
 void 
-LirsPolicy::evictEntries() {}
+LirsPolicy::evictEntries()
+{
+	int limit = static_cast<int>(this->getLimit());
+	int hirCapacity = std::min(limit, 1 + limit / 100);
+	int lirCapacity = limit - hirCapacity;
+	cacheSize = limit;
+
+	int nLir = std::count_if(stackS_.container_.begin(), stackS_.container_.end(),
+	                         [] (const EntryPair& item) { return item.first->getState() == EntryInfo::kLIR; });
+
+	// demote the bottom LIR entries of stack S until LIR fits
+	while (nLir > lirCapacity) {
+		NFD_LOG_INFO("Demote LIR " << stackS_.getBottomEntry().first->getName() << " to ResidentHIR");
+		stackS_.setBottomState(EntryInfo::kresidentHIR);
+		listQ_.pushToEnd(stackS_.getBottomEntry());
+		stackS_.stackPruning();
+		--nLir;
+	}
+
+	while (nLir + listQ_.getSize() > limit) {
+		EntryPair tmp = listQ_.getAndRemoveFrontEntry();
+		NFD_LOG_INFO("Evict ResidentHIR " << tmp.first->getName());
+		stackS_.findAndSetState(tmp.first->getName(), EntryInfo::knonResidentHIR);
+		this->emitSignal(beforeEvict, tmp.second);
+	}
+
+	// ResidentHIR may exceed its capacity while LIR has room; new entries then become LIR
+	// only as long as the cache is not full
+	int nFree = limit - nLir - listQ_.getSize();
+	lirSize_ = std::min(lirCapacity - nLir, nFree);
+	hirSize_ = std::min(hirCapacity - listQ_.getSize(), nFree - lirSize_);
+	NFD_LOG_INFO("evictEntries limit " << limit << ", free LIR " << lirSize_ << ", free HIR " << hirSize_);
+}
+
+// snapshot record sections
+enum : uint64_t {
+	SNAPSHOT_STACK_S = 0,
+	SNAPSHOT_LIST_Q = 1
+};
+
+Block
+LirsPolicy::doSaveState() const
+{
+	Block state(snapshot::tlv::PolicyState);
+	state.push_back(snapshot::makeRealBlock(snapshot::tlv::Parameter, lirSize_));
+	state.push_back(snapshot::makeRealBlock(snapshot::tlv::Parameter, hirSize_));
+	state.push_back(snapshot::makeRealBlock(snapshot::tlv::Parameter, cacheSize));
+
+	for (const EntryPair& item : stackS_.container_) {
+		state.push_back(snapshot::Record(SNAPSHOT_STACK_S, item.first->getName().toName(),
+		                                 {static_cast<double>(item.first->getState())}).wireEncode());
+	}
+	for (const EntryPair& item : listQ_.container_) {
+		state.push_back(snapshot::Record(SNAPSHOT_LIST_Q, item.first->getName().toName(),
+		                                 {static_cast<double>(item.first->getState())}).wireEncode());
+	}
+	state.encode();
+	return state;
+}
+
+bool
+LirsPolicy::doLoadState(const Block& state, const SnapshotIndex& index)
+{
+	std::vector<double> parameters;
+	std::map<Name, std::shared_ptr<EntryInfo>> infos; // S and Q share one EntryInfo per Name
+	std::set<Name> residents;
+	LRUStackS stackS;
+	LRUListQ listQ;
+
+	for (const Block& element : state.elements()) {
+		if (element.type() == snapshot::tlv::Parameter) {
+			parameters.push_back(snapshot::readReal(element));
+			continue;
+		}
+		if (element.type() != snapshot::tlv::Record) {
+			continue;
+		}
+
+		snapshot::Record record(element);
+		if (record.values.size() != 1 || record.values[0] < EntryInfo::kLIR ||
+		    record.values[0] >= EntryInfo::kInvalid) {
+			return false;
+		}
+		auto entryState = static_cast<EntryInfo::EntryState>(record.values[0]);
+
+		// non-resident HIR entries are not in CS; their iterator is never dereferenced
+		iterator i{};
+		if (entryState != EntryInfo::knonResidentHIR) {
+			auto found = index.find(record.name);
+			if (found == index.end()) {
+				return false;
+			}
+			i = found->second;
+			residents.insert(record.name);
+		}
+
+		std::shared_ptr<EntryInfo>& info = infos[record.name];
+		if (info == nullptr) {
+			info = std::make_shared<EntryInfo>(record.name, entryState);
+		}
+
+		if (record.section == SNAPSHOT_STACK_S) {
+			stackS.pushEntry({info, i});
+		}
+		else if (record.section == SNAPSHOT_LIST_Q) {
+			listQ.pushToEnd({info, i});
+		}
+	}
+
+	if (parameters.size() != 3 || residents.size() != index.size()) {
+		return false;
+	}
+
+	lirSize_ = static_cast<int>(parameters[0]);
+	hirSize_ = static_cast<int>(parameters[1]);
+	cacheSize = static_cast<int>(parameters[2]);
+	stackS_ = std::move(stackS);
+	listQ_ = std::move(listQ);
+	return true;
+}
+
+std::vector<iterator>
+LirsPolicy::doListEntries() const
+{
+	// resident HIR entries in list Q go first, then LIR entries from the bottom of stack S
+	std::vector<iterator> entries;
+	for (const EntryPair& item : listQ_.container_) {
+		entries.push_back(item.second);
+	}
+	for (const EntryPair& item : stackS_.container_) {
+		if (item.first->getState() == EntryInfo::kLIR)
+			entries.push_back(item.second);
+	}
+	return entries;
+}
+
+void
+LirsPolicy::doAfterInsertBulk(const std::vector<iterator>& entries)
+{
+	// the hottest entries become LIR and the coldest ones resident HIR;
+	// unlike doAfterInsert, nothing needs to be looked up in stack S
+	size_t nLir = std::min<size_t>(entries.size(), std::max(lirSize_, 0));
+	size_t nHir = std::min<size_t>(entries.size() - nLir, std::max(hirSize_, 0));
+	size_t nEvict = entries.size() - nLir - nHir;
+	NFD_LOG_INFO("After Insert Bulk Function, LIR " << nLir << ", HIR " << nHir << ", evict " << nEvict);
+
+	lirSize_ -= nLir;
+	hirSize_ -= nHir;
+
+	for (size_t k = nEvict; k < nEvict + nHir; ++k) {
+		listQ_.pushToEnd({std::make_shared<EntryInfo>(entries[k]->getName(), EntryInfo::kresidentHIR), entries[k]});
+	}
+	for (size_t k = nEvict + nHir; k < entries.size(); ++k) {
+		stackS_.pushEntry({std::make_shared<EntryInfo>(entries[k]->getName(), EntryInfo::kLIR), entries[k]});
+	}
+	for (size_t k = 0; k < nEvict; ++k) {
+		this->emitSignal(beforeEvict, entries[k]);
+	}
+}
 
 void 
 LirsPolicy::hitHIRInStackS(LRUStackSLocation location, iterator i)
@@ -220,12 +382,39 @@ LRUStack::debugToString(std::string const& name)
 	NFD_LOG_INFO("#############" << name << "#############" );
     std::for_each( container_.begin(), container_.end(), [](EntryPair& item)
       { 
-        NFD_LOG_INFO("<" << item.first->getName().toUri() << " , " <<
+        NFD_LOG_INFO("<" << item.first->getName() << " , " <<
         item.first->returnStateStr(item.first->getState()) << ">");
         } );
 	NFD_LOG_INFO(" " );
 }
 
+
+/** \brief adds the stack slots to the usage, and collects the EntryInfos they point to
+ *
+ *  An EntryInfo may be on both stack S and list Q, and is counted once.
+ */
+static size_t
+getStackMemoryUsage(const LRUStack& stack, std::unordered_set<EntryInfo*>& infos)
+{
+  for (const EntryPair& pair : stack.container_) {
+    infos.insert(pair.first.get());
+  }
+  return stack.container_.capacity() * sizeof(EntryPair);
+}
+
+size_t
+LirsPolicy::doGetMemoryUsage() const
+{
+  using namespace memory_usage;
+
+  std::unordered_set<EntryInfo*> infos;
+  size_t usage = getStackMemoryUsage(stackS_, infos) + getStackMemoryUsage(listQ_, infos);
+  for (EntryInfo* info : infos) {
+    usage += sizeof(EntryInfo) + SHARED_PTR_OVERHEAD + getHeapSize(info->getName());
+  }
+  return usage;
+}
+
 } // namespace lru
 } // namespace cs
 } // namespace nfd
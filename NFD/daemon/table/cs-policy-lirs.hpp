@@ -46,7 +46,7 @@ public:
 		kInvalid
 	};
 
-	EntryInfo(Name name, EntryState state) :
+	EntryInfo(const CompactName& name, EntryState state) :
 		m_name(name),
 		m_state(state)
 	{}
@@ -59,7 +59,7 @@ public:
 		return m_state;
 	}
 
-	const Name& getName(){
+	const CompactName& getName(){
 		return m_name;
 	}
 
@@ -79,7 +79,7 @@ public:
   }
 
 private:
-	Name m_name;
+	CompactName m_name;
 	EntryState m_state;
 };
 
@@ -100,11 +100,11 @@ public:
 
   void debugToString(std::string const& name);
   
-  LRUStackLocation find(const Name &name)
+  LRUStackLocation find(const CompactName &name)
   {
     LRUStackLocation location = InvalidLocation;
     int step = 0;
-    for(auto it : container_)
+    for(const auto& it : container_)
     {
       if (it.first->getName() == name)
       {
@@ -181,7 +181,7 @@ class LRUStackS:public LRUStack
 public:
   void stackPruning()       //栈剪枝，当栈底部的lir条目移至stack首部，则如果底部的条目不是lir条目，必须移除
   {                         //因为栈底的hir和non-hir条目需保证栈底部为lir条目
-    while (true)
+    while (getSize() > 0)
     {
       EntryInfo::EntryState state = getBottomState();
       assert(state != EntryInfo::kInvalid);
@@ -192,7 +192,7 @@ public:
     }
   }
 
-  void findAndSetState(const Name &name, EntryInfo::EntryState state)
+  void findAndSetState(const CompactName &name, EntryInfo::EntryState state)
   {
     LRUStackSLocation location = find(name);
     if(location != InvalidLocation)
@@ -215,7 +215,7 @@ public:
     movToTop(location, i);
   }
 
-  void findAndRemove(const Name &name) 
+  void findAndRemove(const CompactName &name) 
   {
 		LRUListQLocation location = find(name);
 		if(location != InvalidLocation)
@@ -238,7 +238,6 @@ public:
 
 public:
   static const std::string POLICY_NAME;
-  void setLimit(size_t nMaxEntries);
 
 private:
   virtual void
@@ -256,6 +255,16 @@ private:
 private:
 	void evictEntries() override;
 
+	Block doSaveState() const override;
+
+	bool doLoadState(const Block& state, const SnapshotIndex& index) override;
+
+	std::vector<iterator> doListEntries() const override;
+
+	void doAfterInsertBulk(const std::vector<iterator>& entries) override;
+
+	size_t doGetMemoryUsage() const override;
+
 	void hitHIRInStackS(LRUStackSLocation location, iterator i);
 
 	void addAResidentHIREntry(iterator i);
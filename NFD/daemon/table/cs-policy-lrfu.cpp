@@ -30,6 +30,7 @@
 #include "cs-policy-lrfu.hpp"
 #include "cs.hpp"
 #include "core/logger.hpp"
+#include "memory-usage.hpp"
 #include "math.h"
 
 NFD_LOG_INIT("LrfuPolicy");
@@ -41,6 +42,10 @@ namespace lrfu {
 const std::string PriorityLrfuPolicy::POLICY_NAME = "lrfu";
 NFD_REGISTER_CS_POLICY(PriorityLrfuPolicy);
 
+/** \brief number of entries kept in the heap list before new entries go to the linked list
+ */
+static const size_t HEAP_LIST_SIZE = 7;
+
 PriorityLrfuPolicy::PriorityLrfuPolicy()
   : Policy(POLICY_NAME)
 {
@@ -121,21 +126,131 @@ PriorityLrfuPolicy::evictEntries()
 {
   BOOST_ASSERT(this->getCs() != nullptr);
 
-  while (this->getCs()->size() > this->getLimit()) {
+  while (this->size() > this->getLimit()) {
     this->evictOne();
   }
 }
 
+/** \return current steady clock time in seconds, as used for lastReferencedTime
+ */
+static double
+getCurrentTime()
+{
+  ndn::time::milliseconds now = ::ndn::time::duration_cast<::ndn::time::milliseconds>(
+    ::ndn::time::steady_clock::now().time_since_epoch());
+  return static_cast<double>(now.count()) / 1000;
+}
+
+Block
+PriorityLrfuPolicy::doSaveState() const
+{
+  // each record carries the CRF value and the time since last reference,
+  // because steady clock time does not carry over to another run
+  double currentTime = getCurrentTime();
+
+  Block state(snapshot::tlv::PolicyState);
+  for (QueueType queueType : {heaplist, linkedlist}) {
+    for (iterator i : m_queues[queueType]) {
+      const EntryInfo* entryInfo = m_entryInfoMap.at(i);
+      state.push_back(snapshot::Record(queueType, i->getName(),
+                                       {entryInfo->crf,
+                                        currentTime - entryInfo->lastReferencedTime}).wireEncode());
+    }
+  }
+  state.encode();
+  return state;
+}
+
+bool
+PriorityLrfuPolicy::doLoadState(const Block& state, const SnapshotIndex& index)
+{
+  std::vector<snapshot::Record> records;
+  std::set<Name> names;
+  for (const Block& element : state.elements()) {
+    if (element.type() != snapshot::tlv::Record) {
+      continue;
+    }
+    records.emplace_back(element);
+    const snapshot::Record& record = records.back();
+    if (record.section >= lrfu || record.values.size() != 2 || index.count(record.name) == 0 ||
+        !names.insert(record.name).second) {
+      return false;
+    }
+  }
+  if (records.size() != index.size()) {
+    return false;
+  }
+
+  double currentTime = getCurrentTime();
+  for (const snapshot::Record& record : records) {
+    iterator i = index.at(record.name);
+
+    EntryInfo* entryInfo = new EntryInfo();
+    entryInfo->queueType = static_cast<QueueType>(record.section);
+    entryInfo->crf = record.values[0];
+    entryInfo->lastReferencedTime = currentTime - record.values[1];
+
+    Queue& queue = m_queues[entryInfo->queueType];
+    entryInfo->queueIt = queue.insert(queue.end(), i);
+    m_entryInfoMap[i] = entryInfo;
+  }
+  return true;
+}
+
+std::vector<iterator>
+PriorityLrfuPolicy::doListEntries() const
+{
+  // the linked list is evicted from the front; the heap list is ordered by CRF
+  std::vector<iterator> entries(m_queues[linkedlist].begin(), m_queues[linkedlist].end());
+
+  std::vector<iterator> heap(m_queues[heaplist].begin(), m_queues[heaplist].end());
+  std::stable_sort(heap.begin(), heap.end(), [this] (iterator a, iterator b) {
+      return m_entryInfoMap.at(a)->crf < m_entryInfoMap.at(b)->crf;
+    });
+  entries.insert(entries.end(), heap.begin(), heap.end());
+  return entries;
+}
+
+void
+PriorityLrfuPolicy::doAfterInsertBulk(const std::vector<iterator>& entries)
+{
+  NFD_LOG_INFO("After Insert Bulk Function " << entries.size());
+
+  // the hottest entries fill the heap list, the others are appended to the linked list
+  // in eviction order; this skips the heap scan that attachQueue does on every insertion.
+  // Entries above the limit must be in the linked list because evictOne only looks there.
+  size_t nLinked = entries.size() - std::min({entries.size(), HEAP_LIST_SIZE, this->getLimit()});
+  double currentTime = getCurrentTime();
+
+  for (size_t k = 0; k < entries.size(); ++k) {
+    iterator i = entries[k];
+    BOOST_ASSERT(m_entryInfoMap.find(i) == m_entryInfoMap.end());
+
+    EntryInfo* entryInfo = new EntryInfo();
+    entryInfo->queueType = k < nLinked ? linkedlist : heaplist;
+    entryInfo->crf = 1.0;
+    entryInfo->lastReferencedTime = currentTime;
+
+    Queue& queue = m_queues[entryInfo->queueType];
+    entryInfo->queueIt = queue.insert(queue.end(), i);
+    m_entryInfoMap[i] = entryInfo;
+  }
+
+  this->evictEntries();
+}
+
 void
 PriorityLrfuPolicy::evictOne()
 {
   BOOST_ASSERT(!m_queues[heaplist].empty()||
                !m_queues[linkedlist].empty());
 
-   iterator i;
-    if(!m_queues[linkedlist].empty()){
-       i = m_queues[linkedlist].front();
-     }
+  // when the limit drops below the heap list size, the linked list can run empty;
+  // demote the heap entry with the lowest CRF first
+  if (m_queues[linkedlist].empty()) {
+    this->restoreHeapStructure(true);
+  }
+  iterator i = m_queues[linkedlist].front();
 
    this->detachQueue(i);
    this->emitSignal(beforeEvict, i);
@@ -155,12 +270,12 @@ PriorityLrfuPolicy::attachQueue(iterator i)
     entryInfo->crf = 1.0;
     entryInfo->lastReferencedTime=init_currentTime;
 
-    if(this->getCs()->size() == this->getLimit()+1){
+    if(this->size() == this->getLimit()+1){
       NFD_LOG_INFO("** New Interest **");
       this->restoreHeapStructure(true);
       entryInfo->queueType = heaplist;
     }
-    else if (this->getCs()->size() > 7) {
+    else if (this->size() > HEAP_LIST_SIZE) {
       entryInfo->queueType = linkedlist;
       NFD_LOG_INFO("Type : LinkedList");
     }
@@ -188,7 +303,7 @@ PriorityLrfuPolicy::attachQueue(iterator i)
   }          
 
 
-  NFD_LOG_DEBUG("Size: "<< this->getCs()->size() <<"CRF : "<< m_entryInfoMap[i]->crf << ", entryInfo: "<< m_entryInfoMap[i]);
+  NFD_LOG_DEBUG("Size: "<< this->size() <<"CRF : "<< m_entryInfoMap[i]->crf << ", entryInfo: "<< m_entryInfoMap[i]);
 
 }
 
@@ -299,6 +414,21 @@ PriorityLrfuPolicy::moveToHeapList(iterator i)
 
 }
 
+
+size_t
+PriorityLrfuPolicy::doGetMemoryUsage() const
+{
+  using namespace memory_usage;
+
+  size_t usage = 0;
+  for (const Queue& queue : m_queues) {
+    usage += queue.size() * (sizeof(iterator) + LIST_NODE_OVERHEAD);
+  }
+  usage += m_entryInfoMap.size() * (sizeof(EntryInfoMapLrfu::value_type) + TREE_NODE_OVERHEAD +
+                                    sizeof(EntryInfo));
+  return usage;
+}
+
 } // namespace lrfu
 } // namespace cs
 } // namespace nfd
@@ -100,6 +100,21 @@ private:
   virtual void
   evictEntries() override;
 
+  virtual Block
+  doSaveState() const override;
+
+  virtual bool
+  doLoadState(const Block& state, const SnapshotIndex& index) override;
+
+  virtual std::vector<iterator>
+  doListEntries() const override;
+
+  virtual void
+  doAfterInsertBulk(const std::vector<iterator>& entries) override;
+
+  virtual size_t
+  doGetMemoryUsage() const override;
+
 private:
   /** \brief evicts one entry
    *  \pre CS is not empty
@@ -25,6 +25,7 @@
 
 #include "cs-policy-lru.hpp"
 #include "cs.hpp"
+#include "memory-usage.hpp"
 
 namespace nfd {
 namespace cs {
@@ -67,12 +68,50 @@ void
 LruPolicy::evictEntries()
 {
   BOOST_ASSERT(this->getCs() != nullptr);
-  while (this->getCs()->size() > this->getLimit()) {
-    BOOST_ASSERT(!m_queue.empty());
-    iterator i = m_queue.front();
-    m_queue.pop_front();
-    this->emitSignal(beforeEvict, i);
+  this->evictBatch([this] {
+      BOOST_ASSERT(!m_queue.empty());
+      iterator i = m_queue.front();
+      m_queue.pop_front();
+      return i;
+    });
+}
+
+std::vector<iterator>
+LruPolicy::doListEntries() const
+{
+  return std::vector<iterator>(m_queue.begin(), m_queue.end());
+}
+
+Block
+LruPolicy::doSaveState() const
+{
+  Block state(snapshot::tlv::PolicyState);
+  for (iterator i : m_queue) {
+    state.push_back(snapshot::Record(0, i->getName()).wireEncode());
   }
+  state.encode();
+  return state;
+}
+
+bool
+LruPolicy::doLoadState(const Block& state, const SnapshotIndex& index)
+{
+  Queue queue;
+  for (const Block& element : state.elements()) {
+    if (element.type() != snapshot::tlv::Record) {
+      continue;
+    }
+    auto found = index.find(snapshot::Record(element).name);
+    if (found == index.end() || !queue.push_back(found->second).second) {
+      return false;
+    }
+  }
+  if (queue.size() != index.size()) {
+    return false;
+  }
+
+  m_queue.swap(queue);
+  return true;
 }
 
 void
@@ -89,6 +128,15 @@ LruPolicy::insertToQueue(iterator i, bool isNewEntry)
   }
 }
 
+
+size_t
+LruPolicy::doGetMemoryUsage() const
+{
+  using namespace memory_usage;
+
+  return m_queue.size() * (sizeof(iterator) + LIST_NODE_OVERHEAD + TREE_NODE_OVERHEAD);
+}
+
 } // namespace lru
 } // namespace cs
 } // namespace nfd
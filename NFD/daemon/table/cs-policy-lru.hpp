@@ -85,6 +85,18 @@ private:
   virtual void
   evictEntries() override;
 
+  virtual std::vector<iterator>
+  doListEntries() const override;
+
+  virtual Block
+  doSaveState() const override;
+
+  virtual bool
+  doLoadState(const Block& state, const SnapshotIndex& index) override;
+
+  virtual size_t
+  doGetMemoryUsage() const override;
+
 private:
   /** \brief moves an entry to the end of queue
    */
@@ -0,0 +1,397 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-partitioned.hpp"
+#include "cs-policy-lru.hpp"
+#include "cs.hpp"
+#include "core/logger.hpp"
+#include "memory-usage.hpp"
+#include "name-tree-hashtable.hpp"
+
+#include <cmath>
+
+namespace nfd {
+namespace cs {
+namespace partitioned {
+
+NFD_LOG_INIT("PartitionedPolicy");
+
+const std::string PartitionedPolicy::POLICY_NAME = "partitioned";
+NFD_REGISTER_CS_POLICY(PartitionedPolicy);
+
+PartitionedPolicy::PartitionedPolicy()
+  : Policy(POLICY_NAME)
+  , m_rebalanceInterval(0)
+  , m_rebalanceStep(0)
+  , m_nInsertsSinceRebalance(0)
+{
+  m_partitions.emplace_back();
+  m_partitions.front().prefix = Name("/");
+  m_partitions.front().weight = 1.0;
+  this->setPartitionPolicy(0, make_unique<LruPolicy>());
+}
+
+void
+PartitionedPolicy::addPartition(const Name& prefix, unique_ptr<Policy> policy, double weight)
+{
+  BOOST_ASSERT(policy != nullptr);
+  BOOST_ASSERT(weight > 0.0);
+  BOOST_ASSERT(this->size() == 0);
+
+  auto it = std::find_if(m_partitions.begin(), m_partitions.end(),
+                         [&prefix] (const Partition& p) { return p.prefix == prefix; });
+  if (it == m_partitions.end()) {
+    m_partitions.emplace_back();
+    it = std::prev(m_partitions.end());
+    it->prefix = prefix;
+  }
+  it->weight = weight;
+  it->counters = Counters();
+  this->setPartitionPolicy(std::distance(m_partitions.begin(), it), std::move(policy));
+  NFD_LOG_DEBUG("add-partition " << prefix << " policy=" << it->policy->getName()
+                << " weight=" << weight);
+
+  this->evictEntries();
+}
+
+size_t
+PartitionedPolicy::findPartition(const Name& name) const
+{
+  size_t found = 0;
+  size_t foundLength = 0;
+  for (size_t k = 1; k < m_partitions.size(); ++k) {
+    const Name& prefix = m_partitions[k].prefix;
+    if (prefix.size() > foundLength && prefix.isPrefixOf(name)) {
+      found = k;
+      foundLength = prefix.size();
+    }
+  }
+  return found;
+}
+
+void
+PartitionedPolicy::setRebalanceInterval(size_t nInserts)
+{
+  m_rebalanceInterval = nInserts;
+  m_nInsertsSinceRebalance = 0;
+  for (Partition& p : m_partitions) {
+    p.nWindowGhostHits = 0;
+    if (m_rebalanceInterval == 0) {
+      p.ghosts.clear();
+      p.ghostIndex.clear();
+    }
+  }
+}
+
+void
+PartitionedPolicy::setRebalanceStep(size_t nEntries)
+{
+  m_rebalanceStep = nEntries;
+  for (Partition& p : m_partitions) {
+    this->trimGhosts(p);
+  }
+}
+
+size_t
+PartitionedPolicy::getRebalanceStep() const
+{
+  if (m_rebalanceStep > 0) {
+    return m_rebalanceStep;
+  }
+  return std::max<size_t>(this->getLimit() / 64, 1);
+}
+
+void
+PartitionedPolicy::rebalance()
+{
+  m_nInsertsSinceRebalance = 0;
+  size_t step = this->getRebalanceStep();
+
+  Partition* receiver = nullptr;
+  for (Partition& p : m_partitions) {
+    if (receiver == nullptr || p.nWindowGhostHits > receiver->nWindowGhostHits) {
+      receiver = &p;
+    }
+  }
+
+  Partition* donor = nullptr;
+  for (Partition& p : m_partitions) {
+    if (&p != receiver && p.policy->getLimit() >= step &&
+        (donor == nullptr || p.nWindowGhostHits < donor->nWindowGhostHits)) {
+      donor = &p;
+    }
+  }
+
+  if (donor != nullptr && receiver->nWindowGhostHits > donor->nWindowGhostHits) {
+    NFD_LOG_DEBUG("rebalance " << donor->prefix << "(" << donor->nWindowGhostHits << ") -> "
+                  << receiver->prefix << "(" << receiver->nWindowGhostHits << ") step=" << step);
+    // shrink first, so that the partitions never exceed the limit together
+    donor->policy->setLimit(donor->policy->getLimit() - step);
+    receiver->policy->setLimit(receiver->policy->getLimit() + step);
+  }
+
+  for (Partition& p : m_partitions) {
+    p.nWindowGhostHits = 0;
+  }
+}
+
+void
+PartitionedPolicy::setCs(Cs* cs)
+{
+  Policy::setCs(cs);
+  for (Partition& p : m_partitions) {
+    p.policy->setCs(cs);
+  }
+}
+
+void
+PartitionedPolicy::setEvictionTarget(double fraction)
+{
+  Policy::setEvictionTarget(fraction);
+  for (Partition& p : m_partitions) {
+    p.policy->setEvictionTarget(fraction);
+  }
+}
+
+void
+PartitionedPolicy::doAfterInsert(iterator i)
+{
+  Partition& p = m_partitions[this->findPartition(i->getName())];
+  ++p.counters.nInserts;
+  if (m_rebalanceInterval > 0 && this->takeGhost(p, getHash(i))) {
+    ++p.counters.nGhostHits;
+    ++p.nWindowGhostHits;
+  }
+
+  p.policy->afterInsert(i);
+
+  if (m_rebalanceInterval > 0 && ++m_nInsertsSinceRebalance >= m_rebalanceInterval) {
+    this->rebalance();
+  }
+}
+
+void
+PartitionedPolicy::doAfterRefresh(iterator i)
+{
+  m_partitions[this->findPartition(i->getName())].policy->afterRefresh(i);
+}
+
+void
+PartitionedPolicy::doBeforeErase(iterator i)
+{
+  m_partitions[this->findPartition(i->getName())].policy->beforeErase(i);
+}
+
+void
+PartitionedPolicy::doBeforeUse(iterator i)
+{
+  Partition& p = m_partitions[this->findPartition(i->getName())];
+  ++p.counters.nHits;
+  p.policy->beforeUse(i);
+}
+
+void
+PartitionedPolicy::evictEntries()
+{
+  double totalWeight = 0.0;
+  for (const Partition& p : m_partitions) {
+    totalWeight += p.weight;
+  }
+
+  // largest remainder method, so that quotas add up to the limit
+  size_t limit = this->getLimit();
+  std::vector<size_t> quotas(m_partitions.size());
+  std::vector<std::pair<double, size_t>> remainders; // (fraction of an entry, partition index)
+  size_t nAssigned = 0;
+  for (size_t k = 0; k < m_partitions.size(); ++k) {
+    double exact = limit * m_partitions[k].weight / totalWeight;
+    quotas[k] = std::min(static_cast<size_t>(std::floor(exact)), limit - nAssigned);
+    nAssigned += quotas[k];
+    remainders.emplace_back(exact - quotas[k], k);
+  }
+  std::stable_sort(remainders.begin(), remainders.end(),
+                   [] (const std::pair<double, size_t>& a, const std::pair<double, size_t>& b) {
+                     return a.first > b.first;
+                   });
+  for (size_t k = 0; nAssigned < limit; ++k) {
+    ++quotas[remainders[k % remainders.size()].second];
+    ++nAssigned;
+  }
+
+  // shrink first, so that the partitions never exceed the limit together
+  for (size_t k = 0; k < m_partitions.size(); ++k) {
+    if (quotas[k] < m_partitions[k].policy->getLimit()) {
+      m_partitions[k].policy->setLimit(quotas[k]);
+    }
+  }
+  for (size_t k = 0; k < m_partitions.size(); ++k) {
+    if (quotas[k] != m_partitions[k].policy->getLimit()) {
+      m_partitions[k].policy->setLimit(quotas[k]);
+    }
+  }
+
+  m_nInsertsSinceRebalance = 0;
+  for (Partition& p : m_partitions) {
+    p.nWindowGhostHits = 0;
+    this->trimGhosts(p);
+  }
+}
+
+std::vector<iterator>
+PartitionedPolicy::doListEntries() const
+{
+  // each partition is listed coldest first; partitions do not share an order
+  std::vector<iterator> entries;
+  entries.reserve(this->size());
+  for (const Partition& p : m_partitions) {
+    std::vector<iterator> listed = p.policy->listEntries();
+    if (listed.size() != p.policy->size()) {
+      return {};
+    }
+    entries.insert(entries.end(), listed.begin(), listed.end());
+  }
+  return entries;
+}
+
+void
+PartitionedPolicy::doAfterInsertBulk(const std::vector<iterator>& entries)
+{
+  std::vector<std::vector<iterator>> byPartition(m_partitions.size());
+  for (iterator i : entries) {
+    byPartition[this->findPartition(i->getName())].push_back(i);
+  }
+  for (size_t k = 0; k < m_partitions.size(); ++k) {
+    std::vector<iterator>& handedOver = byPartition[k];
+    // the coldest entries that do not fit into the quota are evicted before the handover,
+    // so that the partition policy is not asked to evict entries it does not know yet
+    size_t quota = m_partitions[k].policy->getLimit();
+    size_t nExcess = handedOver.size() > quota ? handedOver.size() - quota : 0;
+    if (nExcess > 0) {
+      std::vector<iterator> victims(handedOver.begin(), handedOver.begin() + nExcess);
+      this->emitSignal(beforeEvictBatch, victims);
+      handedOver.erase(handedOver.begin(), handedOver.begin() + nExcess);
+    }
+
+    if (!handedOver.empty()) {
+      m_partitions[k].policy->afterInsertBulk(handedOver);
+    }
+  }
+}
+
+bool
+PartitionedPolicy::doNeedsRetrievalCost() const
+{
+  return std::any_of(m_partitions.begin(), m_partitions.end(),
+                     [] (const Partition& p) { return p.policy->needsRetrievalCost(); });
+}
+
+size_t
+PartitionedPolicy::doGetMemoryUsage() const
+{
+  using namespace memory_usage;
+
+  size_t usage = m_partitions.capacity() * sizeof(Partition);
+  for (const Partition& p : m_partitions) {
+    usage += p.policy->getMemoryUsage() +
+             p.ghosts.size() * sizeof(size_t) +
+             p.ghostIndex.size() * (sizeof(std::pair<size_t, uint64_t>) + HASH_NODE_OVERHEAD) +
+             p.ghostIndex.bucket_count() * sizeof(void*);
+  }
+  return usage;
+}
+
+void
+PartitionedPolicy::setPartitionPolicy(size_t index, unique_ptr<Policy> policy)
+{
+  Partition& p = m_partitions[index];
+  p.beforeEvictConnection.disconnect();
+  p.beforeEvictBatchConnection.disconnect();
+  p.policy = std::move(policy);
+  p.policy->setCs(this->getCs());
+  p.policy->setEvictionTarget(this->getEvictionTarget());
+  p.beforeEvictConnection = p.policy->beforeEvict.connect([this, index] (iterator i) {
+      if (m_rebalanceInterval > 0) {
+        this->addGhost(m_partitions[index], getHash(i));
+      }
+      this->emitSignal(beforeEvict, i);
+    });
+  p.beforeEvictBatchConnection = p.policy->beforeEvictBatch.connect(
+    [this, index] (const std::vector<iterator>& victims) {
+      if (m_rebalanceInterval > 0) {
+        for (iterator i : victims) {
+          this->addGhost(m_partitions[index], getHash(i));
+        }
+      }
+      this->emitSignal(beforeEvictBatch, victims);
+    });
+  p.ghosts.clear();
+  p.ghostIndex.clear();
+}
+
+void
+PartitionedPolicy::addGhost(Partition& p, size_t hash)
+{
+  p.ghosts.push_back(hash);
+  p.ghostIndex[hash] = p.nGhostsAdded++;
+  this->trimGhosts(p);
+}
+
+void
+PartitionedPolicy::trimGhosts(Partition& p)
+{
+  size_t ghostLimit = this->getRebalanceStep();
+  while (p.ghosts.size() > ghostLimit) {
+    uint64_t seq = p.nGhostsAdded - p.ghosts.size();
+    auto ghost = p.ghostIndex.find(p.ghosts.front());
+    // a ghost that has been hit, or remembered again later, has a different sequence number
+    if (ghost != p.ghostIndex.end() && ghost->second == seq) {
+      p.ghostIndex.erase(ghost);
+    }
+    p.ghosts.pop_front();
+  }
+}
+
+bool
+PartitionedPolicy::takeGhost(Partition& p, size_t hash)
+{
+  auto ghost = p.ghostIndex.find(hash);
+  if (ghost == p.ghostIndex.end()) {
+    return false;
+  }
+  // the deque slot stays behind and is skipped when it is dropped
+  p.ghostIndex.erase(ghost);
+  return true;
+}
+
+size_t
+PartitionedPolicy::getHash(iterator i)
+{
+  // reuses the hashes cached on the Data by NameTree lookups in the forwarding pipeline
+  return name_tree::getHashes(i->getData()).back();
+}
+
+} // namespace partitioned
+} // namespace cs
+} // namespace nfd
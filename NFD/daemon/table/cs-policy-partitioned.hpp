@@ -0,0 +1,241 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_PARTITIONED_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_PARTITIONED_HPP
+
+#include "cs-policy.hpp"
+
+#include <deque>
+#include <unordered_map>
+
+namespace nfd {
+namespace cs {
+namespace partitioned {
+
+/** \brief partitioned cs replacement policy
+ *
+ *  The capacity is divided among partitions. Each partition is defined by a name prefix and
+ *  managed by its own replacement policy, which may evict only entries of that partition to
+ *  stay within the partition's quota. An entry belongs to the partition with the longest
+ *  prefix of its name; the partition of ndn:/ takes all other entries. Thus a scan of a large
+ *  catalog under one prefix cannot push popular content of another prefix out of the cache.
+ *
+ *  Quotas are proportional to partition weights. If rebalancing is enabled, each partition
+ *  also remembers the names of its most recently evicted entries, as many as the rebalancing
+ *  step. When such a name is inserted again, a quota larger by one step would have turned the
+ *  miss into a hit, so the number of these ghost hits estimates the marginal hit gain of the
+ *  partition. After every rebalancing interval, one step of capacity moves from the partition
+ *  with the fewest ghost hits to the partition with the most.
+ *
+ *  Ghosts store only the hash of the Data name, which the forwarding pipeline has already
+ *  computed for NameTree lookups.
+ */
+class PartitionedPolicy : public Policy
+{
+public:
+  PartitionedPolicy();
+
+public:
+  static const std::string POLICY_NAME;
+
+  /** \brief statistics of a partition
+   */
+  struct Counters
+  {
+    uint64_t nHits = 0;      ///< lookups satisfied by an entry of the partition
+    uint64_t nInserts = 0;   ///< new entries, i.e., misses that brought Data
+    uint64_t nGhostHits = 0; ///< new entries whose name had recently been evicted
+  };
+
+  /** \brief adds a partition, or replaces the partition with the same prefix
+   *  \param prefix name prefix of the partition
+   *  \param policy replacement policy within the partition
+   *  \param weight share of the capacity relative to the weights of other partitions
+   *  \pre size() == 0
+   *
+   *  Initially, there is one partition of ndn:/ with LRU policy and weight 1.
+   *  Quotas are recomputed from the weights, discarding any rebalancing.
+   */
+  void
+  addPartition(const Name& prefix, unique_ptr<Policy> policy, double weight = 1.0);
+
+  size_t
+  getNPartitions() const
+  {
+    return m_partitions.size();
+  }
+
+  /** \return index of the partition that Data named \p name belongs to
+   */
+  size_t
+  findPartition(const Name& name) const;
+
+  const Name&
+  getPartitionPrefix(size_t index) const
+  {
+    return m_partitions.at(index).prefix;
+  }
+
+  /** \return the replacement policy of a partition
+   *
+   *  Its Policy::getLimit is the quota of the partition, and Policy::size is the number of
+   *  entries in the partition.
+   */
+  const Policy&
+  getPartitionPolicy(size_t index) const
+  {
+    return *m_partitions.at(index).policy;
+  }
+
+  const Counters&
+  getPartitionCounters(size_t index) const
+  {
+    return m_partitions.at(index).counters;
+  }
+
+  /** \brief sets the rebalancing interval
+   *  \param nInserts number of new entries between rebalancing decisions;
+   *                  0 disables rebalancing, which is the default
+   */
+  void
+  setRebalanceInterval(size_t nInserts);
+
+  size_t
+  getRebalanceInterval() const
+  {
+    return m_rebalanceInterval;
+  }
+
+  /** \brief sets the capacity moved by one rebalancing decision
+   *  \param nEntries number of entries; 0 selects 1/64 of the limit, which is the default
+   */
+  void
+  setRebalanceStep(size_t nEntries);
+
+  /** \return the capacity moved by one rebalancing decision, in number of entries
+   */
+  size_t
+  getRebalanceStep() const;
+
+  /** \brief moves one step of capacity towards the partition with the highest marginal gain
+   *
+   *  This is invoked every rebalancing interval. It starts a new measurement window.
+   */
+  void
+  rebalance();
+
+public:
+  virtual void
+  setCs(Cs* cs) override;
+
+  /** \brief sets the eviction target of every partition
+   */
+  virtual void
+  setEvictionTarget(double fraction) override;
+
+private:
+  virtual void
+  doAfterInsert(iterator i) override;
+
+  virtual void
+  doAfterRefresh(iterator i) override;
+
+  virtual void
+  doBeforeErase(iterator i) override;
+
+  virtual void
+  doBeforeUse(iterator i) override;
+
+  /** \brief assigns quotas proportional to weights
+   */
+  virtual void
+  evictEntries() override;
+
+  virtual std::vector<iterator>
+  doListEntries() const override;
+
+  virtual void
+  doAfterInsertBulk(const std::vector<iterator>& entries) override;
+
+  virtual bool
+  doNeedsRetrievalCost() const override;
+
+  virtual size_t
+  doGetMemoryUsage() const override;
+
+private:
+  struct Partition
+  {
+    Name prefix;
+    double weight;
+    unique_ptr<Policy> policy;
+    Counters counters;
+    uint64_t nWindowGhostHits = 0; ///< ghost hits since the last rebalancing decision
+
+    std::deque<size_t> ghosts;                          ///< name hashes, oldest first
+    uint64_t nGhostsAdded = 0;                          ///< sequence number of the next ghost
+    std::unordered_map<size_t, uint64_t> ghostIndex;    ///< name hash => ghost sequence number
+
+    signal::ScopedConnection beforeEvictConnection;
+    signal::ScopedConnection beforeEvictBatchConnection;
+  };
+
+  void
+  setPartitionPolicy(size_t index, unique_ptr<Policy> policy);
+
+  /** \brief remembers \p hash as a ghost of partition \p p
+   */
+  void
+  addGhost(Partition& p, size_t hash);
+
+  /** \brief forgets the oldest ghosts of partition \p p over the rebalancing step
+   */
+  void
+  trimGhosts(Partition& p);
+
+  /** \return whether \p hash is a ghost of partition \p p; the ghost is forgotten
+   */
+  bool
+  takeGhost(Partition& p, size_t hash);
+
+  static size_t
+  getHash(iterator i);
+
+private:
+  std::vector<Partition> m_partitions; ///< m_partitions[0] is the partition of ndn:/
+  size_t m_rebalanceInterval;
+  size_t m_rebalanceStep;
+  size_t m_nInsertsSinceRebalance;
+};
+
+} // namespace partitioned
+
+using partitioned::PartitionedPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_PARTITIONED_HPP
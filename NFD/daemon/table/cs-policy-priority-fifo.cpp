@@ -25,6 +25,7 @@
 
 #include "cs-policy-priority-fifo.hpp"
 #include "cs.hpp"
+#include "memory-usage.hpp"
 
 namespace nfd {
 namespace cs {
@@ -76,13 +77,21 @@ PriorityFifoPolicy::evictEntries()
 {
   BOOST_ASSERT(this->getCs() != nullptr);
 
-  while (this->getCs()->size() > this->getLimit()) {
-    this->evictOne();
+  this->evictBatch([this] { return this->popVictim(); });
+}
+
+std::vector<iterator>
+PriorityFifoPolicy::doListEntries() const
+{
+  std::vector<iterator> entries;
+  for (const Queue& queue : m_queues) {
+    entries.insert(entries.end(), queue.begin(), queue.end());
   }
+  return entries;
 }
 
-void
-PriorityFifoPolicy::evictOne()
+iterator
+PriorityFifoPolicy::popVictim()
 {
   BOOST_ASSERT(!m_queues[QUEUE_UNSOLICITED].empty() ||
                !m_queues[QUEUE_STALE].empty() ||
@@ -100,7 +109,7 @@ PriorityFifoPolicy::evictOne()
   }
 
   this->detachQueue(i);
-  this->emitSignal(beforeEvict, i);
+  return i;
 }
 
 void
@@ -157,6 +166,21 @@ PriorityFifoPolicy::moveToStaleQueue(iterator i)
   m_entryInfoMap[i] = entryInfo;
 }
 
+
+size_t
+PriorityFifoPolicy::doGetMemoryUsage() const
+{
+  using namespace memory_usage;
+
+  size_t usage = 0;
+  for (const Queue& queue : m_queues) {
+    usage += queue.size() * (sizeof(iterator) + LIST_NODE_OVERHEAD);
+  }
+  usage += m_entryInfoMap.size() * (sizeof(EntryInfoMapFifo::value_type) + TREE_NODE_OVERHEAD +
+                                    sizeof(EntryInfo));
+  return usage;
+}
+
 } // namespace priority_fifo
 } // namespace cs
 } // namespace nfd
@@ -100,12 +100,19 @@ private:
   void
   evictEntries() override;
 
+  std::vector<iterator>
+  doListEntries() const override;
+
+  size_t
+  doGetMemoryUsage() const override;
+
 private:
-  /** \brief evicts one entry
+  /** \brief detaches the next entry to evict from its queue
    *  \pre CS is not empty
+   *  \return the entry to evict
    */
-  void
-  evictOne();
+  iterator
+  popVictim();
 
   /** \brief attaches the entry to an appropriate queue
    *  \pre the entry is not in any queue
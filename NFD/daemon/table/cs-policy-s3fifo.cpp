@@ -0,0 +1,411 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-s3fifo.hpp"
+#include "cs.hpp"
+#include "memory-usage.hpp"
+#include "name-tree-hashtable.hpp"
+
+namespace nfd {
+namespace cs {
+namespace s3fifo {
+
+const std::string S3FifoPolicy::POLICY_NAME = "s3fifo";
+NFD_REGISTER_CS_POLICY(S3FifoPolicy);
+
+const uint8_t S3FifoPolicy::MAX_FREQUENCY;
+const S3FifoPolicy::NodeIndex S3FifoPolicy::NONE = std::numeric_limits<NodeIndex>::max();
+
+S3FifoPolicy::S3FifoPolicy()
+  : Policy(POLICY_NAME)
+  , m_freeList(NONE)
+  , m_nQueued{0, 0}
+  , m_nGhostsAdded(0)
+{
+}
+
+void
+S3FifoPolicy::doAfterInsert(iterator i)
+{
+  size_t hash = getHash(i);
+
+  bool isGhost = false;
+  auto ghost = m_ghostIndex.find(hash);
+  if (ghost != m_ghostIndex.end()) {
+    // the ring slot stays behind and is skipped when it is dequeued
+    m_ghostIndex.erase(ghost);
+    isGhost = true;
+  }
+
+  // i is in CS but not yet queued, so it cannot be chosen for eviction
+  while (this->size() > this->getLimit() && m_nQueued[SMALL] + m_nQueued[MAIN] > 0) {
+    this->evictOne();
+  }
+
+  if (this->size() > this->getLimit()) {
+    this->emitSignal(beforeEvict, i);
+  }
+  else {
+    this->admit(isGhost ? MAIN : SMALL, i, hash, 0);
+  }
+}
+
+void
+S3FifoPolicy::doAfterRefresh(iterator i)
+{
+  this->doBeforeUse(i);
+}
+
+void
+S3FifoPolicy::doBeforeErase(iterator i)
+{
+  auto found = m_index.find(&*i);
+  BOOST_ASSERT(found != m_index.end());
+  Node& node = m_nodes[found->second];
+  m_index.erase(found);
+
+  node.isErased = true;
+  QueueId id = node.queue;
+  --m_nQueued[id];
+
+  // erased nodes are normally dropped by eviction; compact if they pile up without it
+  size_t nErased = m_queues[id].size() - m_nQueued[id];
+  if (nErased > std::max<size_t>(m_nQueued[id], 16)) {
+    this->compact(id);
+  }
+}
+
+void
+S3FifoPolicy::doBeforeUse(iterator i)
+{
+  auto found = m_index.find(&*i);
+  BOOST_ASSERT(found != m_index.end());
+  Node& node = m_nodes[found->second];
+  if (node.frequency < MAX_FREQUENCY) {
+    ++node.frequency;
+  }
+}
+
+void
+S3FifoPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+  while (this->size() > this->getLimit()) {
+    BOOST_ASSERT(m_nQueued[SMALL] + m_nQueued[MAIN] > 0);
+    this->evictOne();
+  }
+  this->trimGhosts();
+}
+
+std::vector<iterator>
+S3FifoPolicy::doListEntries() const
+{
+  std::vector<iterator> entries;
+  entries.reserve(m_index.size());
+  for (QueueId id : {SMALL, MAIN}) {
+    for (size_t k = 0; k < m_queues[id].size(); ++k) {
+      const Node& node = m_nodes[m_queues[id][k]];
+      if (!node.isErased) {
+        entries.push_back(node.entry);
+      }
+    }
+  }
+  return entries;
+}
+
+// snapshot record sections
+enum : uint64_t {
+  SNAPSHOT_SMALL = 0,
+  SNAPSHOT_MAIN = 1
+};
+
+Block
+S3FifoPolicy::doSaveState() const
+{
+  // the ghost queue keeps only name hashes, so it is not saved and starts empty after loading
+  Block state(snapshot::tlv::PolicyState);
+  for (QueueId id : {SMALL, MAIN}) {
+    for (size_t k = 0; k < m_queues[id].size(); ++k) {
+      const Node& node = m_nodes[m_queues[id][k]];
+      if (!node.isErased) {
+        state.push_back(snapshot::Record(id == SMALL ? SNAPSHOT_SMALL : SNAPSHOT_MAIN,
+                                         node.entry->getName(),
+                                         {static_cast<double>(node.frequency)}).wireEncode());
+      }
+    }
+  }
+  state.encode();
+  return state;
+}
+
+bool
+S3FifoPolicy::doLoadState(const Block& state, const SnapshotIndex& index)
+{
+  struct Loaded
+  {
+    QueueId queue;
+    iterator entry;
+    uint8_t frequency;
+  };
+  std::vector<Loaded> entries;
+  std::set<const Entry*> seen;
+
+  for (const Block& element : state.elements()) {
+    if (element.type() != snapshot::tlv::Record) {
+      continue;
+    }
+
+    snapshot::Record record(element);
+    if ((record.section != SNAPSHOT_SMALL && record.section != SNAPSHOT_MAIN) ||
+        record.values.size() != 1 || !(record.values[0] >= 0 && record.values[0] <= MAX_FREQUENCY)) {
+      return false;
+    }
+    auto found = index.find(record.name);
+    if (found == index.end() || !seen.insert(&*found->second).second) {
+      return false;
+    }
+    entries.push_back({record.section == SNAPSHOT_SMALL ? SMALL : MAIN, found->second,
+                       static_cast<uint8_t>(record.values[0])});
+  }
+  if (entries.size() != index.size()) {
+    return false;
+  }
+
+  m_nodes.clear();
+  m_freeList = NONE;
+  for (QueueId id : {SMALL, MAIN}) {
+    m_queues[id].clear();
+    m_nQueued[id] = 0;
+  }
+  m_index.clear();
+  m_ghosts.clear();
+  m_ghostIndex.clear();
+  m_nGhostsAdded = 0;
+
+  m_nodes.reserve(entries.size());
+  for (const Loaded& entry : entries) {
+    this->admit(entry.queue, entry.entry, getHash(entry.entry), entry.frequency);
+  }
+  return true;
+}
+
+size_t
+S3FifoPolicy::doGetMemoryUsage() const
+{
+  using namespace memory_usage;
+
+  return m_nodes.capacity() * sizeof(Node) +
+         (m_queues[SMALL].capacity() + m_queues[MAIN].capacity()) * sizeof(NodeIndex) +
+         m_ghosts.capacity() * sizeof(size_t) +
+         m_index.size() * (sizeof(std::pair<const Entry*, NodeIndex>) + HASH_NODE_OVERHEAD) +
+         m_ghostIndex.size() * (sizeof(std::pair<size_t, uint64_t>) + HASH_NODE_OVERHEAD) +
+         (m_index.bucket_count() + m_ghostIndex.bucket_count()) * sizeof(void*);
+}
+
+S3FifoPolicy::NodeIndex
+S3FifoPolicy::allocateNode()
+{
+  if (m_freeList != NONE) {
+    NodeIndex n = m_freeList;
+    m_freeList = m_nodes[n].nextFree;
+    return n;
+  }
+
+  BOOST_ASSERT(m_nodes.size() < NONE);
+  m_nodes.emplace_back();
+  return static_cast<NodeIndex>(m_nodes.size() - 1);
+}
+
+void
+S3FifoPolicy::releaseNode(NodeIndex n)
+{
+  m_nodes[n].nextFree = m_freeList;
+  m_freeList = n;
+}
+
+void
+S3FifoPolicy::admit(QueueId id, iterator i, size_t hash, uint8_t frequency)
+{
+  NodeIndex n = this->allocateNode();
+  Node& node = m_nodes[n];
+  node.entry = i;
+  node.hash = hash;
+  node.frequency = frequency;
+  node.queue = id;
+  node.isErased = false;
+
+  m_queues[id].pushBack(n);
+  ++m_nQueued[id];
+
+  bool isNew = m_index.emplace(&*i, n).second;
+  BOOST_ASSERT(isNew);
+  (void)isNew;
+}
+
+void
+S3FifoPolicy::evictOne()
+{
+  if (m_nQueued[SMALL] > 0 &&
+      (m_nQueued[SMALL] >= this->getSmallLimit() || m_nQueued[MAIN] == 0)) {
+    this->evictSmall();
+  }
+  else {
+    this->evictMain();
+  }
+}
+
+void
+S3FifoPolicy::evictSmall()
+{
+  Ring<NodeIndex>& small = m_queues[SMALL];
+  while (small.size() > 0) {
+    NodeIndex n = small.front();
+    small.popFront();
+
+    Node& node = m_nodes[n];
+    if (node.isErased) {
+      this->releaseNode(n);
+      continue;
+    }
+    --m_nQueued[SMALL];
+
+    if (node.frequency > 1) {
+      // used again while on probation: keep it, but it has to earn its reinsertions anew
+      node.queue = MAIN;
+      node.frequency = 0;
+      m_queues[MAIN].pushBack(n);
+      ++m_nQueued[MAIN];
+    }
+    else {
+      this->addGhost(node.hash);
+      this->evict(n);
+      return;
+    }
+  }
+}
+
+void
+S3FifoPolicy::evictMain()
+{
+  Ring<NodeIndex>& main = m_queues[MAIN];
+  while (main.size() > 0) {
+    NodeIndex n = main.front();
+    main.popFront();
+
+    Node& node = m_nodes[n];
+    if (node.isErased) {
+      this->releaseNode(n);
+      continue;
+    }
+
+    if (node.frequency > 0) {
+      --node.frequency;
+      main.pushBack(n);
+    }
+    else {
+      --m_nQueued[MAIN];
+      this->evict(n);
+      return;
+    }
+  }
+}
+
+void
+S3FifoPolicy::evict(NodeIndex n)
+{
+  iterator victim = m_nodes[n].entry;
+  m_index.erase(&*victim);
+  this->releaseNode(n);
+  this->emitSignal(beforeEvict, victim);
+}
+
+void
+S3FifoPolicy::addGhost(size_t hash)
+{
+  if (this->getGhostLimit() == 0) {
+    return;
+  }
+
+  // a colliding hash is either the same name or indistinguishable from it: keep the newer ghost
+  m_ghostIndex[hash] = m_nGhostsAdded++;
+  m_ghosts.pushBack(hash);
+  this->trimGhosts();
+}
+
+void
+S3FifoPolicy::trimGhosts()
+{
+  size_t limit = this->getGhostLimit();
+
+  // slots of ghosts that were hit or superseded stay in the ring, so it is bounded separately
+  while (m_ghostIndex.size() > limit || m_ghosts.size() > 2 * limit) {
+    uint64_t sequence = m_nGhostsAdded - m_ghosts.size();
+    auto found = m_ghostIndex.find(m_ghosts.front());
+    if (found != m_ghostIndex.end() && found->second == sequence) {
+      m_ghostIndex.erase(found);
+    }
+    m_ghosts.popFront();
+  }
+}
+
+void
+S3FifoPolicy::compact(QueueId id)
+{
+  Ring<NodeIndex>& queue = m_queues[id];
+  for (size_t k = queue.size(); k > 0; --k) {
+    NodeIndex n = queue.front();
+    queue.popFront();
+    if (m_nodes[n].isErased) {
+      this->releaseNode(n);
+    }
+    else {
+      queue.pushBack(n);
+    }
+  }
+}
+
+size_t
+S3FifoPolicy::getSmallLimit() const
+{
+  return std::max<size_t>(this->getLimit() / 10, 1);
+}
+
+size_t
+S3FifoPolicy::getGhostLimit() const
+{
+  // as many names as the main queue can hold
+  return this->getLimit() - std::min(this->getSmallLimit(), this->getLimit());
+}
+
+size_t
+S3FifoPolicy::getHash(iterator i)
+{
+  // reuses the hashes cached on the Data by NameTree lookups in the forwarding pipeline
+  return name_tree::getHashes(i->getData()).back();
+}
+
+} // namespace s3fifo
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,280 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_S3FIFO_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_S3FIFO_HPP
+
+#include "cs-policy.hpp"
+
+#include <unordered_map>
+
+namespace nfd {
+namespace cs {
+namespace s3fifo {
+
+/** \brief a FIFO queue in a ring buffer whose capacity is a power of two
+ */
+template<typename T>
+class Ring
+{
+public:
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_slots.size();
+  }
+
+  /** \return the i-th element from the front
+   */
+  const T&
+  operator[](size_t i) const
+  {
+    return m_slots[(m_head + i) & (m_slots.size() - 1)];
+  }
+
+  const T&
+  front() const
+  {
+    BOOST_ASSERT(m_size > 0);
+    return m_slots[m_head];
+  }
+
+  void
+  pushBack(const T& value)
+  {
+    if (m_size == m_slots.size()) {
+      this->grow();
+    }
+    m_slots[(m_head + m_size) & (m_slots.size() - 1)] = value;
+    ++m_size;
+  }
+
+  void
+  popFront()
+  {
+    BOOST_ASSERT(m_size > 0);
+    m_head = (m_head + 1) & (m_slots.size() - 1);
+    --m_size;
+  }
+
+  void
+  clear()
+  {
+    m_slots.clear();
+    m_head = 0;
+    m_size = 0;
+  }
+
+private:
+  /** \brief doubles the capacity, moving elements to the beginning of the new buffer
+   */
+  void
+  grow()
+  {
+    std::vector<T> slots(std::max<size_t>(m_slots.size() * 2, 16));
+    for (size_t i = 0; i < m_size; ++i) {
+      slots[i] = (*this)[i];
+    }
+    m_slots.swap(slots);
+    m_head = 0;
+  }
+
+private:
+  std::vector<T> m_slots;
+  size_t m_head = 0;
+  size_t m_size = 0;
+};
+
+/** \brief S3-FIFO cs replacement policy
+ *
+ *  S3-FIFO (Yang et al., SOSP 2023) uses three FIFO queues. New entries enter the small
+ *  queue, which holds about 10% of the cache and filters out entries that are used only once.
+ *  Entries leaving the small queue move to the main queue if they were used more than once
+ *  since insertion, and are otherwise evicted and remembered in the ghost queue. A new entry
+ *  whose name is in the ghost queue goes directly to the main queue. The main queue evicts
+ *  like CLOCK: an entry that has been used since it was last considered is reinserted with a
+ *  decremented frequency. Frequencies are saturating 2-bit counters.
+ *
+ *  Queues are ring buffers of indices into a pool of nodes, so enqueuing, dequeuing, and
+ *  using an entry take constant time and do not allocate once the buffers have grown to their
+ *  working size. An entry erased by management is marked in its node and skipped when it
+ *  reaches the front of its queue. Ghosts store only the hash of the Data name, which the
+ *  forwarding pipeline has already computed for NameTree lookups.
+ */
+class S3FifoPolicy : public Policy
+{
+public:
+  S3FifoPolicy();
+
+public:
+  static const std::string POLICY_NAME;
+
+  /** \brief saturation value of the frequency counter
+   */
+  static const uint8_t MAX_FREQUENCY = 3;
+
+  enum QueueId : uint8_t {
+    SMALL,
+    MAIN,
+    N_QUEUES
+  };
+
+  /** \return number of cached entries on queue \p id
+   */
+  size_t
+  getQueueSize(QueueId id) const
+  {
+    return m_nQueued[id];
+  }
+
+  /** \return number of names remembered in the ghost queue
+   */
+  size_t
+  getGhostSize() const
+  {
+    return m_ghostIndex.size();
+  }
+
+private:
+  virtual void
+  doAfterInsert(iterator i) override;
+
+  virtual void
+  doAfterRefresh(iterator i) override;
+
+  virtual void
+  doBeforeErase(iterator i) override;
+
+  virtual void
+  doBeforeUse(iterator i) override;
+
+  virtual void
+  evictEntries() override;
+
+  virtual std::vector<iterator>
+  doListEntries() const override;
+
+  virtual Block
+  doSaveState() const override;
+
+  virtual bool
+  doLoadState(const Block& state, const SnapshotIndex& index) override;
+
+  virtual size_t
+  doGetMemoryUsage() const override;
+
+private:
+  typedef uint32_t NodeIndex;
+  static const NodeIndex NONE;
+
+  struct Node
+  {
+    iterator entry;
+    size_t hash;          ///< hash of the Data name
+    NodeIndex nextFree;
+    uint8_t frequency;
+    QueueId queue;
+    bool isErased;        ///< entry has been erased, node is waiting to be dequeued
+  };
+
+  NodeIndex
+  allocateNode();
+
+  void
+  releaseNode(NodeIndex n);
+
+  /** \brief adds entry \p i to the back of queue \p id
+   */
+  void
+  admit(QueueId id, iterator i, size_t hash, uint8_t frequency);
+
+  /** \brief evicts one entry, from the small queue if it is over its share of the cache
+   */
+  void
+  evictOne();
+
+  /** \brief dequeues from the small queue until an entry is evicted or the queue is empty
+   */
+  void
+  evictSmall();
+
+  /** \brief dequeues from the main queue until an entry is evicted
+   */
+  void
+  evictMain();
+
+  void
+  evict(NodeIndex n);
+
+  /** \brief remembers \p hash in the ghost queue, forgetting the oldest ghosts over the limit
+   */
+  void
+  addGhost(size_t hash);
+
+  /** \brief keeps the ghost queue within the size of the main queue
+   */
+  void
+  trimGhosts();
+
+  /** \brief drops erased nodes from queue \p id
+   */
+  void
+  compact(QueueId id);
+
+  size_t
+  getSmallLimit() const;
+
+  size_t
+  getGhostLimit() const;
+
+  static size_t
+  getHash(iterator i);
+
+private:
+  std::vector<Node> m_nodes;
+  NodeIndex m_freeList;
+  Ring<NodeIndex> m_queues[N_QUEUES];
+  size_t m_nQueued[N_QUEUES]; ///< number of nodes on each queue that are not erased
+  std::unordered_map<const Entry*, NodeIndex> m_index;
+
+  Ring<size_t> m_ghosts;                          ///< name hashes, oldest first
+  uint64_t m_nGhostsAdded;                        ///< sequence number of the next ghost
+  std::unordered_map<size_t, uint64_t> m_ghostIndex; ///< name hash => ghost sequence number
+};
+
+} // namespace s3fifo
+
+using s3fifo::S3FifoPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_S3FIFO_HPP
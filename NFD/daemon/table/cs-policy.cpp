@@ -60,7 +60,19 @@ Policy::getPolicyNames()
 
 Policy::Policy(const std::string& policyName)
   : m_policyName(policyName)
+  , m_limit(0)
+  , m_nEntries(0)
+  , m_evictionTarget(1.0)
+  , m_cs(nullptr)
 {
+  beforeEvict.connect([this] (iterator) {
+      BOOST_ASSERT(m_nEntries > 0);
+      --m_nEntries;
+    });
+  beforeEvictBatch.connect([this] (const std::vector<iterator>& victims) {
+      BOOST_ASSERT(m_nEntries >= victims.size());
+      m_nEntries -= victims.size();
+    });
 }
 
 void
@@ -71,10 +83,26 @@ Policy::setLimit(size_t nMaxEntries)
   this->evictEntries();
 }
 
+void
+Policy::setEvictionTarget(double fraction)
+{
+  BOOST_ASSERT(fraction > 0.0 && fraction <= 1.0);
+  NFD_LOG_INFO("setEvictionTarget " << fraction);
+  m_evictionTarget = fraction;
+}
+
+size_t
+Policy::getEvictionTargetSize() const
+{
+  size_t target = static_cast<size_t>(m_limit * m_evictionTarget);
+  return std::min(std::max<size_t>(target, 1), m_limit);
+}
+
 void
 Policy::afterInsert(iterator i)
 {
   BOOST_ASSERT(m_cs != nullptr);
+  ++m_nEntries;
   this->doAfterInsert(i);
 }
 
@@ -89,7 +117,9 @@ void
 Policy::beforeErase(iterator i)
 {
   BOOST_ASSERT(m_cs != nullptr);
+  BOOST_ASSERT(m_nEntries > 0);
   this->doBeforeErase(i);
+  --m_nEntries;
 }
 
 void
@@ -99,5 +129,92 @@ Policy::beforeUse(iterator i)
   this->doBeforeUse(i);
 }
 
+std::vector<iterator>
+Policy::listEntries() const
+{
+  return this->doListEntries();
+}
+
+void
+Policy::afterInsertBulk(const std::vector<iterator>& entries)
+{
+  BOOST_ASSERT(m_cs != nullptr);
+  NFD_LOG_DEBUG("afterInsertBulk " << entries.size());
+  m_nEntries += entries.size();
+  this->doAfterInsertBulk(entries);
+}
+
+std::vector<iterator>
+Policy::doListEntries() const
+{
+  return {};
+}
+
+void
+Policy::doAfterInsertBulk(const std::vector<iterator>& entries)
+{
+  for (iterator i : entries) {
+    this->doAfterInsert(i);
+  }
+}
+
+Block
+Policy::saveState() const
+{
+  return this->doSaveState();
+}
+
+bool
+Policy::loadState(const Block& state, const SnapshotIndex& index)
+{
+  BOOST_ASSERT(m_cs != nullptr);
+  if (state.type() != snapshot::tlv::PolicyState) {
+    return false;
+  }
+
+  state.parse();
+  if (!this->doLoadState(state, index)) {
+    return false;
+  }
+  m_nEntries += index.size();
+  return true;
+}
+
+Block
+Policy::doSaveState() const
+{
+  return Block();
+}
+
+bool
+Policy::doLoadState(const Block& state, const SnapshotIndex& index)
+{
+  return false;
+}
+
+bool
+Policy::needsRetrievalCost() const
+{
+  return this->doNeedsRetrievalCost();
+}
+
+bool
+Policy::doNeedsRetrievalCost() const
+{
+  return false;
+}
+
+size_t
+Policy::getMemoryUsage() const
+{
+  return this->doGetMemoryUsage();
+}
+
+size_t
+Policy::doGetMemoryUsage() const
+{
+  return 0;
+}
+
 } // namespace cs
 } // namespace nfd
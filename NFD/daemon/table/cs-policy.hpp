@@ -28,6 +28,7 @@
 
 #include "cs-internal.hpp"
 #include "cs-entry-impl.hpp"
+#include "cs-snapshot.hpp"
 
 namespace nfd {
 namespace cs {
@@ -77,9 +78,17 @@ public:
 
   /** \brief sets cs
    */
-  void
+  virtual void
   setCs(Cs *cs);
 
+  /** \brief gets number of entries managed by this policy
+   *
+   *  This equals cs.size() unless the policy manages a part of CS on behalf of
+   *  another policy, such as a partition of \c PartitionedPolicy.
+   */
+  size_t
+  size() const;
+
   /** \brief gets hard limit (in number of entries)
    */
   size_t
@@ -87,13 +96,29 @@ public:
 
   /** \brief sets hard limit (in number of entries)
    *  \post getLimit() == nMaxEntries
-   *  \post cs.size() <= getLimit()
+   *  \post size() <= getLimit()
    *
    *  The policy may evict entries if necessary.
    */
   virtual void
   setLimit(size_t nMaxEntries);
 
+  /** \brief gets eviction target, as a fraction of hard limit
+   */
+  double
+  getEvictionTarget() const;
+
+  /** \brief sets how far the policy evicts once size() exceeds hard limit
+   *  \param fraction fraction of hard limit to evict down to, in (0,1]; default 1
+   *
+   *  With a fraction below 1, each eviction selects several victims, which CS erases in one
+   *  pass upon a single \p beforeEvictBatch signal, so that insertions into a full CS do not
+   *  pay for an eviction each. At least one entry is kept.
+   *  A policy that does not use \p evictBatch always evicts down to hard limit.
+   */
+  virtual void
+  setEvictionTarget(double fraction);
+
   /** \brief emits when an entry is being evicted
    *
    *  A policy implementation should emit this signal to cause CS to erase the entry from its index.
@@ -101,8 +126,15 @@ public:
    */
   signal::Signal<Policy, iterator> beforeEvict;
 
+  /** \brief emits when several entries are being evicted
+   *
+   *  The entries have been removed from the cleanup index, and CS should erase them from
+   *  its index upon signal emission.
+   */
+  signal::Signal<Policy, std::vector<iterator>> beforeEvictBatch;
+
   /** \brief invoked by CS after a new entry is inserted
-   *  \post cs.size() <= getLimit()
+   *  \post size() <= getLimit()
    *
    *  The policy may evict entries if necessary.
    *  During this process, \p i might be evicted.
@@ -130,6 +162,59 @@ public:
   void
   beforeUse(iterator i);
 
+public: // migration
+  /** \brief lists entries known to the policy
+   *  \return entries ordered from the next to be evicted to the last to be evicted,
+   *          or an empty vector if the policy cannot tell
+   *
+   *  CS uses this order to replay existing entries into a new policy, so that entries
+   *  the old policy considered hot are also the most recent ones in the new policy.
+   */
+  std::vector<iterator>
+  listEntries() const;
+
+  /** \brief invoked by CS after existing entries are handed over from another policy
+   *  \param entries entries in CS that are unknown to the policy, coldest first
+   *  \post size() <= getLimit()
+   */
+  void
+  afterInsertBulk(const std::vector<iterator>& entries);
+
+public: // snapshot
+  /** \brief encodes replacement metadata of this policy
+   *  \return a PolicyState block, or an empty Block if the policy keeps no metadata
+   *          that cannot be rebuilt by replaying entries in Table order
+   */
+  Block
+  saveState() const;
+
+  /** \brief restores replacement metadata previously obtained from saveState()
+   *  \param state a PolicyState block
+   *  \param index Table entries restored from the same snapshot
+   *  \retval true the cleanup index has been rebuilt and covers every entry in \p index
+   *  \retval false \p state is not understood; the policy has not been modified
+   *  \pre every entry in \p index is in CS and unknown to the policy
+   */
+  bool
+  loadState(const Block& state, const SnapshotIndex& index);
+
+public: // capabilities
+  /** \brief tells whether the policy reads RetrievalCostTag on inserted Data
+   *
+   *  Forwarder measures the retrieval cost of incoming Data only if the CS policy needs it.
+   */
+  bool
+  needsRetrievalCost() const;
+
+public: // memory accounting
+  /** \return estimated bytes held by the cleanup index and other replacement metadata
+   *  \sa memory-usage.hpp
+   *
+   *  Stored entries and Data packets are reported by Cs::getMemoryUsage.
+   */
+  size_t
+  getMemoryUsage() const;
+
 protected:
   /** \brief invoked after a new entry is created in CS
    *
@@ -168,13 +253,93 @@ protected:
   doBeforeUse(iterator i) = 0;
 
   /** \brief evicts zero or more entries
-   *  \post CS size does not exceed hard limit
+   *  \post size() does not exceed hard limit
    */
   virtual void
   evictEntries() = 0;
 
+  /** \brief lists entries in eviction order
+   *
+   *  The default implementation returns an empty vector, which causes CS to replay
+   *  entries in Table order.
+   */
+  virtual std::vector<iterator>
+  doListEntries() const;
+
+  /** \brief inserts entries handed over from another policy
+   *
+   *  The default implementation invokes \p doAfterInsert on each entry.
+   *  A policy whose per-insertion cost depends on its size should override this method,
+   *  so that a migration costs O(n).
+   */
+  virtual void
+  doAfterInsertBulk(const std::vector<iterator>& entries);
+
+  /** \brief encodes replacement metadata
+   *
+   *  The default implementation returns an empty Block, which causes CS to replay
+   *  restored entries through \p doAfterInsert in Table order.
+   */
+  virtual Block
+  doSaveState() const;
+
+  /** \brief rebuilds the cleanup index from replacement metadata
+   *
+   *  The default implementation returns false.
+   */
+  virtual bool
+  doLoadState(const Block& state, const SnapshotIndex& index);
+
+  /** \brief tells whether the policy reads RetrievalCostTag on inserted Data
+   *
+   *  The default implementation returns false.
+   */
+  virtual bool
+  doNeedsRetrievalCost() const;
+
+  /** \brief estimates bytes held by replacement metadata
+   *
+   *  The default implementation returns 0, which means the policy does not report its usage.
+   */
+  virtual size_t
+  doGetMemoryUsage() const;
+
 protected:
   DECLARE_SIGNAL_EMIT(beforeEvict)
+  DECLARE_SIGNAL_EMIT(beforeEvictBatch)
+
+  /** \brief evicts entries down to the eviction target, if size() exceeds hard limit
+   *  \param popVictim a callable that removes the next entry to evict from the cleanup index,
+   *                   and returns it
+   *
+   *  A single victim is announced through \p beforeEvict; more victims are collected and
+   *  announced through one \p beforeEvictBatch.
+   */
+  template<typename F>
+  void
+  evictBatch(const F& popVictim)
+  {
+    if (m_nEntries <= m_limit) {
+      return;
+    }
+
+    size_t nVictims = m_nEntries - this->getEvictionTargetSize();
+    if (nVictims == 1) {
+      this->emitSignal(beforeEvict, popVictim());
+      return;
+    }
+
+    m_victims.clear();
+    for (size_t k = 0; k < nVictims; ++k) {
+      m_victims.push_back(popVictim());
+    }
+    this->emitSignal(beforeEvictBatch, m_victims);
+  }
+
+  /** \return number of entries to keep when size() exceeds hard limit
+   */
+  size_t
+  getEvictionTargetSize() const;
 
 private: // registry
   typedef std::function<unique_ptr<Policy>()> CreateFunc;
@@ -186,6 +351,9 @@ private: // registry
 private:
   std::string m_policyName;
   size_t m_limit;
+  size_t m_nEntries;
+  double m_evictionTarget;
+  std::vector<iterator> m_victims; ///< reused by evictBatch
   Cs* m_cs;
 };
 
@@ -207,12 +375,24 @@ Policy::setCs(Cs *cs)
   m_cs = cs;
 }
 
+inline size_t
+Policy::size() const
+{
+  return m_nEntries;
+}
+
 inline size_t
 Policy::getLimit() const
 {
   return m_limit;
 }
 
+inline double
+Policy::getEvictionTarget() const
+{
+  return m_evictionTarget;
+}
+
 } // namespace cs
 } // namespace nfd
 
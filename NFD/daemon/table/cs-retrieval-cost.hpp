@@ -0,0 +1,58 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_RETRIEVAL_COST_HPP
+#define NFD_DAEMON_TABLE_CS_RETRIEVAL_COST_HPP
+
+#include "core/common.hpp"
+
+#include <ndn-cxx/tag.hpp>
+
+namespace nfd {
+namespace cs {
+
+/** \brief how expensive it was to retrieve a Data packet from upstream
+ *
+ *  The forwarder attaches a RetrievalCostTag to Data before inserting it into the CS, so that
+ *  cost-aware replacement policies can keep content that would be expensive to fetch again.
+ */
+struct RetrievalCost
+{
+  /** \brief hops traveled from the producer or the upstream cache that satisfied the Interest
+   */
+  uint64_t hopCount = 0;
+
+  /** \brief time from forwarding the Interest upstream until the Data arrived,
+   *         negative if unknown (e.g., unsolicited Data)
+   */
+  time::nanoseconds latency = time::nanoseconds(-1);
+};
+
+typedef ndn::SimpleTag<RetrievalCost, 0x60000100> RetrievalCostTag;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_RETRIEVAL_COST_HPP
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-snapshot.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/endian.hpp>
+
+#include <cstring>
+
+namespace nfd {
+namespace cs {
+namespace snapshot {
+
+using ndn::encoding::makeBinaryBlock;
+using ndn::encoding::makeNonNegativeIntegerBlock;
+using ndn::encoding::readNonNegativeInteger;
+
+static_assert(sizeof(double) == sizeof(uint64_t), "snapshot format requires 64-bit double");
+
+Block
+makeRealBlock(uint32_t type, double value)
+{
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  bits = htobe64(bits);
+  return makeBinaryBlock(type, reinterpret_cast<const uint8_t*>(&bits), sizeof(bits));
+}
+
+double
+readReal(const Block& block)
+{
+  uint64_t bits = 0;
+  if (block.value_size() != sizeof(bits)) {
+    BOOST_THROW_EXCEPTION(ndn::tlv::Error("Real value must be 8 octets"));
+  }
+  std::memcpy(&bits, block.value(), sizeof(bits));
+  bits = be64toh(bits);
+
+  double value = 0;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+Record::Record(const Block& wire)
+{
+  this->wireDecode(wire);
+}
+
+Block
+Record::wireEncode() const
+{
+  Block wire(tlv::Record);
+  wire.push_back(makeNonNegativeIntegerBlock(tlv::Section, section));
+  wire.push_back(name.wireEncode());
+  for (double value : values) {
+    wire.push_back(makeRealBlock(tlv::RealValue, value));
+  }
+  wire.encode();
+  return wire;
+}
+
+void
+Record::wireDecode(const Block& wire)
+{
+  if (wire.type() != tlv::Record) {
+    BOOST_THROW_EXCEPTION(ndn::tlv::Error("expecting Record"));
+  }
+  wire.parse();
+
+  auto element = wire.elements_begin();
+  if (element == wire.elements_end() || element->type() != tlv::Section) {
+    BOOST_THROW_EXCEPTION(ndn::tlv::Error("Record is missing Section"));
+  }
+  section = readNonNegativeInteger(*element);
+
+  ++element;
+  if (element == wire.elements_end() || element->type() != ndn::tlv::Name) {
+    BOOST_THROW_EXCEPTION(ndn::tlv::Error("Record is missing Name"));
+  }
+  name.wireDecode(*element);
+
+  values.clear();
+  for (++element; element != wire.elements_end(); ++element) {
+    if (element->type() == tlv::RealValue) {
+      values.push_back(readReal(*element));
+    }
+  }
+}
+
+} // namespace snapshot
+} // namespace cs
+} // namespace nfd
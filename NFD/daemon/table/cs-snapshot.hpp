@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \file
+ *  \brief declares the on-disk format of ContentStore snapshots
+ *
+ *  A snapshot is a sequence of TLV elements:
+ *
+ *      Snapshot = Header *Entry [PolicyState]
+ *      Header = HEADER-TYPE TLV-LENGTH Version PolicyName Limit
+ *      Entry = ENTRY-TYPE TLV-LENGTH [Unsolicited] Data
+ *      PolicyState = POLICY-STATE-TYPE TLV-LENGTH *Parameter *Record
+ *      Record = RECORD-TYPE TLV-LENGTH Section Name *RealValue
+ *
+ *  Entries appear in Table order. PolicyState is opaque to the Cs; each policy decides
+ *  which parameters and records it needs to rebuild its cleanup index.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_SNAPSHOT_HPP
+#define NFD_DAEMON_TABLE_CS_SNAPSHOT_HPP
+
+#include "cs-internal.hpp"
+
+namespace nfd {
+namespace cs {
+namespace snapshot {
+
+namespace tlv {
+
+enum : uint32_t {
+  Header      = 200,
+  Version     = 201,
+  PolicyName  = 202,
+  Limit       = 203,
+  Entry       = 204,
+  Unsolicited = 205,
+  PolicyState = 206,
+  Parameter   = 207,
+  Record      = 208,
+  Section     = 209,
+  RealValue   = 210
+};
+
+} // namespace tlv
+
+/** \brief current snapshot format version
+ */
+const uint64_t VERSION = 1;
+
+/** \brief encodes \p value as a RealValue-like element of type \p type
+ *
+ *  The value is stored as an 8-octet IEEE 754 double in network byte order.
+ */
+Block
+makeRealBlock(uint32_t type, double value);
+
+/** \brief decodes a double encoded by makeRealBlock
+ *  \throw ndn::tlv::Error TLV-LENGTH is not 8
+ */
+double
+readReal(const Block& block);
+
+/** \brief one line of replacement-policy metadata
+ *
+ *  A record associates a Data name with a section (which queue or stack of the policy
+ *  it belongs to) and a list of numeric attributes. Records are written in the order
+ *  the policy needs to replay them.
+ */
+class Record
+{
+public:
+  Record() = default;
+
+  Record(uint64_t section, const Name& name, std::vector<double> values = {})
+    : section(section)
+    , name(name)
+    , values(std::move(values))
+  {
+  }
+
+  explicit
+  Record(const Block& wire);
+
+  Block
+  wireEncode() const;
+
+  void
+  wireDecode(const Block& wire);
+
+public:
+  uint64_t section = 0;
+  Name name;
+  std::vector<double> values;
+};
+
+} // namespace snapshot
+
+/** \brief maps Data names restored from a snapshot to their Table entries
+ */
+typedef std::map<Name, iterator> SnapshotIndex;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_SNAPSHOT_HPP
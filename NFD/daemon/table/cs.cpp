@@ -26,10 +26,15 @@
 #include "cs.hpp"
 #include "core/algorithm.hpp"
 #include "core/logger.hpp"
+#include "fw/pipeline-profiler.hpp"
+#include "memory-usage.hpp"
 
+#include <ndn-cxx/encoding/block-helpers.hpp>
 #include <ndn-cxx/lp/tags.hpp>
 #include <ndn-cxx/util/concepts.hpp>
 
+#include <iterator>
+
 namespace nfd {
 namespace cs {
 
@@ -59,6 +64,7 @@ makeDefaultPolicy()
 Cs::Cs(size_t nMaxPackets)
   : m_shouldAdmit(true)
   , m_shouldServe(true)
+  , m_profiler(nullptr)
 {
   this->setPolicyImpl(makeDefaultPolicy());
   m_policy->setLimit(nMaxPackets);
@@ -94,9 +100,11 @@ Cs::insert(const Data& data, bool isUnsolicited)
       entry.unsetUnsolicited();
     }
 
+    PipelineProfiler::ScopedTimer timer(m_profiler, PipelineStage::POLICY_AFTER_REFRESH);
     m_policy->afterRefresh(it);
   }
   else {
+    PipelineProfiler::ScopedTimer timer(m_profiler, PipelineStage::POLICY_AFTER_INSERT);
     m_policy->afterInsert(it);
   }
   NFD_LOG_DEBUG("CS Size: " << m_policy->getCs()->size());
@@ -115,7 +123,10 @@ Cs::erase(const Name& prefix, size_t limit, const AfterEraseCallback& cb)
 
   size_t nErased = 0;
   while (first != last && nErased < limit) {
-    m_policy->beforeErase(first);
+    {
+      PipelineProfiler::ScopedTimer timer(m_profiler, PipelineStage::POLICY_BEFORE_ERASE);
+      m_policy->beforeErase(first);
+    }
     first = m_table.erase(first);
     ++nErased;
   }
@@ -125,6 +136,18 @@ Cs::erase(const Name& prefix, size_t limit, const AfterEraseCallback& cb)
   }
 }
 
+size_t
+Cs::getMemoryUsage() const
+{
+  using namespace memory_usage;
+
+  size_t usage = 0;
+  for (const EntryImpl& entry : m_table) {
+    usage += sizeof(EntryImpl) + TREE_NODE_OVERHEAD + getPacketSize(entry.getData());
+  }
+  return usage;
+}
+
 void
 Cs::find(const Interest& interest,
          const HitCallback& hitCallback,
@@ -233,7 +256,10 @@ Cs::find(const Interest& interest,
   }
     
   // NFD_LOG_DEBUG("  matching " << match->getName());
-  m_policy->beforeUse(match);
+  {
+    PipelineProfiler::ScopedTimer timer(m_profiler, PipelineStage::POLICY_BEFORE_USE);
+    m_policy->beforeUse(match);
+  }
   hitCallback(interest, match->getData());
 }
 
@@ -296,8 +322,29 @@ Cs::setPolicy(unique_ptr<Policy> policy)
   BOOST_ASSERT(policy != nullptr);
   BOOST_ASSERT(m_policy != nullptr);
   size_t limit = m_policy->getLimit();
+  double evictionTarget = m_policy->getEvictionTarget();
+
+  std::vector<iterator> entries;
+  if (!m_table.empty()) {
+    entries = m_policy->listEntries();
+    if (entries.size() != m_table.size()) {
+      NFD_LOG_DEBUG("set-policy " << m_policy->getName() << " cannot list entries, using Table order");
+      entries.clear();
+      entries.reserve(m_table.size());
+      for (iterator it = m_table.begin(); it != m_table.end(); ++it) {
+        entries.push_back(it);
+      }
+    }
+  }
+
   this->setPolicyImpl(std::move(policy));
+  m_policy->setEvictionTarget(evictionTarget);
   m_policy->setLimit(limit);
+
+  if (!entries.empty()) {
+    NFD_LOG_DEBUG("set-policy migrating " << entries.size() << " entries");
+    m_policy->afterInsertBulk(entries);
+  }
 }
 
 void
@@ -308,11 +355,166 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
   m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (iterator it) {
       m_table.erase(it);
     });
+  m_beforeEvictBatchConnection = m_policy->beforeEvictBatch.connect(
+    [this] (const std::vector<iterator>& victims) {
+      for (iterator it : victims) {
+        m_table.erase(it);
+      }
+    });
 
   m_policy->setCs(this);
   BOOST_ASSERT(m_policy->getCs() == this);
 }
 
+static void
+writeBlock(std::ostream& os, const Block& block)
+{
+  os.write(reinterpret_cast<const char*>(block.wire()), block.size());
+}
+
+void
+Cs::saveSnapshot(std::ostream& os) const
+{
+  using namespace snapshot;
+  using ndn::encoding::makeNonNegativeIntegerBlock;
+
+  Block header(tlv::Header);
+  header.push_back(makeNonNegativeIntegerBlock(tlv::Version, VERSION));
+  header.push_back(ndn::encoding::makeStringBlock(tlv::PolicyName, m_policy->getName()));
+  header.push_back(makeNonNegativeIntegerBlock(tlv::Limit, m_policy->getLimit()));
+  header.encode();
+  writeBlock(os, header);
+
+  for (const EntryImpl& entry : m_table) {
+    Block element(tlv::Entry);
+    if (entry.isUnsolicited()) {
+      element.push_back(ndn::encoding::makeEmptyBlock(tlv::Unsolicited));
+    }
+    element.push_back(entry.getData().wireEncode());
+    element.encode();
+    writeBlock(os, element);
+  }
+
+  Block state = m_policy->saveState();
+  if (!state.empty()) {
+    writeBlock(os, state);
+  }
+
+  NFD_LOG_DEBUG("save-snapshot entries=" << m_table.size() << " policy=" << m_policy->getName()
+                << (state.empty() ? "" : " with-state"));
+}
+
+size_t
+Cs::loadSnapshot(std::istream& is)
+{
+  using namespace snapshot;
+  BOOST_ASSERT(m_table.empty());
+
+  auto buffer = make_shared<ndn::Buffer>(std::istreambuf_iterator<char>(is),
+                                         std::istreambuf_iterator<char>());
+
+  std::string policyName;
+  uint64_t limit = 0;
+  std::vector<std::pair<shared_ptr<Data>, bool>> entries;
+  Block state;
+
+  for (size_t offset = 0; offset < buffer->size();) {
+    bool isOk = false;
+    Block element;
+    std::tie(isOk, element) = Block::fromBuffer(buffer, offset);
+    if (!isOk) {
+      BOOST_THROW_EXCEPTION(ndn::tlv::Error("truncated CS snapshot"));
+    }
+    offset += element.size();
+
+    switch (element.type()) {
+      case tlv::Header: {
+        element.parse();
+        auto version = element.find(tlv::Version);
+        if (version == element.elements_end() ||
+            ndn::encoding::readNonNegativeInteger(*version) != VERSION) {
+          BOOST_THROW_EXCEPTION(ndn::tlv::Error("unsupported CS snapshot version"));
+        }
+        auto name = element.find(tlv::PolicyName);
+        if (name != element.elements_end()) {
+          policyName = ndn::encoding::readString(*name);
+        }
+        auto limitElement = element.find(tlv::Limit);
+        if (limitElement != element.elements_end()) {
+          limit = ndn::encoding::readNonNegativeInteger(*limitElement);
+        }
+        break;
+      }
+      case tlv::Entry: {
+        element.parse();
+        auto dataElement = element.find(ndn::tlv::Data);
+        if (dataElement == element.elements_end()) {
+          BOOST_THROW_EXCEPTION(ndn::tlv::Error("CS snapshot entry is missing Data"));
+        }
+        // copy the Data out of the file buffer, so that it does not pin the whole snapshot
+        auto data = make_shared<Data>(Block(dataElement->wire(), dataElement->size()));
+        bool isUnsolicited = element.find(tlv::Unsolicited) != element.elements_end();
+        entries.emplace_back(data, isUnsolicited);
+        break;
+      }
+      case tlv::PolicyState:
+        state = element;
+        break;
+      default:
+        // unknown elements are ignored for forward compatibility
+        break;
+    }
+  }
+
+  bool canLoadState = !state.empty() && policyName == m_policy->getName() &&
+                      limit == m_policy->getLimit() && entries.size() <= m_policy->getLimit();
+  if (!canLoadState) {
+    // insert entries one by one, so that the policy may evict as it would during the run
+    for (const auto& entry : entries) {
+      iterator it;
+      bool isNewEntry = false;
+      std::tie(it, isNewEntry) = m_table.emplace(entry.first, entry.second);
+      if (isNewEntry) {
+        const_cast<EntryImpl&>(*it).updateStaleTime();
+        m_policy->afterInsert(it);
+      }
+    }
+    NFD_LOG_DEBUG("load-snapshot entries=" << m_table.size() << " replayed");
+  }
+  else {
+    std::vector<iterator> restored;
+    SnapshotIndex index;
+    bool hasUniqueNames = true;
+    for (const auto& entry : entries) {
+      iterator it;
+      bool isNewEntry = false;
+      std::tie(it, isNewEntry) = m_table.emplace(entry.first, entry.second);
+      if (isNewEntry) {
+        const_cast<EntryImpl&>(*it).updateStaleTime();
+        restored.push_back(it);
+        // policy records are keyed by Name
+        hasUniqueNames = index.emplace(it->getName(), it).second && hasUniqueNames;
+      }
+    }
+
+    if (hasUniqueNames && m_policy->loadState(state, index)) {
+      NFD_LOG_DEBUG("load-snapshot entries=" << m_table.size() << " with-state");
+    }
+    else {
+      // size() <= getLimit(), so no entry is evicted during the replay
+      for (iterator it : restored) {
+        m_policy->afterInsert(it);
+      }
+      NFD_LOG_DEBUG("load-snapshot entries=" << m_table.size() << " replayed");
+    }
+  }
+
+  if (!m_table.empty()) {
+    flag = true;
+  }
+  return m_table.size();
+}
+
 void
 Cs::enableAdmit(bool shouldAdmit)
 {
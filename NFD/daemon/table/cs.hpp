@@ -33,6 +33,9 @@
 #include <boost/iterator/transform_iterator.hpp>
 
 namespace nfd {
+
+class PipelineProfiler;
+
 namespace cs {
 
 /** \brief implements the Content Store
@@ -90,6 +93,14 @@ public:
     return m_table.size();
   }
 
+  /** \return estimated bytes held by stored entries and Data packets
+   *  \sa memory-usage.hpp
+   *
+   *  Metadata of the replacement policy is reported by Policy::getMemoryUsage.
+   */
+  size_t
+  getMemoryUsage() const;
+
 public: // configuration
   /** \brief get capacity (in number of packets)
    */
@@ -107,6 +118,23 @@ public: // configuration
     return m_policy->setLimit(nMaxPackets);
   }
 
+  /** \brief get the fraction of capacity that a full CS evicts down to
+   */
+  double
+  getEvictionTarget() const
+  {
+    return m_policy->getEvictionTarget();
+  }
+
+  /** \brief change the fraction of capacity that a full CS evicts down to
+   *  \sa Policy::setEvictionTarget
+   */
+  void
+  setEvictionTarget(double fraction)
+  {
+    m_policy->setEvictionTarget(fraction);
+  }
+
   /** \brief get replacement policy
    */
   Policy*
@@ -116,7 +144,11 @@ public: // configuration
   }
 
   /** \brief change replacement policy
-   *  \pre size() == 0
+   *
+   *  Existing entries are handed over to the new policy, ordered from the coldest to the
+   *  hottest as reported by the old policy's Policy::listEntries. If the old policy cannot
+   *  list its entries, they are handed over in Table order.
+   *  The capacity and the eviction target are kept unchanged.
    */
   void
   setPolicy(unique_ptr<Policy> policy);
@@ -151,6 +183,44 @@ public: // configuration
   void
   enableServe(bool shouldServe);
 
+  /** \brief get the profiler that times replacement policy callbacks
+   *  \return the profiler, or nullptr if none is set
+   */
+  PipelineProfiler*
+  getProfiler() const
+  {
+    return m_profiler;
+  }
+
+  /** \brief set the profiler that times replacement policy callbacks
+   *  \param profiler a profiler that outlives this Content Store, or nullptr
+   */
+  void
+  setProfiler(PipelineProfiler* profiler)
+  {
+    m_profiler = profiler;
+  }
+
+public: // snapshot
+  /** \brief writes stored Data packets and replacement-policy metadata to \p os
+   *  \sa cs-snapshot.hpp for the format
+   */
+  void
+  saveSnapshot(std::ostream& os) const;
+
+  /** \brief restores entries written by saveSnapshot()
+   *  \pre size() == 0
+   *  \throw ndn::tlv::Error the snapshot is malformed
+   *  \return number of restored entries
+   *
+   *  Policy metadata is restored when the snapshot was written by the same policy with the
+   *  same limit. Otherwise, entries are inserted into the current policy in Table order,
+   *  and the policy may evict some of them.
+   *  A restored CS is considered warmed up by the hit ratio counters.
+   */
+  size_t
+  loadSnapshot(std::istream& is);
+
 public: // enumeration
   struct EntryFromEntryImpl
   {
@@ -209,9 +279,11 @@ private:
   Table m_table;
   unique_ptr<Policy> m_policy;
   signal::ScopedConnection m_beforeEvictConnection;
+  signal::ScopedConnection m_beforeEvictBatchConnection;
 
   bool m_shouldAdmit; ///< if false, no Data will be admitted
   bool m_shouldServe; ///< if false, all lookups will miss
+  PipelineProfiler* m_profiler;
   
   // mutable bool flag = false;
   // mutable double hitRateRatio = 0;
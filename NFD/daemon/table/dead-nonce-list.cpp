@@ -26,6 +26,7 @@
 #include "dead-nonce-list.hpp"
 #include "core/city-hash.hpp"
 #include "core/logger.hpp"
+#include "memory-usage.hpp"
 
 NFD_LOG_INIT("DeadNonceList");
 
@@ -86,27 +87,49 @@ DeadNonceList::size() const
   return m_queue.size() - this->countMarks();
 }
 
+size_t
+DeadNonceList::getMemoryUsage() const
+{
+  using namespace memory_usage;
+
+  return m_index.size() * (sizeof(Entry) + LIST_NODE_OVERHEAD + HASH_NODE_OVERHEAD) +
+         m_ht.bucket_count() * sizeof(void*) +
+         m_actualMarkCounts.size() * (sizeof(size_t) + TREE_NODE_OVERHEAD);
+}
+
 bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
-  Entry entry = DeadNonceList::makeEntry(name, nonce);
+  return this->has(name_tree::computeHash(name), nonce);
+}
+
+bool
+DeadNonceList::has(name_tree::HashValue nameHash, uint32_t nonce) const
+{
+  Entry entry = DeadNonceList::makeEntry(nameHash, nonce);
   return m_ht.find(entry) != m_ht.end();
 }
 
 void
 DeadNonceList::add(const Name& name, uint32_t nonce)
 {
-  Entry entry = DeadNonceList::makeEntry(name, nonce);
+  this->add(name_tree::computeHash(name), nonce);
+}
+
+void
+DeadNonceList::add(name_tree::HashValue nameHash, uint32_t nonce)
+{
+  Entry entry = DeadNonceList::makeEntry(nameHash, nonce);
   m_queue.push_back(entry);
 
   this->evictEntries();
 }
 
 DeadNonceList::Entry
-DeadNonceList::makeEntry(const Name& name, uint32_t nonce)
+DeadNonceList::makeEntry(name_tree::HashValue nameHash, uint32_t nonce)
 {
-  Block nameWire = name.wireEncode();
-  return CityHash64WithSeed(reinterpret_cast<const char*>(nameWire.wire()), nameWire.size(),
+  uint64_t h = static_cast<uint64_t>(nameHash);
+  return CityHash64WithSeed(reinterpret_cast<const char*>(&h), sizeof(h),
                             static_cast<uint64_t>(nonce));
 }
 
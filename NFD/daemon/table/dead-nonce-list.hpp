@@ -27,6 +27,7 @@
 #define NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
 
 #include "core/common.hpp"
+#include "name-tree-hashtable.hpp"
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index/hashed_index.hpp>
@@ -41,6 +42,8 @@ namespace nfd {
  *  Dead Nonce List, and kept for a duration in which most loops are expected to have occured.
  *
  *  To reduce memory usage, the Interest Name and Nonce are stored as a 64-bit hash.
+ *  The hash is derived from the NameTree hash of the Interest Name, so that a caller holding
+ *  the cached hashes of a packet (see name_tree::getHashes) does not need to hash the Name again.
  *  There could be false positives (non-looping Interest could be considered looping),
  *  but the probability is small, and the error is recoverable when consumer retransmits
  *  with a different Nonce.
@@ -72,17 +75,38 @@ public:
   bool
   has(const Name& name, uint32_t nonce) const;
 
+  /** \brief determines if name+nonce exists
+   *  \param nameHash name_tree::computeHash(name)
+   *  \param nonce the Nonce
+   *  \return true if name+nonce exists
+   */
+  bool
+  has(name_tree::HashValue nameHash, uint32_t nonce) const;
+
   /** \brief records name+nonce
    */
   void
   add(const Name& name, uint32_t nonce);
 
+  /** \brief records name+nonce
+   *  \param nameHash name_tree::computeHash(name)
+   *  \param nonce the Nonce
+   */
+  void
+  add(name_tree::HashValue nameHash, uint32_t nonce);
+
   /** \return number of stored Nonces
    *  \note The return value does not contain non-Nonce entries in the index, if any.
    */
   size_t
   size() const;
 
+  /** \return estimated bytes held by the index, including MARK entries
+   *  \sa memory-usage.hpp
+   */
+  size_t
+  getMemoryUsage() const;
+
   /** \return expected lifetime
    */
   const time::nanoseconds&
@@ -92,7 +116,7 @@ private: // Entry and Index
   typedef uint64_t Entry;
 
   static Entry
-  makeEntry(const Name& name, uint32_t nonce);
+  makeEntry(name_tree::HashValue nameHash, uint32_t nonce);
 
   typedef boost::multi_index_container<
     Entry,
@@ -26,6 +26,7 @@
 #include "fib.hpp"
 #include "pit-entry.hpp"
 #include "measurements-entry.hpp"
+#include "memory-usage.hpp"
 
 #include <ndn-cxx/util/concepts.hpp>
 
@@ -144,6 +145,17 @@ Fib::removeNextHop(Entry& entry, const Face& face)
   }
 }
 
+size_t
+Fib::getMemoryUsage() const
+{
+  size_t usage = 0;
+  for (const Entry& entry : *this) {
+    usage += sizeof(Entry) + memory_usage::getHeapSize(entry.getPrefix()) +
+             entry.getNextHops().capacity() * sizeof(NextHop);
+  }
+  return usage;
+}
+
 Fib::Range
 Fib::getRange() const
 {
@@ -58,6 +58,12 @@ public:
     return m_nItems;
   }
 
+  /** \return estimated bytes held by FIB entries and their next hops
+   *  \sa memory-usage.hpp
+   */
+  size_t
+  getMemoryUsage() const;
+
 public: // lookup
   /** \brief performs a longest prefix match
    */
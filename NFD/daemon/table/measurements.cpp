@@ -27,6 +27,7 @@
 #include "name-tree.hpp"
 #include "pit-entry.hpp"
 #include "fib-entry.hpp"
+#include "memory-usage.hpp"
 
 namespace nfd {
 namespace measurements {
@@ -140,6 +141,20 @@ Measurements::extendLifetime(Entry& entry, const time::nanoseconds& lifetime)
   entry.m_cleanup = scheduler::schedule(lifetime, bind(&Measurements::cleanup, this, ref(entry)));
 }
 
+size_t
+Measurements::getMemoryUsage() const
+{
+  auto hasMeasurementsEntry = [] (const name_tree::Entry& nte) {
+    return nte.getMeasurementsEntry() != nullptr;
+  };
+
+  size_t usage = 0;
+  for (const name_tree::Entry& nte : m_nameTree.fullEnumerate(hasMeasurementsEntry)) {
+    usage += sizeof(Entry) + memory_usage::getHeapSize(nte.getMeasurementsEntry()->getName());
+  }
+  return usage;
+}
+
 void
 Measurements::cleanup(Entry& entry)
 {
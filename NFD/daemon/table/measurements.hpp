@@ -146,6 +146,12 @@ public:
   size_t
   size() const;
 
+  /** \return estimated bytes held by Measurements entries and their strategy info
+   *  \sa memory-usage.hpp
+   */
+  size_t
+  getMemoryUsage() const;
+
 private:
   void
   cleanup(Entry& entry);
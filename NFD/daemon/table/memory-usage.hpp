@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_MEMORY_USAGE_HPP
+#define NFD_DAEMON_TABLE_MEMORY_USAGE_HPP
+
+#include "core/common.hpp"
+
+namespace nfd {
+
+/** \brief estimates of memory held by table entries
+ *
+ *  Tables report their memory usage as the sum of the sizes of their objects, plus the
+ *  bookkeeping that standard containers typically allocate with each element. The figures
+ *  ignore allocator rounding, and are meant for finding out which table to shrink, not for
+ *  reconciling with the resident set size of the process.
+ */
+namespace memory_usage {
+
+/** \brief pointers in each node of std::list and boost::multi_index sequenced index
+ */
+constexpr size_t LIST_NODE_OVERHEAD = 2 * sizeof(void*);
+
+/** \brief pointers and color in each node of std::map, std::set, and ordered index
+ */
+constexpr size_t TREE_NODE_OVERHEAD = 4 * sizeof(void*);
+
+/** \brief pointers in each node of a hashed container, excluding the bucket array
+ */
+constexpr size_t HASH_NODE_OVERHEAD = 2 * sizeof(void*);
+
+/** \brief control block allocated together with an object by make_shared
+ */
+constexpr size_t SHARED_PTR_OVERHEAD = 2 * sizeof(void*);
+
+/** \return bytes that \p name holds outside of sizeof(Name)
+ *
+ *  The wire encoding is counted only if the Name owns its buffer; a Name decoded from a packet
+ *  shares the buffer of the packet.
+ */
+size_t
+getHeapSize(const Name& name);
+
+/** \return bytes that \p name holds outside of sizeof(CompactName)
+ */
+inline size_t
+getHeapSize(const CompactName& name)
+{
+  return name.getAllocatedSize();
+}
+
+/** \return bytes of a packet held by shared_ptr, including its wire encoding
+ *  \tparam Packet Interest or Data
+ */
+template<typename Packet>
+size_t
+getPacketSize(const Packet& packet)
+{
+  return sizeof(Packet) + SHARED_PTR_OVERHEAD + (packet.hasWire() ? packet.wireEncode().size() : 0);
+}
+
+} // namespace memory_usage
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_MEMORY_USAGE_HPP
@@ -26,6 +26,13 @@
 #include "name-tree-hashtable.hpp"
 #include "core/logger.hpp"
 #include "core/city-hash.hpp"
+#include "memory-usage.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 namespace nfd {
 namespace name_tree {
@@ -115,8 +122,236 @@ HashtableOptions::HashtableOptions(size_t size)
 {
 }
 
+namespace {
+
+/** \brief tag of a slot that has never been used since the index was created
+ */
+const uint8_t TAG_EMPTY = 0x80;
+
+/** \brief tag of a slot whose node has been erased or migrated
+ *
+ *  A probe sequence continues past a deleted slot, but stops at a group with an empty slot.
+ */
+const uint8_t TAG_DELETED = 0xFE;
+
+/** \brief tag of a slot with a node, taken from the 7 highest bits of the hash value
+ *
+ *  Tags of used slots have the high bit cleared, while TAG_EMPTY and TAG_DELETED have it set.
+ */
+uint8_t
+computeTag(HashValue h)
+{
+  return static_cast<uint8_t>(h >> (std::numeric_limits<HashValue>::digits - 7));
+}
+
+/** \brief a bitmask with bit i set if slot i of a group matches
+ */
+using GroupMask = uint32_t;
+
+#if defined(__SSE2__)
+
+GroupMask
+matchTag(const uint8_t* group, uint8_t tag)
+{
+  __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+  return static_cast<GroupMask>(_mm_movemask_epi8(
+           _mm_cmpeq_epi8(tags, _mm_set1_epi8(static_cast<char>(tag)))));
+}
+
+GroupMask
+matchFree(const uint8_t* group)
+{
+  __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+  return static_cast<GroupMask>(_mm_movemask_epi8(tags));
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+GroupMask
+toGroupMask(uint8x16_t matches)
+{
+  static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t masked = vandq_u8(matches, vld1q_u8(bits));
+  return static_cast<GroupMask>(vaddv_u8(vget_low_u8(masked))) |
+         (static_cast<GroupMask>(vaddv_u8(vget_high_u8(masked))) << 8);
+}
+
+GroupMask
+matchTag(const uint8_t* group, uint8_t tag)
+{
+  return toGroupMask(vceqq_u8(vld1q_u8(group), vdupq_n_u8(tag)));
+}
+
+GroupMask
+matchFree(const uint8_t* group)
+{
+  return toGroupMask(vtstq_u8(vld1q_u8(group), vdupq_n_u8(0x80)));
+}
+
+#else
+
+GroupMask
+matchTag(const uint8_t* group, uint8_t tag)
+{
+  GroupMask mask = 0;
+  for (size_t i = 0; i < 16; ++i) {
+    mask |= static_cast<GroupMask>(group[i] == tag) << i;
+  }
+  return mask;
+}
+
+GroupMask
+matchFree(const uint8_t* group)
+{
+  GroupMask mask = 0;
+  for (size_t i = 0; i < 16; ++i) {
+    mask |= static_cast<GroupMask>(group[i] >> 7) << i;
+  }
+  return mask;
+}
+
+#endif
+
+/** \brief pop the lowest set bit of a GroupMask
+ *  \pre mask != 0
+ *  \return index of that bit
+ */
+size_t
+popLowest(GroupMask& mask)
+{
+  size_t i = static_cast<size_t>(__builtin_ctz(mask));
+  mask &= mask - 1;
+  return i;
+}
+
+/** \brief maximum (used + deleted) / slots ratio of an OPEN_ADDRESSING index
+ *
+ *  This guarantees every probe sequence ends at a group with an empty slot.
+ */
+const float MAX_OPEN_LOAD_FACTOR = 0.875;
+
+/** \brief how many slots are migrated on each insertion or deletion while resizing
+ *
+ *  Under default options, a new index of nSlots is not due for resizing again until nSlots/4
+ *  insertions after an expansion, or nSlots/20 deletions after a shrink, so migration finishes
+ *  in time. If it does not under custom options, the remaining slots are migrated at once.
+ */
+const size_t MIGRATE_STEP = 4 * 16;
+
+/** \return number of slots in an OPEN_ADDRESSING index that has at least \p n slots
+ */
+size_t
+roundSlots(size_t n)
+{
+  size_t nSlots = 16;
+  while (nSlots < n) {
+    nSlots <<= 1;
+  }
+  return nSlots;
+}
+
+} // namespace
+
+Hashtable::SlotIndex::SlotIndex(size_t nGroups)
+  : nDeleted(0)
+  , m_tags(nGroups * GROUP_SIZE, TAG_EMPTY)
+  , m_nodes(nGroups * GROUP_SIZE, nullptr)
+{
+  BOOST_ASSERT((nGroups & (nGroups - 1)) == 0);
+}
+
+const Node*
+Hashtable::SlotIndex::find(const Name& name, size_t prefixLen, HashValue h) const
+{
+  size_t nGroups = m_nodes.size() / GROUP_SIZE;
+  uint8_t tag = computeTag(h);
+
+  // triangular probing visits every group once when nGroups is a power of two
+  for (size_t i = 0, group = h & (nGroups - 1); i < nGroups; group = (group + ++i) & (nGroups - 1)) {
+    size_t offset = group * GROUP_SIZE;
+    for (GroupMask mask = matchTag(&m_tags[offset], tag); mask != 0;) {
+      const Node* node = m_nodes[offset + popLowest(mask)];
+      if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
+        return node;
+      }
+    }
+    if (matchTag(&m_tags[offset], TAG_EMPTY) != 0) {
+      break;
+    }
+  }
+  return nullptr;
+}
+
+void
+Hashtable::SlotIndex::insert(Node* node)
+{
+  size_t nGroups = m_nodes.size() / GROUP_SIZE;
+
+  for (size_t i = 0, group = node->hash & (nGroups - 1); i < nGroups;
+       group = (group + ++i) & (nGroups - 1)) {
+    size_t offset = group * GROUP_SIZE;
+    GroupMask mask = matchFree(&m_tags[offset]);
+    if (mask != 0) {
+      size_t slot = offset + popLowest(mask);
+      if (m_tags[slot] == TAG_DELETED) {
+        --nDeleted;
+      }
+      m_tags[slot] = computeTag(node->hash);
+      m_nodes[slot] = node;
+      return;
+    }
+  }
+  BOOST_ASSERT_MSG(false, "OPEN_ADDRESSING index is full");
+}
+
+bool
+Hashtable::SlotIndex::erase(const Node* node)
+{
+  size_t nGroups = m_nodes.size() / GROUP_SIZE;
+  uint8_t tag = computeTag(node->hash);
+
+  for (size_t i = 0, group = node->hash & (nGroups - 1); i < nGroups;
+       group = (group + ++i) & (nGroups - 1)) {
+    size_t offset = group * GROUP_SIZE;
+    bool hasEmpty = matchTag(&m_tags[offset], TAG_EMPTY) != 0;
+    for (GroupMask mask = matchTag(&m_tags[offset], tag); mask != 0;) {
+      size_t slot = offset + popLowest(mask);
+      if (m_nodes[slot] == node) {
+        // no probe sequence continues past a group with an empty slot
+        if (hasEmpty) {
+          m_tags[slot] = TAG_EMPTY;
+        }
+        else {
+          m_tags[slot] = TAG_DELETED;
+          ++nDeleted;
+        }
+        m_nodes[slot] = nullptr;
+        return true;
+      }
+    }
+    if (hasEmpty) {
+      break;
+    }
+  }
+  return false;
+}
+
+Node*
+Hashtable::SlotIndex::release(size_t slot)
+{
+  Node* node = m_nodes[slot];
+  if (node != nullptr) {
+    m_tags[slot] = TAG_DELETED;
+    m_nodes[slot] = nullptr;
+    ++nDeleted;
+  }
+  return node;
+}
+
 Hashtable::Hashtable(const Options& options)
-  : m_options(options)
+  : m_migratePos(0)
+  , m_head(nullptr)
+  , m_options(options)
   , m_size(0)
 {
   BOOST_ASSERT(m_options.minSize > 0);
@@ -129,18 +364,71 @@ Hashtable::Hashtable(const Options& options)
   BOOST_ASSERT(m_options.shrinkFactor > 0.0);
   BOOST_ASSERT(m_options.shrinkFactor < 1.0);
 
-  m_buckets.resize(options.initialSize);
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    m_buckets.resize(options.initialSize);
+  }
+  else {
+    m_index = SlotIndex(roundSlots(options.initialSize) / SlotIndex::GROUP_SIZE);
+  }
   this->computeThresholds();
 }
 
 Hashtable::~Hashtable()
 {
+  auto deleteNode = [] (Node* node) {
+    node->prev = node->next = nullptr;
+    delete node;
+  };
+
   for (size_t i = 0; i < m_buckets.size(); ++i) {
-    foreachNode(m_buckets[i], [] (Node* node) {
-      node->prev = node->next = nullptr;
-      delete node;
-    });
+    foreachNode(m_buckets[i], deleteNode);
+  }
+  foreachNode(m_head, deleteNode);
+}
+
+const Node*
+Hashtable::getFirst() const
+{
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    return m_head;
+  }
+
+  for (const Node* head : m_buckets) {
+    if (head != nullptr) {
+      return head;
+    }
   }
+  return nullptr;
+}
+
+const Node*
+Hashtable::getNext(const Node* node) const
+{
+  if (node->next != nullptr || m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    return node->next;
+  }
+
+  for (size_t bucket = this->computeBucketIndex(node->hash) + 1; bucket < m_buckets.size(); ++bucket) {
+    if (m_buckets[bucket] != nullptr) {
+      return m_buckets[bucket];
+    }
+  }
+  return nullptr;
+}
+
+size_t
+Hashtable::getMemoryUsage() const
+{
+  size_t usage = m_buckets.capacity() * sizeof(Node*) +
+                 m_index.getMemoryUsage() + m_oldIndex.getMemoryUsage();
+
+  for (const Node* node = this->getFirst(); node != nullptr; node = this->getNext(node)) {
+    const Entry& entry = node->entry;
+    usage += sizeof(Node) + memory_usage::getHeapSize(entry.getName()) +
+             entry.getChildren().capacity() * sizeof(Entry*) +
+             entry.getPitEntries().capacity() * sizeof(shared_ptr<pit::Entry>);
+  }
+  return usage;
 }
 
 void
@@ -180,6 +468,31 @@ Hashtable::detach(size_t bucket, Node* node)
 std::pair<const Node*, bool>
 Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
 {
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    const Node* found = m_index.find(name, prefixLen, h);
+    if (found == nullptr && m_oldIndex.getNSlots() > 0) {
+      found = m_oldIndex.find(name, prefixLen, h);
+    }
+    if (found != nullptr || !allowInsert) {
+      NFD_LOG_TRACE((found == nullptr ? "not-found " : "found ") << name.getPrefix(prefixLen) <<
+                    " hash=" << h);
+      return {found, false};
+    }
+
+    Node* node = new Node(h, name.getPrefix(prefixLen));
+    m_index.insert(node);
+    node->next = m_head;
+    if (m_head != nullptr) {
+      m_head->prev = node;
+    }
+    m_head = node;
+    NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h);
+    ++m_size;
+
+    this->adjustIndex();
+    return {node, true};
+  }
+
   size_t bucket = this->computeBucketIndex(h);
 
   for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
@@ -233,6 +546,31 @@ Hashtable::erase(Node* node)
   BOOST_ASSERT(node != nullptr);
   BOOST_ASSERT(node->entry.getParent() == nullptr);
 
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash);
+    if (!m_index.erase(node)) {
+      bool isErased = m_oldIndex.getNSlots() > 0 && m_oldIndex.erase(node);
+      BOOST_VERIFY(isErased);
+    }
+
+    if (node->prev != nullptr) {
+      node->prev->next = node->next;
+    }
+    else {
+      BOOST_ASSERT(m_head == node);
+      m_head = node->next;
+    }
+    if (node->next != nullptr) {
+      node->next->prev = node->prev;
+    }
+    node->prev = node->next = nullptr;
+    delete node;
+    --m_size;
+
+    this->adjustIndex();
+    return;
+  }
+
   size_t bucket = this->computeBucketIndex(node->hash);
   NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
 
@@ -250,7 +588,11 @@ Hashtable::erase(Node* node)
 void
 Hashtable::computeThresholds()
 {
-  m_expandThreshold = static_cast<size_t>(m_options.expandLoadFactor * this->getNBuckets());
+  float expandLoadFactor = m_options.expandLoadFactor;
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    expandLoadFactor = std::min(expandLoadFactor, MAX_OPEN_LOAD_FACTOR);
+  }
+  m_expandThreshold = static_cast<size_t>(expandLoadFactor * this->getNBuckets());
   m_shrinkThreshold = static_cast<size_t>(m_options.shrinkLoadFactor * this->getNBuckets());
   NFD_LOG_TRACE("thresholds expand=" << m_expandThreshold << " shrink=" << m_shrinkThreshold);
 }
@@ -258,6 +600,20 @@ Hashtable::computeThresholds()
 void
 Hashtable::resize(size_t newNBuckets)
 {
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    // an index of the same size is rebuilt to discard deleted slots
+    NFD_LOG_DEBUG("resize from=" << this->getNBuckets() << " to=" << newNBuckets);
+
+    // finish the previous migration, so that there are at most two indices at a time
+    this->migrate(m_oldIndex.getNSlots());
+
+    m_oldIndex = std::move(m_index);
+    m_index = SlotIndex(newNBuckets / SlotIndex::GROUP_SIZE);
+    m_migratePos = 0;
+    this->computeThresholds();
+    return;
+  }
+
   if (this->getNBuckets() == newNBuckets) {
     return;
   }
@@ -277,5 +633,55 @@ Hashtable::resize(size_t newNBuckets)
   this->computeThresholds();
 }
 
+void
+Hashtable::migrate(size_t nSlots)
+{
+  size_t end = std::min(m_oldIndex.getNSlots(), m_migratePos + nSlots);
+  for (; m_migratePos < end; ++m_migratePos) {
+    Node* node = m_oldIndex.release(m_migratePos);
+    if (node != nullptr) {
+      m_index.insert(node);
+    }
+  }
+
+  if (m_migratePos == m_oldIndex.getNSlots()) {
+    m_oldIndex = SlotIndex();
+    m_migratePos = 0;
+  }
+}
+
+void
+Hashtable::adjustIndex()
+{
+  if (m_oldIndex.getNSlots() > 0) {
+    this->migrate(MIGRATE_STEP);
+  }
+
+  size_t nSlots = this->getNBuckets();
+  size_t newNSlots = nSlots;
+  bool isShrink = false;
+  if (m_size > m_expandThreshold) {
+    newNSlots = roundSlots(std::max(nSlots + 1, static_cast<size_t>(m_options.expandFactor * nSlots)));
+  }
+  else if (m_size < m_shrinkThreshold) {
+    newNSlots = std::max(roundSlots(m_options.minSize),
+                         std::min(nSlots / 2, roundSlots(static_cast<size_t>(m_options.shrinkFactor * nSlots))));
+    isShrink = true;
+  }
+  else if (m_size + m_index.nDeleted <= m_expandThreshold) {
+    return;
+  }
+
+  // the new index must not be due for expansion
+  float expandLoadFactor = std::min(m_options.expandLoadFactor, MAX_OPEN_LOAD_FACTOR);
+  while (m_size > static_cast<size_t>(expandLoadFactor * newNSlots)) {
+    newNSlots <<= 1;
+  }
+  if (isShrink && newNSlots >= nSlots) {
+    return;
+  }
+  this->resize(newNSlots);
+}
+
 } // namespace name_tree
 } // namespace nfd
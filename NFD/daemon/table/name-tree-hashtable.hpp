@@ -53,10 +53,76 @@ computeHash(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::ma
 HashSequence
 computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
 
+/** \brief a packet tag that caches the hash sequence of the packet name
+ *  \sa getHashes
+ *
+ *  The tag keeps a reference to the Name wire encoding the hashes were computed from.
+ *  If the packet name is changed afterwards, its wire encoding lives in a different buffer,
+ *  and the cached hashes are recognized as stale.
+ */
+class HashSequenceTag : public ndn::Tag
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 0x60000001;
+  }
+
+  HashSequenceTag(const Block& nameWire, HashSequence hashes)
+    : m_nameWire(nameWire)
+    , m_hashes(std::move(hashes))
+  {
+  }
+
+  /** \return whether the hashes were computed from \p nameWire
+   */
+  bool
+  isFor(const Block& nameWire) const
+  {
+    return m_nameWire.wire() == nameWire.wire() && m_nameWire.size() == nameWire.size();
+  }
+
+  const HashSequence&
+  get() const
+  {
+    return m_hashes;
+  }
+
+private:
+  Block m_nameWire;
+  HashSequence m_hashes;
+};
+
+/** \brief computes hash values for each prefix of the name of \p packet, at most once
+ *  \tparam Packet Interest or Data
+ *  \return a hash sequence that equals computeHashes(packet.getName())
+ *
+ *  The hash sequence is cached in a HashSequenceTag on the packet, so that NameTree lookups
+ *  and DeadNonceList queries made for the same packet in different pipeline stages share a
+ *  single computation. The returned reference is valid until the tag is replaced.
+ */
+template<typename Packet>
+const HashSequence&
+getHashes(const Packet& packet)
+{
+  const Name& name = packet.getName();
+  const Block& nameWire = name.wireEncode();
+
+  shared_ptr<HashSequenceTag> tag = packet.template getTag<HashSequenceTag>();
+  if (tag == nullptr || !tag->isFor(nameWire)) {
+    tag = make_shared<HashSequenceTag>(nameWire, computeHashes(name));
+    packet.setTag(tag);
+  }
+  return tag->get();
+}
+
 /** \brief a hashtable node
  *
- *  Zero or more nodes can be added to a hashtable bucket. They are organized as
- *  a doubly linked list through prev and next pointers.
+ *  In HashtableLayout::CHAINED, zero or more nodes can be added to a hashtable bucket.
+ *  They are organized as a doubly linked list through prev and next pointers.
+ *  In HashtableLayout::OPEN_ADDRESSING, every node occupies a slot, and all nodes are
+ *  organized as a single doubly linked list that defines the enumeration order.
  */
 class Node : noncopyable
 {
@@ -101,6 +167,23 @@ foreachNode(N* head, const F& func)
   }
 }
 
+/** \brief indicates how Hashtable resolves hash collisions
+ */
+enum class HashtableLayout {
+  /** \brief each bucket is a doubly linked list of nodes
+   */
+  CHAINED,
+
+  /** \brief nodes are placed in an array of slots, organized in groups of 16
+   *
+   *  Each slot has a 1-byte tag taken from the high bits of the hash value. A lookup compares
+   *  the tags of a whole group at once (with SSE2 or NEON where available), and dereferences
+   *  only the nodes whose tag matches. The number of slots is a power of two, and resizing
+   *  migrates a few groups per insertion or deletion instead of rehashing all nodes at once.
+   */
+  OPEN_ADDRESSING
+};
+
 /** \brief provides options for Hashtable
  */
 class HashtableOptions
@@ -114,7 +197,14 @@ public:
   HashtableOptions(size_t size = 16);
 
 public:
+  /** \brief collision resolution strategy
+   */
+  HashtableLayout layout = HashtableLayout::CHAINED;
+
   /** \brief initial number of buckets
+   *
+   *  In HashtableLayout::OPEN_ADDRESSING, this and other bucket counts are rounded up to
+   *  a power of two no less than 16, and expandLoadFactor is capped at 0.875.
    */
   size_t initialSize;
 
@@ -143,7 +233,8 @@ public:
  *
  *  The Hashtable contains a number of buckets.
  *  Each node is placed into a bucket determined by a hash value computed from its name.
- *  Hash collision is resolved through a doubly linked list in each bucket.
+ *  Hash collision is resolved either through a doubly linked list in each bucket,
+ *  or through open addressing, as selected by HashtableOptions::layout.
  *  The number of buckets is adjusted according to how many nodes are stored.
  */
 class Hashtable
@@ -166,15 +257,16 @@ public:
     return m_size;
   }
 
-  /** \return number of buckets
+  /** \return number of buckets, or number of slots in HashtableLayout::OPEN_ADDRESSING
    */
   size_t
   getNBuckets() const
   {
-    return m_buckets.size();
+    return m_options.layout == HashtableLayout::CHAINED ? m_buckets.size() : m_index.getNSlots();
   }
 
   /** \return bucket index for hash value h
+   *  \pre layout is HashtableLayout::CHAINED
    */
   size_t
   computeBucketIndex(HashValue h) const
@@ -183,15 +275,39 @@ public:
   }
 
   /** \return i-th bucket
+   *  \pre layout is HashtableLayout::CHAINED
    *  \pre bucket < getNBuckets()
    */
   const Node*
   getBucket(size_t bucket) const
   {
+    BOOST_ASSERT(m_options.layout == HashtableLayout::CHAINED);
     BOOST_ASSERT(bucket < this->getNBuckets());
     return m_buckets[bucket]; // don't use m_bucket.at() for better performance
   }
 
+  /** \return first node in enumeration order, or nullptr if hashtable is empty
+   */
+  const Node*
+  getFirst() const;
+
+  /** \return node after \p node in enumeration order, or nullptr if \p node is the last
+   *  \pre node exists in this hashtable
+   *
+   *  Inserting or deleting other nodes does not cause a node to be enumerated twice,
+   *  unless the CHAINED table is resized.
+   */
+  const Node*
+  getNext(const Node* node) const;
+
+  /** \return estimated bytes held by buckets or slots, nodes, and name tree entries
+   *  \sa memory-usage.hpp
+   *
+   *  Table entries attached to name tree entries are not included.
+   */
+  size_t
+  getMemoryUsage() const;
+
   /** \brief find node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
    */
@@ -200,14 +316,14 @@ public:
 
   /** \brief find node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
-   *  \pre hashes == computeHashes(name)
+   *  \pre hashes == computeHashes(name, n), where n >= prefixLen
    */
   const Node*
   find(const Name& name, size_t prefixLen, const HashSequence& hashes) const;
 
   /** \brief find or insert node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
-   *  \pre hashes == computeHashes(name)
+   *  \pre hashes == computeHashes(name, n), where n >= prefixLen
    */
   std::pair<const Node*, bool>
   insert(const Name& name, size_t prefixLen, const HashSequence& hashes);
@@ -219,6 +335,59 @@ public:
   erase(Node* node);
 
 private:
+  /** \brief slots and tags of HashtableLayout::OPEN_ADDRESSING
+   */
+  class SlotIndex
+  {
+  public:
+    /** \brief number of slots in a group, which are probed together
+     */
+    static constexpr size_t GROUP_SIZE = 16;
+
+    explicit
+    SlotIndex(size_t nGroups = 0);
+
+    size_t
+    getNSlots() const
+    {
+      return m_nodes.size();
+    }
+
+    const Node*
+    find(const Name& name, size_t prefixLen, HashValue h) const;
+
+    /** \pre no node with the same name exists in this index
+     */
+    void
+    insert(Node* node);
+
+    /** \return whether node was found and removed
+     */
+    bool
+    erase(const Node* node);
+
+    /** \brief remove node at slot without compacting the probe sequence
+     *  \return the removed node, or nullptr if the slot is free
+     */
+    Node*
+    release(size_t slot);
+
+    size_t
+    getMemoryUsage() const
+    {
+      return m_tags.capacity() * sizeof(uint8_t) + m_nodes.capacity() * sizeof(Node*);
+    }
+
+  public:
+    /** \brief number of slots marked as deleted, which lengthen probe sequences
+     */
+    size_t nDeleted;
+
+  private:
+    std::vector<uint8_t> m_tags;
+    std::vector<Node*> m_nodes;
+  };
+
   /** \brief attach node to bucket
    */
   void
@@ -238,8 +407,22 @@ private:
   void
   resize(size_t newNBuckets);
 
+  /** \brief move up to \p nSlots slots from m_oldIndex to m_index
+   */
+  void
+  migrate(size_t nSlots);
+
+  /** \brief start resizing or compacting the OPEN_ADDRESSING index if it's due
+   */
+  void
+  adjustIndex();
+
 private:
-  std::vector<Node*> m_buckets;
+  std::vector<Node*> m_buckets; ///< CHAINED buckets
+  SlotIndex m_index;            ///< OPEN_ADDRESSING index
+  SlotIndex m_oldIndex;         ///< OPEN_ADDRESSING index being migrated into m_index
+  size_t m_migratePos;          ///< next slot of m_oldIndex to migrate
+  Node* m_head;                 ///< OPEN_ADDRESSING list of all nodes
   Options m_options;
   size_t m_size;
   size_t m_expandThreshold;
@@ -114,43 +114,14 @@ FullEnumerationImpl::FullEnumerationImpl(const NameTree& nt, const EntrySelector
 void
 FullEnumerationImpl::advance(Iterator& i)
 {
-  // find first entry
-  if (i.m_entry == nullptr) {
-    for (size_t bucket = 0; bucket < ht.getNBuckets(); ++bucket) {
-      const Node* node = ht.getBucket(bucket);
-      if (node != nullptr) {
-        i.m_entry = &node->entry;
-        break;
-      }
-    }
-    if (i.m_entry == nullptr) { // empty enumerable
-      i = Iterator();
-      return;
-    }
-    if (m_pred(*i.m_entry)) { // visit first entry
-      return;
-    }
-  }
-
-  // process entries in same bucket
-  for (const Node* node = getNode(*i.m_entry)->next; node != nullptr; node = node->next) {
+  const Node* node = i.m_entry == nullptr ? ht.getFirst() : ht.getNext(getNode(*i.m_entry));
+  for (; node != nullptr; node = ht.getNext(node)) {
     if (m_pred(node->entry)) {
       i.m_entry = &node->entry;
       return;
     }
   }
 
-  // process other buckets
-  size_t currentBucket = ht.computeBucketIndex(getNode(*i.m_entry)->hash);
-  for (size_t bucket = currentBucket + 1; bucket < ht.getNBuckets(); ++bucket) {
-    for (const Node* node = ht.getBucket(bucket); node != nullptr; node = node->next) {
-      if (m_pred(node->entry)) {
-        i.m_entry = &node->entry;
-        return;
-      }
-    }
-  }
-
   // reach the end
   i = Iterator();
 }
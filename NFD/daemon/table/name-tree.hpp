@@ -41,6 +41,9 @@ public:
   explicit
   NameTree(size_t nBuckets = 1024);
 
+  explicit
+  NameTree(const HashtableOptions& options);
+
 public: // information
   /** \brief maximum depth of the name tree
    *
@@ -71,6 +74,15 @@ public: // information
     return m_ht.getNBuckets();
   }
 
+  /** \return estimated bytes held by the hashtable and name tree entries
+   *  \sa Hashtable::getMemoryUsage
+   */
+  size_t
+  getMemoryUsage() const
+  {
+    return m_ht.getMemoryUsage();
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    */
@@ -94,6 +106,13 @@ public: // mutation
   Entry&
   lookup(const Name& name, size_t prefixLen);
 
+  /** \brief equivalent to `lookup(name, prefixLen)`, with precomputed hashes
+   *  \pre hashes == computeHashes(name, n), where n >= prefixLen
+   *  \sa getHashes
+   */
+  Entry&
+  lookup(const Name& name, size_t prefixLen, const HashSequence& hashes);
+
   /** \brief equivalent to `lookup(name, name.size())`
    */
   Entry&
@@ -151,6 +170,13 @@ public: // matching
   Entry*
   findExactMatch(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max()) const;
 
+  /** \brief equivalent to `findExactMatch(name, prefixLen)`, with precomputed hashes
+   *  \pre hashes == computeHashes(name, n), where n >= std::min(name.size(), prefixLen)
+   *  \sa getHashes
+   */
+  Entry*
+  findExactMatch(const Name& name, size_t prefixLen, const HashSequence& hashes) const;
+
   /** \brief longest prefix matching
    *  \return entry whose name is a prefix of \p name and passes \p entrySelector,
    *          where no other entry with a longer name satisfies those requirements;
@@ -160,6 +186,14 @@ public: // matching
   findLongestPrefixMatch(const Name& name,
                          const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief equivalent to `findLongestPrefixMatch(name, entrySelector)`, with precomputed hashes
+   *  \pre hashes == computeHashes(name, n), where n >= std::min(name.size(), getMaxDepth())
+   *  \sa getHashes
+   */
+  Entry*
+  findLongestPrefixMatch(const Name& name, const HashSequence& hashes,
+                         const EntrySelector& entrySelector = AnyEntry()) const;
+
   /** \brief equivalent to `findLongestPrefixMatch(entry.getName(), entrySelector)`
    *  \note This overload is more efficient than
    *        `findLongestPrefixMatch(const Name&, const EntrySelector&)` in common cases.
@@ -216,6 +250,14 @@ public: // matching
   findAllMatches(const Name& name,
                  const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief equivalent to `findAllMatches(name, entrySelector)`, with precomputed hashes
+   *  \pre hashes == computeHashes(name, n), where n >= std::min(name.size(), getMaxDepth())
+   *  \sa getHashes
+   */
+  Range
+  findAllMatches(const Name& name, const HashSequence& hashes,
+                 const EntrySelector& entrySelector = AnyEntry()) const;
+
 public: // enumeration
   using const_iterator = Iterator;
 
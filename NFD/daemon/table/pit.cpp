@@ -24,6 +24,7 @@
  */
 
 #include "pit.hpp"
+#include "memory-usage.hpp"
 
 namespace nfd {
 namespace pit {
@@ -49,13 +50,16 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
   size_t nteDepth = name.size() - static_cast<int>(hasDigest);
   nteDepth = std::min(nteDepth, NameTree::getMaxDepth());
 
+  // hashes are cached on the Interest and reused by other tables
+  const name_tree::HashSequence& hashes = name_tree::getHashes(interest);
+
   // ensure NameTree entry exists
   name_tree::Entry* nte = nullptr;
   if (allowInsert) {
-    nte = &m_nameTree.lookup(name, nteDepth);
+    nte = &m_nameTree.lookup(name, nteDepth, hashes);
   }
   else {
-    nte = m_nameTree.findExactMatch(name, nteDepth);
+    nte = m_nameTree.findExactMatch(name, nteDepth, hashes);
     if (nte == nullptr) {
       return {nullptr, true};
     }
@@ -86,7 +90,8 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
 DataMatchResult
 Pit::findAllDataMatches(const Data& data) const
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), &nteHasPitEntries);
+  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), name_tree::getHashes(data),
+                                               &nteHasPitEntries);
 
   DataMatchResult matches;
   for (const name_tree::Entry& nte : ntMatches) {
@@ -129,5 +134,27 @@ Pit::begin() const
   return const_iterator(m_nameTree.fullEnumerate(&nteHasPitEntries).begin());
 }
 
+size_t
+Pit::getMemoryUsage() const
+{
+  using namespace memory_usage;
+
+  size_t usage = 0;
+  for (const Entry& entry : *this) {
+    const Interest& interest = entry.getInterest();
+    usage += sizeof(Entry) + SHARED_PTR_OVERHEAD + getPacketSize(interest);
+
+    for (const InRecord& inRecord : entry.getInRecords()) {
+      usage += sizeof(InRecord) + LIST_NODE_OVERHEAD;
+      // the in-record of the first downstream usually keeps the same Interest as the entry
+      if (&inRecord.getInterest() != &interest) {
+        usage += getPacketSize(inRecord.getInterest());
+      }
+    }
+    usage += entry.getOutRecords().size() * (sizeof(OutRecord) + LIST_NODE_OVERHEAD);
+  }
+  return usage;
+}
+
 } // namespace pit
 } // namespace nfd
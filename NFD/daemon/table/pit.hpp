@@ -58,6 +58,13 @@ public:
     return m_nItems;
   }
 
+  /** \return estimated bytes held by PIT entries, their in-records and out-records,
+   *          and the Interests they keep
+   *  \sa memory-usage.hpp
+   */
+  size_t
+  getMemoryUsage() const;
+
   /** \brief finds a PIT entry for Interest
    *  \param interest the Interest
    *  \return an existing entry with same Name and Selectors; otherwise nullptr
@@ -30,7 +30,71 @@ namespace nfd {
 void
 StrategyInfoHost::clearStrategyInfo()
 {
-  m_items.clear();
+  m_more.reset();
+  m_first.info.reset();
+}
+
+fw::StrategyInfo*
+StrategyInfoHost::findMore(int typeId) const
+{
+  for (const Item& item : *m_more) {
+    if (item.typeId == typeId) {
+      return item.info.get();
+    }
+  }
+  return nullptr;
+}
+
+void
+StrategyInfoHost::insert(int typeId, unique_ptr<fw::StrategyInfo> info)
+{
+  BOOST_ASSERT(this->find(typeId) == nullptr);
+
+  if (m_first.info == nullptr) {
+    m_first.typeId = typeId;
+    m_first.info = std::move(info);
+    return;
+  }
+
+  if (m_more == nullptr) {
+    m_more = make_unique<std::vector<Item>>();
+  }
+  m_more->push_back({typeId, std::move(info)});
+}
+
+size_t
+StrategyInfoHost::erase(int typeId)
+{
+  if (m_first.info != nullptr && m_first.typeId == typeId) {
+    if (m_more == nullptr) {
+      m_first.info.reset();
+    }
+    else {
+      m_first = std::move(m_more->back());
+      m_more->pop_back();
+      if (m_more->empty()) {
+        m_more.reset();
+      }
+    }
+    return 1;
+  }
+
+  if (m_more == nullptr) {
+    return 0;
+  }
+
+  auto it = std::find_if(m_more->begin(), m_more->end(),
+                         [typeId] (const Item& item) { return item.typeId == typeId; });
+  if (it == m_more->end()) {
+    return 0;
+  }
+
+  *it = std::move(m_more->back());
+  m_more->pop_back();
+  if (m_more->empty()) {
+    m_more.reset();
+  }
+  return 1;
 }
 
 } // namespace nfd
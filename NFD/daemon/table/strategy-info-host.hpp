@@ -31,6 +31,10 @@
 namespace nfd {
 
 /** \brief base class for an entity onto which StrategyInfo items may be placed
+ *
+ *  A host usually carries items of a single strategy, so the first item is kept inline
+ *  and looked up with one comparison against the compile-time type identifier.
+ *  Further items go into a vector that is allocated only when needed.
  */
 class StrategyInfoHost
 {
@@ -46,11 +50,7 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    auto it = m_items.find(T::getTypeId());
-    if (it == m_items.end()) {
-      return nullptr;
-    }
-    return static_cast<T*>(it->second.get());
+    return static_cast<T*>(this->find(T::getTypeId()));
   }
 
   /** \brief insert a StrategyInfo item
@@ -65,12 +65,15 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    unique_ptr<fw::StrategyInfo>& item = m_items[T::getTypeId()];
-    bool isNew = (item == nullptr);
-    if (isNew) {
-      item.reset(new T(std::forward<A>(args)...));
+    fw::StrategyInfo* existing = this->find(T::getTypeId());
+    if (existing != nullptr) {
+      return {static_cast<T*>(existing), false};
     }
-    return {static_cast<T*>(item.get()), isNew};
+
+    unique_ptr<T> item(new T(std::forward<A>(args)...));
+    T* itemPtr = item.get();
+    this->insert(T::getTypeId(), std::move(item));
+    return {itemPtr, true};
   }
 
   /** \brief erase a StrategyInfo item
@@ -84,7 +87,7 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    return m_items.erase(T::getTypeId());
+    return this->erase(T::getTypeId());
   }
 
   /** \brief clear all StrategyInfo items
@@ -93,7 +96,35 @@ public:
   clearStrategyInfo();
 
 private:
-  std::unordered_map<int, unique_ptr<fw::StrategyInfo>> m_items;
+  fw::StrategyInfo*
+  find(int typeId) const
+  {
+    if (m_first.info != nullptr && m_first.typeId == typeId) {
+      return m_first.info.get();
+    }
+    return m_more == nullptr ? nullptr : this->findMore(typeId);
+  }
+
+  fw::StrategyInfo*
+  findMore(int typeId) const;
+
+  /** \pre find(typeId) == nullptr
+   */
+  void
+  insert(int typeId, unique_ptr<fw::StrategyInfo> info);
+
+  size_t
+  erase(int typeId);
+
+private:
+  struct Item
+  {
+    int typeId;
+    unique_ptr<fw::StrategyInfo> info;
+  };
+
+  Item m_first{0, nullptr}; ///< empty if info is nullptr
+  unique_ptr<std::vector<Item>> m_more; ///< non-empty only if m_first is occupied
 };
 
 } // namespace nfd
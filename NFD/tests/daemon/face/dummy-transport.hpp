@@ -48,6 +48,7 @@ public:
                  ssize_t sendQueueCapacity = QUEUE_UNSUPPORTED)
     : isClosed(false)
     , m_sendQueueLength(0)
+    , m_sendQueueSojournTime(QUEUE_UNSUPPORTED)
   {
     this->setLocalUri(FaceUri(localUri));
     this->setRemoteUri(FaceUri(remoteUri));
@@ -82,6 +83,18 @@ public:
     m_sendQueueLength = sendQueueLength;
   }
 
+  time::nanoseconds
+  getSendQueueSojournTime() override
+  {
+    return m_sendQueueSojournTime;
+  }
+
+  void
+  setSendQueueSojournTime(time::nanoseconds sojournTime)
+  {
+    m_sendQueueSojournTime = sojournTime;
+  }
+
   void
   receivePacket(Packet&& packet)
   {
@@ -121,6 +134,7 @@ public:
 
 private:
   ssize_t m_sendQueueLength;
+  time::nanoseconds m_sendQueueSojournTime;
 };
 
 } // namespace tests
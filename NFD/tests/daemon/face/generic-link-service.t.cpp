@@ -25,6 +25,7 @@
 
 #include "face/generic-link-service.hpp"
 #include "face/face.hpp"
+#include "table/name-tree-hashtable.hpp"
 
 #include "dummy-transport.hpp"
 #include "tests/test-common.hpp"
@@ -158,6 +159,60 @@ BOOST_AUTO_TEST_CASE(SendNack)
   BOOST_CHECK(!nack1pkt.has<lp::SequenceField>());
 }
 
+BOOST_AUTO_TEST_CASE(SendBareInterest)
+{
+  GenericLinkService::Options options;
+  options.allowBarePackets = true;
+  initialize(options);
+
+  shared_ptr<Interest> interest1 = makeInterest("/localhost/test");
+
+  face->sendInterest(*interest1);
+
+  BOOST_CHECK_EQUAL(service->getCounters().nOutInterests, 1);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(transport->sentPackets.back().packet, interest1->wireEncode());
+
+  // HopCount requires LpPacket header
+  interest1->setTag(make_shared<lp::HopCountTag>(1));
+  face->sendInterest(*interest1);
+
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 2);
+  lp::Packet interest1pkt;
+  BOOST_REQUIRE_NO_THROW(interest1pkt.wireDecode(transport->sentPackets.back().packet));
+  BOOST_CHECK_EQUAL(interest1pkt.get<lp::HopCountTagField>(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(SendBareData)
+{
+  GenericLinkService::Options options;
+  options.allowFragmentation = true;
+  options.allowBarePackets = true;
+  initialize(options);
+
+  transport->setMtu(105);
+
+  shared_ptr<Data> data1 = makeData("/test/data/123456789/987654321/123456789");
+
+  face->sendData(*data1);
+
+  BOOST_CHECK_EQUAL(service->getCounters().nOutData, 1);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(transport->sentPackets.back().packet, data1->wireEncode());
+
+  // packet over MTU is fragmented
+  shared_ptr<Data> data2 = makeData("/test/data/123456789/987654321/123456789");
+  data2->setContent(make_shared<ndn::Buffer>(500));
+  signData(data2);
+
+  face->sendData(*data2);
+
+  BOOST_CHECK_GT(transport->sentPackets.size(), 2);
+  lp::Packet frag;
+  BOOST_REQUIRE_NO_THROW(frag.wireDecode(transport->sentPackets.back().packet));
+  BOOST_CHECK(frag.has<lp::FragIndexField>());
+}
+
 BOOST_AUTO_TEST_CASE(ReceiveBareInterest)
 {
   // Initialize with Options that disables all services
@@ -824,6 +879,65 @@ BOOST_AUTO_TEST_CASE(DefaultThreshold)
   BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 1);
 }
 
+BOOST_AUTO_TEST_CASE(SojournTime)
+{
+  GenericLinkService::Options options;
+  options.allowCongestionMarking = true;
+  options.baseCongestionMarkingInterval = time::milliseconds(100);
+  options.congestionSojournTarget = time::milliseconds(5);
+  initialize(options, MTU_UNLIMITED, 65536);
+
+  shared_ptr<Interest> interest = makeInterest("/12345678");
+
+  // sojourn time is used instead of queue length
+  transport->setSendQueueLength(65536);
+  transport->setSendQueueSojournTime(time::milliseconds(1));
+  face->sendInterest(*interest);
+  lp::Packet pkt1;
+  BOOST_REQUIRE_NO_THROW(pkt1.wireDecode(transport->sentPackets.back().packet));
+  BOOST_CHECK_EQUAL(pkt1.count<lp::CongestionMarkField>(), 0);
+  BOOST_CHECK_EQUAL(service->m_firstAboveTime, time::steady_clock::TimePoint::max());
+
+  // above target, but not yet for a whole interval
+  transport->setSendQueueSojournTime(time::milliseconds(6));
+  face->sendInterest(*interest);
+  lp::Packet pkt2;
+  BOOST_REQUIRE_NO_THROW(pkt2.wireDecode(transport->sentPackets.back().packet));
+  BOOST_CHECK_EQUAL(pkt2.count<lp::CongestionMarkField>(), 0);
+  BOOST_CHECK_EQUAL(service->m_firstAboveTime, time::steady_clock::now());
+
+  advanceClocks(time::milliseconds(100));
+
+  // above target for a whole interval, will be marked
+  face->sendInterest(*interest);
+  lp::Packet pkt3;
+  BOOST_REQUIRE_NO_THROW(pkt3.wireDecode(transport->sentPackets.back().packet));
+  BOOST_CHECK_EQUAL(pkt3.count<lp::CongestionMarkField>(), 1);
+  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 1);
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 1);
+
+  // below target, congestion incident ends
+  transport->setSendQueueSojournTime(time::milliseconds(2));
+  face->sendInterest(*interest);
+  lp::Packet pkt4;
+  BOOST_REQUIRE_NO_THROW(pkt4.wireDecode(transport->sentPackets.back().packet));
+  BOOST_CHECK_EQUAL(pkt4.count<lp::CongestionMarkField>(), 0);
+  BOOST_CHECK_EQUAL(service->m_firstAboveTime, time::steady_clock::TimePoint::max());
+  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::TimePoint::max());
+  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
+
+  advanceClocks(time::milliseconds(100));
+
+  // transport does not report sojourn time: fall back to queue length
+  transport->setSendQueueSojournTime(time::nanoseconds(QUEUE_UNSUPPORTED));
+  transport->setSendQueueLength(32769);
+  face->sendInterest(*interest);
+  lp::Packet pkt5;
+  BOOST_REQUIRE_NO_THROW(pkt5.wireDecode(transport->sentPackets.back().packet));
+  BOOST_CHECK_EQUAL(pkt5.count<lp::CongestionMarkField>(), 1);
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // CongestionMark
 
 BOOST_AUTO_TEST_SUITE(LpFields)
@@ -1134,6 +1248,94 @@ BOOST_AUTO_TEST_CASE(ReceiveCongestionMarkNack)
   BOOST_CHECK_EQUAL(*tag, 1);
 }
 
+BOOST_AUTO_TEST_CASE(SendCentralityInterest)
+{
+  shared_ptr<Interest> interest = makeInterest("/12345678");
+  interest->setTag(make_shared<lp::CentralityTag>(42));
+
+  face->sendInterest(*interest);
+
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  lp::Packet sent(transport->sentPackets.back().packet);
+  BOOST_REQUIRE(sent.has<lp::CentralityTagField>());
+  BOOST_CHECK_EQUAL(sent.get<lp::CentralityTagField>(), 42);
+}
+
+BOOST_AUTO_TEST_CASE(SendCentralityData)
+{
+  shared_ptr<Data> data = makeData("/12345678");
+
+  face->sendData(*data);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK(!lp::Packet(transport->sentPackets.back().packet).has<lp::CentralityTagField>());
+
+  data->setTag(make_shared<lp::CentralityTag>(0));
+  face->sendData(*data);
+
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 2);
+  lp::Packet sent(transport->sentPackets.back().packet);
+  BOOST_REQUIRE(sent.has<lp::CentralityTagField>());
+  BOOST_CHECK_EQUAL(sent.get<lp::CentralityTagField>(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ReceiveCentralityInterest)
+{
+  shared_ptr<Interest> interest = makeInterest("/12345678");
+  lp::Packet packet(interest->wireEncode());
+  packet.set<lp::CentralityTagField>(42);
+
+  transport->receivePacket(packet.wireEncode());
+
+  BOOST_REQUIRE_EQUAL(receivedInterests.size(), 1);
+  shared_ptr<lp::CentralityTag> tag = receivedInterests.back().getTag<lp::CentralityTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK_EQUAL(*tag, 42);
+}
+
+BOOST_AUTO_TEST_CASE(ReceiveCentralityData)
+{
+  shared_ptr<Data> data = makeData("/12345678");
+  lp::Packet packet(data->wireEncode());
+  packet.set<lp::CentralityTagField>(42);
+
+  transport->receivePacket(packet.wireEncode());
+
+  BOOST_REQUIRE_EQUAL(receivedData.size(), 1);
+  shared_ptr<lp::CentralityTag> tag = receivedData.back().getTag<lp::CentralityTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK_EQUAL(*tag, 42);
+}
+
+BOOST_AUTO_TEST_CASE(CentralityWithHashSequence)
+{
+  BOOST_CHECK_NE(lp::CentralityTag::getTypeId(), name_tree::HashSequenceTag::getTypeId());
+
+  shared_ptr<Interest> interest = makeInterest("/A/B/C");
+  interest->setTag(make_shared<lp::CentralityTag>(42));
+  name_tree::HashSequence hashes = name_tree::getHashes(*interest);
+
+  shared_ptr<lp::CentralityTag> centralityTag = interest->getTag<lp::CentralityTag>();
+  BOOST_REQUIRE(centralityTag != nullptr);
+  BOOST_CHECK_EQUAL(*centralityTag, 42);
+  shared_ptr<name_tree::HashSequenceTag> hashTag = interest->getTag<name_tree::HashSequenceTag>();
+  BOOST_REQUIRE(hashTag != nullptr);
+  BOOST_CHECK(hashTag->get() == hashes);
+
+  face->sendInterest(*interest);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  transport->receivePacket(transport->sentPackets.back().packet);
+
+  BOOST_REQUIRE_EQUAL(receivedInterests.size(), 1);
+  const Interest& received = receivedInterests.back();
+  centralityTag = received.getTag<lp::CentralityTag>();
+  BOOST_REQUIRE(centralityTag != nullptr);
+  BOOST_CHECK_EQUAL(*centralityTag, 42);
+  BOOST_CHECK(name_tree::getHashes(received) == hashes);
+  centralityTag = received.getTag<lp::CentralityTag>(); // still there after getHashes adds its tag
+  BOOST_REQUIRE(centralityTag != nullptr);
+  BOOST_CHECK_EQUAL(*centralityTag, 42);
+}
+
 BOOST_AUTO_TEST_CASE(SendNonDiscovery)
 {
   GenericLinkService::Options options;
@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/cache-placement-policy.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/lp/tags.hpp>
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+class CachePlacementPolicyFixture : public BaseFixture
+{
+protected:
+  /** \brief creates a PIT entry with an in-record for an Interest that has traveled \p hopCount
+   *         hops and collected \p centrality
+   */
+  pit::DataMatchResult
+  makePitMatches(const Name& name, optional<uint64_t> hopCount = nullopt,
+                 optional<uint64_t> centrality = nullopt)
+  {
+    shared_ptr<Interest> interest = makeInterest(name);
+    if (hopCount) {
+      interest->setTag(make_shared<lp::HopCountTag>(*hopCount));
+    }
+    if (centrality) {
+      interest->setTag(make_shared<lp::CentralityTag>(*centrality));
+    }
+
+    auto pitEntry = make_shared<pit::Entry>(*interest);
+    pitEntry->insertOrUpdateInRecord(downstream, *interest);
+    return {pitEntry};
+  }
+
+  static shared_ptr<Data>
+  makeData(const Name& name, optional<uint64_t> hopCount = nullopt)
+  {
+    shared_ptr<Data> data = nfd::tests::makeData(name);
+    if (hopCount) {
+      data->setTag(make_shared<lp::HopCountTag>(*hopCount));
+    }
+    return data;
+  }
+
+protected:
+  face::tests::DummyFace upstream;
+  face::tests::DummyFace downstream;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestCachePlacementPolicy, CachePlacementPolicyFixture)
+
+BOOST_AUTO_TEST_CASE(GetPolicyNames)
+{
+  std::set<std::string> policyNames = CachePlacementPolicy::getPolicyNames();
+  BOOST_CHECK_EQUAL(policyNames.count("everywhere"), 1);
+  BOOST_CHECK_EQUAL(policyNames.count("lcd"), 1);
+  BOOST_CHECK_EQUAL(policyNames.count("probcache"), 1);
+  BOOST_CHECK_EQUAL(policyNames.count("betweenness"), 1);
+
+  BOOST_CHECK(CachePlacementPolicy::create("lcd") != nullptr);
+  BOOST_CHECK(CachePlacementPolicy::create("unknown") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Everywhere)
+{
+  CacheEverywherePlacementPolicy policy;
+  BOOST_CHECK_EQUAL(policy.decide(upstream, *makeData("/A", 3), makePitMatches("/A")),
+                    CachePlacementDecision::CACHE);
+  BOOST_CHECK_EQUAL(policy.decide(upstream, *makeData("/A"), makePitMatches("/A")),
+                    CachePlacementDecision::CACHE);
+}
+
+BOOST_AUTO_TEST_CASE(LeaveCopyDown)
+{
+  LeaveCopyDownPlacementPolicy policy;
+
+  // Data from a local producer is cached one hop downstream
+  BOOST_CHECK_EQUAL(policy.decide(upstream, *makeData("/A"), makePitMatches("/A", 2)),
+                    CachePlacementDecision::BYPASS);
+  BOOST_CHECK_EQUAL(policy.decide(upstream, *makeData("/A", 1), makePitMatches("/A", 2)),
+                    CachePlacementDecision::CACHE);
+  BOOST_CHECK_EQUAL(policy.decide(upstream, *makeData("/A", 2), makePitMatches("/A", 1)),
+                    CachePlacementDecision::BYPASS);
+}
+
+BOOST_AUTO_TEST_CASE(ProbCache)
+{
+  ProbCachePlacementPolicy policy;
+
+  // x = 2 hops from the source, 3 hops to the consumer: TimesIn = 4 / 10, CacheWeight = 2 / 5
+  BOOST_CHECK_CLOSE(policy.getProbability(*makeData("/A", 2), makePitMatches("/A", 3)),
+                    0.16, 1e-9);
+
+  // the consumer is attached to this forwarder
+  BOOST_CHECK_CLOSE(policy.getProbability(*makeData("/A", 4), makePitMatches("/A")),
+                    0.1, 1e-9);
+
+  // the farthest consumer counts
+  pit::DataMatchResult pitMatches = makePitMatches("/A", 1);
+  pitMatches.front()->insertOrUpdateInRecord(upstream, *makeInterest("/A"));
+  pit::DataMatchResult farther = makePitMatches("/A/B", 3);
+  pitMatches.push_back(farther.front());
+  BOOST_CHECK_CLOSE(policy.getProbability(*makeData("/A/B", 2), pitMatches), 0.16, 1e-9);
+
+  // Data from a local producer is not cached
+  BOOST_CHECK_EQUAL(policy.getProbability(*makeData("/A"), makePitMatches("/A", 3)), 0.0);
+  BOOST_CHECK_EQUAL(policy.decide(upstream, *makeData("/A"), makePitMatches("/A", 3)),
+                    CachePlacementDecision::BYPASS);
+
+  // probability is capped at 1
+  policy.setTimesInWindow(0.5);
+  BOOST_CHECK_EQUAL(policy.getProbability(*makeData("/A", 4), makePitMatches("/A", 4)), 1.0);
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK_EQUAL(policy.decide(upstream, *makeData("/A", 4), makePitMatches("/A", 4)),
+                      CachePlacementDecision::CACHE);
+  }
+
+  policy.setTimesInWindow(10);
+  int nCached = 0;
+  for (int i = 0; i < 1000; ++i) {
+    if (policy.decide(upstream, *makeData("/A", 2), makePitMatches("/A", 3)) ==
+        CachePlacementDecision::CACHE) {
+      ++nCached;
+    }
+  }
+  BOOST_CHECK_GT(nCached, 100);
+  BOOST_CHECK_LT(nCached, 220);
+}
+
+BOOST_AUTO_TEST_CASE(Betweenness)
+{
+  BetweennessPlacementPolicy policy;
+  policy.setCentrality(5);
+  BOOST_CHECK_EQUAL(policy.getCentrality(), 5);
+
+  // Interests collect the highest centrality on their path
+  shared_ptr<Interest> interest = makeInterest("/A");
+  policy.afterReceiveInterest(downstream, *interest);
+  BOOST_REQUIRE(interest->getTag<lp::CentralityTag>() != nullptr);
+  BOOST_CHECK_EQUAL(*interest->getTag<lp::CentralityTag>(), 5);
+
+  interest->setTag(make_shared<lp::CentralityTag>(3));
+  policy.afterReceiveInterest(downstream, *interest);
+  BOOST_CHECK_EQUAL(*interest->getTag<lp::CentralityTag>(), 5);
+
+  interest->setTag(make_shared<lp::CentralityTag>(9));
+  policy.afterReceiveInterest(downstream, *interest);
+  BOOST_CHECK_EQUAL(*interest->getTag<lp::CentralityTag>(), 9);
+
+  // a ContentStore hit returns the highest centrality collected by the Interest
+  shared_ptr<Data> data = makeData("/A");
+  policy.afterContentStoreHit(*interest, *data);
+  BOOST_REQUIRE(data->getTag<lp::CentralityTag>() != nullptr);
+  BOOST_CHECK_EQUAL(*data->getTag<lp::CentralityTag>(), 9);
+
+  // only the most central forwarder on the path caches
+  BOOST_CHECK_EQUAL(policy.decide(upstream, *data, makePitMatches("/A")),
+                    CachePlacementDecision::BYPASS);
+  data->setTag(make_shared<lp::CentralityTag>(5));
+  BOOST_CHECK_EQUAL(policy.decide(upstream, *data, makePitMatches("/A")),
+                    CachePlacementDecision::CACHE);
+
+  // Data from the producer takes the highest centrality from the pending Interests
+  shared_ptr<Data> fromProducer = makeData("/A");
+  BOOST_CHECK_EQUAL(policy.decide(upstream, *fromProducer, makePitMatches("/A", nullopt, 7)),
+                    CachePlacementDecision::BYPASS);
+  BOOST_REQUIRE(fromProducer->getTag<lp::CentralityTag>() != nullptr);
+  BOOST_CHECK_EQUAL(*fromProducer->getTag<lp::CentralityTag>(), 7);
+
+  fromProducer = makeData("/A");
+  BOOST_CHECK_EQUAL(policy.decide(upstream, *fromProducer, makePitMatches("/A", nullopt, 4)),
+                    CachePlacementDecision::CACHE);
+  BOOST_CHECK_EQUAL(*fromProducer->getTag<lp::CentralityTag>(), 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCachePlacementPolicy
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
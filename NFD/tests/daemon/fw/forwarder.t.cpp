@@ -24,6 +24,8 @@
  */
 
 #include "fw/forwarder.hpp"
+#include "table/cs-policy-gdsf.hpp"
+#include "table/cs-retrieval-cost.hpp"
 
 #include "tests/test-common.hpp"
 #include "tests/daemon/face/dummy-face.hpp"
@@ -335,6 +337,81 @@ BOOST_AUTO_TEST_CASE(IncomingData)
   BOOST_CHECK_EQUAL(face4->sentData.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(IncomingDataRetrievalCost)
+{
+  Forwarder forwarder;
+  forwarder.getCs().setPolicy(make_unique<cs::GdsfPolicy>());
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+  forwarder.getFib().insert("/A").first->addNextHop(*face2, 0);
+
+  face1->receiveInterest(*makeInterest("/A/B"));
+  this->advanceClocks(time::milliseconds(10), time::milliseconds(30));
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 1);
+
+  shared_ptr<Data> dataAB = makeData("/A/B");
+  dataAB->setTag(make_shared<lp::HopCountTag>(3));
+  face2->receiveData(*dataAB);
+
+  const Cs& cs = forwarder.getCs();
+  BOOST_REQUIRE_EQUAL(cs.size(), 1);
+  shared_ptr<cs::RetrievalCostTag> tag = cs.begin()->getData().getTag<cs::RetrievalCostTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK_EQUAL(tag->get().hopCount, 3);
+  BOOST_CHECK(tag->get().latency == time::milliseconds(30));
+}
+
+BOOST_AUTO_TEST_CASE(IncomingDataRetrievalCostUnused)
+{
+  Forwarder forwarder;
+  BOOST_REQUIRE(!forwarder.getCs().getPolicy()->needsRetrievalCost());
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+  forwarder.getFib().insert("/A").first->addNextHop(*face2, 0);
+
+  face1->receiveInterest(*makeInterest("/A/B"));
+  this->advanceClocks(time::milliseconds(10), time::milliseconds(30));
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 1);
+  face2->receiveData(*makeData("/A/B"));
+
+  const Cs& cs = forwarder.getCs();
+  BOOST_REQUIRE_EQUAL(cs.size(), 1);
+  BOOST_CHECK(cs.begin()->getData().getTag<cs::RetrievalCostTag>() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(IncomingDataCachePlacement)
+{
+  Forwarder forwarder;
+  forwarder.setCachePlacementPolicy(make_unique<fw::LeaveCopyDownPlacementPolicy>());
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+  forwarder.getFib().insert("/A").first->addNextHop(*face2, 0);
+
+  // Data that was found two hops away is forwarded but not cached
+  face1->receiveInterest(*makeInterest("/A/B"));
+  shared_ptr<Data> dataAB = makeData("/A/B");
+  dataAB->setTag(make_shared<lp::HopCountTag>(2));
+  face2->receiveData(*dataAB);
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face1->sentData.size(), 1);
+  BOOST_CHECK_EQUAL(forwarder.getCs().size(), 0);
+
+  // Data from the adjacent cache or producer is cached
+  face1->receiveInterest(*makeInterest("/A/C"));
+  shared_ptr<Data> dataAC = makeData("/A/C");
+  dataAC->setTag(make_shared<lp::HopCountTag>(1));
+  face2->receiveData(*dataAC);
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face1->sentData.size(), 2);
+  BOOST_CHECK_EQUAL(forwarder.getCs().size(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(IncomingNack)
 {
   Forwarder forwarder;
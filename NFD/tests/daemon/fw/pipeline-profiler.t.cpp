@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/pipeline-profiler.hpp"
+#include "fw/forwarder.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestPipelineProfiler, UnitTestTimeFixture)
+
+BOOST_AUTO_TEST_CASE(Histogram)
+{
+  LatencyHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.getNSamples(), 0);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.5), 0);
+
+  histogram.add(0);
+  histogram.add(1);
+  histogram.add(5);
+  histogram.add(7);
+  histogram.add(1000);
+  BOOST_CHECK_EQUAL(histogram.getNSamples(), 5);
+  BOOST_CHECK_EQUAL(histogram.getSum(), 1013);
+  BOOST_CHECK_EQUAL(histogram.getMax(), 1000);
+  BOOST_CHECK_EQUAL(histogram.getBucket(0), 2);
+  BOOST_CHECK_EQUAL(histogram.getBucket(2), 2); // [4,8)
+  BOOST_CHECK_EQUAL(histogram.getBucket(9), 1); // [512,1024)
+
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.0), 1);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.4), 1);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.5), 7);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.8), 7);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.99), 1000); // capped by max
+  BOOST_CHECK_EQUAL(histogram.getQuantile(1.0), 1000);
+
+  histogram.add(std::numeric_limits<uint64_t>::max());
+  BOOST_CHECK_EQUAL(histogram.getBucket(LatencyHistogram::N_BUCKETS - 1), 1);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(1.0), std::numeric_limits<uint64_t>::max());
+
+  histogram.reset();
+  BOOST_CHECK_EQUAL(histogram.getNSamples(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMax(), 0);
+  BOOST_CHECK_EQUAL(histogram.getBucket(0), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ScopedTimer)
+{
+  PipelineProfiler profiler;
+  BOOST_CHECK_EQUAL(profiler.isEnabled(), false);
+  {
+    PipelineProfiler::ScopedTimer timer(&profiler, PipelineStage::CS_FIND);
+  }
+  {
+    PipelineProfiler::ScopedTimer timer(nullptr, PipelineStage::CS_FIND);
+  }
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::CS_FIND).getNSamples(), 0);
+
+  profiler.setEnabled(true);
+  {
+    PipelineProfiler::ScopedTimer timer(&profiler, PipelineStage::CS_FIND);
+    profiler.setEnabled(false); // timer that has started still records
+  }
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::CS_FIND).getNSamples(), 1);
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::CS_HIT).getNSamples(), 0);
+
+  profiler.reset();
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::CS_FIND).getNSamples(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(StageNames)
+{
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(PipelineStage::INCOMING_INTEREST),
+                    "IncomingInterest");
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(PipelineStage::POLICY_BEFORE_USE),
+                    "PolicyBeforeUse");
+}
+
+BOOST_AUTO_TEST_CASE(ForwarderStages)
+{
+  Forwarder forwarder;
+  PipelineProfiler& profiler = forwarder.getProfiler();
+  BOOST_CHECK_EQUAL(forwarder.getCs().getProfiler(), &profiler);
+
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+  forwarder.getFib().insert("/A").first->addNextHop(*face2, 0);
+
+  // disabled by default
+  face1->receiveInterest(*makeInterest("/A/0"));
+  this->advanceClocks(time::milliseconds(100), time::seconds(1));
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::INCOMING_INTEREST).getNSamples(), 0);
+
+  profiler.setEnabled(true);
+  face1->receiveInterest(*makeInterest("/A/1"));
+  this->advanceClocks(time::milliseconds(10), time::milliseconds(100));
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::INCOMING_INTEREST).getNSamples(), 1);
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::DEAD_NONCE_LIST).getNSamples(), 1);
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::PIT_INSERT).getNSamples(), 1);
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::CS_FIND).getNSamples(), 1);
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::CS_MISS).getNSamples(), 1);
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::STRATEGY).getNSamples(), 1);
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::FACE_SEND).getNSamples(), 1);
+
+  face2->receiveData(*makeData("/A/1"));
+  this->advanceClocks(time::milliseconds(10), time::milliseconds(100));
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::INCOMING_DATA).getNSamples(), 1);
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::CS_INSERT).getNSamples(), 1);
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::POLICY_AFTER_INSERT).getNSamples(), 1);
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::OUTGOING_DATA).getNSamples(), 1);
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::FACE_SEND).getNSamples(), 2);
+
+  face1->receiveInterest(*makeInterest("/A/1"));
+  this->advanceClocks(time::milliseconds(10), time::milliseconds(100));
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::CS_HIT).getNSamples(), 1);
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::POLICY_BEFORE_USE).getNSamples(), 1);
+  BOOST_CHECK_EQUAL(profiler.get(PipelineStage::OUTGOING_DATA).getNSamples(), 2);
+  BOOST_CHECK_EQUAL(face1->sentData.size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestPipelineProfiler
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace nfd
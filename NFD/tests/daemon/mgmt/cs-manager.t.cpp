@@ -25,6 +25,7 @@
 
 #include "mgmt/cs-manager.hpp"
 #include "nfd-manager-common-fixture.hpp"
+#include "table/cs-policy-priority-fifo.hpp"
 #include <ndn-cxx/mgmt/nfd/cs-info.hpp>
 
 namespace nfd {
@@ -70,6 +71,7 @@ BOOST_AUTO_TEST_CASE(Config)
   body.setCapacity(22129);
   body.setFlagBit(CsFlagBit::BIT_CS_ENABLE_ADMIT, false, false);
   body.setFlagBit(CsFlagBit::BIT_CS_ENABLE_SERVE, true, false);
+  body.setCsPolicy(m_cs.getPolicy()->getName());
   BOOST_CHECK_EQUAL(checkResponse(0, req.getName(),
                                   ControlResponse(200, "OK").setBody(body.wireEncode())),
                     CheckResponseResult::OK);
@@ -96,6 +98,42 @@ BOOST_AUTO_TEST_CASE(Config)
   BOOST_CHECK_EQUAL(m_cs.shouldServe(), false);
 }
 
+BOOST_AUTO_TEST_CASE(ConfigPolicy)
+{
+  const Name cmdPrefix("/localhost/nfd/cs/config");
+
+  m_cs.setLimit(3);
+  m_cs.setPolicy(make_unique<cs::PriorityFifoPolicy>());
+  m_cs.insert(*makeData("/A"));
+  m_cs.insert(*makeData("/B"));
+
+  // switch to LRU, cached Data are kept
+  ControlParameters parameters;
+  parameters.setCsPolicy("lru");
+  auto req = makeControlCommandRequest(cmdPrefix, parameters);
+  receiveInterest(req);
+
+  BOOST_REQUIRE_EQUAL(m_responses.size(), 1);
+  ControlResponse resp;
+  resp.wireDecode(m_responses[0].getContent().blockFromValue());
+  BOOST_CHECK_EQUAL(resp.getCode(), 200);
+  BOOST_CHECK_EQUAL(ControlParameters(resp.getBody()).getCsPolicy(), "lru");
+  BOOST_CHECK_EQUAL(m_cs.getPolicy()->getName(), "lru");
+  BOOST_CHECK_EQUAL(m_cs.size(), 2);
+  BOOST_CHECK_EQUAL(m_cs.getLimit(), 3);
+
+  // unknown policy is rejected, nothing changes
+  parameters.setCsPolicy("no-such-policy");
+  parameters.setCapacity(1);
+  req = makeControlCommandRequest(cmdPrefix, parameters);
+  receiveInterest(req);
+
+  BOOST_CHECK_EQUAL(checkResponse(1, req.getName(), ControlResponse(404, "Content Store replacement policy not found")),
+                    CheckResponseResult::OK);
+  BOOST_CHECK_EQUAL(m_cs.getPolicy()->getName(), "lru");
+  BOOST_CHECK_EQUAL(m_cs.getLimit(), 3);
+}
+
 BOOST_AUTO_TEST_CASE(Erase)
 {
   m_cs.setLimit(CsManager::ERASE_LIMIT * 5);
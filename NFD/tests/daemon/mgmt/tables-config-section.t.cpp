@@ -200,6 +200,77 @@ BOOST_AUTO_TEST_CASE(Unknown)
 
 BOOST_AUTO_TEST_SUITE_END() // CsPolicy
 
+BOOST_AUTO_TEST_SUITE(CsEvictionTarget)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  cs.setEvictionTarget(0.5);
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(cs.getEvictionTarget(), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(Valid)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_policy lru
+      cs_eviction_target 0.9
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(cs.getEvictionTarget(), 1.0);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  NFD_CHECK_TYPEID_EQUAL(*cs.getPolicy(), cs::LruPolicy);
+  BOOST_CHECK_EQUAL(cs.getEvictionTarget(), 0.9);
+}
+
+BOOST_AUTO_TEST_CASE(OutOfRange)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    tables
+    {
+      cs_eviction_target 0
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG1, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG1, false), ConfigFile::Error);
+
+  const std::string CONFIG2 = R"CONFIG(
+    tables
+    {
+      cs_eviction_target 1.5
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG2, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG2, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValue)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_eviction_target invalid
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CsEvictionTarget
+
 class CsUnsolicitedPolicyFixture : public TablesConfigSectionFixture
 {
 protected:
@@ -273,6 +344,60 @@ BOOST_AUTO_TEST_CASE(Unknown)
 
 BOOST_AUTO_TEST_SUITE_END() // CsUnsolicitedPolicy
 
+BOOST_AUTO_TEST_SUITE(CsPlacementPolicy)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  forwarder.setCachePlacementPolicy(make_unique<fw::LeaveCopyDownPlacementPolicy>());
+
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  fw::CachePlacementPolicy* currentPolicy = &forwarder.getCachePlacementPolicy();
+  NFD_CHECK_TYPEID_NE(*currentPolicy, fw::DefaultCachePlacementPolicy);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  currentPolicy = &forwarder.getCachePlacementPolicy();
+  NFD_CHECK_TYPEID_EQUAL(*currentPolicy, fw::DefaultCachePlacementPolicy);
+}
+
+BOOST_AUTO_TEST_CASE(Known)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_placement_policy probcache
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  fw::CachePlacementPolicy* currentPolicy = &forwarder.getCachePlacementPolicy();
+  NFD_CHECK_TYPEID_NE(*currentPolicy, fw::ProbCachePlacementPolicy);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  currentPolicy = &forwarder.getCachePlacementPolicy();
+  NFD_CHECK_TYPEID_EQUAL(*currentPolicy, fw::ProbCachePlacementPolicy);
+}
+
+BOOST_AUTO_TEST_CASE(Unknown)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_placement_policy unknown
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CsPlacementPolicy
+
 BOOST_AUTO_TEST_SUITE(StrategyChoice)
 
 BOOST_AUTO_TEST_CASE(Unversioned)
@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-arc.hpp"
+
+#include "tests/daemon/table/cs-policy-fixture.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Table)
+
+BOOST_FIXTURE_TEST_SUITE(TestCsArc, CsPolicyFixture)
+
+BOOST_AUTO_TEST_CASE(Registration)
+{
+  std::set<std::string> policyNames = Policy::getPolicyNames();
+  BOOST_CHECK_EQUAL(policyNames.count("arc"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(EvictAndAdapt)
+{
+  Cs cs(3);
+  ArcPolicy& arc = installPolicy<ArcPolicy>(cs);
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  cs.insert(*makeData("ndn:/C"));
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::T1), 3);
+
+  // A moves to T2
+  use(cs, "ndn:/A");
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::T1), 2);
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::T2), 1);
+
+  // evict B, the LRU entry of T1, into B1
+  cs.insert(*makeData("ndn:/D"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK(!isCached(cs, "ndn:/B"));
+  BOOST_CHECK(isCached(cs, "ndn:/A"));
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::B1), 1);
+
+  // B hits B1: target grows, C is evicted from T1, and B enters T2
+  cs.insert(*makeData("ndn:/B"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(arc.getTarget(), 1);
+  BOOST_CHECK(!isCached(cs, "ndn:/C"));
+  BOOST_CHECK(isCached(cs, "ndn:/B"));
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::T1), 1);
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::T2), 2);
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::B1), 1);
+
+  // T1 is at its target, so A, the LRU entry of T2, is evicted into B2
+  cs.insert(*makeData("ndn:/E"));
+  BOOST_CHECK(!isCached(cs, "ndn:/A"));
+  BOOST_CHECK(isCached(cs, "ndn:/D"));
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::B2), 1);
+
+  // A hits B2: target shrinks, D is evicted from T1, and A enters T2
+  cs.insert(*makeData("ndn:/A"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(arc.getTarget(), 0);
+  BOOST_CHECK(!isCached(cs, "ndn:/D"));
+  BOOST_CHECK(isCached(cs, "ndn:/A"));
+  BOOST_CHECK(isCached(cs, "ndn:/B"));
+  BOOST_CHECK(isCached(cs, "ndn:/E"));
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::T1), 1);
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::T2), 2);
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::B1), 2);
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::B2), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ScanResistance)
+{
+  Cs cs(4);
+  installPolicy<ArcPolicy>(cs);
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  use(cs, "ndn:/A");
+  use(cs, "ndn:/B");
+
+  // a scan of names used once does not flush entries used twice
+  for (int i = 0; i < 20; ++i) {
+    cs.insert(*makeData(Name("ndn:/scan").appendNumber(i)));
+    BOOST_CHECK_LE(cs.size(), 4);
+  }
+  BOOST_CHECK(isCached(cs, "ndn:/A"));
+  BOOST_CHECK(isCached(cs, "ndn:/B"));
+}
+
+BOOST_AUTO_TEST_CASE(GhostBounds)
+{
+  Cs cs(5);
+  ArcPolicy& arc = installPolicy<ArcPolicy>(cs);
+
+  for (int i = 0; i < 50; ++i) {
+    cs.insert(*makeData(Name("ndn:/A").appendNumber(i % 13)));
+    if (i % 3 == 0) {
+      use(cs, Name("ndn:/A").appendNumber(i % 13));
+    }
+
+    size_t t1 = arc.getListSize(ArcPolicy::T1);
+    size_t t2 = arc.getListSize(ArcPolicy::T2);
+    size_t b1 = arc.getListSize(ArcPolicy::B1);
+    size_t b2 = arc.getListSize(ArcPolicy::B2);
+    BOOST_CHECK_EQUAL(t1 + t2, cs.size());
+    BOOST_CHECK_LE(t1 + b1, 5);
+    BOOST_CHECK_LE(t1 + t2 + b1 + b2, 10);
+    BOOST_CHECK_LE(arc.getTarget(), 5);
+  }
+
+  cs.setLimit(2);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::T1) + arc.getListSize(ArcPolicy::T2), 2);
+  BOOST_CHECK_LE(arc.getListSize(ArcPolicy::T1) + arc.getListSize(ArcPolicy::B1), 2);
+  BOOST_CHECK_LE(arc.getTarget(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  Cs cs(3);
+  ArcPolicy& arc = installPolicy<ArcPolicy>(cs);
+
+  cs.insert(*makeData("ndn:/A/1"));
+  cs.insert(*makeData("ndn:/A/2"));
+  cs.insert(*makeData("ndn:/B"));
+  use(cs, "ndn:/B");
+
+  size_t nErased = 0;
+  cs.erase("ndn:/A", 10, [&] (size_t n) { nErased = n; });
+  BOOST_CHECK_EQUAL(nErased, 2);
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::T1), 0);
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::T2), 1);
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::B1), 0);
+
+  // nodes of erased entries are reused
+  cs.insert(*makeData("ndn:/C"));
+  cs.insert(*makeData("ndn:/D"));
+  cs.insert(*makeData("ndn:/E"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK(isCached(cs, "ndn:/B"));
+}
+
+BOOST_AUTO_TEST_CASE(Snapshot)
+{
+  Cs cs(3);
+  installPolicy<ArcPolicy>(cs);
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  cs.insert(*makeData("ndn:/C"));
+  use(cs, "ndn:/A");
+
+  std::stringstream snapshot;
+  cs.saveSnapshot(snapshot);
+
+  Cs restored(3);
+  ArcPolicy& arc = installPolicy<ArcPolicy>(restored);
+  BOOST_CHECK_EQUAL(restored.loadSnapshot(snapshot), 3);
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::T1), 2);
+  BOOST_CHECK_EQUAL(arc.getListSize(ArcPolicy::T2), 1);
+
+  // evict B, the LRU entry of T1
+  restored.insert(*makeData("ndn:/D"));
+  BOOST_CHECK_EQUAL(restored.size(), 3);
+  BOOST_CHECK(!isCached(restored, "ndn:/B"));
+  BOOST_CHECK(isCached(restored, "ndn:/A"));
+  BOOST_CHECK(isCached(restored, "ndn:/C"));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsArc
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
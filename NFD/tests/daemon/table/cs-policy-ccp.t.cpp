@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-ccp.hpp"
+
+#include "tests/daemon/table/cs-policy-fixture.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_FIXTURE_TEST_SUITE(TestCsCcp, CsPolicyFixture)
+
+BOOST_AUTO_TEST_CASE(Registration)
+{
+  std::set<std::string> policyNames = Policy::getPolicyNames();
+  BOOST_CHECK_EQUAL(policyNames.count("ccp"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Snapshot)
+{
+  Cs cs(5);
+  installPolicy<CcpPolicy>(cs);
+
+  // insert in reverse Name order, so that Table order differs from the policy's order
+  for (int i = 4; i >= 0; --i) {
+    cs.insert(*makeData(Name("/A").appendNumber(i)));
+  }
+  use(cs, Name("/A").appendNumber(1));
+  use(cs, Name("/A").appendNumber(3));
+  use(cs, Name("/A").appendNumber(1));
+  cs.insert(*makeData("/B"));
+  cs.insert(*makeData("/C"));
+  BOOST_REQUIRE_EQUAL(cs.size(), 5);
+
+  checkSnapshot<CcpPolicy>(cs);
+}
+
+BOOST_AUTO_TEST_CASE(HandOver)
+{
+  Cs cs(5);
+  installPolicy<CcpPolicy>(cs);
+
+  for (int i = 4; i >= 0; --i) {
+    cs.insert(*makeData(Name("/A").appendNumber(i)));
+  }
+  use(cs, Name("/A").appendNumber(1));
+  use(cs, Name("/A").appendNumber(3));
+  cs.insert(*makeData("/B"));
+  BOOST_REQUIRE_EQUAL(cs.size(), 5);
+
+  checkHandOver<CcpPolicy>(cs);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsCcp
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-dlirs.hpp"
+
+#include "tests/daemon/table/cs-policy-fixture.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_FIXTURE_TEST_SUITE(TestCsDlirs, CsPolicyFixture)
+
+BOOST_AUTO_TEST_CASE(Registration)
+{
+  std::set<std::string> policyNames = Policy::getPolicyNames();
+  BOOST_CHECK_EQUAL(policyNames.count("dlirs"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Snapshot)
+{
+  Cs cs(5);
+  installPolicy<DlirsPolicy>(cs);
+
+  // insert in reverse Name order, so that Table order differs from the policy's order
+  for (int i = 4; i >= 0; --i) {
+    cs.insert(*makeData(Name("/A").appendNumber(i)));
+  }
+  use(cs, Name("/A").appendNumber(1));
+  use(cs, Name("/A").appendNumber(3));
+  use(cs, Name("/A").appendNumber(1));
+  cs.insert(*makeData("/B"));
+  cs.insert(*makeData("/C"));
+  BOOST_REQUIRE_EQUAL(cs.size(), 5);
+
+  checkSnapshot<DlirsPolicy>(cs);
+}
+
+BOOST_AUTO_TEST_CASE(HandOver)
+{
+  Cs cs(5);
+  installPolicy<DlirsPolicy>(cs);
+
+  for (int i = 4; i >= 0; --i) {
+    cs.insert(*makeData(Name("/A").appendNumber(i)));
+  }
+  use(cs, Name("/A").appendNumber(1));
+  use(cs, Name("/A").appendNumber(3));
+  cs.insert(*makeData("/B"));
+  BOOST_REQUIRE_EQUAL(cs.size(), 5);
+
+  checkHandOver<DlirsPolicy>(cs);
+}
+
+BOOST_AUTO_TEST_CASE(SetLimit)
+{
+  Cs cs(10);
+  installPolicy<DlirsPolicy>(cs);
+  insertRange(cs, "/A", 0, 10);
+  BOOST_REQUIRE_EQUAL(cs.size(), 10);
+
+  // shrinking demotes the oldest LIR entries and evicts them
+  cs.setLimit(4);
+  BOOST_CHECK_EQUAL(cs.size(), 4);
+  BOOST_CHECK_EQUAL(cs.getPolicy()->size(), 4);
+  BOOST_CHECK(isCached(cs, Name("/A").appendNumber(8)));
+  BOOST_CHECK(!isCached(cs, Name("/A").appendNumber(0)));
+
+  // the smaller cache does not fill past its limit
+  insertRange(cs, "/B", 0, 10);
+  BOOST_CHECK_EQUAL(cs.size(), 4);
+  BOOST_CHECK_EQUAL(cs.getPolicy()->size(), 4);
+
+  // the larger cache fills up to its limit
+  cs.setLimit(8);
+  BOOST_CHECK_EQUAL(cs.size(), 4);
+  insertRange(cs, "/C", 0, 10);
+  BOOST_CHECK_EQUAL(cs.size(), 8);
+  BOOST_CHECK_EQUAL(cs.getPolicy()->size(), 8);
+
+  cs.setLimit(0);
+  BOOST_CHECK_EQUAL(cs.size(), 0);
+  BOOST_CHECK_EQUAL(cs.getPolicy()->size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsDlirs
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
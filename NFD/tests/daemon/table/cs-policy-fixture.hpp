@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_TESTS_DAEMON_TABLE_CS_POLICY_FIXTURE_HPP
+#define NFD_TESTS_DAEMON_TABLE_CS_POLICY_FIXTURE_HPP
+
+#include "table/cs.hpp"
+#include "table/cs-policy-lru.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::tests;
+
+/** \brief a fixture to drive a Content Store through its replacement policy
+ */
+class CsPolicyFixture : public UnitTestTimeFixture
+{
+protected:
+  /** \brief replaces the policy of \p cs with a new P
+   *  \return the installed policy
+   */
+  template<typename P>
+  static P&
+  installPolicy(Cs& cs)
+  {
+    cs.setPolicy(make_unique<P>());
+    return static_cast<P&>(*cs.getPolicy());
+  }
+
+  /** \brief checks whether \p name is cached without letting the policy witness a use
+   */
+  static bool
+  isCached(const Cs& cs, const Name& name)
+  {
+    return std::any_of(cs.begin(), cs.end(), [&] (const Entry& entry) { return entry.getName() == name; });
+  }
+
+  /** \brief looks up \p name, which must be cached
+   */
+  static void
+  use(Cs& cs, const Name& name)
+  {
+    cs.find(Interest(name),
+            bind([] { BOOST_CHECK(true); }),
+            bind([] { BOOST_CHECK(false); }));
+  }
+
+  /** \brief inserts Data named \p prefix with a number in [\p first, \p last) appended
+   */
+  static void
+  insertRange(Cs& cs, const std::string& prefix, int first, int last)
+  {
+    for (int i = first; i < last; ++i) {
+      cs.insert(*makeData(Name(prefix).appendNumber(i)));
+    }
+  }
+
+  /** \return names of cached Data, in Table order
+   */
+  static std::vector<Name>
+  getCachedNames(const Cs& cs)
+  {
+    std::vector<Name> names;
+    for (const Entry& entry : cs) {
+      names.push_back(entry.getName());
+    }
+    return names;
+  }
+
+  /** \return names of cached Data, in the eviction order reported by the policy
+   */
+  static std::vector<Name>
+  getEvictionOrder(const Cs& cs)
+  {
+    std::vector<Name> names;
+    for (iterator i : cs.getPolicy()->listEntries()) {
+      names.push_back(i->getName());
+    }
+    return names;
+  }
+
+  /** \brief checks that a snapshot of \p cs restores the metadata of its policy P
+   *
+   *  The snapshot is loaded into a new CS with the same limit and policy. Both CSes must
+   *  report the same eviction order, and keep the same Data while they receive the same
+   *  insertions afterwards.
+   */
+  template<typename P>
+  static void
+  checkSnapshot(Cs& cs)
+  {
+    std::stringstream snapshot;
+    cs.saveSnapshot(snapshot);
+
+    Cs restored(cs.getLimit());
+    installPolicy<P>(restored);
+    BOOST_REQUIRE_EQUAL(restored.loadSnapshot(snapshot), cs.size());
+    BOOST_CHECK_EQUAL(restored.getPolicy()->size(), cs.size());
+
+    std::vector<Name> expectedOrder = getEvictionOrder(cs);
+    std::vector<Name> actualOrder = getEvictionOrder(restored);
+    BOOST_CHECK_EQUAL_COLLECTIONS(actualOrder.begin(), actualOrder.end(),
+                                  expectedOrder.begin(), expectedOrder.end());
+
+    for (size_t i = 0; i < cs.getLimit(); ++i) {
+      Name name = Name("/after-snapshot").appendNumber(i);
+      cs.insert(*makeData(name));
+      restored.insert(*makeData(name));
+
+      std::vector<Name> expected = getCachedNames(cs);
+      std::vector<Name> actual = getCachedNames(restored);
+      BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+    }
+  }
+
+  /** \brief checks that the entries of \p cs are handed over from its policy P and back
+   *
+   *  The eviction order reported by P must be the order in which LRU receives the entries.
+   *  A new P that receives them back from LRU must know every entry, and evict the coldest
+   *  one first.
+   */
+  template<typename P>
+  static void
+  checkHandOver(Cs& cs)
+  {
+    std::vector<Name> order = getEvictionOrder(cs);
+    BOOST_REQUIRE_EQUAL(order.size(), cs.size());
+
+    installPolicy<LruPolicy>(cs);
+    std::vector<Name> lruOrder = getEvictionOrder(cs);
+    BOOST_CHECK_EQUAL_COLLECTIONS(lruOrder.begin(), lruOrder.end(), order.begin(), order.end());
+
+    installPolicy<P>(cs);
+    BOOST_REQUIRE_EQUAL(cs.size(), order.size());
+    BOOST_CHECK_EQUAL(cs.getPolicy()->size(), cs.size());
+    std::vector<Name> known = getEvictionOrder(cs);
+    std::sort(known.begin(), known.end());
+    std::vector<Name> cached = getCachedNames(cs);
+    BOOST_CHECK_EQUAL_COLLECTIONS(known.begin(), known.end(), cached.begin(), cached.end());
+
+    for (size_t i = 0; cs.size() < cs.getLimit(); ++i) {
+      cs.insert(*makeData(Name("/after-hand-over").appendNumber(i)));
+    }
+    cs.insert(*makeData("/after-hand-over/evict"));
+    BOOST_CHECK_EQUAL(cs.size(), cs.getLimit());
+    BOOST_CHECK_EQUAL(cs.getPolicy()->size(), cs.size());
+    BOOST_CHECK(!isCached(cs, order.front()));
+  }
+};
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_TESTS_DAEMON_TABLE_CS_POLICY_FIXTURE_HPP
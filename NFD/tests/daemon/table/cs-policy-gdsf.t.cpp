@@ -0,0 +1,271 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-gdsf.hpp"
+#include "table/cs-retrieval-cost.hpp"
+
+#include "tests/daemon/table/cs-policy-fixture.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Table)
+
+class GdsfFixture : public CsPolicyFixture
+{
+protected:
+  static double
+  getPriority(const GdsfPolicy& gdsf, const Name& name)
+  {
+    for (iterator i : gdsf.listEntries()) {
+      if (i->getName() == name) {
+        return gdsf.getPriority(i);
+      }
+    }
+    BOOST_FAIL(name << " is not cached");
+    return 0;
+  }
+
+  /** \brief inserts Data retrieved over \p hopCount hops in \p latency
+   */
+  static void
+  insert(Cs& cs, const Name& name, uint64_t hopCount,
+         time::nanoseconds latency = time::nanoseconds(-1))
+  {
+    shared_ptr<Data> data = makeData(name);
+    RetrievalCost cost;
+    cost.hopCount = hopCount;
+    cost.latency = latency;
+    data->setTag(make_shared<RetrievalCostTag>(cost));
+    cs.insert(*data);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestCsGdsf, GdsfFixture)
+
+BOOST_AUTO_TEST_CASE(Registration)
+{
+  std::set<std::string> policyNames = Policy::getPolicyNames();
+  BOOST_CHECK_EQUAL(policyNames.count("gdsf"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(NeedsRetrievalCost)
+{
+  BOOST_CHECK(GdsfPolicy().needsRetrievalCost());
+  BOOST_CHECK(!LruPolicy().needsRetrievalCost());
+}
+
+BOOST_AUTO_TEST_CASE(HopCount)
+{
+  Cs cs(3);
+  GdsfPolicy& gdsf = installPolicy<GdsfPolicy>(cs);
+
+  insert(cs, "ndn:/A", 5);
+  insert(cs, "ndn:/B", 0);
+  insert(cs, "ndn:/C", 0);
+  BOOST_CHECK_EQUAL(gdsf.getInflation(), 0.0);
+
+  // nearby entries with equal priorities are evicted in LRU order
+  insert(cs, "ndn:/D", 0);
+  BOOST_CHECK(!isCached(cs, "ndn:/B"));
+  BOOST_CHECK_GT(gdsf.getInflation(), 0.0);
+  insert(cs, "ndn:/E", 0);
+  BOOST_CHECK(!isCached(cs, "ndn:/C"));
+  BOOST_CHECK(isCached(cs, "ndn:/A"));
+  BOOST_CHECK(isCached(cs, "ndn:/D"));
+  BOOST_CHECK(isCached(cs, "ndn:/E"));
+}
+
+BOOST_AUTO_TEST_CASE(Frequency)
+{
+  Cs cs(2);
+  GdsfPolicy& gdsf = installPolicy<GdsfPolicy>(cs);
+
+  insert(cs, "ndn:/A", 0);
+  insert(cs, "ndn:/B", 0);
+  double initial = getPriority(gdsf, "ndn:/A");
+  BOOST_CHECK_CLOSE(getPriority(gdsf, "ndn:/B"), initial, 1e-9);
+
+  use(cs, "ndn:/A");
+  use(cs, "ndn:/A");
+  BOOST_CHECK_CLOSE(getPriority(gdsf, "ndn:/A"), 3 * initial, 1e-9);
+
+  insert(cs, "ndn:/C", 0);
+  BOOST_CHECK(isCached(cs, "ndn:/A"));
+  BOOST_CHECK(!isCached(cs, "ndn:/B"));
+  BOOST_CHECK(isCached(cs, "ndn:/C"));
+}
+
+BOOST_AUTO_TEST_CASE(Aging)
+{
+  Cs cs(3);
+  GdsfPolicy& gdsf = installPolicy<GdsfPolicy>(cs);
+
+  insert(cs, "ndn:/A", 3);
+  double priorityA = getPriority(gdsf, "ndn:/A");
+
+  // the inflation value rises with every eviction until the unused far entry is the lowest
+  int nInserted = 0;
+  while (isCached(cs, "ndn:/A")) {
+    BOOST_REQUIRE_LT(nInserted, 100);
+    insert(cs, Name("ndn:/N").appendNumber(nInserted++), 0);
+  }
+  BOOST_CHECK_GT(nInserted, 2);
+  BOOST_CHECK_CLOSE(gdsf.getInflation(), priorityA, 1e-9);
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(Latency)
+{
+  Cs cs(2);
+  GdsfPolicy& gdsf = installPolicy<GdsfPolicy>(cs);
+  gdsf.setCostMetric(GdsfPolicy::COST_LATENCY);
+  BOOST_CHECK_EQUAL(gdsf.getCostMetric(), GdsfPolicy::COST_LATENCY);
+
+  // the slow entry is kept even though it is fewer hops away
+  insert(cs, "ndn:/A", 1, time::milliseconds(80));
+  insert(cs, "ndn:/B", 4, time::milliseconds(10));
+  insert(cs, "ndn:/C", 4, time::milliseconds(20));
+  BOOST_CHECK(isCached(cs, "ndn:/A"));
+  BOOST_CHECK(!isCached(cs, "ndn:/B"));
+  BOOST_CHECK(isCached(cs, "ndn:/C"));
+
+  // without a measured latency, the cost is estimated from the hop count
+  double priorityC = getPriority(gdsf, "ndn:/C");
+  insert(cs, "ndn:/D", 100);
+  BOOST_CHECK(isCached(cs, "ndn:/D"));
+  BOOST_CHECK(!isCached(cs, "ndn:/C"));
+  BOOST_CHECK_GT(getPriority(gdsf, "ndn:/D") - gdsf.getInflation(), priorityC);
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  Cs cs(100);
+  GdsfPolicy& gdsf = installPolicy<GdsfPolicy>(cs);
+
+  for (int i = 0; i < 50; ++i) {
+    insert(cs, Name("ndn:/A").appendNumber(i), i % 7);
+    insert(cs, Name("ndn:/B").appendNumber(i), i % 5);
+  }
+
+  size_t nErased = 0;
+  cs.erase("ndn:/A", 100, [&] (size_t n) { nErased = n; });
+  BOOST_CHECK_EQUAL(nErased, 50);
+
+  // the remaining entries are still listed in eviction order
+  std::vector<iterator> entries = gdsf.listEntries();
+  BOOST_REQUIRE_EQUAL(entries.size(), 50);
+  for (size_t i = 1; i < entries.size(); ++i) {
+    BOOST_CHECK_LE(gdsf.getPriority(entries[i - 1]), gdsf.getPriority(entries[i]));
+  }
+
+  for (int i = 0; i < 200; ++i) {
+    insert(cs, Name("ndn:/C").appendNumber(i), 0);
+  }
+  BOOST_CHECK_EQUAL(cs.size(), 100);
+  BOOST_CHECK_EQUAL(gdsf.listEntries().size(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(Snapshot)
+{
+  Cs cs(3);
+  GdsfPolicy& gdsf = installPolicy<GdsfPolicy>(cs);
+
+  insert(cs, "ndn:/A", 2);
+  insert(cs, "ndn:/B", 0);
+  insert(cs, "ndn:/C", 0);
+  use(cs, "ndn:/B");
+  insert(cs, "ndn:/D", 0);
+  BOOST_CHECK(!isCached(cs, "ndn:/C"));
+
+  std::stringstream snapshot;
+  cs.saveSnapshot(snapshot);
+
+  Cs restored(3);
+  GdsfPolicy& restoredGdsf = installPolicy<GdsfPolicy>(restored);
+  BOOST_CHECK_EQUAL(restored.loadSnapshot(snapshot), 3);
+  BOOST_CHECK_CLOSE(restoredGdsf.getInflation(), gdsf.getInflation(), 1e-9);
+  for (const Name& name : {Name("ndn:/A"), Name("ndn:/B"), Name("ndn:/D")}) {
+    BOOST_CHECK_CLOSE(getPriority(restoredGdsf, name), getPriority(gdsf, name), 1e-9);
+  }
+
+  // B keeps its frequency and cost, so a further use gives it L + 3 * C / S
+  double costPerByteB = getPriority(gdsf, "ndn:/B") / 2;
+  use(restored, "ndn:/B");
+  BOOST_CHECK_CLOSE(getPriority(restoredGdsf, "ndn:/B"),
+                    restoredGdsf.getInflation() + 3 * costPerByteB, 1e-9);
+
+  insert(restored, "ndn:/E", 0);
+  BOOST_CHECK(!isCached(restored, "ndn:/D"));
+  BOOST_CHECK(isCached(restored, "ndn:/A"));
+}
+
+BOOST_AUTO_TEST_CASE(EvictBatch)
+{
+  Cs cs(10);
+  cs.setEvictionTarget(0.8);
+  GdsfPolicy& gdsf = installPolicy<GdsfPolicy>(cs);
+
+  size_t nBatchVictims = 0;
+  gdsf.beforeEvictBatch.connect([&] (const std::vector<iterator>& victims) {
+    nBatchVictims += victims.size();
+  });
+
+  // a longer path gives a higher priority, so /A/0 /A/1 /A/2 are the cheapest to lose
+  std::vector<double> priorities;
+  for (int i = 0; i < 10; ++i) {
+    Name name = Name("ndn:/A").appendNumber(i);
+    insert(cs, name, i);
+    priorities.push_back(getPriority(gdsf, name));
+  }
+  BOOST_CHECK_EQUAL(gdsf.getInflation(), 0.0);
+
+  insert(cs, "ndn:/B", 100);
+  BOOST_CHECK_EQUAL(cs.size(), 8);
+  BOOST_CHECK_EQUAL(gdsf.size(), cs.size());
+  BOOST_CHECK_EQUAL(nBatchVictims, 3);
+  for (int i = 0; i < 3; ++i) {
+    BOOST_CHECK(!isCached(cs, Name("ndn:/A").appendNumber(i)));
+  }
+
+  // inflation is the priority of the last victim, not of the first one
+  BOOST_CHECK_CLOSE(gdsf.getInflation(), priorities[2], 1e-9);
+  for (int i = 3; i < 10; ++i) {
+    BOOST_CHECK_CLOSE(getPriority(gdsf, Name("ndn:/A").appendNumber(i)), priorities[i], 1e-9);
+  }
+
+  // a new entry of the same size and cost as /A/0 is admitted on top of the inflation
+  Name nameC = Name("ndn:/A").appendNumber(10);
+  insert(cs, nameC, 0);
+  BOOST_CHECK_CLOSE(getPriority(gdsf, nameC), gdsf.getInflation() + priorities[0], 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsGdsf
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
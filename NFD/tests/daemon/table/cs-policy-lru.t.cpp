@@ -90,6 +90,120 @@ BOOST_FIXTURE_TEST_CASE(EvictOne, UnitTestTimeFixture)
           bind([] { BOOST_CHECK(true); }));
 }
 
+BOOST_FIXTURE_TEST_CASE(Snapshot, UnitTestTimeFixture)
+{
+  Cs cs(3);
+  cs.setPolicy(make_unique<LruPolicy>());
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  cs.insert(*makeData("ndn:/C"));
+  // use A, so that B becomes least recently used
+  cs.find(Interest("ndn:/A"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+
+  std::stringstream snapshot;
+  cs.saveSnapshot(snapshot);
+
+  Cs restored(3);
+  restored.setPolicy(make_unique<LruPolicy>());
+  BOOST_CHECK_EQUAL(restored.loadSnapshot(snapshot), 3);
+
+  // evict B
+  restored.insert(*makeData("ndn:/D"));
+  BOOST_CHECK_EQUAL(restored.size(), 3);
+  restored.find(Interest("ndn:/B"),
+                bind([] { BOOST_CHECK(false); }),
+                bind([] { BOOST_CHECK(true); }));
+  restored.find(Interest("ndn:/A"),
+                bind([] { BOOST_CHECK(true); }),
+                bind([] { BOOST_CHECK(false); }));
+}
+
+BOOST_FIXTURE_TEST_CASE(HandOver, UnitTestTimeFixture)
+{
+  Cs cs(3);
+  cs.setPolicy(make_unique<LruPolicy>());
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  cs.insert(*makeData("ndn:/C"));
+  // use A, so that B becomes least recently used
+  cs.find(Interest("ndn:/A"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+
+  // replace the policy while the CS is full
+  cs.setPolicy(make_unique<LruPolicy>());
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(cs.getLimit(), 3);
+
+  // evict B
+  cs.insert(*makeData("ndn:/D"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  cs.find(Interest("ndn:/B"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+  cs.find(Interest("ndn:/A"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+}
+
+BOOST_FIXTURE_TEST_CASE(EvictBatch, UnitTestTimeFixture)
+{
+  Cs cs(10);
+  cs.setEvictionTarget(0.8);
+  cs.setPolicy(make_unique<LruPolicy>());
+  BOOST_CHECK_EQUAL(cs.getEvictionTarget(), 0.8);
+
+  size_t nEvictSignals = 0;
+  size_t nBatchSignals = 0;
+  size_t nBatchVictims = 0;
+  cs.getPolicy()->beforeEvict.connect([&] (iterator) { ++nEvictSignals; });
+  cs.getPolicy()->beforeEvictBatch.connect([&] (const std::vector<iterator>& victims) {
+    ++nBatchSignals;
+    nBatchVictims += victims.size();
+  });
+
+  for (int i = 0; i < 10; ++i) {
+    cs.insert(*makeData(Name("/A").appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+  // use /A/0, so that /A/1 becomes least recently used
+  cs.find(Interest(Name("/A").appendNumber(0)),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+
+  // evict /A/1 /A/2 /A/3 in one batch, down to 8 entries
+  cs.insert(*makeData("/B"));
+  BOOST_CHECK_EQUAL(cs.size(), 8);
+  BOOST_CHECK_EQUAL(nEvictSignals, 0);
+  BOOST_CHECK_EQUAL(nBatchSignals, 1);
+  BOOST_CHECK_EQUAL(nBatchVictims, 3);
+  for (int i = 1; i <= 3; ++i) {
+    cs.find(Interest(Name("/A").appendNumber(i)),
+            bind([] { BOOST_CHECK(false); }),
+            bind([] { BOOST_CHECK(true); }));
+  }
+  cs.find(Interest(Name("/A").appendNumber(0)),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+
+  // no eviction until the CS is over its limit again
+  cs.insert(*makeData("/C"));
+  cs.insert(*makeData("/D"));
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+  BOOST_CHECK_EQUAL(nBatchSignals, 1);
+
+  // a single victim uses beforeEvict
+  cs.setEvictionTarget(1.0);
+  cs.insert(*makeData("/E"));
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+  BOOST_CHECK_EQUAL(nEvictSignals, 1);
+  BOOST_CHECK_EQUAL(nBatchSignals, 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestCsLru
 BOOST_AUTO_TEST_SUITE_END() // Table
 
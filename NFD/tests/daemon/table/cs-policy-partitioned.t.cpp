@@ -0,0 +1,320 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-partitioned.hpp"
+#include "table/cs-policy-gdsf.hpp"
+#include "table/cs-policy-lirs.hpp"
+#include "table/cs-policy-lru.hpp"
+#include "table/cs-policy-priority-fifo.hpp"
+
+#include "tests/daemon/table/cs-policy-fixture.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Table)
+
+class PartitionedFixture : public CsPolicyFixture
+{
+protected:
+  /** \brief installs a partitioned policy with a partition of /A and the default partition
+   */
+  PartitionedPolicy&
+  installPartitioned(Cs& cs, double weightA, double weightRoot)
+  {
+    auto policy = make_unique<PartitionedPolicy>();
+    policy->addPartition("ndn:/A", make_unique<LruPolicy>(), weightA);
+    policy->addPartition("ndn:/", make_unique<LruPolicy>(), weightRoot);
+    cs.setPolicy(std::move(policy));
+    return static_cast<PartitionedPolicy&>(*cs.getPolicy());
+  }
+
+  /** \brief looks up \p name, and inserts it on a miss
+   *  \return whether the lookup was a hit
+   */
+  static bool
+  request(Cs& cs, const Name& name)
+  {
+    bool isHit = false;
+    cs.find(Interest(name),
+            bind([&isHit] { isHit = true; }),
+            bind([] {}));
+    if (!isHit) {
+      cs.insert(*makeData(name));
+    }
+    return isHit;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestCsPartitioned, PartitionedFixture)
+
+BOOST_AUTO_TEST_CASE(Registration)
+{
+  std::set<std::string> policyNames = Policy::getPolicyNames();
+  BOOST_CHECK_EQUAL(policyNames.count("partitioned"), 1);
+
+  PartitionedPolicy policy;
+  BOOST_REQUIRE_EQUAL(policy.getNPartitions(), 1);
+  BOOST_CHECK_EQUAL(policy.getPartitionPrefix(0), "ndn:/");
+  BOOST_CHECK_EQUAL(policy.getPartitionPolicy(0).getName(), "lru");
+}
+
+BOOST_AUTO_TEST_CASE(NeedsRetrievalCost)
+{
+  PartitionedPolicy partitioned;
+  BOOST_CHECK(!partitioned.needsRetrievalCost());
+  partitioned.addPartition("ndn:/A", make_unique<GdsfPolicy>());
+  BOOST_CHECK(partitioned.needsRetrievalCost());
+}
+
+BOOST_AUTO_TEST_CASE(Quotas)
+{
+  Cs cs(10);
+  auto policy = make_unique<PartitionedPolicy>();
+  policy->addPartition("ndn:/A", make_unique<LruPolicy>());
+  policy->addPartition("ndn:/B", make_unique<PriorityFifoPolicy>());
+  cs.setPolicy(std::move(policy));
+  auto& partitioned = static_cast<PartitionedPolicy&>(*cs.getPolicy());
+
+  BOOST_REQUIRE_EQUAL(partitioned.getNPartitions(), 3);
+  BOOST_CHECK_EQUAL(partitioned.findPartition("ndn:/A/1"), 1);
+  BOOST_CHECK_EQUAL(partitioned.findPartition("ndn:/B/1"), 2);
+  BOOST_CHECK_EQUAL(partitioned.findPartition("ndn:/C/1"), 0);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(2).getName(), "priority_fifo");
+
+  // equal weights: quotas add up to the limit
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(0).getLimit(), 4);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(1).getLimit(), 3);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(2).getLimit(), 3);
+
+  insertRange(cs, "ndn:/A", 0, 5);
+  insertRange(cs, "ndn:/B", 0, 5);
+  insertRange(cs, "ndn:/C", 0, 5);
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(0).size(), 4);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(1).size(), 3);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(2).size(), 3);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionCounters(1).nInserts, 5);
+
+  cs.setLimit(5);
+  BOOST_CHECK_EQUAL(cs.size(), 5);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(0).size(), 2);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(1).size(), 2);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(2).size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Isolation)
+{
+  Cs cs(10);
+  PartitionedPolicy& partitioned = installPartitioned(cs, 3, 2);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(1).getLimit(), 6);
+
+  insertRange(cs, "ndn:/A", 0, 6);
+
+  // a scan in another partition cannot evict entries of /A
+  insertRange(cs, "ndn:/S", 0, 100);
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+  for (int i = 0; i < 6; ++i) {
+    BOOST_CHECK(request(cs, Name("ndn:/A").appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(partitioned.getPartitionCounters(1).nHits, 6);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionCounters(0).nHits, 0);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(0).size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  Cs cs(10);
+  PartitionedPolicy& partitioned = installPartitioned(cs, 1, 1);
+
+  insertRange(cs, "ndn:/A", 0, 5);
+  insertRange(cs, "ndn:/B", 0, 5);
+
+  size_t nErased = 0;
+  cs.erase("ndn:/A", 3, [&] (size_t n) { nErased = n; });
+  BOOST_CHECK_EQUAL(nErased, 3);
+  BOOST_CHECK_EQUAL(partitioned.size(), 7);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(1).size(), 2);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(0).size(), 5);
+
+  // freed quota of /A is not taken by other partitions
+  insertRange(cs, "ndn:/B", 5, 10);
+  BOOST_CHECK_EQUAL(cs.size(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(Rebalance)
+{
+  Cs cs(20);
+  PartitionedPolicy& partitioned = installPartitioned(cs, 1, 1);
+  partitioned.setRebalanceStep(2);
+  partitioned.setRebalanceInterval(10);
+
+  // /A cycles through 12 names, which thrash its quota of 10;
+  // a scan in the default partition never requests a name again
+  int nScanned = 0;
+  size_t nHits = 0;
+  for (int round = 0; round < 10; ++round) {
+    nHits = 0;
+    for (int i = 0; i < 12; ++i) {
+      nHits += request(cs, Name("ndn:/A").appendNumber(i));
+      cs.insert(*makeData(Name("ndn:/S").appendNumber(nScanned++)));
+    }
+  }
+
+  BOOST_CHECK_GT(partitioned.getPartitionCounters(1).nGhostHits, 0);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionCounters(0).nGhostHits, 0);
+  BOOST_CHECK_GE(partitioned.getPartitionPolicy(1).getLimit(), 12);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(0).getLimit() +
+                    partitioned.getPartitionPolicy(1).getLimit(), 20);
+  BOOST_CHECK_EQUAL(nHits, 12);
+
+  // changing the limit restores the quotas given by the weights
+  cs.setLimit(10);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(0).getLimit(), 5);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(1).getLimit(), 5);
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(RebalanceLirs)
+{
+  Cs cs(20);
+  auto policy = make_unique<PartitionedPolicy>();
+  policy->addPartition("ndn:/A", make_unique<LirsPolicy>());
+  cs.setPolicy(std::move(policy));
+  auto& partitioned = static_cast<PartitionedPolicy&>(*cs.getPolicy());
+  partitioned.setRebalanceStep(2);
+  partitioned.setRebalanceInterval(10);
+
+  // the partition of ndn:/ thrashes, and takes quota from the LIRS partition of /A
+  insertRange(cs, "ndn:/A", 0, 10);
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 12; ++i) {
+      request(cs, Name("ndn:/S").appendNumber(i));
+    }
+  }
+
+  const Policy& lirs = partitioned.getPartitionPolicy(1);
+  const Policy& lru = partitioned.getPartitionPolicy(0);
+  BOOST_CHECK_LT(lirs.getLimit(), 10);
+  BOOST_CHECK_EQUAL(lirs.getLimit() + lru.getLimit(), 20);
+  BOOST_CHECK_EQUAL(lirs.size(), lirs.getLimit());
+  BOOST_CHECK_EQUAL(lru.size(), lru.getLimit());
+  BOOST_CHECK_EQUAL(partitioned.size(), cs.size());
+
+  // the LIRS partition does not fill past its smaller quota
+  insertRange(cs, "ndn:/A", 10, 30);
+  BOOST_CHECK_EQUAL(lirs.size(), lirs.getLimit());
+  BOOST_CHECK_EQUAL(lirs.getLimit() + lru.getLimit(), 20);
+  BOOST_CHECK_EQUAL(partitioned.size(), cs.size());
+
+  // and shrinks again when the limit changes
+  cs.setLimit(10);
+  BOOST_CHECK_EQUAL(lirs.getLimit(), 5);
+  BOOST_CHECK_EQUAL(lirs.size(), 5);
+  BOOST_CHECK_EQUAL(lru.size(), 5);
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+  BOOST_CHECK_EQUAL(partitioned.size(), cs.size());
+}
+
+BOOST_AUTO_TEST_CASE(Migration)
+{
+  Cs cs(10);
+  cs.setPolicy(make_unique<LruPolicy>());
+  insertRange(cs, "ndn:/A", 0, 8);
+  insertRange(cs, "ndn:/B", 0, 2);
+
+  // the newest /A entries are kept when the old entries do not fit into the quota of /A
+  PartitionedPolicy& partitioned = installPartitioned(cs, 1, 1);
+  BOOST_CHECK_EQUAL(cs.size(), 7);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(1).size(), 5);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(0).size(), 2);
+  BOOST_CHECK(!isCached(cs, Name("ndn:/A").appendNumber(2)));
+  BOOST_CHECK(isCached(cs, Name("ndn:/A").appendNumber(3)));
+
+  // entries are listed partition by partition
+  BOOST_CHECK_EQUAL(partitioned.listEntries().size(), 7);
+  cs.setPolicy(make_unique<LruPolicy>());
+  BOOST_CHECK_EQUAL(cs.size(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(EvictBatch)
+{
+  Cs cs(10);
+  cs.setEvictionTarget(0.8);
+  PartitionedPolicy& partitioned = installPartitioned(cs, 1, 1);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(1).getEvictionTarget(), 0.8);
+
+  size_t nBatchSignals = 0;
+  size_t nBatchVictims = 0;
+  partitioned.beforeEvictBatch.connect([&] (const std::vector<iterator>& victims) {
+    ++nBatchSignals;
+    nBatchVictims += victims.size();
+  });
+
+  insertRange(cs, "ndn:/A", 0, 5);
+  insertRange(cs, "ndn:/B", 0, 5);
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+  BOOST_CHECK_EQUAL(partitioned.size(), cs.size());
+
+  // /A is over its quota of 5, and evicts down to 4 in one batch
+  cs.insert(*makeData("ndn:/A/5"));
+  BOOST_CHECK_EQUAL(nBatchSignals, 1);
+  BOOST_CHECK_EQUAL(nBatchVictims, 2);
+  BOOST_CHECK_EQUAL(cs.size(), 9);
+  BOOST_CHECK_EQUAL(partitioned.size(), cs.size());
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(1).size(), 4);
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(0).size(), 5);
+  BOOST_CHECK(!isCached(cs, "ndn:/A/0"));
+  BOOST_CHECK(!isCached(cs, "ndn:/A/1"));
+
+  // the other partition is unaffected until it exceeds its own quota
+  cs.insert(*makeData("ndn:/B/5"));
+  BOOST_CHECK_EQUAL(nBatchSignals, 2);
+  BOOST_CHECK_EQUAL(cs.size(), 8);
+  BOOST_CHECK_EQUAL(partitioned.size(), cs.size());
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(0).size() +
+                    partitioned.getPartitionPolicy(1).size(), cs.size());
+
+  // erasing after a batch keeps the counts in sync
+  size_t nErased = 0;
+  cs.erase("ndn:/A", 2, [&] (size_t n) { nErased = n; });
+  BOOST_CHECK_EQUAL(nErased, 2);
+  BOOST_CHECK_EQUAL(cs.size(), 6);
+  BOOST_CHECK_EQUAL(partitioned.size(), cs.size());
+  BOOST_CHECK_EQUAL(partitioned.getPartitionPolicy(1).size(), 2);
+
+  insertRange(cs, "ndn:/A", 6, 9);
+  BOOST_CHECK_EQUAL(nBatchSignals, 2);
+  BOOST_CHECK_EQUAL(cs.size(), 9);
+  BOOST_CHECK_EQUAL(partitioned.size(), cs.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsPartitioned
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
@@ -27,6 +27,7 @@
 #include "table/cs.hpp"
 
 #include "tests/test-common.hpp"
+#include "tests/daemon/table/cs-policy-fixture.hpp"
 
 namespace nfd {
 namespace cs {
@@ -146,6 +147,26 @@ BOOST_FIXTURE_TEST_CASE(Refresh, UnitTestTimeFixture)
           bind([] { BOOST_CHECK(true); }));
 }
 
+BOOST_FIXTURE_TEST_CASE(HandOver, CsPolicyFixture)
+{
+  Cs cs(4);
+  installPolicy<PriorityFifoPolicy>(cs);
+
+  for (const char* name : {"ndn:/D", "ndn:/A", "ndn:/C", "ndn:/B"}) {
+    shared_ptr<Data> data = makeData(name);
+    data->setFreshnessPeriod(time::milliseconds(99999));
+    data->wireEncode();
+    cs.insert(*data, data->getName() == "ndn:/C");
+  }
+
+  // unsolicited C, then D, A, and B in FIFO order
+  std::vector<Name> expectedOrder{"ndn:/C", "ndn:/D", "ndn:/A", "ndn:/B"};
+  std::vector<Name> order = getEvictionOrder(cs);
+  BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), expectedOrder.begin(), expectedOrder.end());
+
+  checkHandOver<PriorityFifoPolicy>(cs);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestCsPriorityFifo
 BOOST_AUTO_TEST_SUITE_END() // Table
 
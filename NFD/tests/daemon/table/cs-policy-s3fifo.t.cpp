@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-s3fifo.hpp"
+
+#include "tests/daemon/table/cs-policy-fixture.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Table)
+
+BOOST_FIXTURE_TEST_SUITE(TestCsS3Fifo, CsPolicyFixture)
+
+BOOST_AUTO_TEST_CASE(Registration)
+{
+  std::set<std::string> policyNames = Policy::getPolicyNames();
+  BOOST_CHECK_EQUAL(policyNames.count("s3fifo"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Queues)
+{
+  Cs cs(10);
+  S3FifoPolicy& s3fifo = installPolicy<S3FifoPolicy>(cs);
+
+  insertRange(cs, "ndn:/N", 0, 10);
+  BOOST_CHECK_EQUAL(s3fifo.getQueueSize(S3FifoPolicy::SMALL), 10);
+
+  // N/0 leaves the small queue unused and becomes a ghost
+  insertRange(cs, "ndn:/N", 10, 11);
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+  BOOST_CHECK(!isCached(cs, Name("ndn:/N").appendNumber(0)));
+  BOOST_CHECK_EQUAL(s3fifo.getGhostSize(), 1);
+
+  // N/1 was used twice on probation, so it moves to the main queue and N/2 is evicted instead
+  use(cs, Name("ndn:/N").appendNumber(1));
+  use(cs, Name("ndn:/N").appendNumber(1));
+  insertRange(cs, "ndn:/N", 11, 12);
+  BOOST_CHECK(isCached(cs, Name("ndn:/N").appendNumber(1)));
+  BOOST_CHECK(!isCached(cs, Name("ndn:/N").appendNumber(2)));
+  BOOST_CHECK_EQUAL(s3fifo.getQueueSize(S3FifoPolicy::SMALL), 9);
+  BOOST_CHECK_EQUAL(s3fifo.getQueueSize(S3FifoPolicy::MAIN), 1);
+  BOOST_CHECK_EQUAL(s3fifo.getGhostSize(), 2);
+
+  // a ghost goes directly to the main queue
+  insertRange(cs, "ndn:/N", 0, 1);
+  BOOST_CHECK(isCached(cs, Name("ndn:/N").appendNumber(0)));
+  BOOST_CHECK(!isCached(cs, Name("ndn:/N").appendNumber(3)));
+  BOOST_CHECK_EQUAL(s3fifo.getQueueSize(S3FifoPolicy::SMALL), 8);
+  BOOST_CHECK_EQUAL(s3fifo.getQueueSize(S3FifoPolicy::MAIN), 2);
+
+  // shrinking empties the small queue first; the ghost queue follows the main queue size
+  cs.setLimit(2);
+  BOOST_CHECK_EQUAL(s3fifo.getQueueSize(S3FifoPolicy::SMALL), 0);
+  BOOST_CHECK_EQUAL(s3fifo.getQueueSize(S3FifoPolicy::MAIN), 2);
+  BOOST_CHECK_LE(s3fifo.getGhostSize(), 1);
+
+  // the main queue reinserts N/1, which has been used, and evicts N/0
+  use(cs, Name("ndn:/N").appendNumber(1));
+  insertRange(cs, "ndn:/M", 0, 1);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  BOOST_CHECK(isCached(cs, Name("ndn:/N").appendNumber(1)));
+  BOOST_CHECK(!isCached(cs, Name("ndn:/N").appendNumber(0)));
+}
+
+BOOST_AUTO_TEST_CASE(ScanResistance)
+{
+  Cs cs(10);
+  installPolicy<S3FifoPolicy>(cs);
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  for (int i = 0; i < 2; ++i) {
+    use(cs, "ndn:/A");
+    use(cs, "ndn:/B");
+  }
+
+  insertRange(cs, "ndn:/scan", 0, 100);
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+  BOOST_CHECK(isCached(cs, "ndn:/A"));
+  BOOST_CHECK(isCached(cs, "ndn:/B"));
+}
+
+BOOST_AUTO_TEST_CASE(ZeroLimit)
+{
+  Cs cs(0);
+  S3FifoPolicy& s3fifo = installPolicy<S3FifoPolicy>(cs);
+
+  cs.insert(*makeData("ndn:/A"));
+  BOOST_CHECK_EQUAL(cs.size(), 0);
+  BOOST_CHECK_EQUAL(s3fifo.getQueueSize(S3FifoPolicy::SMALL), 0);
+  BOOST_CHECK_EQUAL(s3fifo.getGhostSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  Cs cs(100);
+  S3FifoPolicy& s3fifo = installPolicy<S3FifoPolicy>(cs);
+
+  insertRange(cs, "ndn:/A", 0, 60);
+  insertRange(cs, "ndn:/B", 0, 10);
+
+  // erased entries are compacted away without waiting for eviction
+  size_t nErased = 0;
+  cs.erase("ndn:/A", 100, [&] (size_t n) { nErased = n; });
+  BOOST_CHECK_EQUAL(nErased, 60);
+  BOOST_CHECK_EQUAL(s3fifo.getQueueSize(S3FifoPolicy::SMALL), 10);
+  BOOST_CHECK_EQUAL(s3fifo.listEntries().size(), 10);
+
+  insertRange(cs, "ndn:/C", 0, 200);
+  BOOST_CHECK_EQUAL(cs.size(), 100);
+  BOOST_CHECK_EQUAL(s3fifo.getQueueSize(S3FifoPolicy::SMALL), 100);
+  BOOST_CHECK(!isCached(cs, Name("ndn:/B").appendNumber(0)));
+}
+
+BOOST_AUTO_TEST_CASE(Snapshot)
+{
+  Cs cs(3);
+  installPolicy<S3FifoPolicy>(cs);
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  cs.insert(*makeData("ndn:/C"));
+  for (int i = 0; i < 2; ++i) {
+    use(cs, "ndn:/A");
+    use(cs, "ndn:/B");
+  }
+
+  // A and B move to the main queue, C is evicted
+  cs.insert(*makeData("ndn:/D"));
+  use(cs, "ndn:/A");
+
+  std::stringstream snapshot;
+  cs.saveSnapshot(snapshot);
+
+  Cs restored(3);
+  S3FifoPolicy& s3fifo = installPolicy<S3FifoPolicy>(restored);
+  BOOST_CHECK_EQUAL(restored.loadSnapshot(snapshot), 3);
+  BOOST_CHECK_EQUAL(s3fifo.getQueueSize(S3FifoPolicy::SMALL), 1);
+  BOOST_CHECK_EQUAL(s3fifo.getQueueSize(S3FifoPolicy::MAIN), 2);
+
+  restored.setLimit(2);
+  BOOST_CHECK(!isCached(restored, "ndn:/D"));
+
+  // A is at the front of the main queue, but is reinserted thanks to its restored frequency
+  restored.insert(*makeData("ndn:/E"));
+  BOOST_CHECK(isCached(restored, "ndn:/A"));
+  BOOST_CHECK(!isCached(restored, "ndn:/B"));
+  BOOST_CHECK(isCached(restored, "ndn:/E"));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsS3Fifo
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
@@ -49,6 +49,11 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
   BOOST_CHECK_EQUAL(dnl.has(nameA, nonce2), false);
   BOOST_CHECK_EQUAL(dnl.has(nameB, nonce1), false);
+
+  dnl.add(name_tree::computeHash(nameB), nonce2);
+  BOOST_CHECK_EQUAL(dnl.size(), 2);
+  BOOST_CHECK_EQUAL(dnl.has(nameB, nonce2), true);
+  BOOST_CHECK_EQUAL(dnl.has(name_tree::computeHash(nameA), nonce1), true);
 }
 
 BOOST_AUTO_TEST_CASE(MinLifetime)
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2018,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/memory-usage.hpp"
+#include "table/cs.hpp"
+#include "table/dead-nonce-list.hpp"
+#include "table/fib.hpp"
+#include "table/measurements.hpp"
+#include "table/pit.hpp"
+
+#include "tests/daemon/face/dummy-face.hpp"
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_FIXTURE_TEST_SUITE(TestMemoryUsage, BaseFixture)
+
+BOOST_AUTO_TEST_CASE(NameHeapSize)
+{
+  Name name("/A/B");
+  name.wireEncode();
+  BOOST_CHECK_EQUAL(memory_usage::getHeapSize(name),
+                    2 * sizeof(Block) + sizeof(ndn::Buffer) + memory_usage::SHARED_PTR_OVERHEAD + 8);
+
+  // a Name decoded from a packet shares the buffer of the packet
+  shared_ptr<Data> data = makeData("/A/B");
+  BOOST_CHECK_EQUAL(memory_usage::getHeapSize(data->getName()), 2 * sizeof(Block));
+
+  BOOST_CHECK_EQUAL(memory_usage::getHeapSize(CompactName(name)), 2 * 4 + 8);
+}
+
+BOOST_AUTO_TEST_CASE(Tables)
+{
+  NameTree nameTree(16);
+  Fib fib(nameTree);
+  Pit pit(nameTree);
+  Measurements measurements(nameTree);
+  size_t emptyNameTree = nameTree.getMemoryUsage();
+  BOOST_CHECK_EQUAL(fib.getMemoryUsage(), 0);
+  BOOST_CHECK_EQUAL(pit.getMemoryUsage(), 0);
+  BOOST_CHECK_EQUAL(measurements.getMemoryUsage(), 0);
+
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  fib.insert("/A").first->addNextHop(*face1, 0);
+  BOOST_CHECK_GE(fib.getMemoryUsage(), sizeof(fib::Entry) + sizeof(fib::NextHop));
+
+  shared_ptr<Interest> interest = makeInterest("/A/B/C");
+  shared_ptr<pit::Entry> pitEntry = pit.insert(*interest).first;
+  size_t pitWithoutRecords = pit.getMemoryUsage();
+  BOOST_CHECK_GE(pitWithoutRecords, sizeof(pit::Entry) + interest->wireEncode().size());
+  pitEntry->insertOrUpdateInRecord(*face1, *interest);
+  pitEntry->insertOrUpdateOutRecord(*face2, *interest);
+  size_t pitWithOneInRecord = pit.getMemoryUsage();
+  BOOST_CHECK_GE(pitWithOneInRecord, pitWithoutRecords + sizeof(pit::InRecord) + sizeof(pit::OutRecord));
+
+  // an in-record with its own Interest is counted with that Interest
+  shared_ptr<Interest> interest2 = makeInterest("/A/B/C");
+  pitEntry->insertOrUpdateInRecord(*face2, *interest2);
+  BOOST_CHECK_GE(pit.getMemoryUsage(),
+                 pitWithOneInRecord + sizeof(pit::InRecord) + interest2->wireEncode().size());
+
+  measurements.get(*pitEntry);
+  BOOST_CHECK_GE(measurements.getMemoryUsage(), sizeof(measurements::Entry));
+
+  // name tree has /, /A, /A/B, /A/B/C
+  BOOST_CHECK_GE(nameTree.getMemoryUsage(), emptyNameTree + 4 * sizeof(name_tree::Node));
+}
+
+BOOST_AUTO_TEST_CASE(DeadNonces)
+{
+  DeadNonceList dnl;
+  size_t empty = dnl.getMemoryUsage();
+  for (uint32_t nonce = 0; nonce < 100; ++nonce) {
+    dnl.add(Name("/A"), nonce);
+  }
+  BOOST_CHECK_GE(dnl.getMemoryUsage(), empty + 100 * sizeof(uint64_t));
+}
+
+BOOST_AUTO_TEST_CASE(ContentStore)
+{
+  for (const std::string& policyName : cs::Policy::getPolicyNames()) {
+    BOOST_TEST_CONTEXT("Policy " << policyName) {
+      Cs cs(100);
+      cs.setPolicy(cs::Policy::create(policyName));
+      BOOST_CHECK_EQUAL(cs.getMemoryUsage(), 0);
+      size_t emptyPolicy = cs.getPolicy()->getMemoryUsage();
+
+      shared_ptr<Data> data;
+      for (int i = 0; i < 10; ++i) {
+        data = makeData(Name("/A").appendNumber(i));
+        cs.insert(*data);
+      }
+      BOOST_CHECK_GE(cs.getMemoryUsage(), cs.size() * (sizeof(Data) + data->wireEncode().size()));
+      BOOST_CHECK_GT(cs.getPolicy()->getMemoryUsage(), emptyPolicy);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestMemoryUsage
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace nfd
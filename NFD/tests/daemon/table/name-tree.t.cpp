@@ -52,6 +52,21 @@ BOOST_AUTO_TEST_CASE(ComputeHash)
   BOOST_CHECK_EQUAL(hashes.size(), 3);
 }
 
+BOOST_AUTO_TEST_CASE(GetHashes)
+{
+  auto interest = makeInterest("/A/B/C");
+  const HashSequence& hashes = getHashes(*interest);
+  BOOST_CHECK(hashes == computeHashes(interest->getName()));
+  BOOST_CHECK(interest->getTag<HashSequenceTag>() != nullptr);
+  BOOST_CHECK_EQUAL(&getHashes(*interest), &hashes); // cached
+
+  interest->setName("/A/D");
+  BOOST_CHECK(getHashes(*interest) == computeHashes("/A/D")); // stale tag is recomputed
+
+  auto data = makeData("/E/F");
+  BOOST_CHECK(getHashes(*data) == computeHashes(data->getName()));
+}
+
 BOOST_AUTO_TEST_SUITE(Hashtable)
 using name_tree::Hashtable;
 
@@ -182,6 +197,80 @@ BOOST_AUTO_TEST_CASE(Resize)
   BOOST_CHECK_EQUAL(ht.getNBuckets(), 6);
 }
 
+BOOST_AUTO_TEST_CASE(OpenAddressing)
+{
+  HashtableOptions options(20);
+  options.layout = HashtableLayout::OPEN_ADDRESSING;
+  Hashtable ht(options);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+
+  std::map<Name, const Node*> nodes;
+  for (int i = 0; i < 500; ++i) {
+    Name name("/A");
+    name.appendNumber(i);
+    HashSequence hashes = computeHashes(name);
+
+    const Node* node = nullptr;
+    bool isNew = false;
+    std::tie(node, isNew) = ht.insert(name, name.size(), hashes);
+    BOOST_CHECK_EQUAL(isNew, true);
+    BOOST_CHECK_EQUAL(ht.find(name, name.size()), node);
+    nodes[name] = node;
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 500);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 1024);
+
+  // all nodes remain reachable during and after incremental resizing
+  for (const auto& p : nodes) {
+    BOOST_CHECK_EQUAL(ht.find(p.first, p.first.size()), p.second);
+    BOOST_CHECK_EQUAL(ht.insert(p.first, p.first.size(), computeHashes(p.first)).second, false);
+  }
+
+  std::set<const Node*> enumerated;
+  for (const Node* node = ht.getFirst(); node != nullptr; node = ht.getNext(node)) {
+    BOOST_CHECK(enumerated.insert(node).second);
+  }
+  BOOST_CHECK_EQUAL(enumerated.size(), 500);
+
+  for (int i = 0; i < 495; ++i) {
+    Name name("/A");
+    name.appendNumber(i);
+    ht.erase(const_cast<Node*>(nodes.at(name)));
+    nodes.erase(name);
+    BOOST_CHECK(ht.find(name, name.size()) == nullptr);
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 5);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+
+  for (const auto& p : nodes) {
+    BOOST_CHECK_EQUAL(ht.find(p.first, p.first.size()), p.second);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(OpenAddressingChurn)
+{
+  HashtableOptions options(16);
+  options.layout = HashtableLayout::OPEN_ADDRESSING;
+  Hashtable ht(options);
+
+  // repeated insertion and deletion leaves deleted slots, which must not fill the index
+  for (int i = 0; i < 10000; ++i) {
+    Name name("/B");
+    name.appendNumber(i);
+    const Node* node = ht.insert(name, name.size(), computeHashes(name)).first;
+    if (i >= 5) {
+      Name oldName("/B");
+      oldName.appendNumber(i - 5);
+      const Node* oldNode = ht.find(oldName, oldName.size());
+      BOOST_REQUIRE(oldNode != nullptr);
+      ht.erase(const_cast<Node*>(oldNode));
+    }
+    BOOST_CHECK_EQUAL(ht.find(name, name.size()), node);
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 5);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 16);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Hashtable
 
 BOOST_AUTO_TEST_SUITE(TestEntry)
@@ -762,6 +851,38 @@ BOOST_AUTO_TEST_CASE(SurvivedIteratorAfterErase)
   BOOST_CHECK(seenNames.size() == 7);
 }
 
+BOOST_AUTO_TEST_CASE(SurvivedIteratorOpenAddressing)
+{
+  HashtableOptions options(16);
+  options.layout = HashtableLayout::OPEN_ADDRESSING;
+  NameTree nt(options);
+  nt.lookup("/A/B/C");
+  nt.lookup("/A/D/E");
+  nt.lookup("/A/F/G");
+  nt.lookup("/H");
+
+  Name nameD("/A/D");
+  std::set<Name> seenNames;
+  for (NameTree::const_iterator it = nt.begin(); it != nt.end(); ++it) {
+    BOOST_CHECK(seenNames.insert(it->getName()).second);
+    if (it->getName() == nameD) {
+      nt.eraseIfEmpty(nt.findExactMatch("/A/F/G")); // /A/F/G and /A/F are erased
+      for (int i = 0; i < 20; ++i) { // causes resizing
+        nt.lookup(Name("/I").appendNumber(i));
+      }
+    }
+  }
+
+  BOOST_CHECK_EQUAL(seenNames.count("/"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A/B"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A/B/C"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A/D"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A/D/E"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/H"), 1);
+  BOOST_CHECK_GT(nt.getNBuckets(), 16);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestNameTree
 BOOST_AUTO_TEST_SUITE_END() // Table
 
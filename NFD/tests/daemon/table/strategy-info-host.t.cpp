@@ -77,6 +77,24 @@ public:
   int m_id;
 };
 
+class DummyStrategyInfo3 : public StrategyInfo, noncopyable
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 3;
+  }
+
+  DummyStrategyInfo3(int id)
+    : m_id(id)
+  {
+  }
+
+public:
+  int m_id;
+};
+
 BOOST_AUTO_TEST_SUITE(Table)
 BOOST_FIXTURE_TEST_SUITE(TestStrategyInfoHost, BaseFixture)
 
@@ -131,6 +149,34 @@ BOOST_AUTO_TEST_CASE(Types)
   BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfo>(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(ManyTypes)
+{
+  StrategyInfoHost host;
+  g_DummyStrategyInfo_count = 0;
+
+  host.insertStrategyInfo<DummyStrategyInfo>(4430);
+  host.insertStrategyInfo<DummyStrategyInfo2>(1522);
+  host.insertStrategyInfo<DummyStrategyInfo3>(9807);
+
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfo2>(), 1);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo2>() == nullptr);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>()->m_id, 4430);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo3>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo3>()->m_id, 9807);
+
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfo>(), 1);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 0);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo3>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo3>()->m_id, 9807);
+
+  host.insertStrategyInfo<DummyStrategyInfo>(6152);
+  host.clearStrategyInfo();
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo3>() == nullptr);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestStrategyInfoHost
 BOOST_AUTO_TEST_SUITE_END() // Table
 
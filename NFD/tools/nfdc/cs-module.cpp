@@ -40,7 +40,8 @@ CsModule::registerCommands(CommandParser& parser)
     .setTitle("change CS configuration")
     .addArg("capacity", ArgValueType::UNSIGNED, Required::NO, Positional::NO)
     .addArg("admit", ArgValueType::BOOLEAN, Required::NO, Positional::NO)
-    .addArg("serve", ArgValueType::BOOLEAN, Required::NO, Positional::NO);
+    .addArg("serve", ArgValueType::BOOLEAN, Required::NO, Positional::NO)
+    .addArg("policy", ArgValueType::STRING, Required::NO, Positional::NO);
   parser.addCommand(defCsConfig, &CsModule::config);
 }
 
@@ -52,6 +53,7 @@ CsModule::config(ExecuteContext& ctx)
   auto capacity = ctx.args.getOptional<uint64_t>("capacity");
   auto enableAdmit = ctx.args.getTribool("admit");
   auto enableServe = ctx.args.getTribool("serve");
+  auto policy = ctx.args.getOptional<std::string>("policy");
 
   ControlParameters p;
   if (capacity) {
@@ -63,6 +65,9 @@ CsModule::config(ExecuteContext& ctx)
   if (!indeterminate(enableServe)) {
     p.setFlagBit(ndn::nfd::BIT_CS_ENABLE_SERVE, enableServe);
   }
+  if (policy) {
+    p.setCsPolicy(*policy);
+  }
 
   ctx.controller.start<ndn::nfd::CsConfigCommand>(p,
     [&] (const ControlParameters& resp) {
@@ -70,8 +75,11 @@ CsModule::config(ExecuteContext& ctx)
       ctx.out << "cs-config-updated "
               << ia("capacity") << resp.getCapacity()
               << ia("admit") << text::OnOff{resp.getFlagBit(ndn::nfd::BIT_CS_ENABLE_ADMIT)}
-              << ia("serve") << text::OnOff{resp.getFlagBit(ndn::nfd::BIT_CS_ENABLE_SERVE)}
-              << '\n';
+              << ia("serve") << text::OnOff{resp.getFlagBit(ndn::nfd::BIT_CS_ENABLE_SERVE)};
+      if (resp.hasCsPolicy()) {
+        ctx.out << ia("policy") << resp.getCsPolicy();
+      }
+      ctx.out << '\n';
     },
     ctx.makeCommandFailureHandler("updating CS config"),
     ctx.makeCommandOptions());
@@ -177,15 +177,9 @@ ConsumerZipfMandelbrot::SendPacket()
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
   NS_LOG_DEBUG("Trying to add " << seq << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
+                                << m_seqTracker.GetNPendingTimeouts() << " items");
 
-  m_seqTimeouts.insert(SeqTimeout(seq, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqLastDelay.erase(seq);
-  m_seqLastDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqRetxCounts[seq]++;
+  m_seqTracker.Sent(seq, Simulator::Now());
 
   m_rtt->SentSeq(SequenceNumber32(seq), 1);
 
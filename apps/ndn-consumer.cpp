@@ -115,17 +115,10 @@ Consumer::CheckRetxTimeout()
   Time rto = m_rtt->RetransmitTimeout();
   // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
-  while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    if (entry->time + rto <= now) // timeout expired?
-    {
-      uint32_t seqNo = entry->seq;
-      m_seqTimeouts.get<i_timestamp>().erase(entry);
-      OnTimeout(seqNo);
-    }
-    else
-      break; // nothing else to do. All later packets need not be retransmitted
+  // timeouts are ordered by send time; stops at the first one that has not expired
+  uint32_t seqNo;
+  while (m_seqTracker.PopExpired(now - rto, seqNo)) {
+    OnTimeout(seqNo);
   }
 
   m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
@@ -231,21 +224,14 @@ Consumer::OnData(shared_ptr<const Data> data)
   }
   NS_LOG_DEBUG("Hop count: " << hopCount);
 
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
-  if (entry != m_seqLastDelay.end()) {
-    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
-  }
-
-  entry = m_seqFullDelay.find(seq);
-  if (entry != m_seqFullDelay.end()) {
-    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
+  const SeqTracker::Record* entry = m_seqTracker.Find(seq);
+  if (entry != nullptr) {
+    SeqTracker::Record record = *entry;
+    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - record.lastSent, hopCount);
+    m_firstInterestDataDelay(this, seq, Simulator::Now() - record.firstSent, record.retxCount, hopCount);
   }
 
-  m_seqRetxCounts.erase(seq);
-  m_seqFullDelay.erase(seq);
-  m_seqLastDelay.erase(seq);
-
-  m_seqTimeouts.erase(seq);
+  m_seqTracker.Erase(seq);
   m_retxSeqs.erase(seq);
 
   m_rtt->AckSeq(SequenceNumber32(seq));
@@ -279,15 +265,9 @@ void
 Consumer::WillSendOutInterest(uint32_t sequenceNumber)
 {
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+                                << m_seqTracker.GetNPendingTimeouts() << " items");
 
-  m_seqRetxCounts[sequenceNumber]++;
+  m_seqTracker.Sent(sequenceNumber, Simulator::Now());
 
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
 }
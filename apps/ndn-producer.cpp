@@ -21,6 +21,7 @@
 #include "ns3/log.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
@@ -63,7 +64,12 @@ Producer::GetTypeId(void)
          MakeUintegerChecker<uint32_t>())
       .AddAttribute("KeyLocator",
                     "Name to be used for key locator.  If root, then key locator is not used",
-                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker());
+                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker())
+      .AddAttribute("DataTemplate",
+                    "If true, encode Content and Signature once and share them among all "
+                    "Data packets; the packets are identical to those produced otherwise",
+                    BooleanValue(true), MakeBooleanAccessor(&Producer::m_useDataTemplate),
+                    MakeBooleanChecker());
   return tid;
 }
 
@@ -104,6 +110,17 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   // dataName.append(m_postfix);
   // dataName.appendVersion();
 
+  shared_ptr<Data> data = m_useDataTemplate ? MakeDataFromTemplate(dataName) : MakeData(dataName);
+
+  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
+
+  m_transmittedDatas(data, this, m_face);
+  m_appLink->onReceiveData(*data);
+}
+
+shared_ptr<Data>
+Producer::MakeData(const Name& dataName) const
+{
   auto data = make_shared<Data>();
   data->setName(dataName);
   data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
@@ -122,13 +139,46 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
 
   data->setSignature(signature);
 
-  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
-
   // to create real wire encoding
   data->wireEncode();
 
-  m_transmittedDatas(data, this, m_face);
-  m_appLink->onReceiveData(*data);
+  return data;
+}
+
+shared_ptr<Data>
+Producer::MakeDataFromTemplate(const Name& dataName)
+{
+  UpdateDataTemplate();
+
+  // Content and Signature share the template buffers, so the payload is neither allocated
+  // nor zeroed per packet; wireEncode copies it into the wire encoding once
+  auto data = make_shared<Data>(dataName);
+  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
+  data->setContent(m_templateContent);
+  data->setSignature(m_templateSignature);
+  data->wireEncode();
+
+  return data;
+}
+
+void
+Producer::UpdateDataTemplate()
+{
+  if (m_templateContent.hasWire() && m_templatePayloadSize == m_virtualPayloadSize
+      && m_templateSignatureValue == m_signature && m_templateKeyLocator == m_keyLocator) {
+    return;
+  }
+
+  NS_LOG_DEBUG("Encoding Data template, payload size " << m_virtualPayloadSize);
+
+  // elements of a Data made the legacy way, so that both ways produce the same packets
+  shared_ptr<Data> data = MakeData(Name());
+  m_templateContent = data->getContent();
+  m_templateSignature = data->getSignature();
+
+  m_templatePayloadSize = m_virtualPayloadSize;
+  m_templateSignatureValue = m_signature;
+  m_templateKeyLocator = m_keyLocator;
 }
 
 } // namespace ndn
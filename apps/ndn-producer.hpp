@@ -59,6 +59,30 @@ protected:
   virtual void
   StopApplication(); // Called at time specified by Stop
 
+private:
+  /**
+   * @brief Create a Data packet the way it was done before template mode
+   */
+  shared_ptr<Data>
+  MakeData(const Name& dataName) const;
+
+  /**
+   * @brief Create a Data packet that shares the cached Content and Signature
+   *
+   * Only Name and MetaInfo are encoded per packet; the wire encoding of the Data copies the
+   * payload once.
+   */
+  shared_ptr<Data>
+  MakeDataFromTemplate(const Name& dataName);
+
+  /**
+   * @brief Encode Content, SignatureInfo, and SignatureValue once
+   *
+   * The template is rebuilt if any attribute it depends on has changed.
+   */
+  void
+  UpdateDataTemplate();
+
 private:
   Name m_prefix;
   Name m_postfix;
@@ -67,6 +91,13 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  bool m_useDataTemplate;
+  Block m_templateContent; ///< Content element shared by all Data packets
+  Signature m_templateSignature; ///< SignatureInfo and SignatureValue shared by all Data packets
+  uint32_t m_templatePayloadSize;
+  uint32_t m_templateSignatureValue;
+  Name m_templateKeyLocator;
 };
 
 } // namespace ndn
@@ -5,7 +5,7 @@ export NumberOfContents=1000
 export ZipfParam=0.8
 
 # cache=(nfd::cs::lirs nfd::cs::dlirs)
-cache=(nfd::cs::lru nfd::cs::lrfu nfd::cs::ccp nfd::cs::lirs nfd::cs::dlirs)
+cache=(nfd::cs::lru nfd::cs::lrfu nfd::cs::ccp nfd::cs::lirs nfd::cs::dlirs nfd::cs::arc nfd::cs::s3fifo nfd::cs::gdsf)
 cache_size=(20 50 100 150 200)
 zipf=(0.6 0.7 0.8 0.9 1.0)
 frequency=(100 200 300 400 500)
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-cs-snapshot-helper.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include "model/ndn-l3-protocol.hpp"
+
+#include "NFD/daemon/fw/forwarder.hpp"
+#include "NFD/daemon/table/cs.hpp"
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CsSnapshotHelper");
+
+namespace ns3 {
+namespace ndn {
+
+std::string
+CsSnapshotHelper::GetFileName(Ptr<Node> node, const std::string& prefix)
+{
+  return prefix + "-" + std::to_string(node->GetId()) + ".cs";
+}
+
+size_t
+CsSnapshotHelper::Save(Ptr<Node> node, const std::string& fileName)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != nullptr, "NDN stack should be installed on the node");
+
+  std::ofstream os(fileName, std::ios::binary | std::ios::trunc);
+  if (!os) {
+    NS_FATAL_ERROR("Cannot open " << fileName << " for writing");
+  }
+
+  const nfd::Cs& cs = ndn->getForwarder()->getCs();
+  cs.saveSnapshot(os);
+  NS_LOG_DEBUG("Node " << node->GetId() << ": saved " << cs.size() << " entries to " << fileName);
+  return cs.size();
+}
+
+void
+CsSnapshotHelper::SaveNow(const NodeContainer& nodes, const std::string& prefix)
+{
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    if ((*node)->GetObject<L3Protocol>() == nullptr) {
+      continue;
+    }
+    Save(*node, GetFileName(*node, prefix));
+  }
+}
+
+void
+CsSnapshotHelper::Save(const NodeContainer& nodes, Time when, const std::string& prefix)
+{
+  Simulator::Schedule(when, &CsSnapshotHelper::SaveNow, nodes, prefix);
+}
+
+void
+CsSnapshotHelper::SaveAll(Time when, const std::string& prefix)
+{
+  Save(NodeContainer::GetGlobal(), when, prefix);
+}
+
+size_t
+CsSnapshotHelper::Restore(Ptr<Node> node, const std::string& fileName)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != nullptr, "NDN stack should be installed on the node");
+
+  std::ifstream is(fileName, std::ios::binary);
+  if (!is) {
+    NS_LOG_DEBUG("Node " << node->GetId() << ": no snapshot " << fileName);
+    return 0;
+  }
+
+  size_t nRestored = ndn->getForwarder()->getCs().loadSnapshot(is);
+  NS_LOG_DEBUG("Node " << node->GetId() << ": restored " << nRestored << " entries from " << fileName);
+  return nRestored;
+}
+
+void
+CsSnapshotHelper::Restore(const NodeContainer& nodes, const std::string& prefix)
+{
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    if ((*node)->GetObject<L3Protocol>() == nullptr) {
+      continue;
+    }
+    Restore(*node, GetFileName(*node, prefix));
+  }
+}
+
+void
+CsSnapshotHelper::RestoreAll(const std::string& prefix)
+{
+  Restore(NodeContainer::GetGlobal(), prefix);
+}
+
+} // namespace ndn
+} // namespace ns3
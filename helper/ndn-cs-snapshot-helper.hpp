@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDNSIM_HELPER_NDN_CS_SNAPSHOT_HELPER_HPP
+#define NDNSIM_HELPER_NDN_CS_SNAPSHOT_HELPER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to save and restore NFD Content Store state of nodes
+ *
+ * A snapshot contains cached Data packets together with the replacement-policy metadata
+ * (e.g., LIRS stack S and list Q, LRFU CRF values, CCP p/n values). It allows a set of runs
+ * that share the same cache warm-up to perform the warm-up once:
+ *
+ *     // warm-up run
+ *     ndn::CsSnapshotHelper::SaveAll(Seconds(100.0), "warm/cs");
+ *
+ *     // measurement runs, after the NDN stack is installed
+ *     ndn::CsSnapshotHelper::RestoreAll("warm/cs");
+ *
+ * Each node is stored in its own file named `<prefix>-<node id>.cs`.
+ * The Content Store limit and policy should be the same in both runs in order to restore
+ * policy metadata; otherwise, Data packets are inserted into the current policy.
+ */
+class CsSnapshotHelper {
+public:
+  /**
+   * @brief Write the Content Store of a node into a file
+   * @return number of saved entries
+   */
+  static size_t
+  Save(Ptr<Node> node, const std::string& fileName);
+
+  /**
+   * @brief Schedule saving Content Stores of all nodes with NDN stack at time @p when
+   */
+  static void
+  SaveAll(Time when, const std::string& prefix);
+
+  /**
+   * @brief Schedule saving Content Stores of nodes in @p nodes at time @p when
+   */
+  static void
+  Save(const NodeContainer& nodes, Time when, const std::string& prefix);
+
+  /**
+   * @brief Restore the Content Store of a node from a file
+   * @pre Content Store of the node is empty
+   * @return number of restored entries, or 0 if the file cannot be opened
+   */
+  static size_t
+  Restore(Ptr<Node> node, const std::string& fileName);
+
+  /**
+   * @brief Restore Content Stores of all nodes with NDN stack
+   *
+   * Nodes without a snapshot file are skipped.
+   */
+  static void
+  RestoreAll(const std::string& prefix);
+
+  /**
+   * @brief Restore Content Stores of nodes in @p nodes
+   */
+  static void
+  Restore(const NodeContainer& nodes, const std::string& prefix);
+
+  /**
+   * @brief Get name of the snapshot file of @p node
+   */
+  static std::string
+  GetFileName(Ptr<Node> node, const std::string& prefix);
+
+private:
+  static void
+  SaveNow(const NodeContainer& nodes, const std::string& prefix);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_HELPER_NDN_CS_SNAPSHOT_HELPER_HPP
@@ -34,6 +34,7 @@
 #include "daemon/fw/forwarder.hpp"
 #include "daemon/table/fib-entry.hpp"
 #include "daemon/table/fib-nexthop.hpp"
+#include "daemon/fw/cache-placement-policy.hpp"
 
 #include "ns3/object.h"
 #include "ns3/node.h"
@@ -52,6 +53,7 @@
 #include <boost/concept/assert.hpp>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 
+#include <queue>
 #include <unordered_map>
 
 #include "boost-graph-ndn-global-routing-helper.hpp"
@@ -386,5 +388,114 @@ GlobalRoutingHelper::CalculateAllPossibleRoutes()
   }
 }
 
+void
+GlobalRoutingHelper::CalculateCentrality()
+{
+  // Brandes' algorithm with Dijkstra searches; channels of multi-access links are vertices
+  // that paths can pass through, but they are neither sources nor targets
+  std::vector<Ptr<GlobalRouter>> routers;
+  std::unordered_map<GlobalRouter*, size_t> index;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr != 0) {
+      index.emplace(PeekPointer(gr), routers.size());
+      routers.push_back(gr);
+    }
+  }
+  size_t nNodes = routers.size();
+
+  struct Link
+  {
+    size_t to;
+    uint64_t weight;
+  };
+  std::vector<std::vector<Link>> links;
+  for (size_t v = 0; v < routers.size(); ++v) {
+    links.emplace_back();
+    for (const auto& incidency : routers[v]->GetIncidencies()) {
+      Ptr<GlobalRouter> other = std::get<2>(incidency);
+      auto inserted = index.emplace(PeekPointer(other), routers.size());
+      if (inserted.second) {
+        routers.push_back(other);
+      }
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      links[v].push_back({inserted.first->second, face == nullptr ? 0 : face->getMetric()});
+    }
+  }
+
+  const uint64_t INF = std::numeric_limits<uint64_t>::max();
+  std::vector<double> centrality(routers.size(), 0.0);
+  std::vector<uint64_t> distance(routers.size());
+  std::vector<double> nPaths(routers.size());
+  std::vector<double> dependency(routers.size());
+  std::vector<std::vector<size_t>> predecessors(routers.size());
+  std::vector<size_t> order;
+
+  typedef std::pair<uint64_t, size_t> QueueItem;
+  for (size_t source = 0; source < nNodes; ++source) {
+    std::fill(distance.begin(), distance.end(), INF);
+    std::fill(nPaths.begin(), nPaths.end(), 0.0);
+    std::fill(dependency.begin(), dependency.end(), 0.0);
+    for (auto& p : predecessors) {
+      p.clear();
+    }
+    order.clear();
+
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+    distance[source] = 0;
+    nPaths[source] = 1.0;
+    queue.push({0, source});
+    while (!queue.empty()) {
+      uint64_t d = queue.top().first;
+      size_t v = queue.top().second;
+      queue.pop();
+      if (d > distance[v]) {
+        continue;
+      }
+      order.push_back(v);
+
+      for (const Link& link : links[v]) {
+        uint64_t newDistance = d + link.weight;
+        if (newDistance < distance[link.to]) {
+          distance[link.to] = newDistance;
+          nPaths[link.to] = nPaths[v];
+          predecessors[link.to].assign(1, v);
+          queue.push({newDistance, link.to});
+        }
+        else if (newDistance == distance[link.to]) {
+          nPaths[link.to] += nPaths[v];
+          predecessors[link.to].push_back(v);
+        }
+      }
+    }
+
+    // accumulate dependencies in order of non-increasing distance
+    for (auto v = order.rbegin(); v != order.rend(); ++v) {
+      double isTarget = *v < nNodes ? 1.0 : 0.0;
+      for (size_t p : predecessors[*v]) {
+        dependency[p] += nPaths[p] / nPaths[*v] * (isTarget + dependency[*v]);
+      }
+      if (*v != source) {
+        centrality[*v] += dependency[*v];
+      }
+    }
+  }
+
+  for (size_t v = 0; v < nNodes; ++v) {
+    Ptr<Node> node = routers[v]->GetObject<Node>();
+    NS_LOG_DEBUG("Node " << node->GetId() << " has betweenness centrality " << centrality[v]);
+
+    Ptr<L3Protocol> l3 = node->GetObject<L3Protocol>();
+    if (l3 == nullptr) {
+      continue;
+    }
+    auto policy = dynamic_cast<nfd::fw::BetweennessPlacementPolicy*>(
+      &l3->getForwarder()->getCachePlacementPolicy());
+    if (policy != nullptr) {
+      policy->setCentrality(static_cast<uint64_t>(std::llround(centrality[v] * 1000)));
+    }
+  }
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -111,6 +111,22 @@ public:
   static void
   CalculateAllPossibleRoutes();
 
+  /**
+   * @brief Calculate betweenness centrality of every node and pass it to the node's cache
+   *        placement policy
+   *
+   * Centrality of a node is the number of shortest paths between ordered pairs of other nodes
+   * that pass through it, using link metrics as weights; a pair with several equal-cost paths
+   * contributes to each of them in proportion.  It is given in units of 1/1000 path to
+   * forwarders that use the "betweenness" cache placement policy (see
+   * StackHelper::setCachePlacementPolicy), and is ignored by other policies.
+   *
+   * Call this after the NDN stack and GlobalRouter interfaces have been installed, and again
+   * whenever link metrics change.
+   */
+  static void
+  CalculateCentrality();
+
 private:
   void
   Install(Ptr<Channel> channel);
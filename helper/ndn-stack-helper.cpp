@@ -34,8 +34,10 @@
 #include <limits>
 #include <map>
 #include <boost/lexical_cast.hpp>
+#include <boost/property_tree/ptree.hpp>
 
 #include "ns3/ndnSIM/NFD/daemon/face/generic-link-service.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/cache-placement-policy.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-priority-fifo.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-lru.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-lrfu.hpp"
@@ -43,6 +45,10 @@
 #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-dlirs.hpp"
 // #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-ccpcc.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-ccp.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy-arc.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy-s3fifo.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy-gdsf.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy-partitioned.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.StackHelper");
 
@@ -54,8 +60,14 @@ StackHelper::StackHelper()
   // , m_isFaceManagerDisabled(false)
   , m_isForwarderStatusManagerDisabled(false)
   , m_isStrategyChoiceManagerDisabled(false)
+  , m_isForwardingOnly(false)
   , m_needSetDefaultRoutes(false)
+  , m_allowBarePackets(false)
+  , m_congestionSojournTarget(0)
   , m_maxCsSize(100)
+  , m_csEvictionTarget(1.0)
+  , m_csRebalanceInterval(0)
+  , m_csRebalanceStep(0)
 {
   setCustomNdnCxxClocks();
 
@@ -66,6 +78,9 @@ StackHelper::StackHelper()
   m_csPolicies.insert({"nfd::cs::dlirs", [] () { return make_unique<nfd::cs::DlirsPolicy>(); }});
   // m_csPolicies.insert({"nfd::cs::ccpcc", [] () { return make_unique<nfd::cs::CcpccPolicy>(); }}); 
   m_csPolicies.insert({"nfd::cs::ccp", [] () { return make_unique<nfd::cs::CcpPolicy>(); }});   
+  m_csPolicies.insert({"nfd::cs::arc", [] () { return make_unique<nfd::cs::ArcPolicy>(); }});
+  m_csPolicies.insert({"nfd::cs::s3fifo", [] () { return make_unique<nfd::cs::S3FifoPolicy>(); }});
+  m_csPolicies.insert({"nfd::cs::gdsf", [] () { return make_unique<nfd::cs::GdsfPolicy>(); }});
 
   m_csPolicyCreationFunc = m_csPolicies["nfd::cs::lru"];
 
@@ -103,6 +118,29 @@ StackHelper::SetDefaultRoutes(bool needSet)
   m_needSetDefaultRoutes = needSet;
 }
 
+void
+StackHelper::SetBarePackets(bool allow)
+{
+  NS_LOG_FUNCTION(this << allow);
+  m_allowBarePackets = allow;
+}
+
+void
+StackHelper::setCongestionSojournTarget(const Time& target)
+{
+  if (target.IsStrictlyNegative()) {
+    NS_FATAL_ERROR("Congestion sojourn time target " << target << " must not be negative");
+  }
+  m_congestionSojournTarget = target;
+}
+
+void
+StackHelper::SetForwardingOnly(bool isForwardingOnly)
+{
+  NS_LOG_FUNCTION(this << isForwardingOnly);
+  m_isForwardingOnly = isForwardingOnly;
+}
+
 void
 StackHelper::SetStackAttributes(const std::string& attr1, const std::string& value1,
                                 const std::string& attr2, const std::string& value2,
@@ -127,6 +165,7 @@ StackHelper::SetOldContentStore(const std::string& contentStore, const std::stri
                                 const std::string& value4)
 {
   m_maxCsSize = 0;
+  m_forwardingOnlyConfig = nullptr;
 
   m_contentStoreFactory.SetTypeId(contentStore);
   if (attr1 != "")
@@ -143,6 +182,7 @@ void
 StackHelper::setCsSize(size_t maxSize)
 {
   m_maxCsSize = maxSize;
+  m_forwardingOnlyConfig = nullptr;
 }
 
 // void 
@@ -167,6 +207,98 @@ StackHelper::setPolicy(const std::string& policy)
   }
 }
 
+void
+StackHelper::setCachePlacementPolicy(const std::string& policy)
+{
+  if (nfd::fw::CachePlacementPolicy::getPolicyNames().count(policy) == 0) {
+    NS_FATAL_ERROR("Cache placement policy " << policy << " not found");
+  }
+  m_csPlacementPolicy = policy;
+  m_forwardingOnlyConfig = nullptr;
+}
+
+void
+StackHelper::addCsPartition(const Name& prefix, double weight, const std::string& policy)
+{
+  if (weight <= 0) {
+    NS_FATAL_ERROR("Weight of CS partition " << prefix << " must be positive");
+  }
+
+  PolicyCreationCallback creationFunc;
+  if (!policy.empty()) {
+    auto found = m_csPolicies.find(policy);
+    if (found == m_csPolicies.end()) {
+      NS_FATAL_ERROR("Cache replacement policy " << policy << " not found");
+    }
+    creationFunc = found->second;
+  }
+  m_csPartitions.push_back({prefix, weight, creationFunc});
+}
+
+void
+StackHelper::setCsRebalancing(size_t nInserts, size_t step)
+{
+  m_csRebalanceInterval = nInserts;
+  m_csRebalanceStep = step;
+}
+
+void
+StackHelper::setCsEvictionTarget(double fraction)
+{
+  if (!(fraction > 0 && fraction <= 1)) {
+    NS_FATAL_ERROR("CS eviction target " << fraction << " must be in (0, 1]");
+  }
+  m_csEvictionTarget = fraction;
+  m_forwardingOnlyConfig = nullptr;
+}
+
+StackHelper::PolicyCreationCallback
+StackHelper::getCsPolicyCreationFunc() const
+{
+  if (m_csPartitions.empty()) {
+    return m_csPolicyCreationFunc;
+  }
+
+  auto partitions = m_csPartitions;
+  auto defaultFunc = m_csPolicyCreationFunc;
+  size_t interval = m_csRebalanceInterval;
+  size_t step = m_csRebalanceStep;
+  return [=] () -> std::unique_ptr<nfd::cs::Policy> {
+    auto policy = make_unique<nfd::cs::PartitionedPolicy>();
+    policy->addPartition("/", defaultFunc());
+    for (const CsPartition& partition : partitions) {
+      policy->addPartition(partition.prefix,
+                           partition.policy ? partition.policy() : defaultFunc(),
+                           partition.weight);
+    }
+    policy->setRebalanceStep(step);
+    policy->setRebalanceInterval(interval);
+    return policy;
+  };
+}
+
+void
+StackHelper::UpdateCsPolicy(Ptr<Node> node, const std::string& policy) const
+{
+  auto found = m_csPolicies.find(policy);
+  if (found == m_csPolicies.end()) {
+    NS_FATAL_ERROR("Cache replacement policy " << policy << " not found");
+  }
+
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != nullptr, "NDN stack is not installed on node " << node->GetId());
+  NS_LOG_DEBUG("Node " << node->GetId() << " switches CS policy to " << policy);
+  ndn->setCsReplacementPolicy(found->second);
+}
+
+void
+StackHelper::UpdateCsPolicy(const NodeContainer& c, const std::string& policy) const
+{
+  for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
+    UpdateCsPolicy(*i, policy);
+  }
+}
+
 Ptr<FaceContainer>
 StackHelper::Install(const NodeContainer& c) const
 {
@@ -196,23 +328,42 @@ StackHelper::Install(Ptr<Node> node) const
 
   Ptr<L3Protocol> ndn = m_ndnFactory.Create<L3Protocol>();
 
-  if (m_isRibManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_rib_manager", true);
+  if (m_isForwardingOnly) {
+    if (m_forwardingOnlyConfig == nullptr) {
+      auto config = make_shared<nfd::ConfigSection>();
+      config->put_child("tables", L3Protocol::getDefaultConfig()->get_child("tables"));
+      config->put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
+      config->put("tables.cs_eviction_target", m_csEvictionTarget);
+      if (!m_csPlacementPolicy.empty()) {
+        config->put("tables.cs_placement_policy", m_csPlacementPolicy);
+      }
+      m_forwardingOnlyConfig = config;
+    }
+    ndn->setForwardingOnly(m_forwardingOnlyConfig);
   }
+  else {
+    if (m_isRibManagerDisabled) {
+      ndn->getConfig().put("ndnSIM.disable_rib_manager", true);
+    }
 
-  // if (m_isFaceManagerDisabled) {
-  //   ndn->getConfig().put("ndnSIM.disable_face_manager", true);
-  // }
+    // if (m_isFaceManagerDisabled) {
+    //   ndn->getConfig().put("ndnSIM.disable_face_manager", true);
+    // }
 
-  if (m_isForwarderStatusManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_forwarder_status_manager", true);
-  }
+    if (m_isForwarderStatusManagerDisabled) {
+      ndn->getConfig().put("ndnSIM.disable_forwarder_status_manager", true);
+    }
 
-  if (m_isStrategyChoiceManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
-  }
+    if (m_isStrategyChoiceManagerDisabled) {
+      ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
+    }
 
-  ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
+    ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
+    ndn->getConfig().put("tables.cs_eviction_target", m_csEvictionTarget);
+    if (!m_csPlacementPolicy.empty()) {
+      ndn->getConfig().put("tables.cs_placement_policy", m_csPlacementPolicy);
+    }
+  }
 
   // Create and aggregate content store if NFD's contest store has been disabled
   if (m_maxCsSize == 0) {
@@ -220,7 +371,7 @@ StackHelper::Install(Ptr<Node> node) const
   }
   // if NFD's CS is enabled, check if a replacement policy has been specified
   else {
-    ndn->setCsReplacementPolicy(m_csPolicyCreationFunc);
+    ndn->setCsReplacementPolicy(getCsPolicyCreationFunc());
   }
 
   // Aggregate L3Protocol on node (must be after setting ndnSIM CS)
@@ -290,6 +441,11 @@ StackHelper::DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   ::nfd::face::GenericLinkService::Options opts;
   opts.allowFragmentation = true;
   opts.allowReassembly = true;
+  opts.allowBarePackets = m_allowBarePackets;
+  if (m_congestionSojournTarget.IsStrictlyPositive()) {
+    opts.allowCongestionMarking = true;
+    opts.congestionSojournTarget = ::ndn::time::nanoseconds(m_congestionSojournTarget.GetNanoSeconds());
+  }
 
   auto linkService = make_unique<::nfd::face::GenericLinkService>(opts);
 
@@ -328,6 +484,11 @@ StackHelper::PointToPointNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   ::nfd::face::GenericLinkService::Options opts;
   opts.allowFragmentation = true;
   opts.allowReassembly = true;
+  opts.allowBarePackets = m_allowBarePackets;
+  if (m_congestionSojournTarget.IsStrictlyPositive()) {
+    opts.allowCongestionMarking = true;
+    opts.congestionSojournTarget = ::ndn::time::nanoseconds(m_congestionSojournTarget.GetNanoSeconds());
+  }
 
   auto linkService = make_unique<::nfd::face::GenericLinkService>(opts);
 
@@ -31,7 +31,10 @@
 #include "ndn-fib-helper.hpp"
 #include "ndn-strategy-choice-helper.hpp"
 
+#include <boost/property_tree/ptree_fwd.hpp>
+
 namespace nfd {
+typedef boost::property_tree::ptree ConfigSection;
 namespace cs {
 class Policy;
 } // namespace cs
@@ -86,6 +89,81 @@ public:
   void
   setPolicy(const std::string& policy);
 
+  /**
+   * @brief Set the cache placement policy, which decides whether a forwarder caches a Data
+   *
+   * By default ("everywhere"), every forwarder on the path caches every Data it forwards.
+   * Other policies cache fewer copies at chosen places: "lcd" (Leave Copy Down),
+   * "probcache" (ProbCache), and "betweenness" (the node with the highest betweenness
+   * centrality on the path).  "betweenness" needs GlobalRoutingHelper::CalculateCentrality
+   * after the stacks and GlobalRouter interfaces are installed.  The policies rely on the
+   * HopCount field, so they are not meant for faces that send bare packets.
+   *
+   * The replacement policy (setPolicy) is unaffected.  Applies to NFD's Content Store as well
+   * as ndnSIM 1.0 content stores.
+   */
+  void
+  setCachePlacementPolicy(const std::string& policy);
+
+  /**
+   * @brief Give a name prefix its own partition of NFD's Content Store
+   *
+   * Data under @p prefix is cached only within the quota of its partition, and is managed
+   * by the partition's own replacement policy, so that other traffic cannot evict it.  The
+   * capacity (setCsSize) is divided among partitions in proportion to their weights.  Data
+   * under no partition prefix goes to the partition of "/", which uses the policy given by
+   * setPolicy and has weight 1, unless "/" is configured here.
+   *
+   * @param prefix Name prefix of the partition
+   * @param weight Share of the capacity, relative to weights of other partitions
+   * @param policy Replacement policy name, as in setPolicy; empty selects the setPolicy one
+   */
+  void
+  addCsPartition(const Name& prefix, double weight, const std::string& policy = "");
+
+  /**
+   * @brief Let partitions of NFD's Content Store trade capacity (see addCsPartition)
+   *
+   * Capacity moves towards the partition whose recently evicted Data is requested again most
+   * often, i.e., the one with the highest marginal hit gain.
+   *
+   * @param nInserts Number of insertions between decisions; 0 disables rebalancing
+   * @param step Number of entries moved by one decision; 0 selects 1/64 of the capacity
+   */
+  void
+  setCsRebalancing(size_t nInserts, size_t step = 0);
+
+  /**
+   * @brief Set how far NFD's Content Store evicts once it is full
+   *
+   * With a fraction below 1, an insertion into a full Content Store evicts it down to
+   * @p fraction of its capacity (setCsSize) in one batch, rather than one Data packet per
+   * insertion.  Policies that do not support batched eviction evict one Data packet per
+   * insertion regardless.
+   *
+   * @param fraction Fraction of the capacity to evict down to, in (0, 1]; default is 1
+   */
+  void
+  setCsEvictionTarget(double fraction);
+
+  /**
+   * @brief Replace the cache replacement policy of NFD's Content Store on an installed node
+   *
+   * Can be scheduled while the simulation is running.  Cached Data packets are kept and
+   * handed over to the new policy, coldest first.
+   *
+   * @param node Node with NDN stack installed
+   * @param policy Policy name, as in setPolicy (e.g., "nfd::cs::lru")
+   */
+  void
+  UpdateCsPolicy(Ptr<Node> node, const std::string& policy) const;
+
+  /**
+   * @brief Replace the cache replacement policy of NFD's Content Store on installed nodes
+   */
+  void
+  UpdateCsPolicy(const NodeContainer& c, const std::string& policy) const;
+
   /**
    * @brief Set ndnSIM 1.0 content store implementation and its attributes
    * @param contentStoreClass string, representing class of the content store
@@ -190,6 +268,44 @@ public:
   void
   SetDefaultRoutes(bool needSet);
 
+  /**
+   * \brief Set flag allowing faces to send Interest and Data without NDNLPv2 header
+   *
+   * Applies to faces created afterwards by the default face creation callbacks.  A packet is
+   * sent bare only if it needs no link protocol field, e.g., no fragmentation and no
+   * congestion mark.  HopCount is not conveyed in bare packets, so hop counts reported by
+   * tracers and applications are unavailable for them.
+   */
+  void
+  SetBarePackets(bool allow);
+
+  /**
+   * @brief Enable CoDel-style congestion marking on faces, with the given sojourn time target
+   *
+   * Applies to faces created afterwards by the default face creation callbacks.  A face marks
+   * packets once the oldest packet in its NetDevice send queue has waited longer than
+   * @p target for a whole marking interval.  Zero (the default) disables congestion marking.
+   *
+   * @param target Send queue sojourn time target; must not be negative
+   */
+  void
+  setCongestionSojournTarget(const Time& target);
+
+  /**
+   * \brief Set flag to install forwarding-only stacks
+   *
+   * A forwarding-only stack has nfd::Forwarder with its tables and faces, but no internal face,
+   * no NFD management, and no RIB manager (see L3Protocol::setForwardingOnly).  All stacks
+   * installed by this helper share one immutable tables config, instead of each keeping a
+   * copy.  This reduces per-node memory and setup time in large topologies.
+   *
+   * FibHelper, StrategyChoiceHelper, and GlobalRoutingHelper work on forwarding-only stacks.
+   * Anything that sends /localhost/nfd commands, e.g., prefix registration through ndn-cxx
+   * Face, does not.  The disable*Manager flags have no effect on forwarding-only stacks.
+   */
+  void
+  SetForwardingOnly(bool isForwardingOnly);
+
   static KeyChain&
   getKeyChain();
 
@@ -262,6 +378,7 @@ private:
   // bool m_isFaceManagerDisabled;
   bool m_isForwarderStatusManagerDisabled;
   bool m_isStrategyChoiceManagerDisabled;
+  bool m_isForwardingOnly;
 
 public:
   void
@@ -272,11 +389,35 @@ private:
   ObjectFactory m_contentStoreFactory;
 
   bool m_needSetDefaultRoutes;
+  bool m_allowBarePackets;
+  Time m_congestionSojournTarget;
   size_t m_maxCsSize;
+  double m_csEvictionTarget;
+  std::string m_csPlacementPolicy;
+
+  /// tables config shared by forwarding-only stacks, created on first Install
+  mutable shared_ptr<const nfd::ConfigSection> m_forwardingOnlyConfig;
 
   typedef std::function<std::unique_ptr<nfd::cs::Policy>()> PolicyCreationCallback;
   PolicyCreationCallback m_csPolicyCreationFunc;
 
+  /**
+   * @brief Get the function that creates the replacement policy of NFD's Content Store,
+   *        which is partitioned if addCsPartition has been used
+   */
+  PolicyCreationCallback
+  getCsPolicyCreationFunc() const;
+
+  struct CsPartition
+  {
+    Name prefix;
+    double weight;
+    PolicyCreationCallback policy; ///< empty selects m_csPolicyCreationFunc
+  };
+  std::vector<CsPartition> m_csPartitions;
+  size_t m_csRebalanceInterval;
+  size_t m_csRebalanceStep;
+
   std::map<std::string, PolicyCreationCallback> m_csPolicies;
 
   typedef std::list<std::pair<TypeId, FaceCreateCallback>> NetDeviceCallbackList;
@@ -31,6 +31,18 @@ NS_LOG_COMPONENT_DEFINE("ndn.StrategyChoiceHelper");
 void
 StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (l3protocol->isForwardingOnly()) {
+    // there is no strategy choice manager; update the table the same way it would
+    auto res = l3protocol->getForwarder()->getStrategyChoice().insert(parameters.getName(),
+                                                                      parameters.getStrategy());
+    if (!res) {
+      NS_FATAL_ERROR("Cannot set strategy " << parameters.getStrategy() << " for "
+                     << parameters.getName() << " on node " << node->GetId() << ": " << res);
+    }
+    return;
+  }
+
   NS_LOG_DEBUG("Strategy choice command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -41,7 +53,6 @@ StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node>
   shared_ptr<Interest> command(make_shared<Interest>(commandName));
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
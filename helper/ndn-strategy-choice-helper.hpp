@@ -56,6 +56,9 @@ using ::ndn::nfd::ControlParameters;
  * The Strategy Choice helper interacts with the Strategy Choice manager of NFD by sending
  * special Interest commands to the manager in order to specify the desired per-name
  * prefix forwarding strategy for one, more or all the nodes of a topology.
+ *
+ * On a forwarding-only stack (see StackHelper::SetForwardingOnly), which has no Strategy
+ * Choice manager, the helper modifies the Strategy Choice table directly.
  */
 class StrategyChoiceHelper
 {
@@ -119,8 +119,10 @@ public:
    *
    * If an entry is found, it is promoted to the top of most recent
    * used entries index, \see m_contentStore
+   *
+   * \return the cached Data itself rather than a copy, or nullptr if there is no match
    */
-  virtual shared_ptr<Data>
+  virtual shared_ptr<const Data>
   Lookup(shared_ptr<const Interest> interest) = 0;
 
   /**
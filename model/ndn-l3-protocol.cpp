@@ -111,58 +111,15 @@ L3Protocol::GetTypeId(void)
 class L3Protocol::Impl {
 private:
   Impl()
+    : m_sharedConfig(L3Protocol::getDefaultConfig())
+    , m_isForwardingOnly(false)
   {
-    // Do not modify initial config file. Use helpers to set specific NFD parameters
-    std::string initialConfig =
-      "general\n"
-      "{\n"
-      "}\n"
-      "\n"
-      "tables\n"
-      "{\n"
-      "  cs_max_packets 100\n"
-      "\n"
-      "  strategy_choice\n"
-      "  {\n"
-      "    /               /localhost/nfd/strategy/best-route\n"
-      "    /localhost      /localhost/nfd/strategy/multicast\n"
-      "    /localhost/nfd  /localhost/nfd/strategy/best-route\n"
-      "    /ndn/multicast  /localhost/nfd/strategy/multicast\n"
-      "  }\n"
-      "}\n"
-      "\n"
-      // "face_system\n"
-      // "{\n"
-      // "}\n"
-      "\n"
-      "authorizations\n"
-      "{\n"
-      "  authorize\n"
-      "  {\n"
-      "    certfile any\n"
-      "    privileges\n"
-      "    {\n"
-      "      faces\n"
-      "      fib\n"
-      "      strategy-choice\n"
-      "    }\n"
-      "  }\n"
-      "}\n"
-      "\n"
-      "rib\n"
-      "{\n"
-      "  localhost_security\n"
-      "  {\n"
-      "    trust-anchor\n"
-      "    {\n"
-      "      type any\n"
-      "    }\n"
-      "  }\n"
-      "}\n"
-      "\n";
-
-    std::istringstream input(initialConfig);
-    boost::property_tree::read_info(input, m_config);
+  }
+
+  const nfd::ConfigSection&
+  getConfig() const
+  {
+    return m_config != nullptr ? *m_config : *m_sharedConfig;
   }
 
   friend class L3Protocol;
@@ -186,12 +143,75 @@ private:
 
   std::shared_ptr<nfd::face::FaceSystem> m_faceSystem;
 
-  nfd::ConfigSection m_config;
+  std::shared_ptr<const nfd::ConfigSection> m_sharedConfig;
+  std::unique_ptr<nfd::ConfigSection> m_config; ///< private copy of m_sharedConfig, made by getConfig()
+  bool m_isForwardingOnly;
 
   Ptr<ContentStore> m_csFromNdnSim;
   PolicyCreationCallback m_policy;
 };
 
+shared_ptr<const nfd::ConfigSection>
+L3Protocol::getDefaultConfig()
+{
+  static shared_ptr<const nfd::ConfigSection> config = [] {
+      // Do not modify initial config file. Use helpers to set specific NFD parameters
+      std::string initialConfig =
+        "general\n"
+        "{\n"
+        "}\n"
+        "\n"
+        "tables\n"
+        "{\n"
+        "  cs_max_packets 100\n"
+        "\n"
+        "  strategy_choice\n"
+        "  {\n"
+        "    /               /localhost/nfd/strategy/best-route\n"
+        "    /localhost      /localhost/nfd/strategy/multicast\n"
+        "    /localhost/nfd  /localhost/nfd/strategy/best-route\n"
+        "    /ndn/multicast  /localhost/nfd/strategy/multicast\n"
+        "  }\n"
+        "}\n"
+        "\n"
+        // "face_system\n"
+        // "{\n"
+        // "}\n"
+        "\n"
+        "authorizations\n"
+        "{\n"
+        "  authorize\n"
+        "  {\n"
+        "    certfile any\n"
+        "    privileges\n"
+        "    {\n"
+        "      faces\n"
+        "      fib\n"
+        "      strategy-choice\n"
+        "    }\n"
+        "  }\n"
+        "}\n"
+        "\n"
+        "rib\n"
+        "{\n"
+        "  localhost_security\n"
+        "  {\n"
+        "    trust-anchor\n"
+        "    {\n"
+        "      type any\n"
+        "    }\n"
+        "  }\n"
+        "}\n"
+        "\n";
+
+      auto section = make_shared<nfd::ConfigSection>();
+      std::istringstream input(initialConfig);
+      boost::property_tree::read_info(input, *section);
+      return section;
+    }();
+  return config;
+}
+
 L3Protocol::L3Protocol()
   : m_impl(new Impl())
 {
@@ -208,12 +228,18 @@ L3Protocol::initialize()
 {
   m_impl->m_forwarder = make_shared<nfd::Forwarder>();
 
-  initializeManagement();
+  if (m_impl->m_isForwardingOnly) {
+    initializeTables();
+  }
+  else {
+    initializeManagement();
+  }
 
   nfd::FaceTable& faceTable = m_impl->m_forwarder->getFaceTable();
   faceTable.addReserved(nfd::face::makeNullFace(), nfd::face::FACEID_NULL);
 
-  if (!this->getConfig().get<bool>("ndnSIM.disable_rib_manager", false)) {
+  if (!m_impl->m_isForwardingOnly &&
+      !m_impl->getConfig().get<bool>("ndnSIM.disable_rib_manager", false)) {
     Simulator::ScheduleWithContext(m_node->GetId(), Seconds(0), &L3Protocol::initializeRibManager, this);
   }
 
@@ -245,6 +271,8 @@ private:
 void
 L3Protocol::injectInterest(const Interest& interest)
 {
+  NS_ASSERT_MSG(m_impl->m_internalFace != nullptr,
+                "Forwarding-only stack has no internal face to inject " << interest.getName());
   m_impl->m_internalFace->sendInterest(interest);
 }
 
@@ -252,6 +280,11 @@ void
 L3Protocol::setCsReplacementPolicy(const PolicyCreationCallback& policy)
 {
   m_impl->m_policy = policy;
+
+  // after initialization, replace the policy right away; cached Data are handed over
+  if (m_impl->m_forwarder != nullptr && m_impl->m_csFromNdnSim == nullptr) {
+    m_impl->m_forwarder->getCs().setPolicy(m_impl->m_policy());
+  }
 }
 
 void
@@ -284,7 +317,7 @@ L3Protocol::initializeManagement()
   //   this->getConfig().get_child("authorizations").get_child("authorize").get_child("privileges").erase("faces");
   // }
 
-  if (!this->getConfig().get<bool>("ndnSIM.disable_strategy_choice_manager", false)) {
+  if (!m_impl->getConfig().get<bool>("ndnSIM.disable_strategy_choice_manager", false)) {
     m_impl->m_strategyChoiceManager.reset(new StrategyChoiceManager(forwarder->getStrategyChoice(),
                                                                     *m_impl->m_dispatcher,
                                                                     *m_impl->m_authenticator));
@@ -293,7 +326,7 @@ L3Protocol::initializeManagement()
     this->getConfig().get_child("authorizations").get_child("authorize").get_child("privileges").erase("strategy-choice");
   }
 
-  if (!this->getConfig().get<bool>("ndnSIM.disable_forwarder_status_manager", false)) {
+  if (!m_impl->getConfig().get<bool>("ndnSIM.disable_forwarder_status_manager", false)) {
     m_impl->m_forwarderStatusManager.reset(new ForwarderStatusManager(*forwarder, *m_impl->m_dispatcher));
   }
 
@@ -315,7 +348,7 @@ L3Protocol::initializeManagement()
   // }
 
   // apply config
-  config.parse(m_impl->m_config, false, "ndnSIM.conf");
+  config.parse(m_impl->getConfig(), false, "ndnSIM.conf");
 
   tablesConfig.ensureConfigured();
 
@@ -326,6 +359,27 @@ L3Protocol::initializeManagement()
   m_impl->m_dispatcher->addTopPrefix(topPrefix, false);
 }
 
+void
+L3Protocol::initializeTables()
+{
+  auto& forwarder = m_impl->m_forwarder;
+  using namespace nfd;
+
+  m_impl->m_csFromNdnSim = GetObject<ContentStore>();
+  if (m_impl->m_csFromNdnSim == nullptr) {
+    forwarder->getCs().setPolicy(m_impl->m_policy());
+  }
+
+  // only the tables section applies; other sections configure management, which is not created
+  ConfigFile config(&ConfigFile::ignoreUnknownSection);
+  TablesConfigSection tablesConfig(*forwarder);
+  tablesConfig.setConfigFile(config);
+
+  config.parse(m_impl->getConfig(), false, "ndnSIM.conf");
+
+  tablesConfig.ensureConfigured();
+}
+
 void
 L3Protocol::initializeRibManager()
 {
@@ -355,7 +409,7 @@ L3Protocol::initializeRibManager()
   m_impl->m_ribManager->setConfigFile(config);
 
   // apply config
-  config.parse(m_impl->m_config, false, "ndnSIM.conf");
+  config.parse(m_impl->getConfig(), false, "ndnSIM.conf");
 
   m_impl->m_ribManager->registerWithNfd();
 }
@@ -381,7 +435,29 @@ L3Protocol::getStrategyChoiceManager()
 nfd::ConfigSection&
 L3Protocol::getConfig()
 {
-  return m_impl->m_config;
+  NS_ASSERT_MSG(!m_impl->m_isForwardingOnly, "Config of a forwarding-only stack is immutable");
+
+  if (m_impl->m_config == nullptr) {
+    m_impl->m_config = make_unique<nfd::ConfigSection>(*m_impl->m_sharedConfig);
+  }
+  return *m_impl->m_config;
+}
+
+void
+L3Protocol::setForwardingOnly(shared_ptr<const nfd::ConfigSection> config)
+{
+  NS_ASSERT_MSG(m_node == nullptr, "Stack is already aggregated to a node");
+  NS_ASSERT(config != nullptr);
+
+  m_impl->m_isForwardingOnly = true;
+  m_impl->m_sharedConfig = std::move(config);
+  m_impl->m_config.reset();
+}
+
+bool
+L3Protocol::isForwardingOnly() const
+{
+  return m_impl->m_isForwardingOnly;
 }
 
 /*
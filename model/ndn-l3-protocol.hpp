@@ -146,12 +146,46 @@ public:
 
   /**
    * \brief Get NFD config (boost::property_tree)
+   *
+   * The first call makes a private copy of the default config, which can then be modified
+   * before the stack is aggregated to a node.
+   *
+   * \pre the stack is not forwarding-only
    */
   nfd::ConfigSection&
   getConfig();
 
+  /**
+   * \brief Get the config that every stack starts with
+   *
+   * It is parsed once and shared by all stacks that do not modify their config.
+   */
+  static shared_ptr<const nfd::ConfigSection>
+  getDefaultConfig();
+
+  /**
+   * \brief Make the stack forwarding-only
+   *
+   * A forwarding-only stack consists of nfd::Forwarder with its tables and faces.  It has no
+   * internal face, no management (FIB, face, strategy choice, and forwarder status managers),
+   * and no RIB manager, so it cannot process /localhost/nfd commands.  FibHelper and
+   * StrategyChoiceHelper modify the tables of such a stack directly.
+   *
+   * \param config tables config to apply, which may be shared among many stacks
+   * \pre the stack is not yet aggregated to a node
+   */
+  void
+  setForwardingOnly(shared_ptr<const nfd::ConfigSection> config);
+
+  /**
+   * \brief Check whether the stack is forwarding-only
+   */
+  bool
+  isForwardingOnly() const;
+
   /**
    * \brief Inject interest through internal Face
+   * \pre the stack is not forwarding-only
    */
   void
   injectInterest(const Interest& interest);
@@ -160,6 +194,9 @@ public:
 
   /**
    * \brief Set the replacement policy of NFD's CS
+   *
+   * If the stack is already initialized, the policy is replaced immediately and the
+   * cached Data packets are handed over to the new policy.
    */
   void
   setCsReplacementPolicy(const PolicyCreationCallback& policy);
@@ -195,6 +232,9 @@ private:
   void
   initializeManagement();
 
+  void
+  initializeTables();
+
   void
   initializeRibManager();
 
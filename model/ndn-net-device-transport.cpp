@@ -43,6 +43,7 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
                                        ::ndn::nfd::LinkType linkType)
   : m_netDevice(netDevice)
   , m_node(node)
+  , m_txQueueBytes(0)
 {
   this->setLocalUri(FaceUri(localUri));
   this->setRemoteUri(FaceUri(remoteUri));
@@ -51,12 +52,22 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
   this->setLinkType(linkType);
   this->setMtu(m_netDevice->GetMtu()); // Use the MTU of the netDevice
 
-  // Get send queue capacity for congestion marking
+  // Get send queue capacity for congestion marking, and subscribe to send queue changes
   PointerValue txQueueAttribute;
   if (m_netDevice->GetAttributeFailSafe("TxQueue", txQueueAttribute)) {
-    Ptr<ns3::QueueBase> txQueue = txQueueAttribute.Get<ns3::QueueBase>();
+    m_txQueue = txQueueAttribute.Get<ns3::QueueBase>();
     // must be put into bytes mode queue
-    this->setSendQueueCapacity(txQueue->GetMaxBytes());
+    this->setSendQueueCapacity(m_txQueue->GetMaxBytes());
+
+    m_txQueueBytes = m_txQueue->GetNBytes();
+    m_txQueue->TraceConnectWithoutContext("BytesInQueue",
+                                          MakeCallback(&NetDeviceTransport::onTxQueueBytesChanged, this));
+    m_txQueue->TraceConnectWithoutContext("Enqueue",
+                                          MakeCallback(&NetDeviceTransport::onTxQueueEnqueue, this));
+    m_txQueue->TraceConnectWithoutContext("Dequeue",
+                                          MakeCallback(&NetDeviceTransport::onTxQueueDequeue, this));
+    m_txQueue->TraceConnectWithoutContext("DropAfterDequeue",
+                                          MakeCallback(&NetDeviceTransport::onTxQueueDequeue, this));
   }
 
   NS_LOG_FUNCTION(this << "Creating an ndnSIM transport instance for netDevice with URI"
@@ -72,19 +83,64 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
 NetDeviceTransport::~NetDeviceTransport()
 {
   NS_LOG_FUNCTION_NOARGS();
+
+  if (m_txQueue != nullptr) {
+    m_txQueue->TraceDisconnectWithoutContext("BytesInQueue",
+                                             MakeCallback(&NetDeviceTransport::onTxQueueBytesChanged, this));
+    m_txQueue->TraceDisconnectWithoutContext("Enqueue",
+                                             MakeCallback(&NetDeviceTransport::onTxQueueEnqueue, this));
+    m_txQueue->TraceDisconnectWithoutContext("Dequeue",
+                                             MakeCallback(&NetDeviceTransport::onTxQueueDequeue, this));
+    m_txQueue->TraceDisconnectWithoutContext("DropAfterDequeue",
+                                             MakeCallback(&NetDeviceTransport::onTxQueueDequeue, this));
+  }
 }
 
 ssize_t
 NetDeviceTransport::getSendQueueLength()
 {
-  PointerValue txQueueAttribute;
-  if (m_netDevice->GetAttributeFailSafe("TxQueue", txQueueAttribute)) {
-    Ptr<ns3::QueueBase> txQueue = txQueueAttribute.Get<ns3::QueueBase>();
-    return txQueue->GetNBytes();
-  }
-  else {
+  if (m_txQueue == nullptr) {
     return nfd::face::QUEUE_UNSUPPORTED;
   }
+  return m_txQueueBytes;
+}
+
+time::nanoseconds
+NetDeviceTransport::getSendQueueSojournTime()
+{
+  if (m_txQueue == nullptr) {
+    return time::nanoseconds(nfd::face::QUEUE_UNSUPPORTED);
+  }
+  if (m_txQueueArrivals.empty()) {
+    return time::nanoseconds::zero();
+  }
+  return time::nanoseconds((Simulator::Now() - m_txQueueArrivals.front().second).GetNanoSeconds());
+}
+
+void
+NetDeviceTransport::onTxQueueBytesChanged(uint32_t oldValue, uint32_t newValue)
+{
+  m_txQueueBytes = newValue;
+}
+
+void
+NetDeviceTransport::onTxQueueEnqueue(Ptr<const ns3::Packet> packet)
+{
+  m_txQueueArrivals.emplace_back(packet->GetUid(), Simulator::Now());
+}
+
+void
+NetDeviceTransport::onTxQueueDequeue(Ptr<const ns3::Packet> packet)
+{
+  // TxQueue is FIFO, so the packet is normally at the front; packets that were queued before
+  // the transport subscribed are not found and ignored
+  auto it = std::find_if(m_txQueueArrivals.begin(), m_txQueueArrivals.end(),
+                         [packet] (const std::pair<uint64_t, Time>& arrival) {
+                           return arrival.first == packet->GetUid();
+                         });
+  if (it != m_txQueueArrivals.end()) {
+    m_txQueueArrivals.erase(m_txQueueArrivals.begin(), it + 1);
+  }
 }
 
 void
@@ -31,6 +31,9 @@
 
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
+#include "ns3/queue.h"
+
+#include <deque>
 
 namespace ns3 {
 namespace ndn {
@@ -38,6 +41,10 @@ namespace ndn {
 /**
  * \ingroup ndn-face
  * \brief ndnSIM-specific transport
+ *
+ * If the NetDevice has a TxQueue, the transport subscribes to its trace sources once and
+ * keeps the send queue length and the enqueue times of queued packets up to date, so that
+ * congestion detection in the link service does not need to look up the queue per packet.
  */
 class NetDeviceTransport : public nfd::face::Transport
 {
@@ -57,6 +64,9 @@ public:
   virtual ssize_t
   getSendQueueLength() final;
 
+  virtual time::nanoseconds
+  getSendQueueSojournTime() final;
+
 private:
   virtual void
   doClose() override;
@@ -71,8 +81,24 @@ private:
                        const Address& from, const Address& to,
                        NetDevice::PacketType packetType);
 
+  void
+  onTxQueueBytesChanged(uint32_t oldValue, uint32_t newValue);
+
+  void
+  onTxQueueEnqueue(Ptr<const ns3::Packet> packet);
+
+  /** \brief called when a packet leaves the TxQueue, either dequeued or removed
+   */
+  void
+  onTxQueueDequeue(Ptr<const ns3::Packet> packet);
+
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
   Ptr<Node> m_node;
+
+  Ptr<ns3::QueueBase> m_txQueue; ///< \brief TxQueue of the NetDevice, if any
+  uint32_t m_txQueueBytes;       ///< \brief number of bytes in m_txQueue
+  /// \brief uid and enqueue time of packets in m_txQueue, in FIFO order
+  std::deque<std::pair<uint64_t, Time>> m_txQueueArrivals;
 };
 
 } // namespace ndn
@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "compact-name.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include <cstring>
+#include <boost/functional/hash.hpp>
+
+namespace ndn {
+
+CompactName::CompactName() noexcept
+  : m_nComponents(0)
+  , m_valueSize(0)
+{
+}
+
+CompactName::CompactName(const Name& name)
+  : CompactName()
+{
+  const Block& wire = name.wireEncode();
+  this->allocate(name.size(), wire.value_size());
+
+  size_t offset = 0;
+  for (size_t i = 0; i < m_nComponents; ++i) {
+    m_buffer[i] = static_cast<uint32_t>(offset);
+    offset += name[i].size();
+  }
+  BOOST_ASSERT(offset == m_valueSize);
+
+  if (m_valueSize > 0) {
+    std::memcpy(const_cast<uint8_t*>(this->value()), wire.value(), m_valueSize);
+  }
+}
+
+CompactName::CompactName(const CompactName& other)
+  : CompactName()
+{
+  *this = other;
+}
+
+CompactName::CompactName(CompactName&& other) noexcept
+  : m_buffer(std::move(other.m_buffer))
+  , m_nComponents(other.m_nComponents)
+  , m_valueSize(other.m_valueSize)
+{
+  other.m_nComponents = other.m_valueSize = 0;
+}
+
+CompactName&
+CompactName::operator=(const CompactName& other)
+{
+  if (this != &other) {
+    this->allocate(other.m_nComponents, other.m_valueSize);
+    // offsets and TLV-VALUE are copied together
+    std::memcpy(m_buffer.get(), other.m_buffer.get(),
+                m_nComponents * sizeof(uint32_t) + m_valueSize);
+  }
+  return *this;
+}
+
+CompactName&
+CompactName::operator=(CompactName&& other) noexcept
+{
+  m_buffer = std::move(other.m_buffer);
+  m_nComponents = other.m_nComponents;
+  m_valueSize = other.m_valueSize;
+  other.m_nComponents = other.m_valueSize = 0;
+  return *this;
+}
+
+void
+CompactName::allocate(size_t nComponents, size_t valueSize)
+{
+  m_nComponents = static_cast<uint32_t>(nComponents);
+  m_valueSize = static_cast<uint32_t>(valueSize);
+
+  size_t nWords = nComponents + (valueSize + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+  if (nWords == 0) {
+    m_buffer.reset();
+  }
+  else {
+    m_buffer.reset(new uint32_t[nWords]);
+  }
+}
+
+Name
+CompactName::toName() const
+{
+  return Name(encoding::makeBinaryBlock(tlv::Name, this->value(), m_valueSize));
+}
+
+name::Component
+CompactName::at(size_t i) const
+{
+  if (i >= m_nComponents) {
+    BOOST_THROW_EXCEPTION(Name::Error("Requested component does not exist (out of bounds)"));
+  }
+
+  size_t offset = this->getOffset(i);
+  return name::Component(Block(this->value() + offset, this->getOffset(i + 1) - offset));
+}
+
+CompactName
+CompactName::getPrefix(size_t nComponents) const
+{
+  if (nComponents >= m_nComponents) {
+    return *this;
+  }
+
+  CompactName prefix;
+  prefix.allocate(nComponents, this->getOffset(nComponents));
+  std::memcpy(prefix.m_buffer.get(), m_buffer.get(), nComponents * sizeof(uint32_t));
+  if (prefix.m_valueSize > 0) {
+    std::memcpy(const_cast<uint8_t*>(prefix.value()), this->value(), prefix.m_valueSize);
+  }
+  return prefix;
+}
+
+bool
+CompactName::isPrefixOf(const CompactName& other) const
+{
+  // the offset check ensures the prefix ends at a component boundary of other
+  return m_nComponents <= other.m_nComponents &&
+         m_valueSize == other.getOffset(m_nComponents) &&
+         (m_valueSize == 0 || std::memcmp(this->value(), other.value(), m_valueSize) == 0);
+}
+
+int
+CompactName::compare(const CompactName& other) const
+{
+  size_t length = std::min(m_valueSize, other.m_valueSize);
+  if (length > 0) {
+    int res = std::memcmp(this->value(), other.value(), length);
+    if (res != 0) {
+      return res;
+    }
+  }
+  return static_cast<int>(m_valueSize) - static_cast<int>(other.m_valueSize);
+}
+
+bool
+CompactName::equals(const Name& other) const
+{
+  const Block& wire = other.wireEncode();
+  return wire.value_size() == m_valueSize &&
+         (m_valueSize == 0 || std::memcmp(wire.value(), this->value(), m_valueSize) == 0);
+}
+
+std::ostream&
+operator<<(std::ostream& os, const CompactName& name)
+{
+  return os << name.toName();
+}
+
+} // namespace ndn
+
+namespace std {
+
+size_t
+hash<ndn::CompactName>::operator()(const ndn::CompactName& name) const
+{
+  return boost::hash_range(name.value(), name.value() + name.value_size());
+}
+
+} // namespace std
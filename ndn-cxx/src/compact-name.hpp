@@ -0,0 +1,240 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_COMPACT_NAME_HPP
+#define NDN_COMPACT_NAME_HPP
+
+#include "name.hpp"
+
+namespace ndn {
+
+/** @brief Represents an absolute name in a single contiguous buffer
+ *
+ *  Name keeps every component as a separate Block that shares the wire buffer, so copying
+ *  a Name copies a vector of Blocks. CompactName instead keeps a copy of the TLV-VALUE of the
+ *  Name, preceded by an array of component offsets in the same allocation. Copying it is
+ *  one allocation and one memcpy; comparing and hashing it operate on the flat TLV-VALUE.
+ *
+ *  CompactName is meant to be a key in tables that store many names. It is implicitly
+ *  constructible from Name; use toName() for the operations that only Name provides.
+ */
+class CompactName
+{
+public:
+  /** @brief Create an empty name
+   */
+  CompactName() noexcept;
+
+  /** @brief Create from Name
+   */
+  CompactName(const Name& name);
+
+  CompactName(const CompactName& other);
+
+  CompactName(CompactName&& other) noexcept;
+
+  CompactName&
+  operator=(const CompactName& other);
+
+  CompactName&
+  operator=(CompactName&& other) noexcept;
+
+  /** @brief Convert to Name
+   */
+  Name
+  toName() const;
+
+  /** @brief Check if name is empty
+   */
+  bool
+  empty() const
+  {
+    return m_nComponents == 0;
+  }
+
+  /** @brief Get number of components
+   */
+  size_t
+  size() const
+  {
+    return m_nComponents;
+  }
+
+  /** @brief Get the TLV-VALUE of the Name, which is the concatenated component TLVs
+   */
+  const uint8_t*
+  value() const
+  {
+    return reinterpret_cast<const uint8_t*>(m_buffer.get() + m_nComponents);
+  }
+
+  /** @brief Get size of TLV-VALUE of the Name
+   */
+  size_t
+  value_size() const
+  {
+    return m_valueSize;
+  }
+
+  /** @brief Get number of octets allocated on the heap for offsets and TLV-VALUE
+   */
+  size_t
+  getAllocatedSize() const
+  {
+    return (m_nComponents + (m_valueSize + sizeof(uint32_t) - 1) / sizeof(uint32_t)) *
+           sizeof(uint32_t);
+  }
+
+  /** @brief Get the component at the given index
+   *  @param i zero-based index of the component
+   *  @throw Name::Error index out of range
+   */
+  name::Component
+  at(size_t i) const;
+
+  /** @brief Extract a prefix of the name
+   *  @param nComponents number of leading components; if larger than size(), a copy is returned
+   */
+  CompactName
+  getPrefix(size_t nComponents) const;
+
+  /** @brief Check if this name is a prefix of another name
+   */
+  bool
+  isPrefixOf(const CompactName& other) const;
+
+  /** @brief Compare with the other name using NDN canonical ordering
+   *  @return negative, zero, or positive, as Name::compare
+   *
+   *  Components are compared in order, and the TLV encoding of a component sorts the same as
+   *  its canonical order, so a single memcmp over both TLV-VALUEs decides. If it finds no
+   *  difference, the shorter name is a prefix of the longer one.
+   */
+  int
+  compare(const CompactName& other) const;
+
+  /** @brief Check if this name equals a Name
+   *
+   *  This compares against the wire encoding of @p other without converting it.
+   */
+  bool
+  equals(const Name& other) const;
+
+private:
+  /** @brief allocate the buffer for @p nComponents offsets and @p valueSize octets
+   */
+  void
+  allocate(size_t nComponents, size_t valueSize);
+
+  /** @return offset of the i-th component in value()
+   */
+  size_t
+  getOffset(size_t i) const
+  {
+    return i < m_nComponents ? m_buffer[i] : m_valueSize;
+  }
+
+private:
+  std::unique_ptr<uint32_t[]> m_buffer; ///< component offsets, followed by TLV-VALUE
+  uint32_t m_nComponents;
+  uint32_t m_valueSize;
+};
+
+inline bool
+operator==(const CompactName& lhs, const CompactName& rhs)
+{
+  return lhs.value_size() == rhs.value_size() &&
+         std::equal(lhs.value(), lhs.value() + lhs.value_size(), rhs.value());
+}
+
+inline bool
+operator!=(const CompactName& lhs, const CompactName& rhs)
+{
+  return !(lhs == rhs);
+}
+
+inline bool
+operator==(const CompactName& lhs, const Name& rhs)
+{
+  return lhs.equals(rhs);
+}
+
+inline bool
+operator==(const Name& lhs, const CompactName& rhs)
+{
+  return rhs.equals(lhs);
+}
+
+inline bool
+operator!=(const CompactName& lhs, const Name& rhs)
+{
+  return !lhs.equals(rhs);
+}
+
+inline bool
+operator!=(const Name& lhs, const CompactName& rhs)
+{
+  return !rhs.equals(lhs);
+}
+
+inline bool
+operator<(const CompactName& lhs, const CompactName& rhs)
+{
+  return lhs.compare(rhs) < 0;
+}
+
+inline bool
+operator<=(const CompactName& lhs, const CompactName& rhs)
+{
+  return lhs.compare(rhs) <= 0;
+}
+
+inline bool
+operator>(const CompactName& lhs, const CompactName& rhs)
+{
+  return lhs.compare(rhs) > 0;
+}
+
+inline bool
+operator>=(const CompactName& lhs, const CompactName& rhs)
+{
+  return lhs.compare(rhs) >= 0;
+}
+
+/** @brief Print URI representation of a name
+ */
+std::ostream&
+operator<<(std::ostream& os, const CompactName& name);
+
+} // namespace ndn
+
+namespace std {
+
+template<>
+struct hash<ndn::CompactName>
+{
+  size_t
+  operator()(const ndn::CompactName& name) const;
+};
+
+} // namespace std
+
+#endif // NDN_COMPACT_NAME_HPP
@@ -57,15 +57,16 @@ Data::wireEncode(EncodingImpl<TAG>& encoder, bool wantUnsignedPortionOnly) const
   size_t totalLength = 0;
 
   // SignatureValue
+  const Signature& signature = getSignature();
   if (!wantUnsignedPortionOnly) {
-    if (!m_signature) {
+    if (!signature) {
       BOOST_THROW_EXCEPTION(Error("Requested wire format, but Data has not been signed"));
     }
-    totalLength += encoder.prependBlock(m_signature.getValue());
+    totalLength += encoder.prependBlock(signature.getValue());
   }
 
   // SignatureInfo
-  totalLength += encoder.prependBlock(m_signature.getInfo());
+  totalLength += encoder.prependBlock(signature.getInfo());
 
   // Content
   totalLength += encoder.prependBlock(getContent());
@@ -119,7 +120,7 @@ Data::wireEncode() const
 }
 
 void
-Data::wireDecode(const Block& wire)
+Data::wireDecode(const Block& wire, bool wantLazySignature)
 {
   m_wire = wire;
   m_wire.parse();
@@ -128,6 +129,7 @@ Data::wireDecode(const Block& wire)
   m_metaInfo = MetaInfo();
   m_content = Block(tlv::Content);
   m_signature = Signature();
+  m_hasLazySignature = false;
   m_fullName.clear();
 
   int lastEle = 0; // last recognized element index, in spec order
@@ -163,7 +165,9 @@ Data::wireDecode(const Block& wire)
           BOOST_THROW_EXCEPTION(Error("SignatureInfo element is out of order"));
         }
         hasSigInfo = true;
-        m_signature.setInfo(ele);
+        if (!wantLazySignature) {
+          m_signature.setInfo(ele);
+        }
         lastEle = 4;
         break;
       }
@@ -171,7 +175,9 @@ Data::wireDecode(const Block& wire)
         if (lastEle >= 5) {
           BOOST_THROW_EXCEPTION(Error("SignatureValue element is out of order"));
         }
-        m_signature.setValue(ele);
+        if (!wantLazySignature) {
+          m_signature.setValue(ele);
+        }
         lastEle = 5;
         break;
       }
@@ -191,6 +197,25 @@ Data::wireDecode(const Block& wire)
   if (!hasSigInfo) {
     BOOST_THROW_EXCEPTION(Error("SignatureInfo element is missing"));
   }
+  m_hasLazySignature = wantLazySignature;
+}
+
+void
+Data::decodeSignature() const
+{
+  BOOST_ASSERT(m_wire.hasWire());
+
+  Signature signature;
+  for (const Block& ele : m_wire.elements()) {
+    if (ele.type() == tlv::SignatureInfo) {
+      signature.setInfo(ele);
+    }
+    else if (ele.type() == tlv::SignatureValue) {
+      signature.setValue(ele);
+    }
+  }
+  m_signature = signature;
+  m_hasLazySignature = false;
 }
 
 const Name&
@@ -210,6 +235,10 @@ Data::getFullName() const
 void
 Data::resetWire()
 {
+  // setters may modify the Signature, which must be decoded before the wire is gone
+  if (m_hasLazySignature) {
+    decodeSignature();
+  }
   m_wire.reset();
   m_fullName.clear();
 }
@@ -102,9 +102,14 @@ public:
   wireEncode() const;
 
   /** @brief Decode from @p wire in NDN Packet Format v0.2 or v0.3.
+   *  @param wire @c tlv::Data element
+   *  @param wantLazySignature if true, SignatureInfo and SignatureValue are only checked for
+   *         presence and order, and are decoded from @p wire on the first getSignature() call.
+   *         A forwarder rarely looks at signatures, so this skips decoding the KeyLocator.
+   *         If SignatureInfo is malformed, getSignature() throws instead of this function.
    */
   void
-  wireDecode(const Block& wire);
+  wireDecode(const Block& wire, bool wantLazySignature = false);
 
   /** @brief Check if this instance has cached wire encoding.
    */
@@ -188,6 +193,9 @@ public: // Data fields
   const Signature&
   getSignature() const
   {
+    if (m_hasLazySignature) {
+      decodeSignature();
+    }
     return m_signature;
   }
 
@@ -252,11 +260,18 @@ protected:
   void
   resetWire();
 
+private:
+  /** @brief Decode SignatureInfo and SignatureValue deferred by a lazy wireDecode
+   */
+  void
+  decodeSignature() const;
+
 private:
   Name m_name;
   MetaInfo m_metaInfo;
   Block m_content;
-  Signature m_signature;
+  mutable Signature m_signature;
+  mutable bool m_hasLazySignature = false; ///< m_signature is yet to be decoded from m_wire
 
   mutable Block m_wire;
   mutable Name m_fullName; ///< cached FullName computed from m_wire
@@ -84,9 +84,10 @@ enum {
   NOutBytes     = 149,
 
   // Content Store Management
-  CsInfo  = 128,
-  NHits   = 129,
-  NMisses = 130,
+  CsInfo   = 128,
+  NHits    = 129,
+  NMisses  = 130,
+  CsPolicy = 137,
 
   // FIB Management
   FibEntry      = 128,
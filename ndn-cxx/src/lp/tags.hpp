@@ -79,6 +79,14 @@ typedef SimpleTag<PrefixAnnouncement, 15> PrefixAnnouncementTag;
  */
 typedef SimpleTag<uint64_t, 0x60000000> HopCountTag;
 
+/** \class CentralityTag
+ *  \brief a packet tag for Centrality field
+ *
+ *  This tag can be attached to Interest and Data. It carries the highest centrality of the
+ *  routers on the path, which is used to place cached copies.
+ */
+typedef SimpleTag<uint64_t, 0x60000002> CentralityTag;
+
 } // namespace lp
 } // namespace ndn
 
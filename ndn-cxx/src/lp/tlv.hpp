@@ -36,6 +36,7 @@ enum {
   FragIndex = 82,
   FragCount = 83,
   HopCountTag = 84,
+  CentralityTag = 85,
   Nack = 800,
   NackReason = 801,
   NextHopFaceId = 816,
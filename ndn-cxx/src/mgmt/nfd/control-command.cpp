@@ -264,10 +264,12 @@ CsConfigCommand::CsConfigCommand()
   m_requestValidator
     .optional(CONTROL_PARAMETER_CAPACITY)
     .optional(CONTROL_PARAMETER_FLAGS)
-    .optional(CONTROL_PARAMETER_MASK);
+    .optional(CONTROL_PARAMETER_MASK)
+    .optional(CONTROL_PARAMETER_CS_POLICY);
   m_responseValidator
     .required(CONTROL_PARAMETER_CAPACITY)
-    .required(CONTROL_PARAMETER_FLAGS);
+    .required(CONTROL_PARAMETER_FLAGS)
+    .optional(CONTROL_PARAMETER_CS_POLICY);
 }
 
 CsEraseCommand::CsEraseCommand()
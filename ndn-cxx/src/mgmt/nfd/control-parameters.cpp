@@ -51,6 +51,9 @@ ControlParameters::wireEncode(EncodingImpl<TAG>& encoder) const
 {
   size_t totalLength = 0;
 
+  if (this->hasCsPolicy()) {
+    totalLength += prependStringBlock(encoder, tlv::nfd::CsPolicy, m_csPolicy);
+  }
   if (this->hasDefaultCongestionThreshold()) {
     totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::DefaultCongestionThreshold,
                                                   m_defaultCongestionThreshold);
@@ -228,6 +231,12 @@ ControlParameters::wireDecode(const Block& block)
   if (this->hasDefaultCongestionThreshold()) {
     m_defaultCongestionThreshold = readNonNegativeInteger(*val);
   }
+
+  val = m_wire.find(tlv::nfd::CsPolicy);
+  m_hasFields[CONTROL_PARAMETER_CS_POLICY] = val != m_wire.elements_end();
+  if (this->hasCsPolicy()) {
+    m_csPolicy = readString(*val);
+  }
 }
 
 bool
@@ -368,6 +377,10 @@ operator<<(std::ostream& os, const ControlParameters& parameters)
     os << "DefaultCongestionThreshold: " << parameters.getDefaultCongestionThreshold() << ", ";
   }
 
+  if (parameters.hasCsPolicy()) {
+    os << "CsPolicy: " << parameters.getCsPolicy() << ", ";
+  }
+
   os << ")";
   return os;
 }
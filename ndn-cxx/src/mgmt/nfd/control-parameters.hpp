@@ -49,6 +49,7 @@ enum ControlParameterField {
   CONTROL_PARAMETER_FACE_PERSISTENCY,
   CONTROL_PARAMETER_BASE_CONGESTION_MARKING_INTERVAL,
   CONTROL_PARAMETER_DEFAULT_CONGESTION_THRESHOLD,
+  CONTROL_PARAMETER_CS_POLICY,
   CONTROL_PARAMETER_UBOUND
 };
 
@@ -67,7 +68,8 @@ const std::string CONTROL_PARAMETER_FIELD[CONTROL_PARAMETER_UBOUND] = {
   "ExpirationPeriod",
   "FacePersistency",
   "BaseCongestionMarkingInterval",
-  "DefaultCongestionThreshold"
+  "DefaultCongestionThreshold",
+  "CsPolicy"
 };
 
 /**
@@ -559,6 +561,40 @@ public: // getters & setters
     return *this;
   }
 
+  bool
+  hasCsPolicy() const
+  {
+    return m_hasFields[CONTROL_PARAMETER_CS_POLICY];
+  }
+
+  /** \brief get name of Content Store replacement policy
+   */
+  const std::string&
+  getCsPolicy() const
+  {
+    BOOST_ASSERT(this->hasCsPolicy());
+    return m_csPolicy;
+  }
+
+  /** \brief set name of Content Store replacement policy
+   */
+  ControlParameters&
+  setCsPolicy(const std::string& policyName)
+  {
+    m_wire.reset();
+    m_csPolicy = policyName;
+    m_hasFields[CONTROL_PARAMETER_CS_POLICY] = true;
+    return *this;
+  }
+
+  ControlParameters&
+  unsetCsPolicy()
+  {
+    m_wire.reset();
+    m_hasFields[CONTROL_PARAMETER_CS_POLICY] = false;
+    return *this;
+  }
+
   const std::vector<bool>&
   getPresentFields() const
   {
@@ -615,6 +651,7 @@ private: // fields
   FacePersistency     m_facePersistency;
   time::nanoseconds   m_baseCongestionMarkingInterval;
   uint64_t            m_defaultCongestionThreshold;
+  std::string         m_csPolicy;
 
 private:
   mutable Block m_wire;
@@ -0,0 +1,7 @@
+#define NDN_CXX_HAVE_STD_TO_STRING
+#define NDN_CXX_HAVE_IS_NOTHROW_MOVE_CONSTRUCTIBLE
+#define NDN_CXX_HAVE_IS_NOTHROW_MOVE_ASSIGNABLE
+#define NDN_CXX_HAVE_IS_NOTHROW_COPY_CONSTRUCTIBLE
+#define NDN_CXX_HAVE_IS_NOTHROW_COPY_ASSIGNABLE
+#define NDN_CXX_HAVE_STD_TO_STRING
+#define NDN_CXX_HAVE_STD_FUNCTION_EQUALS
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "compact-name.hpp"
+
+#include "boost-test.hpp"
+#include <boost/lexical_cast.hpp>
+#include <unordered_set>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestCompactName)
+
+BOOST_AUTO_TEST_CASE(Convert)
+{
+  Name name("/hello/%00%01/sha256digest=0415e3624a151850ac686c84f155f29808c0dd73819aa4a4c20be73a4d8a874c");
+  CompactName compact(name);
+  BOOST_CHECK_EQUAL(compact.size(), 3);
+  BOOST_CHECK_EQUAL(compact.empty(), false);
+  BOOST_CHECK_EQUAL(compact.value_size(), name.wireEncode().value_size());
+  BOOST_CHECK_EQUAL(compact.getAllocatedSize(), 3 * 4 + 7 + 4 + 34 + 3); // padded to 4 octets
+  BOOST_CHECK_EQUAL(compact.toName(), name);
+  BOOST_CHECK_EQUAL(compact.at(0), name[0]);
+  BOOST_CHECK_EQUAL(compact.at(1), name[1]);
+  BOOST_CHECK(compact.at(2).isImplicitSha256Digest());
+  BOOST_CHECK_THROW(compact.at(3), Name::Error);
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(compact), name.toUri());
+
+  CompactName empty;
+  BOOST_CHECK_EQUAL(empty.size(), 0);
+  BOOST_CHECK_EQUAL(empty.empty(), true);
+  BOOST_CHECK_EQUAL(empty.getAllocatedSize(), 0);
+  BOOST_CHECK_EQUAL(empty.toName(), Name());
+  BOOST_CHECK_EQUAL(CompactName(Name()), empty);
+}
+
+BOOST_AUTO_TEST_CASE(CopyMove)
+{
+  CompactName a(Name("/A/B/C"));
+  CompactName b(a);
+  BOOST_CHECK_EQUAL(b, a);
+  BOOST_CHECK_NE(b.value(), a.value());
+
+  CompactName c(Name("/D"));
+  c = b;
+  BOOST_CHECK_EQUAL(c.toName(), Name("/A/B/C"));
+
+  CompactName d(std::move(c));
+  BOOST_CHECK_EQUAL(d.toName(), Name("/A/B/C"));
+  BOOST_CHECK_EQUAL(c.size(), 0);
+
+  c = std::move(d);
+  BOOST_CHECK_EQUAL(c.toName(), Name("/A/B/C"));
+}
+
+BOOST_AUTO_TEST_CASE(Prefix)
+{
+  CompactName name(Name("/A/B/C"));
+  BOOST_CHECK_EQUAL(name.getPrefix(0), CompactName());
+  BOOST_CHECK_EQUAL(name.getPrefix(2).toName(), Name("/A/B"));
+  BOOST_CHECK_EQUAL(name.getPrefix(2).at(1), name.at(1));
+  BOOST_CHECK_EQUAL(name.getPrefix(3), name);
+  BOOST_CHECK_EQUAL(name.getPrefix(5), name);
+
+  BOOST_CHECK(CompactName().isPrefixOf(name));
+  BOOST_CHECK(CompactName(Name("/A/B")).isPrefixOf(name));
+  BOOST_CHECK(name.isPrefixOf(name));
+  BOOST_CHECK(!CompactName(Name("/A/BB")).isPrefixOf(name));
+  BOOST_CHECK(!CompactName(Name("/A/B/C/D")).isPrefixOf(name));
+}
+
+BOOST_AUTO_TEST_CASE(Compare)
+{
+  std::vector<Name> names{"/", "/A", "/A/B", "/A/C", "/AA", "/B", "/B/A",
+                          "/%FF", "/%00%00", "/sha256digest=0000000000000000000000000000000000000000000000000000000000000000"};
+
+  for (const Name& lhs : names) {
+    for (const Name& rhs : names) {
+      CompactName cl(lhs);
+      CompactName cr(rhs);
+      BOOST_CHECK_EQUAL(cl.compare(cr) < 0, lhs.compare(rhs) < 0);
+      BOOST_CHECK_EQUAL(cl.compare(cr) == 0, lhs.compare(rhs) == 0);
+      BOOST_CHECK_EQUAL(cl < cr, lhs < rhs);
+      BOOST_CHECK_EQUAL(cl == cr, lhs == rhs);
+      BOOST_CHECK_EQUAL(cl == rhs, lhs == rhs);
+      BOOST_CHECK_EQUAL(lhs != cr, lhs != rhs);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Hash)
+{
+  std::unordered_set<CompactName> set;
+  set.insert(Name("/A/B"));
+  set.insert(Name("/A/B"));
+  set.insert(Name("/A"));
+  BOOST_CHECK_EQUAL(set.size(), 2);
+  BOOST_CHECK_EQUAL(set.count(Name("/A/B")), 1);
+  BOOST_CHECK_EQUAL(set.count(Name("/A/C")), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCompactName
+
+} // namespace tests
+} // namespace ndn
@@ -341,6 +341,38 @@ BOOST_AUTO_TEST_CASE(UnrecognizedCriticalElement)
     tlv::Error);
 }
 
+BOOST_AUTO_TEST_CASE(LazySignature)
+{
+  Block wire("062C 0703080144 16031B0100 "
+             "1720612A79399E60304A9F701C1ECAC7956BF2F1B046E6C6F0D6C29B3FE3A29BAD76"_block);
+  d.wireDecode(wire, true);
+  BOOST_CHECK_EQUAL(d.getName(), "/D");
+  BOOST_CHECK_EQUAL(d.getContent().value_size(), 0);
+  BOOST_CHECK_EQUAL(d.getSignature().getType(), tlv::DigestSha256);
+  BOOST_CHECK_EQUAL(d.getSignature().getValue().value_size(), 32);
+  BOOST_CHECK_EQUAL(d.wireEncode(), wire);
+
+  // modify before the signature is accessed, then re-encode as v0.2 format
+  d.wireDecode(wire, true);
+  d.setName("/E");
+  BOOST_CHECK_EQUAL(d.wireEncode(),
+    "0630 0703080145 1400 1500 16031B0100 "
+    "1720612A79399E60304A9F701C1ECAC7956BF2F1B046E6C6F0D6C29B3FE3A29BAD76"_block);
+
+  // presence and order of elements are still checked
+  BOOST_CHECK_THROW(d.wireDecode("0605 0703080144"_block, true), tlv::Error);
+  BOOST_CHECK_THROW(d.wireDecode(
+    "0630 0703080145 1400 1500 "
+    "1720612A79399E60304A9F701C1ECAC7956BF2F1B046E6C6F0D6C29B3FE3A29BAD76 16031B0100"_block, true),
+    tlv::Error);
+
+  // malformed SignatureInfo is reported when accessed
+  BOOST_CHECK_NO_THROW(d.wireDecode("0607 0703080144 1600"_block, true));
+  BOOST_CHECK_EQUAL(d.getName(), "/D");
+  BOOST_CHECK_THROW(d.getSignature(), tlv::Error);
+  BOOST_CHECK_THROW(d.wireDecode("0607 0703080144 1600"_block), tlv::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Decode03
 
 BOOST_FIXTURE_TEST_CASE(FullName, IdentityManagementFixture)
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-producer.hpp"
+#include "helper/ndn-app-helper.hpp"
+#include "helper/ndn-strategy-choice-helper.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ProducerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  /** @brief Run producers with and without DataTemplate side by side, on nodes B and C
+   *
+   * A multicast strategy on A sends every Interest of the consumer to both producers.
+   */
+  void
+  run(std::initializer_list<std::pair<std::string, std::string>> producerParams)
+  {
+    createTopology({
+        {"A", "B"},
+        {"A", "C"}
+      });
+
+    addRoutes({
+        {"A", "B", "/prefix", 1},
+        {"A", "C", "/prefix", 1}
+      });
+    StrategyChoiceHelper::Install(getNode("A"), "/prefix", "/localhost/nfd/strategy/multicast");
+
+    addApps({
+        {"A", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "1s"}
+      });
+
+    for (const std::string& node : {"B", "C"}) {
+      AppHelper producerHelper("ns3::ndn::Producer");
+      producerHelper.SetPrefix("/prefix");
+      producerHelper.SetAttribute("DataTemplate", BooleanValue(node == "C"));
+      for (auto&& param : producerParams) {
+        producerHelper.SetAttribute(param.first, StringValue(param.second));
+      }
+      Ptr<Application> producer = producerHelper.Install(getNode(node)).Get(0);
+      producer->TraceConnect("TransmittedDatas", node, MakeCallback(&ProducerFixture::onData, this));
+    }
+
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+  }
+
+  /** @brief Check that both producers sent the same packets
+   */
+  void
+  checkIdentical()
+  {
+    BOOST_REQUIRE_GE(datas["B"].size(), 5);
+    BOOST_REQUIRE_EQUAL(datas["B"].size(), datas["C"].size());
+
+    for (const auto& legacy : datas["B"]) {
+      auto templated = datas["C"].find(legacy.first);
+      BOOST_REQUIRE(templated != datas["C"].end());
+      const Block& expected = legacy.second->wireEncode();
+      const Block& actual = templated->second->wireEncode();
+      BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+    }
+  }
+
+private:
+  void
+  onData(std::string node, shared_ptr<const Data> data, Ptr<App> app, shared_ptr<Face> face)
+  {
+    datas[node][data->getName()] = data;
+  }
+
+public:
+  std::map<std::string, std::map<Name, shared_ptr<const Data>>> datas;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnProducer, ProducerFixture)
+
+BOOST_AUTO_TEST_CASE(DataTemplateDefaults)
+{
+  run({});
+  checkIdentical();
+}
+
+BOOST_AUTO_TEST_CASE(DataTemplateAttributes)
+{
+  run({
+      {"PayloadSize", "3000"},
+      {"Freshness", "2s"},
+      {"Signature", "7"},
+      {"KeyLocator", "/key/locator"}
+    });
+  checkIdentical();
+
+  const Data& data = *datas["C"].begin()->second;
+  BOOST_CHECK_EQUAL(data.getContent().value_size(), 3000);
+  BOOST_CHECK_EQUAL(data.getFreshnessPeriod(), ::ndn::time::seconds(2));
+  BOOST_CHECK_EQUAL(data.getSignature().getKeyLocator().getName(), "/key/locator");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
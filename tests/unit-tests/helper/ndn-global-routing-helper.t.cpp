@@ -23,6 +23,8 @@
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-transport.hpp"
 
+#include "ns3/ndnSIM/NFD/daemon/fw/cache-placement-policy.hpp"
+
 #include "ns3/channel.h"
 #include "ns3/net-device.h"
 #include "ns3/core-module.h"
@@ -147,6 +149,51 @@ BOOST_AUTO_TEST_CASE(CalculateRouteCase2)
   }
 }
 
+BOOST_AUTO_TEST_CASE(CalculateCentrality)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A3  NA  1 1 1\n"
+        << "B3  NA  80  -40 1\n"
+        << "C3  NA  80  40  1\n"
+        << "D3  NA  1  80  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A3      B3  10Mbps    1 1ms 100\n"
+        << "B3      C3  10Mbps    1 1ms 100\n"
+        << "C3      D3  10Mbps    1 1ms 100\n"
+        << "A3      D3  10Mbps    10 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setCachePlacementPolicy("betweenness");
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  BOOST_CHECK_NO_THROW(ndn::GlobalRoutingHelper::CalculateCentrality());
+
+  auto getCentrality = [] (const std::string& nodeName) {
+    auto ndn = Names::Find<Node>(nodeName)->GetObject<ndn::L3Protocol>();
+    auto& policy = dynamic_cast<nfd::fw::BetweennessPlacementPolicy&>(
+      ndn->getForwarder()->getCachePlacementPolicy());
+    return policy.getCentrality();
+  };
+
+  // B3 and C3 are each on the shortest paths of 4 ordered pairs; the A3-D3 link is not used
+  BOOST_CHECK_EQUAL(getCentrality("A3"), 0);
+  BOOST_CHECK_EQUAL(getCentrality("B3"), 4000);
+  BOOST_CHECK_EQUAL(getCentrality("C3"), 4000);
+  BOOST_CHECK_EQUAL(getCentrality("D3"), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -19,6 +19,9 @@
 
 #include "helper/ndn-scenario-helper.hpp"
 #include "helper/ndn-app-helper.hpp"
+#include "helper/ndn-strategy-choice-helper.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 
 #include <ndn-cxx/face.hpp>
 
@@ -149,8 +152,61 @@ BOOST_AUTO_TEST_CASE(DisabledForwarderStatusManager)
                                 receivedDatasets.begin(), receivedDatasets.end());
 }
 
+BOOST_AUTO_TEST_CASE(ForwardingOnly)
+{
+  getStackHelper().SetForwardingOnly(true);
+
+  setupAndRun();
+
+  BOOST_CHECK_EQUAL(receivedDatasets.size(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ManagerCheck
 
+BOOST_AUTO_TEST_CASE(ForwardingOnlyTables)
+{
+  getStackHelper().SetForwardingOnly(true);
+  getStackHelper().setCsSize(10);
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+  StrategyChoiceHelper::Install(getNode("1"), "/prefix", "/localhost/nfd/strategy/multicast");
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+          "0s", "100s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(5.0));
+  Simulator::Run();
+
+  auto ndn = getNode("1")->GetObject<L3Protocol>();
+  BOOST_CHECK(ndn->isForwardingOnly());
+  BOOST_CHECK(ndn->getFibManager() == nullptr);
+  BOOST_CHECK(ndn->getStrategyChoiceManager() == nullptr);
+
+  nfd::Forwarder& forwarder = *ndn->getForwarder();
+  BOOST_CHECK(forwarder.getFib().findExactMatch("/localhost/nfd") == nullptr);
+  BOOST_CHECK(forwarder.getStrategyChoice().get("/prefix").first);
+  BOOST_CHECK_EQUAL(forwarder.getCs().getLimit(), 10);
+  BOOST_CHECK_EQUAL(forwarder.getCs().size(), 5);
+
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nOutInterests, 5);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 5);
+
+  FibHelper::RemoveRoute(getNode("1"), "/prefix", getFace("1", "2"));
+  BOOST_CHECK(forwarder.getFib().findExactMatch("/prefix") == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ModelNdnL3Protocol
 
 } // namespace ndn
@@ -67,6 +67,24 @@ BOOST_AUTO_TEST_CASE(RandomPolicy)
   BOOST_CHECK(entries["1"] != entries["2"]); // this test has a small chance of failing
 }
 
+BOOST_AUTO_TEST_CASE(LookupDoesNotCopy)
+{
+  ObjectFactory factory;
+  factory.SetTypeId("ns3::ndn::cs::Lru");
+  Ptr<ContentStore> cs = factory.Create<ContentStore>();
+
+  auto data = make_shared<Data>("/prefix/1");
+  BOOST_CHECK(cs->Add(data));
+
+  shared_ptr<const Data> match = cs->Lookup(make_shared<Interest>("/prefix/1"));
+  BOOST_CHECK_EQUAL(match.get(), data.get());
+
+  // a second hit returns the same object
+  BOOST_CHECK_EQUAL(cs->Lookup(make_shared<Interest>("/prefix")).get(), data.get());
+
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/other")) == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-hdr-histogram.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnHdrHistogram, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  HdrHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetMin(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetMax(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetMean(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0.5), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SmallValuesAreExact)
+{
+  HdrHistogram histogram;
+  for (uint64_t i = 0; i < 10; ++i) {
+    histogram.Add(i);
+  }
+
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 10);
+  BOOST_CHECK_EQUAL(histogram.GetMin(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetMax(), 9);
+  BOOST_CHECK_CLOSE(histogram.GetMean(), 4.5, 0.001);
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0), 0);
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0.5), 4);
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0.9), 8);
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(1), 9);
+}
+
+BOOST_AUTO_TEST_CASE(RelativeError)
+{
+  HdrHistogram histogram;
+  for (uint64_t i = 1; i <= 100000; ++i) {
+    histogram.Add(i);
+  }
+
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 100000);
+  BOOST_CHECK_CLOSE(histogram.GetMean(), 50000.5, 0.001);
+  for (double q : {0.1, 0.5, 0.9, 0.99}) {
+    uint64_t value = histogram.GetQuantile(q);
+    BOOST_CHECK_GE(value, q * 100000);
+    BOOST_CHECK_LE(value, q * 100000 * (1 + 1.0 / HdrHistogram::SUB_BUCKETS));
+  }
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(1), 100000);
+}
+
+BOOST_AUTO_TEST_CASE(MergeAndReset)
+{
+  HdrHistogram a;
+  a.Add(3);
+  a.Add(1000, 2);
+
+  HdrHistogram b;
+  b.Add(1);
+  b.Add(1 << 20);
+
+  a.Merge(b);
+  BOOST_CHECK_EQUAL(a.GetCount(), 5);
+  BOOST_CHECK_EQUAL(a.GetMin(), 1);
+  BOOST_CHECK_EQUAL(a.GetMax(), 1 << 20);
+  BOOST_CHECK_EQUAL(a.GetQuantile(0.2), 1);
+  BOOST_CHECK_EQUAL(a.GetQuantile(1), 1 << 20);
+
+  a.Reset();
+  BOOST_CHECK_EQUAL(a.GetCount(), 0);
+  BOOST_CHECK_EQUAL(a.GetMax(), 0);
+  a.Add(7);
+  BOOST_CHECK_EQUAL(a.GetMin(), 7);
+  BOOST_CHECK_EQUAL(a.GetQuantile(0.5), 7);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-seq-tracker.hpp"
+
+#include "../tests-common.hpp"
+
+#include <deque>
+#include <random>
+#include <set>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnSeqTracker, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Delays)
+{
+  SeqTracker tracker;
+
+  tracker.Sent(10, Seconds(1));
+  tracker.Sent(11, Seconds(2));
+  tracker.Sent(10, Seconds(3)); // retransmission while the timeout is pending
+  BOOST_CHECK_EQUAL(tracker.GetSize(), 2);
+  BOOST_CHECK_EQUAL(tracker.GetNPendingTimeouts(), 2);
+
+  const SeqTracker::Record* record = tracker.Find(10);
+  BOOST_REQUIRE(record != nullptr);
+  BOOST_CHECK_EQUAL(record->firstSent, Seconds(1));
+  BOOST_CHECK_EQUAL(record->lastSent, Seconds(3));
+  BOOST_CHECK_EQUAL(record->retxCount, 2);
+
+  tracker.Erase(10);
+  BOOST_CHECK(tracker.Find(10) == nullptr);
+  BOOST_CHECK(tracker.Find(11) != nullptr);
+  BOOST_CHECK(tracker.Find(12) == nullptr);
+  BOOST_CHECK_EQUAL(tracker.GetSize(), 1);
+  BOOST_CHECK_EQUAL(tracker.GetNPendingTimeouts(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Timeouts)
+{
+  SeqTracker tracker;
+  uint32_t seq = 0;
+
+  tracker.Sent(1, Seconds(1));
+  tracker.Sent(2, Seconds(2));
+  tracker.Sent(3, Seconds(3));
+  tracker.Erase(2);
+
+  BOOST_CHECK(!tracker.PopExpired(Seconds(0.5), seq));
+  BOOST_CHECK(tracker.PopExpired(Seconds(2.5), seq));
+  BOOST_CHECK_EQUAL(seq, 1);
+  // 2 has been acknowledged
+  BOOST_CHECK(!tracker.PopExpired(Seconds(2.5), seq));
+
+  // the record stays after its timeout fired; retransmission sets a new timeout
+  BOOST_REQUIRE(tracker.Find(1) != nullptr);
+  tracker.Sent(1, Seconds(4));
+  BOOST_CHECK_EQUAL(tracker.Find(1)->retxCount, 2);
+  BOOST_CHECK_EQUAL(tracker.Find(1)->firstSent, Seconds(1));
+
+  BOOST_CHECK(tracker.PopExpired(Seconds(10), seq));
+  BOOST_CHECK_EQUAL(seq, 3);
+  BOOST_CHECK(tracker.PopExpired(Seconds(10), seq));
+  BOOST_CHECK_EQUAL(seq, 1);
+  BOOST_CHECK(!tracker.PopExpired(Seconds(10), seq));
+  BOOST_CHECK_EQUAL(tracker.GetNPendingTimeouts(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Window)
+{
+  SeqTracker tracker(4);
+
+  // the window grows beyond the initial capacity and slides as Data arrive
+  for (uint32_t seq = 100; seq < 1100; ++seq) {
+    tracker.Sent(seq, MilliSeconds(seq));
+    if (seq >= 110) {
+      tracker.Erase(seq - 10);
+    }
+  }
+  BOOST_CHECK_EQUAL(tracker.GetSize(), 10);
+  BOOST_CHECK(tracker.Find(1089) == nullptr);
+  BOOST_REQUIRE(tracker.Find(1090) != nullptr);
+  BOOST_CHECK_EQUAL(tracker.Find(1090)->firstSent, MilliSeconds(1090));
+
+  // out of order sequence numbers, e.g., from ConsumerZipfMandelbrot
+  tracker.Sent(5, MilliSeconds(2000));
+  tracker.Sent(3000, MilliSeconds(2001));
+  BOOST_CHECK_EQUAL(tracker.GetSize(), 12);
+  BOOST_CHECK(tracker.Find(5) != nullptr);
+  BOOST_CHECK(tracker.Find(1095) != nullptr);
+  BOOST_CHECK(tracker.Find(3000) != nullptr);
+
+  uint32_t seq = 0;
+  size_t nExpired = 0;
+  while (tracker.PopExpired(MilliSeconds(2001), seq)) {
+    ++nExpired;
+  }
+  BOOST_CHECK_EQUAL(nExpired, 12);
+}
+
+BOOST_AUTO_TEST_CASE(RandomSequenceNumbers)
+{
+  SeqTracker tracker(4, 256);
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<uint32_t> dist(0, 1000000);
+  std::deque<uint32_t> outstanding;
+  std::set<uint32_t> outstandingSet;
+
+  // a Zipf-like source: sequence numbers are spread over a large range, and about
+  // 100 Interests are outstanding at any time
+  for (int i = 0; i < 20000; ++i) {
+    uint32_t seq = dist(rng);
+    tracker.Sent(seq, MilliSeconds(i));
+    if (outstandingSet.insert(seq).second) {
+      outstanding.push_back(seq);
+    }
+    if (outstanding.size() > 100) {
+      tracker.Erase(outstanding.front());
+      outstandingSet.erase(outstanding.front());
+      outstanding.pop_front();
+    }
+
+    BOOST_REQUIRE_EQUAL(tracker.GetSize(), outstanding.size());
+    BOOST_REQUIRE_LE(tracker.GetWindowCapacity(), 256);
+    BOOST_REQUIRE_LE(tracker.GetNOutOfWindow(), outstanding.size());
+  }
+
+  for (uint32_t seq : outstanding) {
+    BOOST_REQUIRE(tracker.Find(seq) != nullptr);
+    BOOST_CHECK_EQUAL(tracker.Find(seq)->seq, seq);
+  }
+  BOOST_CHECK_GT(tracker.GetNOutOfWindow(), 0);
+
+  // timeouts of sequence numbers out of the window fire as well
+  uint32_t seq = 0;
+  size_t nExpired = 0;
+  while (tracker.PopExpired(MilliSeconds(20000), seq)) {
+    BOOST_CHECK_EQUAL(outstandingSet.count(seq), 1);
+    ++nExpired;
+  }
+  BOOST_CHECK_EQUAL(nExpired, outstanding.size());
+  BOOST_CHECK_EQUAL(tracker.GetNPendingTimeouts(), 0);
+
+  for (uint32_t seq : outstanding) {
+    tracker.Erase(seq);
+  }
+  BOOST_CHECK_EQUAL(tracker.GetSize(), 0);
+  BOOST_CHECK_EQUAL(tracker.GetNOutOfWindow(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
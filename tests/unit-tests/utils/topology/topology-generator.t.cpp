@@ -0,0 +1,223 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/topology-generator.hpp"
+#include "utils/topology/binary-topology-file.hpp"
+#include "utils/topology/annotated-topology-reader.hpp"
+
+#include "ns3/node.h"
+#include "ns3/names.h"
+
+#include "../../tests-common.hpp"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <set>
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path GENERATED_TOPO_TXT =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "generated-topo.txt";
+const boost::filesystem::path GENERATED_TOPO_BIN =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "generated-topo.bin";
+
+class TopologyGeneratorFixture : public CleanupFixture
+{
+public:
+  TopologyGeneratorFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~TopologyGeneratorFixture()
+  {
+    boost::filesystem::remove(GENERATED_TOPO_TXT);
+    boost::filesystem::remove(GENERATED_TOPO_BIN);
+  }
+
+  std::vector<uint32_t>
+  getDegrees(const TopologyGenerator& generator)
+  {
+    std::vector<uint32_t> degrees(generator.GetNodes().size());
+    for (const TopologyGenerator::Link& link : generator.GetLinks()) {
+      ++degrees[link.from];
+      ++degrees[link.to];
+    }
+    return degrees;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTopologyTopologyGenerator, TopologyGeneratorFixture)
+
+BOOST_AUTO_TEST_CASE(Grid)
+{
+  TopologyGenerator generator;
+  generator.GenerateGrid(3, 4);
+
+  BOOST_CHECK_EQUAL(generator.GetNodes().size(), 12);
+  BOOST_CHECK_EQUAL(generator.GetLinks().size(), 3 * 3 + 2 * 4);
+  BOOST_CHECK_EQUAL(generator.GetNodes()[6].name, "1-2");
+
+  std::vector<uint32_t> degrees = getDegrees(generator);
+  BOOST_CHECK_EQUAL(degrees[0], 2);
+  BOOST_CHECK_EQUAL(degrees[5], 4);
+}
+
+BOOST_AUTO_TEST_CASE(Tree)
+{
+  TopologyGenerator generator;
+  generator.GenerateTree(13, 3);
+
+  BOOST_REQUIRE_EQUAL(generator.GetLinks().size(), 12);
+  BOOST_CHECK_EQUAL(generator.GetLinks().back().from, 3);
+  BOOST_CHECK_EQUAL(generator.GetLinks().back().to, 12);
+  BOOST_CHECK_EQUAL(getDegrees(generator)[0], 3);
+}
+
+BOOST_AUTO_TEST_CASE(FatTree)
+{
+  TopologyGenerator generator;
+  generator.GenerateFatTree(4);
+
+  // 4 core, 8 aggregation, 8 edge switches, 16 hosts
+  BOOST_CHECK_EQUAL(generator.GetNodes().size(), 36);
+  BOOST_CHECK_EQUAL(generator.GetLinks().size(), 48);
+
+  std::vector<uint32_t> degrees = getDegrees(generator);
+  for (size_t i = 0; i < degrees.size(); ++i) {
+    if (generator.GetNodes()[i].name.compare(0, 5, "host-") == 0) {
+      BOOST_CHECK_EQUAL(degrees[i], 1);
+    }
+    else {
+      BOOST_CHECK_EQUAL(degrees[i], 4); // every port of a switch is used
+    }
+  }
+
+  generator.GenerateFatTree(4, false);
+  BOOST_CHECK_EQUAL(generator.GetNodes().size(), 20);
+  BOOST_CHECK_EQUAL(generator.GetLinks().size(), 32);
+}
+
+BOOST_AUTO_TEST_CASE(ScaleFree)
+{
+  TopologyGenerator generator;
+  generator.SetDataRate(DataRate("1Mbps"), DataRate("2Mbps"));
+  generator.SetDelay(MilliSeconds(1), MilliSeconds(5));
+  generator.GenerateScaleFree(2000, 2);
+
+  BOOST_CHECK_EQUAL(generator.GetNodes().size(), 2000);
+  BOOST_CHECK_EQUAL(generator.GetLinks().size(), 3 + 1997 * 2);
+
+  std::set<std::pair<uint32_t, uint32_t>> links;
+  for (const TopologyGenerator::Link& link : generator.GetLinks()) {
+    BOOST_CHECK_LT(link.from, link.to);
+    BOOST_CHECK(links.insert(std::make_pair(link.from, link.to)).second);
+
+    BOOST_CHECK_GE(link.dataRate, 1000000);
+    BOOST_CHECK_LE(link.dataRate, 2000000);
+    BOOST_CHECK(link.delay >= MilliSeconds(1) && link.delay <= MilliSeconds(5));
+  }
+
+  // preferential attachment produces hubs
+  std::vector<uint32_t> degrees = getDegrees(generator);
+  BOOST_CHECK_GT(*std::max_element(degrees.begin(), degrees.end()), 40);
+}
+
+BOOST_AUTO_TEST_CASE(BinaryFile)
+{
+  TopologyGenerator generator;
+  generator.SetMaxPackets(100);
+  generator.GenerateTree(40, 3);
+  generator.SaveBinary(GENERATED_TOPO_BIN.string());
+  generator.Save(GENERATED_TOPO_TXT.string());
+
+  BOOST_CHECK(BinaryTopologyFile::IsBinaryTopology(GENERATED_TOPO_BIN.string()));
+  BOOST_CHECK(!BinaryTopologyFile::IsBinaryTopology(GENERATED_TOPO_TXT.string()));
+
+  BinaryTopologyFile file;
+  BOOST_REQUIRE(file.Open(GENERATED_TOPO_BIN.string()));
+  BOOST_REQUIRE_EQUAL(file.GetNNodes(), 40);
+  BOOST_REQUIRE_EQUAL(file.GetNLinks(), 39);
+  for (uint32_t i = 0; i < file.GetNNodes(); ++i) {
+    BOOST_CHECK_EQUAL(file.GetNodeName(i), generator.GetNodes()[i].name);
+    BOOST_CHECK_EQUAL(file.GetNode(i).latitude, generator.GetNodes()[i].latitude);
+  }
+  for (uint32_t i = 0; i < file.GetNLinks(); ++i) {
+    const TopologyGenerator::Link& link = generator.GetLinks()[i];
+    BOOST_CHECK_EQUAL(file.GetLink(i).from, link.from);
+    BOOST_CHECK_EQUAL(file.GetLink(i).to, link.to);
+    BOOST_CHECK_EQUAL(file.GetLink(i).dataRate, link.dataRate);
+    BOOST_CHECK_EQUAL(file.GetLink(i).delay, link.delay.GetNanoSeconds());
+    BOOST_CHECK_EQUAL(file.GetLink(i).maxPackets, 100);
+  }
+  file.Close();
+
+  // truncated file is rejected
+  boost::filesystem::resize_file(GENERATED_TOPO_BIN,
+                                 boost::filesystem::file_size(GENERATED_TOPO_BIN) - 1);
+  BOOST_CHECK(!file.Open(GENERATED_TOPO_BIN.string()));
+}
+
+BOOST_AUTO_TEST_CASE(ReadBinary)
+{
+  TopologyGenerator generator;
+  generator.SetDelay(MilliSeconds(2), MilliSeconds(2));
+  generator.GenerateGrid(5, 5);
+  generator.SaveBinary(GENERATED_TOPO_BIN.string());
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(GENERATED_TOPO_BIN.string());
+  NodeContainer nodes = topologyReader.Read();
+
+  BOOST_CHECK_EQUAL(nodes.GetN(), 25);
+  BOOST_REQUIRE_EQUAL(topologyReader.GetLinks().size(), 40);
+  BOOST_CHECK(Names::Find<Node>("4-4") != nullptr);
+
+  const TopologyReader::Link& link = topologyReader.GetLinks().front();
+  BOOST_CHECK_EQUAL(link.GetFromNodeName(), "0-0");
+  BOOST_CHECK_EQUAL(link.GetToNodeName(), "0-1");
+  BOOST_CHECK(Time(link.GetAttribute("Delay")) == MilliSeconds(2));
+  BOOST_CHECK_EQUAL(DataRate(link.GetAttribute("DataRate")).GetBitRate(), 10000000);
+}
+
+BOOST_AUTO_TEST_CASE(ConvertToBinary)
+{
+  TopologyGenerator generator;
+  generator.GenerateFatTree(4, false);
+  generator.Save(GENERATED_TOPO_TXT.string());
+
+  AnnotatedTopologyReader textReader("");
+  textReader.SetFileName(GENERATED_TOPO_TXT.string());
+  textReader.Read();
+  textReader.SaveBinaryTopology(GENERATED_TOPO_BIN.string());
+
+  BinaryTopologyFile file;
+  BOOST_REQUIRE(file.Open(GENERATED_TOPO_BIN.string()));
+  BOOST_CHECK_EQUAL(file.GetNNodes(), 20);
+  BOOST_REQUIRE_EQUAL(file.GetNLinks(), 32);
+  BOOST_CHECK_EQUAL(file.GetNodeName(file.GetLink(0).from), "core-0");
+  BOOST_CHECK_EQUAL(file.GetNodeName(file.GetLink(0).to), "agg-0-0");
+  BOOST_CHECK_EQUAL(file.GetLink(0).delay, MilliSeconds(10).GetNanoSeconds());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
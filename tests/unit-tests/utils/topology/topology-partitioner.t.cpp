@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/topology-partitioner.hpp"
+#include "utils/topology/annotated-topology-reader.hpp"
+
+#include "ns3/node.h"
+#include "ns3/names.h"
+
+#include "../../tests-common.hpp"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path PARTITION_TOPO_TXT =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "partition-topo.txt";
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTopologyTopologyPartitioner, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Grid)
+{
+  TopologyPartitioner partitioner;
+  const uint32_t side = 20;
+  for (uint32_t i = 0; i < side * side; ++i) {
+    partitioner.AddNode();
+  }
+  for (uint32_t row = 0; row < side; ++row) {
+    for (uint32_t col = 0; col < side; ++col) {
+      if (col + 1 < side) {
+        partitioner.AddLink(row * side + col, row * side + col + 1, MilliSeconds(1));
+      }
+      if (row + 1 < side) {
+        partitioner.AddLink(row * side + col, (row + 1) * side + col, MilliSeconds(1));
+      }
+    }
+  }
+
+  std::vector<uint32_t> parts = partitioner.Partition(4);
+  BOOST_REQUIRE_EQUAL(parts.size(), side * side);
+
+  std::vector<uint32_t> sizes(4, 0);
+  for (uint32_t part : parts) {
+    BOOST_REQUIRE_LT(part, 4);
+    ++sizes[part];
+  }
+  for (uint32_t size : sizes) {
+    BOOST_CHECK_LE(size, 100 * 1.05);
+  }
+
+  // straight strips cut 3 * 20 links; a good partitioning should not be much worse
+  BOOST_CHECK_LE(partitioner.GetNCutLinks(), 3 * side + side / 2);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(1));
+}
+
+BOOST_AUTO_TEST_CASE(PreferLongLinks)
+{
+  // two dense clusters joined by long links, and by one short link that must be cut anyway
+  TopologyPartitioner partitioner;
+  for (uint32_t i = 0; i < 20; ++i) {
+    partitioner.AddNode();
+  }
+  for (uint32_t cluster = 0; cluster < 20; cluster += 10) {
+    for (uint32_t a = 0; a < 10; ++a) {
+      for (uint32_t b = a + 1; b < 10; ++b) {
+        partitioner.AddLink(cluster + a, cluster + b, MilliSeconds(1));
+      }
+    }
+  }
+  partitioner.AddLink(0, 10, MilliSeconds(50));
+  partitioner.AddLink(1, 11, MilliSeconds(50));
+  partitioner.AddLink(2, 12, MilliSeconds(20));
+
+  std::vector<uint32_t> parts = partitioner.Partition(2);
+  for (uint32_t i = 1; i < 10; ++i) {
+    BOOST_CHECK_EQUAL(parts[i], parts[0]);
+    BOOST_CHECK_EQUAL(parts[10 + i], parts[10]);
+  }
+  BOOST_CHECK_NE(parts[0], parts[10]);
+  BOOST_CHECK_EQUAL(partitioner.GetNCutLinks(), 3);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(20));
+}
+
+BOOST_AUTO_TEST_CASE(Trivial)
+{
+  TopologyPartitioner partitioner;
+  partitioner.AddNode();
+  partitioner.AddNode();
+  partitioner.AddLink(0, 1, MilliSeconds(1));
+
+  BOOST_CHECK(partitioner.Partition(1) == std::vector<uint32_t>({0, 0}));
+  BOOST_CHECK_EQUAL(partitioner.GetNCutLinks(), 0);
+  BOOST_CHECK(partitioner.GetLookahead() == Time::Max());
+
+  // more partitions than nodes: one node per partition
+  BOOST_CHECK(partitioner.Partition(3) == std::vector<uint32_t>({0, 1}));
+  BOOST_CHECK_EQUAL(partitioner.GetNCutLinks(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(AnnotatedTopologyReaderPartitions)
+{
+  boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  std::ofstream file(PARTITION_TOPO_TXT.string().c_str());
+  file << "router\n\n"
+       << "#node city  y x mpi-partition\n"
+       << "A1  NA  0 0 0\n"
+       << "A2  NA  0 0 0\n"
+       << "A3  NA  0 0 0\n"
+       << "B1  NA  0 0 0\n"
+       << "B2  NA  0 0 0\n"
+       << "B3  NA  0 0 0\n\n"
+       << "link\n\n"
+       << "A1  A2  10Mbps  1  1ms  100\n"
+       << "A2  A3  10Mbps  1  1ms  100\n"
+       << "A3  A1  10Mbps  1  1ms  100\n"
+       << "B1  B2  10Mbps  1  1ms  100\n"
+       << "B2  B3  10Mbps  1  1ms  100\n"
+       << "B3  B1  10Mbps  1  1ms  100\n"
+       << "A1  B1  10Mbps  1  30ms  100\n";
+  file.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(PARTITION_TOPO_TXT.string());
+  topologyReader.SetPartitions(2);
+  topologyReader.Read();
+  boost::filesystem::remove(PARTITION_TOPO_TXT);
+
+  uint32_t a = Names::Find<Node>("A1")->GetSystemId();
+  uint32_t b = Names::Find<Node>("B1")->GetSystemId();
+  BOOST_CHECK_NE(a, b);
+  BOOST_CHECK_EQUAL(Names::Find<Node>("A2")->GetSystemId(), a);
+  BOOST_CHECK_EQUAL(Names::Find<Node>("A3")->GetSystemId(), a);
+  BOOST_CHECK_EQUAL(Names::Find<Node>("B2")->GetSystemId(), b);
+  BOOST_CHECK_EQUAL(Names::Find<Node>("B3")->GetSystemId(), b);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -143,6 +143,32 @@ BOOST_AUTO_TEST_CASE(InstallNode)
 )STR");
 }
 
+BOOST_AUTO_TEST_CASE(InstallNodeAggregated)
+{
+  AppDelayTracer::Install(getNode("2"), TEST_TRACE.string(), Seconds(0.5));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    R"STR(Time	Node	AppId	Type	Samples	MeanDelayUS	P50DelayUS	P90DelayUS	P99DelayUS	MaxDelayUS	MeanRetxCount	MeanHopCount	P50HopCount	P90HopCount	MaxHopCount
+2.5	2	0	LastDelay	1	0	0	0	0	0	NA	0	0	0	0
+2.5	2	0	FullDelay	1	0	0	0	0	0	1	0	0	0	0
+2.5	2	*	LastDelay	1	0	0	0	0	0	NA	0	0	0	0
+2.5	2	*	FullDelay	1	0	0	0	0	0	1	0	0	0	0
+3.5	2	0	LastDelay	1	20894	20894	20894	20894	20894	NA	1	1	1	1
+3.5	2	0	FullDelay	1	20894	20894	20894	20894	20894	1	1	1	1	1
+3.5	2	*	LastDelay	1	20894	20894	20894	20894	20894	NA	1	1	1	1
+3.5	2	*	FullDelay	1	20894	20894	20894	20894	20894	1	1	1	1	1
+)STR");
+}
+
 BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
 {
   auto output = make_shared<boost::test_tools::output_test_stream>();
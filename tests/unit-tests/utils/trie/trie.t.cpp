@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/ndn-content-store.hpp"
+#include "utils/trie/trie-with-policy.hpp"
+#include "utils/trie/lru-policy.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTrie, CleanupFixture)
+
+struct Item {
+  Name name;
+};
+
+typedef ndnSIM::trie_with_policy<Name, ndnSIM::pointer_payload_traits<Item>,
+                                 ndnSIM::lru_policy_traits> Trie;
+
+static size_t
+countPayloads(Trie& trie)
+{
+  size_t nPayloads = 0;
+  Trie::parent_trie::recursive_iterator item(trie.getTrie()), end(0);
+  for (; item != end; item++) {
+    if (item->payload() != nullptr) {
+      ++nPayloads;
+    }
+  }
+  return nPayloads;
+}
+
+BOOST_AUTO_TEST_CASE(WideFanOut)
+{
+  // 300 children under /wide go through the linear and the hashed child lookup
+  std::vector<Item> items;
+  for (int i = 0; i < 300; ++i) {
+    items.push_back(Item{Name("/wide").appendNumber(i).append("leaf")});
+  }
+
+  Trie trie;
+  trie.getPolicy().set_max_size(0);
+  for (Item& item : items) {
+    BOOST_CHECK(trie.insert(item.name, &item).second);
+  }
+  BOOST_CHECK(!trie.insert(items[7].name, &items[7]).second);
+  BOOST_CHECK_EQUAL(countPayloads(trie), 300);
+
+  for (int i = 0; i < 300; i += 2) {
+    trie.erase(items[i].name);
+  }
+  BOOST_CHECK_EQUAL(countPayloads(trie), 150);
+
+  for (int i = 0; i < 300; ++i) {
+    Trie::iterator found = trie.find_exact(items[i].name);
+    if (i % 2 == 0) {
+      BOOST_CHECK(found == trie.end());
+    }
+    else {
+      BOOST_REQUIRE(found != trie.end());
+      BOOST_CHECK_EQUAL(found->payload()->name, items[i].name);
+    }
+  }
+
+  Trie::iterator match = trie.deepest_prefix_match(Name("/wide").appendNumber(101));
+  BOOST_REQUIRE(match != trie.end());
+  BOOST_CHECK_EQUAL(match->payload()->name, items[101].name);
+  BOOST_CHECK(trie.deepest_prefix_match(Name("/wide").appendNumber(100)) == trie.end());
+
+  // shrinking back below the linear lookup threshold keeps every child reachable
+  for (int i = 1; i < 297; i += 2) {
+    trie.erase(items[i].name);
+  }
+  BOOST_CHECK_EQUAL(countPayloads(trie), 2);
+  BOOST_CHECK(trie.find_exact(items[297].name) != trie.end());
+  BOOST_CHECK(trie.find_exact(items[299].name) != trie.end());
+
+  trie.erase(items[297].name);
+  trie.erase(items[299].name);
+  Trie::parent_trie::point_iterator child(trie.getTrie()), end;
+  BOOST_CHECK(child == end); // all nodes are pruned
+}
+
+BOOST_AUTO_TEST_CASE(Lru)
+{
+  std::vector<Item> items;
+  for (int i = 0; i < 10; ++i) {
+    items.push_back(Item{Name("/prefix").appendNumber(i)});
+  }
+
+  Trie trie;
+  trie.getPolicy().set_max_size(5);
+  for (Item& item : items) {
+    trie.insert(item.name, &item);
+  }
+
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 5);
+  BOOST_CHECK_EQUAL(countPayloads(trie), 5);
+  BOOST_CHECK(trie.find_exact(items[4].name) == trie.end());
+  BOOST_CHECK(trie.find_exact(items[5].name) != trie.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-hdr-histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+HdrHistogram::HdrHistogram()
+  : m_count(0)
+  , m_min(std::numeric_limits<uint64_t>::max())
+  , m_max(0)
+  , m_sum(0)
+{
+}
+
+size_t
+HdrHistogram::GetBucketIndex(uint64_t value)
+{
+  if (value < 2 * SUB_BUCKETS) {
+    return value;
+  }
+
+  // value >> shift is in [SUB_BUCKETS, 2 * SUB_BUCKETS)
+  int shift = 63 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+  return shift * SUB_BUCKETS + (value >> shift);
+}
+
+uint64_t
+HdrHistogram::GetBucketUpperBound(size_t index)
+{
+  if (index < 2 * SUB_BUCKETS) {
+    return index;
+  }
+
+  int shift = index / SUB_BUCKETS - 1;
+  uint64_t subBucket = index - shift * SUB_BUCKETS;
+  return ((subBucket + 1) << shift) - 1;
+}
+
+void
+HdrHistogram::Add(uint64_t value, uint64_t count)
+{
+  if (count == 0) {
+    return;
+  }
+
+  size_t index = GetBucketIndex(value);
+  if (index >= m_counts.size()) {
+    m_counts.resize(index + 1, 0);
+  }
+  m_counts[index] += count;
+
+  m_count += count;
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+  m_sum += static_cast<double>(value) * count;
+}
+
+void
+HdrHistogram::Merge(const HdrHistogram& other)
+{
+  if (other.m_count == 0) {
+    return;
+  }
+
+  if (other.m_counts.size() > m_counts.size()) {
+    m_counts.resize(other.m_counts.size(), 0);
+  }
+  for (size_t i = 0; i < other.m_counts.size(); ++i) {
+    m_counts[i] += other.m_counts[i];
+  }
+
+  m_count += other.m_count;
+  m_min = std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+  m_sum += other.m_sum;
+}
+
+void
+HdrHistogram::Reset()
+{
+  std::fill(m_counts.begin(), m_counts.end(), 0);
+  m_count = 0;
+  m_min = std::numeric_limits<uint64_t>::max();
+  m_max = 0;
+  m_sum = 0;
+}
+
+uint64_t
+HdrHistogram::GetQuantile(double q) const
+{
+  if (m_count == 0) {
+    return 0;
+  }
+
+  double rank = std::max(1.0, std::ceil(std::min(std::max(q, 0.0), 1.0) * m_count));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < m_counts.size(); ++i) {
+    seen += m_counts[i];
+    if (seen >= rank) {
+      return std::min(std::max(GetBucketUpperBound(i), m_min), m_max);
+    }
+  }
+  return m_max;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_HDR_HISTOGRAM_H
+#define NDN_HDR_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Mergeable histogram of non-negative integers with bounded relative error
+ *
+ * The layout follows HdrHistogram: values below 2 * SUB_BUCKETS are counted exactly, and every
+ * larger power-of-two range is split into SUB_BUCKETS equal buckets.  A quantile is therefore
+ * reported with a relative error of at most 1 / SUB_BUCKETS (about 3%).
+ *
+ * Counts are kept per bucket, so the histogram does not grow with the number of samples, and
+ * two histograms are merged by adding their counts.  The bucket array grows up to the bucket
+ * of the largest value seen, and is kept across Reset.
+ */
+class HdrHistogram {
+public:
+  static const int SUB_BUCKET_BITS = 5;
+  static const uint64_t SUB_BUCKETS = uint64_t(1) << SUB_BUCKET_BITS;
+
+  HdrHistogram();
+
+  /**
+   * @brief Record @p value @p count times
+   */
+  void
+  Add(uint64_t value, uint64_t count = 1);
+
+  /**
+   * @brief Add all samples of @p other
+   */
+  void
+  Merge(const HdrHistogram& other);
+
+  /**
+   * @brief Remove all samples
+   */
+  void
+  Reset();
+
+  uint64_t
+  GetCount() const
+  {
+    return m_count;
+  }
+
+  /**
+   * @return the smallest sample, or 0 if there is none
+   */
+  uint64_t
+  GetMin() const
+  {
+    return m_count > 0 ? m_min : 0;
+  }
+
+  /**
+   * @return the largest sample, or 0 if there is none
+   */
+  uint64_t
+  GetMax() const
+  {
+    return m_max;
+  }
+
+  /**
+   * @return the exact mean of the samples, or 0 if there is none
+   */
+  double
+  GetMean() const
+  {
+    return m_count > 0 ? m_sum / m_count : 0;
+  }
+
+  /**
+   * @return an upper bound of the @p q quantile, within [GetMin(), GetMax()]
+   * @param q quantile between 0 and 1, e.g., 0.99 for the 99th percentile
+   */
+  uint64_t
+  GetQuantile(double q) const;
+
+private:
+  static size_t
+  GetBucketIndex(uint64_t value);
+
+  /**
+   * @return the largest value counted in bucket @p index
+   */
+  static uint64_t
+  GetBucketUpperBound(size_t index);
+
+private:
+  std::vector<uint64_t> m_counts;
+  uint64_t m_count;
+  uint64_t m_min;
+  uint64_t m_max;
+  double m_sum;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_HDR_HISTOGRAM_H
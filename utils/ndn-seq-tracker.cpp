@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-seq-tracker.hpp"
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+
+static size_t
+roundUpToPowerOfTwo(uint64_t n)
+{
+  size_t capacity = 1;
+  while (capacity < n) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+SeqTracker::SeqTracker(size_t initialCapacity, size_t maxWindowSize)
+  : m_slots(roundUpToPowerOfTwo(std::max<size_t>(std::min(initialCapacity, maxWindowSize), 1)))
+  , m_begin(0)
+  , m_end(0)
+  , m_nInWindow(0)
+  , m_maxWindowSize(std::max<size_t>(maxWindowSize, 1))
+  , m_size(0)
+  , m_timeouts(m_slots.size())
+  , m_timeoutsHead(0)
+  , m_timeoutsSize(0)
+  , m_nPendingTimeouts(0)
+{
+}
+
+void
+SeqTracker::Sent(uint32_t seq, Time now)
+{
+  Slot* slot = FindSlot(seq);
+  if (slot != nullptr) {
+    slot->lastSent = now;
+    ++slot->retxCount;
+    if (!slot->hasPendingTimeout) {
+      slot->hasPendingTimeout = true;
+      slot->timeoutStart = now;
+      PushTimeout(seq, now);
+    }
+    return;
+  }
+
+  uint64_t begin = m_nInWindow == 0 ? seq : std::min<uint64_t>(m_begin, seq);
+  uint64_t end = m_nInWindow == 0 ? seq + 1ull : std::max<uint64_t>(m_end, seq + 1ull);
+  if (end - begin <= m_maxWindowSize) {
+    Reserve(end - begin);
+    m_begin = begin;
+    m_end = end;
+    slot = &GetSlot(seq);
+    ++m_nInWindow;
+  }
+  else {
+    slot = &m_outOfWindow[seq];
+  }
+
+  slot->seq = seq;
+  slot->firstSent = now;
+  slot->lastSent = now;
+  slot->retxCount = 1;
+  slot->isUsed = true;
+  slot->hasPendingTimeout = true;
+  slot->timeoutStart = now;
+  ++m_size;
+  PushTimeout(seq, now);
+}
+
+const SeqTracker::Record*
+SeqTracker::Find(uint32_t seq) const
+{
+  return FindSlot(seq);
+}
+
+void
+SeqTracker::Erase(uint32_t seq)
+{
+  Slot* slot = FindSlot(seq);
+  if (slot == nullptr) {
+    return;
+  }
+
+  if (slot->hasPendingTimeout) {
+    // the entry in the FIFO is skipped once it reaches the front
+    --m_nPendingTimeouts;
+  }
+  --m_size;
+
+  if (!IsInWindow(seq) || slot != &GetSlot(seq)) {
+    m_outOfWindow.erase(seq);
+    return;
+  }
+
+  slot->isUsed = false;
+  slot->hasPendingTimeout = false;
+  --m_nInWindow;
+
+  if (m_nInWindow == 0) {
+    m_begin = m_end = 0;
+    return;
+  }
+
+  // slide the window; it spans at most m_maxWindowSize sequence numbers, and each of them
+  // is passed over at most once per insertion
+  while (!GetSlot(m_begin).isUsed) {
+    ++m_begin;
+  }
+  while (!GetSlot(m_end - 1).isUsed) {
+    --m_end;
+  }
+}
+
+SeqTracker::Slot*
+SeqTracker::FindSlot(uint32_t seq)
+{
+  if (IsInWindow(seq) && GetSlot(seq).isUsed) {
+    return &GetSlot(seq);
+  }
+  if (m_outOfWindow.empty()) {
+    return nullptr;
+  }
+  auto it = m_outOfWindow.find(seq);
+  return it == m_outOfWindow.end() ? nullptr : &it->second;
+}
+
+bool
+SeqTracker::PopExpired(Time deadline, uint32_t& seq)
+{
+  while (m_timeoutsSize > 0) {
+    const Timeout& timeout = m_timeouts[m_timeoutsHead];
+    Slot* slot = FindSlot(timeout.seq);
+    if (slot == nullptr || !slot->hasPendingTimeout || slot->timeoutStart != timeout.time) {
+      // Data has arrived, or the timeout has already fired
+      PopTimeout();
+      continue;
+    }
+
+    if (timeout.time > deadline) {
+      return false;
+    }
+
+    seq = timeout.seq;
+    slot->hasPendingTimeout = false;
+    --m_nPendingTimeouts;
+    PopTimeout();
+    return true;
+  }
+  return false;
+}
+
+void
+SeqTracker::Reserve(uint64_t windowSize)
+{
+  if (windowSize <= m_slots.size()) {
+    return;
+  }
+
+  std::vector<Slot> slots(roundUpToPowerOfTwo(windowSize));
+  for (uint64_t seq = m_begin; seq < m_end; ++seq) {
+    const Slot& slot = GetSlot(seq);
+    if (slot.isUsed) {
+      slots[seq & (slots.size() - 1)] = slot;
+    }
+  }
+  m_slots.swap(slots);
+}
+
+void
+SeqTracker::PushTimeout(uint32_t seq, Time time)
+{
+  if (m_timeoutsSize == m_timeouts.size()) {
+    std::vector<Timeout> timeouts(m_timeouts.size() * 2);
+    for (size_t i = 0; i < m_timeoutsSize; ++i) {
+      timeouts[i] = m_timeouts[(m_timeoutsHead + i) & (m_timeouts.size() - 1)];
+    }
+    m_timeouts.swap(timeouts);
+    m_timeoutsHead = 0;
+  }
+
+  Timeout& timeout = m_timeouts[(m_timeoutsHead + m_timeoutsSize) & (m_timeouts.size() - 1)];
+  timeout.seq = seq;
+  timeout.time = time;
+  ++m_timeoutsSize;
+  ++m_nPendingTimeouts;
+}
+
+void
+SeqTracker::PopTimeout()
+{
+  m_timeoutsHead = (m_timeoutsHead + 1) & (m_timeouts.size() - 1);
+  --m_timeoutsSize;
+}
+
+} // namespace ndn
+} // namespace ns3
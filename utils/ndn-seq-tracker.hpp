@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_SEQ_TRACKER_H
+#define NDN_SEQ_TRACKER_H
+
+#include "ns3/nstime.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Per-sequence-number bookkeeping of outstanding Interests
+ *
+ * Records are kept in a ring buffer indexed by sequence number, covering the window between
+ * the lowest and the highest outstanding sequence numbers in it.  The window grows (doubling)
+ * when an Interest falls outside of it, up to a maximum size, and slides forward as the lowest
+ * outstanding sequence numbers are acknowledged.  Sequence numbers that would stretch the
+ * window beyond its maximum size, as non-monotonic sources such as ConsumerZipfMandelbrot
+ * produce, are kept in a hash table instead.
+ *
+ * Retransmission timeouts are kept in a FIFO ring: Interests are sent in simulation time
+ * order, so the FIFO is ordered by send time without a heap.  Records whose Data has
+ * arrived are skipped when they reach the front.
+ *
+ * Apart from the occasional doubling of either ring, sending and acknowledging an Interest
+ * in the window takes constant amortized time and does not allocate.  Memory is bounded by
+ * the maximum window size plus the number of outstanding Interests.
+ */
+class SeqTracker {
+public:
+  struct Record {
+    uint32_t seq;
+    Time firstSent;     ///< @brief time the sequence number was first requested
+    Time lastSent;      ///< @brief time of the latest (re)transmission
+    uint32_t retxCount; ///< @brief number of transmissions, including the first one
+  };
+
+  /**
+   * @param initialCapacity initial number of slots in the ring
+   * @param maxWindowSize maximum span of sequence numbers kept in the ring
+   */
+  explicit SeqTracker(size_t initialCapacity = 64, size_t maxWindowSize = 4096);
+
+  /**
+   * @brief Note that an Interest for @p seq is being sent at @p now
+   *
+   * A new sequence number gets a new record and a pending timeout.  For a tracked one,
+   * lastSent and retxCount are updated, and a timeout is set unless one is already pending.
+   */
+  void
+  Sent(uint32_t seq, Time now);
+
+  /**
+   * @return the record of @p seq, or nullptr if it is not tracked
+   */
+  const Record*
+  Find(uint32_t seq) const;
+
+  /**
+   * @brief Stop tracking @p seq, e.g., because Data has arrived
+   */
+  void
+  Erase(uint32_t seq);
+
+  /**
+   * @brief Take the oldest pending timeout, if it was set no later than @p deadline
+   * @param deadline the current time minus the retransmission timeout
+   * @param[out] seq the expired sequence number
+   * @return whether a timeout has expired
+   */
+  bool
+  PopExpired(Time deadline, uint32_t& seq);
+
+  /**
+   * @return number of tracked sequence numbers
+   */
+  size_t
+  GetSize() const
+  {
+    return m_size;
+  }
+
+  /**
+   * @return number of pending timeouts
+   */
+  size_t
+  GetNPendingTimeouts() const
+  {
+    return m_nPendingTimeouts;
+  }
+
+  /**
+   * @return number of slots in the ring
+   */
+  size_t
+  GetWindowCapacity() const
+  {
+    return m_slots.size();
+  }
+
+  /**
+   * @return number of sequence numbers tracked outside of the window
+   */
+  size_t
+  GetNOutOfWindow() const
+  {
+    return m_outOfWindow.size();
+  }
+
+private:
+  struct Slot : public Record {
+    bool isUsed = false;
+    bool hasPendingTimeout = false;
+    Time timeoutStart; ///< @brief time the pending timeout was set
+  };
+
+  struct Timeout {
+    uint32_t seq;
+    Time time;
+  };
+
+  Slot&
+  GetSlot(uint64_t seq)
+  {
+    return m_slots[seq & (m_slots.size() - 1)];
+  }
+
+  const Slot&
+  GetSlot(uint64_t seq) const
+  {
+    return m_slots[seq & (m_slots.size() - 1)];
+  }
+
+  bool
+  IsInWindow(uint32_t seq) const
+  {
+    return m_nInWindow > 0 && m_begin <= seq && seq < m_end;
+  }
+
+  /**
+   * @return the slot of @p seq, either in the window or out of it, or nullptr if not tracked
+   */
+  Slot*
+  FindSlot(uint32_t seq);
+
+  const Slot*
+  FindSlot(uint32_t seq) const
+  {
+    return const_cast<SeqTracker*>(this)->FindSlot(seq);
+  }
+
+  /**
+   * @brief Make sure [begin, end) fits in the ring
+   */
+  void
+  Reserve(uint64_t windowSize);
+
+  void
+  PushTimeout(uint32_t seq, Time time);
+
+  void
+  PopTimeout();
+
+private:
+  std::vector<Slot> m_slots; ///< @brief size is a power of two
+  uint64_t m_begin;          ///< @brief lowest sequence number tracked in the window
+  uint64_t m_end;            ///< @brief one past the highest sequence number tracked in the window
+  size_t m_nInWindow;
+  size_t m_maxWindowSize;
+  std::unordered_map<uint32_t, Slot> m_outOfWindow;
+  size_t m_size;
+
+  std::vector<Timeout> m_timeouts; ///< @brief size is a power of two
+  size_t m_timeoutsHead;
+  size_t m_timeoutsSize;
+  size_t m_nPendingTimeouts;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SEQ_TRACKER_H
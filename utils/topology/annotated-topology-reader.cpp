@@ -41,8 +41,11 @@
 #include "ns3/error-model.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/double.h"
+#include "ns3/data-rate.h"
 
 #include "model/ndn-l3-protocol.hpp"
+#include "topology-partitioner.hpp"
+#include "binary-topology-file.hpp"
 
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
@@ -69,6 +72,7 @@ AnnotatedTopologyReader::AnnotatedTopologyReader(const std::string& path, double
   , m_randY(CreateObject<UniformRandomVariable>())
   , m_scale(scale)
   , m_requiredPartitions(1)
+  , m_nPartitions(0)
 {
   NS_LOG_FUNCTION(this);
 
@@ -138,6 +142,35 @@ AnnotatedTopologyReader::CreateNode(const std::string name, double posX, double
   return node;
 }
 
+void
+AnnotatedTopologyReader::SetPartitions(uint32_t nPartitions)
+{
+  m_nPartitions = nPartitions;
+}
+
+void
+AnnotatedTopologyReader::SetNodeWeight(const std::string& name, double weight)
+{
+  m_nodeWeights[name] = weight;
+}
+
+double
+AnnotatedTopologyReader::GetNodeWeight(const std::string& name) const
+{
+  auto weight = m_nodeWeights.find(name);
+  return weight != m_nodeWeights.end() ? weight->second : 1.0;
+}
+
+std::vector<uint32_t>
+AnnotatedTopologyReader::Partition(TopologyPartitioner& partitioner) const
+{
+  vector<uint32_t> systemIds = partitioner.Partition(m_nPartitions);
+  NS_LOG_INFO("Nodes assigned to " << m_nPartitions << " partitions with "
+                                   << partitioner.GetNCutLinks() << " links between them"
+                                   << " (lookahead " << partitioner.GetLookahead() << ")");
+  return systemIds;
+}
+
 NodeContainer
 AnnotatedTopologyReader::GetNodes() const
 {
@@ -153,6 +186,9 @@ AnnotatedTopologyReader::GetLinks() const
 NodeContainer
 AnnotatedTopologyReader::Read(void)
 {
+  if (BinaryTopologyFile::IsBinaryTopology(GetFileName()))
+    return ReadBinary();
+
   ifstream topgen;
   topgen.open(GetFileName().c_str());
 
@@ -174,6 +210,14 @@ AnnotatedTopologyReader::Read(void)
     return m_nodes;
   }
 
+  struct NodeRecord {
+    string name;
+    double latitude;
+    double longitude;
+    uint32_t systemId;
+  };
+  vector<NodeRecord> nodes;
+
   while (!topgen.eof()) {
     string line;
     getline(topgen, line);
@@ -183,31 +227,23 @@ AnnotatedTopologyReader::Read(void)
       break; // stop reading nodes
 
     istringstream lineBuffer(line);
-    string name, city;
-    double latitude = 0, longitude = 0;
-    uint32_t systemId = 0;
+    NodeRecord node{"", 0, 0, 0};
+    string city;
 
-    lineBuffer >> name >> city >> latitude >> longitude >> systemId;
-    if (name.empty())
+    lineBuffer >> node.name >> city >> node.latitude >> node.longitude >> node.systemId;
+    if (node.name.empty())
       continue;
 
-    Ptr<Node> node;
-
-    if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
-      node = CreateNode(name, m_scale * longitude, -m_scale * latitude, systemId);
-    else {
-      Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
-      node = CreateNode(name, var->GetValue(0, 200), var->GetValue(0, 200), systemId);
-      // node = CreateNode (name, systemId);
-    }
+    nodes.push_back(node);
   }
 
+  struct LinkRecord {
+    string from, to, capacity, metric, delay, maxPackets, lossRate;
+  };
+  vector<LinkRecord> links;
   map<string, set<string>> processedLinks; // to eliminate duplications
 
-  if (topgen.eof()) {
-    NS_LOG_ERROR("Topology file " << GetFileName() << " does not have \"link\" section");
-    return m_nodes;
-  }
+  bool hasLinkSection = !topgen.eof();
 
   // SeekToSection ("link");
   while (!topgen.eof()) {
@@ -221,44 +257,152 @@ AnnotatedTopologyReader::Read(void)
     // NS_LOG_DEBUG ("Input: [" << line << "]");
 
     istringstream lineBuffer(line);
-    string from, to, capacity, metric, delay, maxPackets, lossRate;
+    LinkRecord link;
 
-    lineBuffer >> from >> to >> capacity >> metric >> delay >> maxPackets >> lossRate;
+    lineBuffer >> link.from >> link.to >> link.capacity >> link.metric >> link.delay
+      >> link.maxPackets >> link.lossRate;
 
-    if (processedLinks[to].size() != 0
-        && processedLinks[to].find(from) != processedLinks[to].end()) {
+    if (processedLinks[link.to].size() != 0
+        && processedLinks[link.to].find(link.from) != processedLinks[link.to].end()) {
       continue; // duplicated link
     }
-    processedLinks[from].insert(to);
+    processedLinks[link.from].insert(link.to);
 
-    Ptr<Node> fromNode = Names::Find<Node>(m_path, from);
-    NS_ASSERT_MSG(fromNode != 0, from << " node not found");
-    Ptr<Node> toNode = Names::Find<Node>(m_path, to);
-    NS_ASSERT_MSG(toNode != 0, to << " node not found");
+    links.push_back(link);
+  }
+  topgen.close();
 
-    Link link(fromNode, from, toNode, to);
+  if (m_nPartitions > 0) {
+    TopologyPartitioner partitioner;
+    map<string, uint32_t> indices;
+    for (const NodeRecord& node : nodes) {
+      indices[node.name] = partitioner.AddNode(GetNodeWeight(node.name));
+    }
 
-    link.SetAttribute("DataRate", capacity);
-    link.SetAttribute("OSPF", metric);
+    for (const LinkRecord& link : links) {
+      auto from = indices.find(link.from);
+      auto to = indices.find(link.to);
+      if (from != indices.end() && to != indices.end()) {
+        partitioner.AddLink(from->second, to->second,
+                            link.delay.empty() ? Time() : Time(link.delay));
+      }
+    }
 
-    if (!delay.empty())
-      link.SetAttribute("Delay", delay);
-    if (!maxPackets.empty())
-      link.SetAttribute("MaxPackets", maxPackets);
+    vector<uint32_t> systemIds = Partition(partitioner);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      nodes[i].systemId = systemIds[i];
+    }
+  }
+
+  for (const NodeRecord& node : nodes) {
+    if (abs(node.latitude) > 0.001 && abs(node.latitude) > 0.001)
+      CreateNode(node.name, m_scale * node.longitude, -m_scale * node.latitude, node.systemId);
+    else {
+      Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
+      CreateNode(node.name, var->GetValue(0, 200), var->GetValue(0, 200), node.systemId);
+      // node = CreateNode (name, systemId);
+    }
+  }
+
+  if (!hasLinkSection) {
+    NS_LOG_ERROR("Topology file " << GetFileName() << " does not have \"link\" section");
+    return m_nodes;
+  }
+
+  for (const LinkRecord& record : links) {
+    Ptr<Node> fromNode = Names::Find<Node>(m_path, record.from);
+    NS_ASSERT_MSG(fromNode != 0, record.from << " node not found");
+    Ptr<Node> toNode = Names::Find<Node>(m_path, record.to);
+    NS_ASSERT_MSG(toNode != 0, record.to << " node not found");
+
+    Link link(fromNode, record.from, toNode, record.to);
+
+    link.SetAttribute("DataRate", record.capacity);
+    link.SetAttribute("OSPF", record.metric);
+
+    if (!record.delay.empty())
+      link.SetAttribute("Delay", record.delay);
+    if (!record.maxPackets.empty())
+      link.SetAttribute("MaxPackets", record.maxPackets);
 
     // Saran Added lossRate
-    if (!lossRate.empty())
-      link.SetAttribute("LossRate", lossRate);
+    if (!record.lossRate.empty())
+      link.SetAttribute("LossRate", record.lossRate);
 
     AddLink(link);
-    NS_LOG_DEBUG("New link " << from << " <==> " << to << " / " << capacity << " with " << metric
-                             << " metric (" << delay << ", " << maxPackets << ", " << lossRate
-                             << ")");
+    NS_LOG_DEBUG("New link " << record.from << " <==> " << record.to << " / " << record.capacity
+                             << " with " << record.metric << " metric (" << record.delay << ", "
+                             << record.maxPackets << ", " << record.lossRate << ")");
   }
 
   NS_LOG_INFO("Annotated topology created with " << m_nodes.GetN() << " nodes and " << LinksSize()
                                                  << " links");
-  topgen.close();
+
+  ApplySettings();
+
+  return m_nodes;
+}
+
+NodeContainer
+AnnotatedTopologyReader::ReadBinary()
+{
+  BinaryTopologyFile file;
+  if (!file.Open(GetFileName())) {
+    NS_FATAL_ERROR("Cannot read binary topology file " << GetFileName());
+    return m_nodes;
+  }
+
+  vector<uint32_t> systemIds(file.GetNNodes());
+  if (m_nPartitions > 0) {
+    TopologyPartitioner partitioner;
+    for (uint32_t i = 0; i < file.GetNNodes(); ++i) {
+      partitioner.AddNode(m_nodeWeights.empty() ? 1.0 : GetNodeWeight(file.GetNodeName(i)));
+    }
+    for (uint32_t i = 0; i < file.GetNLinks(); ++i) {
+      const BinaryTopologyFile::LinkEntry& link = file.GetLink(i);
+      partitioner.AddLink(link.from, link.to, NanoSeconds(link.delay));
+    }
+    systemIds = Partition(partitioner);
+  }
+  else {
+    for (uint32_t i = 0; i < file.GetNNodes(); ++i) {
+      systemIds[i] = file.GetNode(i).systemId;
+    }
+  }
+
+  // links refer to nodes by index, so no name lookups are needed to connect them
+  vector<Ptr<Node>> nodes;
+  nodes.reserve(file.GetNNodes());
+  for (uint32_t i = 0; i < file.GetNNodes(); ++i) {
+    const BinaryTopologyFile::NodeEntry& node = file.GetNode(i);
+    if (abs(node.latitude) > 0.001 && abs(node.longitude) > 0.001)
+      nodes.push_back(CreateNode(file.GetNodeName(i), m_scale * node.longitude,
+                                 -m_scale * node.latitude, systemIds[i]));
+    else
+      nodes.push_back(CreateNode(file.GetNodeName(i), m_randX->GetValue(), m_randY->GetValue(),
+                                 systemIds[i]));
+  }
+
+  for (uint32_t i = 0; i < file.GetNLinks(); ++i) {
+    const BinaryTopologyFile::LinkEntry& record = file.GetLink(i);
+
+    Link link(nodes[record.from], file.GetNodeName(record.from), nodes[record.to],
+              file.GetNodeName(record.to));
+
+    link.SetAttribute("DataRate", std::to_string(record.dataRate) + "bps");
+    link.SetAttribute("OSPF", std::to_string(record.metric));
+
+    if (record.delay > 0)
+      link.SetAttribute("Delay", std::to_string(record.delay) + "ns");
+    if (record.maxPackets > 0)
+      link.SetAttribute("MaxPackets", std::to_string(record.maxPackets));
+
+    AddLink(link);
+  }
+  file.Close();
+
+  NS_LOG_INFO("Binary topology created with " << m_nodes.GetN() << " nodes and " << LinksSize()
+                                              << " links");
 
   ApplySettings();
 
@@ -503,6 +647,57 @@ AnnotatedTopologyReader::SaveTopology(const std::string& file)
   }
 }
 
+void
+AnnotatedTopologyReader::SaveBinaryTopology(const std::string& file)
+{
+  BinaryTopologyFile::Writer writer;
+
+  map<uint32_t, uint32_t> indices; // node ID => index in the file
+  for (NodeContainer::Iterator node = m_nodes.Begin(); node != m_nodes.End(); node++) {
+    Vector position = (*node)->GetObject<MobilityModel>()->GetPosition();
+    indices[(*node)->GetId()] = writer.AddNode(Names::FindName(*node), -position.y / m_scale,
+                                    position.x / m_scale, (*node)->GetSystemId());
+  }
+
+  for (std::list<Link>::const_iterator link = m_linksList.begin(); link != m_linksList.end();
+       link++) {
+    string value;
+    if (!link->GetAttributeFailSafe("DataRate", value))
+      NS_FATAL_ERROR("DataRate must be specified for the link");
+    uint64_t dataRate = DataRate(value).GetBitRate();
+
+    uint32_t metric = 1;
+    if (link->GetAttributeFailSafe("OSPF", value))
+      metric = boost::lexical_cast<uint32_t>(value);
+
+    uint64_t delay = 0;
+    if (link->GetAttributeFailSafe("Delay", value))
+      delay = Time(value).GetNanoSeconds();
+
+    // only plain queue sizes can be represented
+    uint32_t maxPackets = 0;
+    if (link->GetAttributeFailSafe("MaxPackets", value)) {
+      try {
+        maxPackets = boost::lexical_cast<uint32_t>(value);
+      }
+      catch (...) {
+        NS_LOG_WARN("Queue of link " << link->GetFromNodeName() << " <==> "
+                                     << link->GetToNodeName() << " is not saved");
+      }
+    }
+
+    if (link->GetAttributeFailSafe("LossRate", value))
+      NS_LOG_WARN("Loss rate of link " << link->GetFromNodeName() << " <==> "
+                                       << link->GetToNodeName() << " is not saved");
+
+    writer.AddLink(indices[link->GetFromNode()->GetId()], indices[link->GetToNode()->GetId()],
+                   dataRate, delay, metric, maxPackets);
+  }
+
+  if (!writer.Write(file))
+    NS_FATAL_ERROR("Cannot write topology to " << file);
+}
+
 /// @cond include_hidden
 
 template<class Names>
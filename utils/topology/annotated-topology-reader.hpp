@@ -26,8 +26,13 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/object-factory.h"
 
+#include <map>
+#include <vector>
+
 namespace ns3 {
 
+class TopologyPartitioner;
+
 /**
  * \brief This class reads annotated topology and apply settings to the corresponding nodes and
  *links
@@ -49,13 +54,36 @@ public:
   /**
    * \brief Main annotated topology reading function.
    *
-   * This method opens an input stream and reads topology file with annotations.
+   * This method opens an input stream and reads topology file with annotations.  Files in the
+   * binary topology format (see BinaryTopologyFile) are recognized by their first bytes and
+   * mapped into memory instead of being parsed.
    *
    * \return the container of the nodes created (or empty container if there was an error)
    */
   virtual NodeContainer
   Read();
 
+  /**
+   * \brief Compute system IDs of the nodes instead of taking them from the topology file
+   *
+   * Nodes are assigned to \p nPartitions partitions by TopologyPartitioner, balancing node
+   * weights and keeping links with short delays inside partitions.  Must be called before Read.
+   *
+   * \param nPartitions number of partitions, normally MpiInterface::GetSize (); 0 to use the
+   *        system IDs from the topology file
+   */
+  void
+  SetPartitions(uint32_t nPartitions);
+
+  /**
+   * \brief Set relative amount of work of a node (default 1), used when computing partitions
+   *
+   * For example, nodes running consumer or producer applications, or core routers that forward
+   * most of the traffic, can be given weights proportional to their expected packet rates.
+   */
+  void
+  SetNodeWeight(const std::string& name, double weight);
+
   /**
    * \brief Get nodes read by the reader
    */
@@ -115,6 +143,14 @@ public:
   virtual void
   SaveGraphviz(const std::string& file);
 
+  /**
+   * \brief Save topology in the binary topology format, which Read loads without parsing
+   *
+   * Link loss rates are not saved.
+   */
+  virtual void
+  SaveBinaryTopology(const std::string& file);
+
 protected:
   Ptr<Node>
   CreateNode(const std::string name, uint32_t systemId);
@@ -131,6 +167,20 @@ protected:
   void
   ApplySettings();
 
+private:
+  NodeContainer
+  ReadBinary();
+
+  double
+  GetNodeWeight(const std::string& name) const;
+
+  /**
+   * \brief Run \p partitioner with the requested number of partitions
+   * \return system ID of every node added to \p partitioner
+   */
+  std::vector<uint32_t>
+  Partition(TopologyPartitioner& partitioner) const;
+
 protected:
   std::string m_path;
   NodeContainer m_nodes;
@@ -147,6 +197,9 @@ private:
   double m_scale;
 
   uint32_t m_requiredPartitions;
+
+  uint32_t m_nPartitions;
+  std::map<std::string, double> m_nodeWeights;
 };
 }
 
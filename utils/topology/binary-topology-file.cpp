@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "binary-topology-file.hpp"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("BinaryTopologyFile");
+
+const char BinaryTopologyFile::MAGIC[8] = {'N', 'D', 'N', 'T', 'O', 'P', 'O', '\0'};
+const uint32_t BinaryTopologyFile::VERSION;
+const uint32_t BinaryTopologyFile::BYTE_ORDER_MARK;
+
+uint32_t
+BinaryTopologyFile::Writer::AddNode(const std::string& name, double latitude, double longitude,
+                                    uint32_t systemId)
+{
+  NodeEntry node;
+  node.name = m_strings.size();
+  node.systemId = systemId;
+  node.latitude = latitude;
+  node.longitude = longitude;
+  m_nodes.push_back(node);
+
+  m_strings.append(name.c_str(), name.size() + 1);
+  return m_nodes.size() - 1;
+}
+
+void
+BinaryTopologyFile::Writer::AddLink(uint32_t from, uint32_t to, uint64_t dataRate,
+                                    uint64_t delay, uint32_t metric, uint32_t maxPackets)
+{
+  NS_ASSERT(from < m_nodes.size() && to < m_nodes.size());
+
+  LinkEntry link;
+  link.from = from;
+  link.to = to;
+  link.metric = metric;
+  link.maxPackets = maxPackets;
+  link.dataRate = dataRate;
+  link.delay = delay;
+  m_links.push_back(link);
+}
+
+bool
+BinaryTopologyFile::Writer::Write(const std::string& file) const
+{
+  Header header;
+  std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+  header.byteOrder = BYTE_ORDER_MARK;
+  header.version = VERSION;
+  header.nNodes = m_nodes.size();
+  header.nLinks = m_links.size();
+  header.stringsSize = m_strings.size();
+  header.reserved = 0;
+
+  std::ofstream os(file.c_str(), std::ios::binary | std::ios::trunc);
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(reinterpret_cast<const char*>(m_nodes.data()), m_nodes.size() * sizeof(NodeEntry));
+  os.write(reinterpret_cast<const char*>(m_links.data()), m_links.size() * sizeof(LinkEntry));
+  os.write(m_strings.data(), m_strings.size());
+  os.close();
+
+  return static_cast<bool>(os);
+}
+
+BinaryTopologyFile::BinaryTopologyFile()
+  : m_data(nullptr)
+  , m_size(0)
+  , m_header(nullptr)
+  , m_nodes(nullptr)
+  , m_links(nullptr)
+  , m_strings(nullptr)
+{
+}
+
+BinaryTopologyFile::~BinaryTopologyFile()
+{
+  Close();
+}
+
+bool
+BinaryTopologyFile::IsBinaryTopology(const std::string& file)
+{
+  std::ifstream is(file.c_str(), std::ios::binary);
+  char magic[sizeof(MAGIC)];
+  is.read(magic, sizeof(magic));
+  return is && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool
+BinaryTopologyFile::Open(const std::string& file)
+{
+  Close();
+
+  int fd = ::open(file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    NS_LOG_ERROR("Cannot open " << file);
+    return false;
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+    NS_LOG_ERROR(file << " is too short to be a binary topology file");
+    ::close(fd);
+    return false;
+  }
+
+  m_size = st.st_size;
+  m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // the mapping stays valid
+  if (m_data == MAP_FAILED) {
+    NS_LOG_ERROR("Cannot map " << file << " into memory");
+    m_data = nullptr;
+    m_size = 0;
+    return false;
+  }
+
+  m_header = static_cast<const Header*>(m_data);
+  if (!Validate()) {
+    NS_LOG_ERROR(file << " is not a valid binary topology file");
+    Close();
+    return false;
+  }
+
+  NS_LOG_DEBUG("Mapped " << file << " with " << m_header->nNodes << " nodes and "
+                         << m_header->nLinks << " links");
+  return true;
+}
+
+void
+BinaryTopologyFile::Close()
+{
+  if (m_data != nullptr) {
+    ::munmap(m_data, m_size);
+  }
+
+  m_data = nullptr;
+  m_size = 0;
+  m_header = nullptr;
+  m_nodes = nullptr;
+  m_links = nullptr;
+  m_strings = nullptr;
+}
+
+bool
+BinaryTopologyFile::Validate()
+{
+  if (std::memcmp(m_header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      m_header->byteOrder != BYTE_ORDER_MARK || m_header->version != VERSION) {
+    return false;
+  }
+
+  uint64_t expectedSize = sizeof(Header) + uint64_t(m_header->nNodes) * sizeof(NodeEntry) +
+                          uint64_t(m_header->nLinks) * sizeof(LinkEntry) +
+                          m_header->stringsSize;
+  if (expectedSize != m_size) {
+    return false;
+  }
+
+  const char* begin = static_cast<const char*>(m_data);
+  m_nodes = reinterpret_cast<const NodeEntry*>(begin + sizeof(Header));
+  m_links = reinterpret_cast<const LinkEntry*>(m_nodes + m_header->nNodes);
+  m_strings = reinterpret_cast<const char*>(m_links + m_header->nLinks);
+
+  // every name must end within the string table
+  if (m_header->nNodes > 0 &&
+      (m_header->stringsSize == 0 || m_strings[m_header->stringsSize - 1] != '\0')) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < m_header->nNodes; ++i) {
+    if (m_nodes[i].name >= m_header->stringsSize) {
+      return false;
+    }
+  }
+
+  for (uint32_t i = 0; i < m_header->nLinks; ++i) {
+    if (m_links[i].from >= m_header->nNodes || m_links[i].to >= m_header->nNodes) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_BINARY_TOPOLOGY_FILE_H
+#define NDN_BINARY_TOPOLOGY_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Compact binary topology format, mapped into memory when read
+ *
+ * The file holds the same information as the router and link sections of an annotated
+ * topology file, except for link loss rates:
+ *
+ *     Header
+ *     NodeEntry[nNodes]
+ *     LinkEntry[nLinks]
+ *     char strings[stringsSize]    (NUL-terminated node names)
+ *
+ * All fields are stored in the byte order of the host that wrote the file; the header records
+ * it, and files written on a host with a different byte order are rejected.  Because the
+ * entries are fixed-size and aligned, a mapped file is used in place, without parsing.
+ *
+ * AnnotatedTopologyReader reads the format whenever the file starts with the magic string.
+ * Files are produced by TopologyGenerator::SaveBinary or by
+ * AnnotatedTopologyReader::SaveBinaryTopology, which converts any topology a reader has loaded.
+ */
+class BinaryTopologyFile {
+public:
+  static const char MAGIC[8];
+  static const uint32_t VERSION = 1;
+  static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+  struct Header {
+    char magic[8];
+    uint32_t byteOrder;
+    uint32_t version;
+    uint32_t nNodes;
+    uint32_t nLinks;
+    uint32_t stringsSize;
+    uint32_t reserved;
+  };
+
+  struct NodeEntry {
+    uint32_t name; ///< \brief offset of the name in the string table
+    uint32_t systemId;
+    double latitude;
+    double longitude;
+  };
+
+  struct LinkEntry {
+    uint32_t from; ///< \brief index of the node entry
+    uint32_t to;
+    uint32_t metric;
+    uint32_t maxPackets; ///< \brief transmission queue size, 0 if not set
+    uint64_t dataRate;   ///< \brief bits per second
+    uint64_t delay;      ///< \brief nanoseconds, 0 if not set
+  };
+
+  /**
+   * \brief Builds a binary topology file in memory and writes it out
+   */
+  class Writer {
+  public:
+    /**
+     * \return index of the node, assigned consecutively from 0
+     */
+    uint32_t
+    AddNode(const std::string& name, double latitude, double longitude, uint32_t systemId = 0);
+
+    void
+    AddLink(uint32_t from, uint32_t to, uint64_t dataRate, uint64_t delay, uint32_t metric = 1,
+            uint32_t maxPackets = 0);
+
+    /**
+     * \return false if the file cannot be written
+     */
+    bool
+    Write(const std::string& file) const;
+
+  private:
+    std::vector<NodeEntry> m_nodes;
+    std::vector<LinkEntry> m_links;
+    std::string m_strings;
+  };
+
+public:
+  BinaryTopologyFile();
+
+  ~BinaryTopologyFile();
+
+  /**
+   * \brief Check whether \p file starts with the magic string of the binary format
+   */
+  static bool
+  IsBinaryTopology(const std::string& file);
+
+  /**
+   * \brief Map \p file into memory and validate it
+   * \return false if the file cannot be mapped or is not a valid binary topology file
+   */
+  bool
+  Open(const std::string& file);
+
+  void
+  Close();
+
+  uint32_t
+  GetNNodes() const
+  {
+    return m_header->nNodes;
+  }
+
+  uint32_t
+  GetNLinks() const
+  {
+    return m_header->nLinks;
+  }
+
+  const NodeEntry&
+  GetNode(uint32_t i) const
+  {
+    return m_nodes[i];
+  }
+
+  const char*
+  GetNodeName(uint32_t i) const
+  {
+    return m_strings + m_nodes[i].name;
+  }
+
+  const LinkEntry&
+  GetLink(uint32_t i) const
+  {
+    return m_links[i];
+  }
+
+private:
+  BinaryTopologyFile(const BinaryTopologyFile&);
+  BinaryTopologyFile&
+  operator=(const BinaryTopologyFile&);
+
+  /**
+   * \brief Check the mapped header and set up pointers to the entries and the string table
+   */
+  bool
+  Validate();
+
+private:
+  void* m_data;
+  size_t m_size;
+
+  const Header* m_header;
+  const NodeEntry* m_nodes;
+  const LinkEntry* m_links;
+  const char* m_strings;
+};
+
+} // namespace ns3
+
+#endif // NDN_BINARY_TOPOLOGY_FILE_H
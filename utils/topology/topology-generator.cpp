@@ -0,0 +1,300 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "topology-generator.hpp"
+#include "binary-topology-file.hpp"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("TopologyGenerator");
+
+TopologyGenerator::TopologyGenerator()
+  : m_random(CreateObject<UniformRandomVariable>())
+  , m_minDataRate(10000000)
+  , m_maxDataRate(10000000)
+  , m_minDelay(MilliSeconds(10))
+  , m_maxDelay(MilliSeconds(10))
+  , m_metric(1)
+  , m_maxPackets(0)
+{
+}
+
+void
+TopologyGenerator::SetDataRate(const DataRate& min, const DataRate& max)
+{
+  NS_ASSERT(min.GetBitRate() <= max.GetBitRate());
+  m_minDataRate = min.GetBitRate();
+  m_maxDataRate = max.GetBitRate();
+}
+
+void
+TopologyGenerator::SetDelay(const Time& min, const Time& max)
+{
+  NS_ASSERT(min <= max);
+  m_minDelay = min;
+  m_maxDelay = max;
+}
+
+void
+TopologyGenerator::SetMetric(uint32_t metric)
+{
+  m_metric = metric;
+}
+
+void
+TopologyGenerator::SetMaxPackets(uint32_t maxPackets)
+{
+  m_maxPackets = maxPackets;
+}
+
+int64_t
+TopologyGenerator::AssignStreams(int64_t stream)
+{
+  m_random->SetStream(stream);
+  return 1;
+}
+
+void
+TopologyGenerator::Clear(uint32_t nNodes)
+{
+  m_nodes.clear();
+  m_links.clear();
+  m_nodes.reserve(nNodes);
+}
+
+uint32_t
+TopologyGenerator::AddNode(const std::string& name, double latitude, double longitude)
+{
+  m_nodes.push_back(Node{name, latitude, longitude});
+  return m_nodes.size() - 1;
+}
+
+void
+TopologyGenerator::AddLink(uint32_t from, uint32_t to)
+{
+  Link link;
+  link.from = from;
+  link.to = to;
+
+  if (m_minDataRate < m_maxDataRate)
+    link.dataRate = static_cast<uint64_t>(m_random->GetValue(m_minDataRate, m_maxDataRate));
+  else
+    link.dataRate = m_minDataRate;
+
+  if (m_minDelay < m_maxDelay)
+    link.delay = NanoSeconds(static_cast<uint64_t>(
+      m_random->GetValue(m_minDelay.GetNanoSeconds(), m_maxDelay.GetNanoSeconds())));
+  else
+    link.delay = m_minDelay;
+
+  m_links.push_back(link);
+}
+
+void
+TopologyGenerator::GenerateScaleFree(uint32_t nNodes, uint32_t nLinksPerNode)
+{
+  NS_ASSERT(nLinksPerNode > 0);
+  Clear(nNodes);
+
+  // every link adds both ends here, so a uniform pick is proportional to degree
+  std::vector<uint32_t> ends;
+  ends.reserve(2 * uint64_t(nNodes) * nLinksPerNode);
+
+  uint32_t nInitial = std::min(nNodes, nLinksPerNode + 1);
+  for (uint32_t i = 0; i < nInitial; ++i) {
+    AddNode("n" + std::to_string(i));
+    for (uint32_t j = 0; j < i; ++j) {
+      AddLink(j, i);
+      ends.push_back(j);
+      ends.push_back(i);
+    }
+  }
+
+  std::vector<uint32_t> targets;
+  for (uint32_t i = nInitial; i < nNodes; ++i) {
+    AddNode("n" + std::to_string(i));
+
+    targets.clear();
+    while (targets.size() < nLinksPerNode) {
+      uint32_t target = ends[m_random->GetInteger(0, ends.size() - 1)];
+      if (std::find(targets.begin(), targets.end(), target) == targets.end()) {
+        targets.push_back(target);
+      }
+    }
+
+    for (uint32_t target : targets) {
+      AddLink(target, i);
+      ends.push_back(target);
+      ends.push_back(i);
+    }
+  }
+
+  NS_LOG_INFO("Scale-free topology with " << m_nodes.size() << " nodes and " << m_links.size()
+                                          << " links");
+}
+
+void
+TopologyGenerator::GenerateGrid(uint32_t nRows, uint32_t nColumns)
+{
+  Clear(nRows * nColumns);
+
+  // positions are offset by one, as the reader places nodes at zero coordinates randomly
+  for (uint32_t row = 0; row < nRows; ++row) {
+    for (uint32_t col = 0; col < nColumns; ++col) {
+      AddNode(std::to_string(row) + "-" + std::to_string(col), -1.0 - row, 1.0 + col);
+    }
+  }
+
+  for (uint32_t row = 0; row < nRows; ++row) {
+    for (uint32_t col = 0; col < nColumns; ++col) {
+      uint32_t node = row * nColumns + col;
+      if (col + 1 < nColumns)
+        AddLink(node, node + 1);
+      if (row + 1 < nRows)
+        AddLink(node, node + nColumns);
+    }
+  }
+
+  NS_LOG_INFO("Grid topology with " << m_nodes.size() << " nodes and " << m_links.size()
+                                    << " links");
+}
+
+void
+TopologyGenerator::GenerateTree(uint32_t nNodes, uint32_t fanout)
+{
+  NS_ASSERT(fanout > 0);
+  Clear(nNodes);
+
+  uint32_t level = 0;
+  uint64_t levelBegin = 0;
+  uint64_t levelSize = 1;
+  for (uint32_t i = 0; i < nNodes; ++i) {
+    if (i >= levelBegin + levelSize) {
+      ++level;
+      levelBegin += levelSize;
+      levelSize *= fanout;
+    }
+    AddNode("n" + std::to_string(i), -1.0 - level, 1.0 + (i - levelBegin));
+    if (i > 0)
+      AddLink((i - 1) / fanout, i);
+  }
+
+  NS_LOG_INFO("Tree topology with " << m_nodes.size() << " nodes and " << m_links.size()
+                                    << " links");
+}
+
+void
+TopologyGenerator::GenerateFatTree(uint32_t k, bool withHosts)
+{
+  NS_ASSERT_MSG(k > 0 && k % 2 == 0, "Fat-tree requires an even number of ports");
+  uint32_t half = k / 2;
+  Clear(half * half + k * k + (withHosts ? k * half * half : 0));
+
+  std::vector<uint32_t> core;
+  for (uint32_t i = 0; i < half * half; ++i) {
+    core.push_back(AddNode("core-" + std::to_string(i), -1.0, 1.0 + i));
+  }
+
+  for (uint32_t pod = 0; pod < k; ++pod) {
+    std::string podName = std::to_string(pod);
+
+    std::vector<uint32_t> aggregation;
+    for (uint32_t i = 0; i < half; ++i) {
+      aggregation.push_back(
+        AddNode("agg-" + podName + "-" + std::to_string(i), -2.0, 1.0 + pod * half + i));
+
+      // i-th aggregation switch of every pod connects to the i-th group of core switches
+      for (uint32_t j = 0; j < half; ++j) {
+        AddLink(core[i * half + j], aggregation.back());
+      }
+    }
+
+    for (uint32_t i = 0; i < half; ++i) {
+      std::string edgeName = podName + "-" + std::to_string(i);
+      uint32_t edge = AddNode("edge-" + edgeName, -3.0, 1.0 + pod * half + i);
+      for (uint32_t agg : aggregation) {
+        AddLink(agg, edge);
+      }
+
+      if (withHosts) {
+        for (uint32_t j = 0; j < half; ++j) {
+          uint32_t host = AddNode("host-" + edgeName + "-" + std::to_string(j), -4.0,
+                                  1.0 + (pod * half + i) * half + j);
+          AddLink(edge, host);
+        }
+      }
+    }
+  }
+
+  NS_LOG_INFO("Fat-tree topology with " << m_nodes.size() << " nodes and " << m_links.size()
+                                        << " links");
+}
+
+void
+TopologyGenerator::Save(const std::string& file) const
+{
+  std::ofstream os(file.c_str(), std::ios::trunc);
+  os << "# generated by ns3::TopologyGenerator\n"
+     << "\n"
+     << "router\n"
+     << "\n"
+     << "# node  comment     yPos    xPos\n";
+  for (const Node& node : m_nodes) {
+    os << node.name << "\tNA\t" << node.latitude << "\t" << node.longitude << "\n";
+  }
+
+  os << "\n"
+     << "link\n"
+     << "\n"
+     << "# srcNode   dstNode     bandwidth   metric  delay   queue\n";
+  for (const Link& link : m_links) {
+    os << m_nodes[link.from].name << "\t" << m_nodes[link.to].name << "\t" << link.dataRate
+       << "bps\t" << m_metric << "\t" << link.delay.GetNanoSeconds() << "ns";
+    if (m_maxPackets > 0)
+      os << "\t" << m_maxPackets;
+    os << "\n";
+  }
+
+  if (!os)
+    NS_FATAL_ERROR("Cannot write topology to " << file);
+}
+
+void
+TopologyGenerator::SaveBinary(const std::string& file) const
+{
+  BinaryTopologyFile::Writer writer;
+  for (const Node& node : m_nodes) {
+    writer.AddNode(node.name, node.latitude, node.longitude);
+  }
+  for (const Link& link : m_links) {
+    writer.AddLink(link.from, link.to, link.dataRate, link.delay.GetNanoSeconds(), m_metric,
+                   m_maxPackets);
+  }
+
+  if (!writer.Write(file))
+    NS_FATAL_ERROR("Cannot write topology to " << file);
+}
+
+} // namespace ns3
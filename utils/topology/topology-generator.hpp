@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TOPOLOGY_GENERATOR_H
+#define NDN_TOPOLOGY_GENERATOR_H
+
+#include "ns3/nstime.h"
+#include "ns3/data-rate.h"
+#include "ns3/random-variable-stream.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Generator of large synthetic topologies with annotated link capacities and delays
+ *
+ * Supported topologies are scale-free (Barabasi-Albert preferential attachment), grid, k-ary
+ * tree, and k-ary fat-tree.  Capacities and delays of links are drawn uniformly from
+ * configurable ranges.  The result can be saved in the annotated topology format or in the
+ * binary format (see BinaryTopologyFile), which AnnotatedTopologyReader loads without parsing.
+ *
+ * Example:
+ *
+ *     TopologyGenerator generator;
+ *     generator.SetDataRate(DataRate("1Gbps"), DataRate("10Gbps"));
+ *     generator.SetDelay(MilliSeconds(1), MilliSeconds(10));
+ *     generator.GenerateScaleFree(100000, 2);
+ *     generator.SaveBinary("topo-100k.bin");
+ *
+ *     AnnotatedTopologyReader reader;
+ *     reader.SetFileName("topo-100k.bin");
+ *     reader.Read();
+ *
+ * Each Generate* call replaces the previously generated topology.
+ */
+class TopologyGenerator {
+public:
+  struct Node {
+    std::string name;
+    double latitude;
+    double longitude;
+  };
+
+  struct Link {
+    uint32_t from;
+    uint32_t to;
+    uint64_t dataRate; ///< \brief bits per second
+    Time delay;
+  };
+
+  TopologyGenerator();
+
+  /**
+   * \brief Set range of link capacities (default 10Mbps)
+   */
+  void
+  SetDataRate(const DataRate& min, const DataRate& max);
+
+  /**
+   * \brief Set range of link delays (default 10ms)
+   */
+  void
+  SetDelay(const Time& min, const Time& max);
+
+  /**
+   * \brief Set OSPF metric of all links (default 1)
+   */
+  void
+  SetMetric(uint32_t metric);
+
+  /**
+   * \brief Set transmission queue size of all links (default: do not set)
+   */
+  void
+  SetMaxPackets(uint32_t maxPackets);
+
+  /**
+   * \brief Assign a fixed random variable stream number to the random variables used by
+   *        the generator
+   * \return the number of stream indices assigned
+   */
+  int64_t
+  AssignStreams(int64_t stream);
+
+  /**
+   * \brief Generate a scale-free topology by preferential attachment
+   *
+   * The topology starts with a clique of \p nLinksPerNode + 1 nodes; each further node is
+   * linked to \p nLinksPerNode distinct existing nodes, chosen with probability proportional
+   * to their degrees.
+   */
+  void
+  GenerateScaleFree(uint32_t nNodes, uint32_t nLinksPerNode);
+
+  /**
+   * \brief Generate a \p nRows by \p nColumns grid; node at row r, column c is named "r-c"
+   */
+  void
+  GenerateGrid(uint32_t nRows, uint32_t nColumns);
+
+  /**
+   * \brief Generate a complete tree with \p nNodes nodes, each having up to \p fanout children
+   *
+   * Nodes are numbered breadth-first starting from the root.
+   */
+  void
+  GenerateTree(uint32_t nNodes, uint32_t fanout);
+
+  /**
+   * \brief Generate a k-ary fat-tree
+   *
+   * The topology has (k/2)^2 core switches and k pods, each with k/2 aggregation and k/2 edge
+   * switches.  Every edge switch is linked to all aggregation switches of its pod and, if
+   * \p withHosts, to k/2 hosts, for k^3/4 hosts in total.
+   *
+   * \param k number of ports of a switch, must be even
+   */
+  void
+  GenerateFatTree(uint32_t k, bool withHosts = true);
+
+  const std::vector<Node>&
+  GetNodes() const
+  {
+    return m_nodes;
+  }
+
+  const std::vector<Link>&
+  GetLinks() const
+  {
+    return m_links;
+  }
+
+  /**
+   * \brief Save topology in the annotated topology format
+   */
+  void
+  Save(const std::string& file) const;
+
+  /**
+   * \brief Save topology in the binary topology format
+   */
+  void
+  SaveBinary(const std::string& file) const;
+
+private:
+  void
+  Clear(uint32_t nNodes);
+
+  uint32_t
+  AddNode(const std::string& name, double latitude = 0, double longitude = 0);
+
+  void
+  AddLink(uint32_t from, uint32_t to);
+
+private:
+  std::vector<Node> m_nodes;
+  std::vector<Link> m_links;
+
+  Ptr<UniformRandomVariable> m_random;
+  uint64_t m_minDataRate;
+  uint64_t m_maxDataRate;
+  Time m_minDelay;
+  Time m_maxDelay;
+  uint32_t m_metric;
+  uint32_t m_maxPackets;
+};
+
+} // namespace ns3
+
+#endif // NDN_TOPOLOGY_GENERATOR_H
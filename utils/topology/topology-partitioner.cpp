@@ -0,0 +1,334 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "topology-partitioner.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <tuple>
+
+NS_LOG_COMPONENT_DEFINE("TopologyPartitioner");
+
+namespace ns3 {
+
+static const uint32_t UNASSIGNED = std::numeric_limits<uint32_t>::max();
+
+/// \brief maximum number of refinement passes over all nodes
+static const int MAX_REFINE_PASSES = 8;
+
+TopologyPartitioner::TopologyPartitioner()
+  : m_nCutLinks(0)
+  , m_lookahead(Time::Max())
+{
+}
+
+uint32_t
+TopologyPartitioner::AddNode(double weight)
+{
+  m_weights.push_back(weight);
+  m_links.emplace_back();
+  return m_weights.size() - 1;
+}
+
+void
+TopologyPartitioner::SetNodeWeight(uint32_t node, double weight)
+{
+  NS_ASSERT(node < m_weights.size());
+  m_weights[node] = weight;
+}
+
+void
+TopologyPartitioner::AddLink(uint32_t from, uint32_t to, Time delay)
+{
+  NS_ASSERT(from < m_weights.size() && to < m_weights.size());
+  if (from == to) {
+    return;
+  }
+
+  m_links[from].push_back({to, delay, 0});
+  m_links[to].push_back({from, delay, 0});
+}
+
+void
+TopologyPartitioner::ComputeLinkCosts()
+{
+  // cost of a cut link is inversely proportional to its delay, normalized to 1 for the
+  // shortest positive delay; links without delay are the most expensive to cut
+  Time minDelay = Time::Max();
+  for (const auto& links : m_links) {
+    for (const Link& link : links) {
+      if (link.delay.IsStrictlyPositive()) {
+        minDelay = std::min(minDelay, link.delay);
+      }
+    }
+  }
+
+  for (auto& links : m_links) {
+    for (Link& link : links) {
+      if (link.delay.IsStrictlyPositive() && minDelay != Time::Max()) {
+        link.cost = minDelay.GetSeconds() / link.delay.GetSeconds();
+      }
+      else {
+        link.cost = 1.0;
+      }
+    }
+  }
+}
+
+uint32_t
+TopologyPartitioner::FindPeripheralNode(uint32_t start, const std::vector<uint32_t>& parts) const
+{
+  // the last node reached by BFS over unassigned nodes is one of the farthest from start
+  std::vector<bool> isVisited(m_weights.size(), false);
+  std::queue<uint32_t> queue;
+  queue.push(start);
+  isVisited[start] = true;
+
+  uint32_t last = start;
+  while (!queue.empty()) {
+    last = queue.front();
+    queue.pop();
+    for (const Link& link : m_links[last]) {
+      if (!isVisited[link.to] && parts[link.to] == UNASSIGNED) {
+        isVisited[link.to] = true;
+        queue.push(link.to);
+      }
+    }
+  }
+  return last;
+}
+
+void
+TopologyPartitioner::GrowPartitions(uint32_t nPartitions, std::vector<uint32_t>& parts) const
+{
+  uint32_t nNodes = m_weights.size();
+  uint32_t nUnassigned = nNodes;
+  uint32_t nextUnassigned = 0;
+
+  double remainingWeight = 0;
+  // sum of costs of links to unassigned nodes
+  std::vector<double> external(nNodes, 0);
+  for (uint32_t node = 0; node < nNodes; ++node) {
+    remainingWeight += m_weights[node];
+    for (const Link& link : m_links[node]) {
+      external[node] += link.cost;
+    }
+  }
+
+  // sum of costs of links to the partition being grown
+  std::vector<double> internal(nNodes, 0);
+  std::vector<uint32_t> version(nNodes, 0);
+
+  for (uint32_t part = 0; part + 1 < nPartitions; ++part) {
+    double target = remainingWeight / (nPartitions - part);
+    double partWeight = 0;
+
+    // (gain, version, node); stale entries are skipped by version
+    typedef std::tuple<double, uint32_t, uint32_t> Candidate;
+    std::priority_queue<Candidate> frontier;
+    std::vector<uint32_t> touched;
+
+    // leave at least one node for each of the remaining partitions
+    while (nUnassigned > nPartitions - part - 1) {
+      uint32_t node = UNASSIGNED;
+      while (!frontier.empty()) {
+        uint32_t candidate, candidateVersion;
+        std::tie(std::ignore, candidateVersion, candidate) = frontier.top();
+        frontier.pop();
+        if (parts[candidate] == UNASSIGNED && candidateVersion == version[candidate]) {
+          node = candidate;
+          break;
+        }
+      }
+
+      if (node == UNASSIGNED) {
+        // first node of the partition, or the component is exhausted
+        while (parts[nextUnassigned] != UNASSIGNED) {
+          ++nextUnassigned;
+        }
+        node = FindPeripheralNode(FindPeripheralNode(nextUnassigned, parts), parts);
+      }
+
+      double weight = m_weights[node];
+      if (partWeight > 0 && partWeight + weight - target > target - partWeight) {
+        break; // adding the node overshoots the target more than stopping short of it
+      }
+
+      parts[node] = part;
+      partWeight += weight;
+      --nUnassigned;
+
+      for (const Link& link : m_links[node]) {
+        uint32_t neighbor = link.to;
+        if (parts[neighbor] != UNASSIGNED) {
+          continue;
+        }
+        external[neighbor] -= link.cost;
+        internal[neighbor] += link.cost;
+        touched.push_back(neighbor);
+        frontier.emplace(internal[neighbor] - external[neighbor], ++version[neighbor], neighbor);
+      }
+    }
+
+    for (uint32_t node : touched) {
+      internal[node] = 0;
+    }
+    remainingWeight -= partWeight;
+  }
+
+  for (uint32_t& part : parts) {
+    if (part == UNASSIGNED) {
+      part = nPartitions - 1;
+    }
+  }
+}
+
+void
+TopologyPartitioner::Refine(uint32_t nPartitions, double maxWeight,
+                            std::vector<uint32_t>& parts) const
+{
+  uint32_t nNodes = m_weights.size();
+  std::vector<double> partWeights(nPartitions, 0);
+  std::vector<uint32_t> partSizes(nPartitions, 0);
+  for (uint32_t node = 0; node < nNodes; ++node) {
+    partWeights[parts[node]] += m_weights[node];
+    ++partSizes[parts[node]];
+  }
+
+  // sum of costs of links from the current node to each partition
+  std::vector<double> connectivity(nPartitions, 0);
+  std::vector<uint32_t> neighborParts;
+
+  for (int pass = 0; pass < MAX_REFINE_PASSES; ++pass) {
+    bool hasMoved = false;
+
+    for (uint32_t node = 0; node < nNodes; ++node) {
+      uint32_t from = parts[node];
+      double weight = m_weights[node];
+      if (partSizes[from] == 1) {
+        continue; // do not empty a partition
+      }
+
+      neighborParts.clear();
+      for (const Link& link : m_links[node]) {
+        uint32_t part = parts[link.to];
+        if (connectivity[part] == 0) {
+          neighborParts.push_back(part);
+        }
+        connectivity[part] += link.cost;
+      }
+
+      bool isOverweight = partWeights[from] > maxWeight;
+      uint32_t best = from;
+      double bestGain = -std::numeric_limits<double>::infinity();
+      for (uint32_t to : neighborParts) {
+        if (to == from || partWeights[to] + weight > maxWeight) {
+          continue;
+        }
+
+        double gain = connectivity[to] - connectivity[from];
+        bool improvesBalance = partWeights[from] > partWeights[to] + weight;
+        bool isAcceptable = gain > 0 || (gain == 0 && improvesBalance) || isOverweight;
+        if (isAcceptable && gain > bestGain) {
+          best = to;
+          bestGain = gain;
+        }
+      }
+
+      for (uint32_t part : neighborParts) {
+        connectivity[part] = 0;
+      }
+
+      if (best != from) {
+        parts[node] = best;
+        partWeights[from] -= weight;
+        partWeights[best] += weight;
+        --partSizes[from];
+        ++partSizes[best];
+        hasMoved = true;
+      }
+    }
+
+    if (!hasMoved) {
+      break;
+    }
+  }
+}
+
+void
+TopologyPartitioner::ComputeStatistics(const std::vector<uint32_t>& parts)
+{
+  m_nCutLinks = 0;
+  m_lookahead = Time::Max();
+
+  for (uint32_t node = 0; node < m_links.size(); ++node) {
+    for (const Link& link : m_links[node]) {
+      if (node < link.to && parts[node] != parts[link.to]) {
+        ++m_nCutLinks;
+        m_lookahead = std::min(m_lookahead, link.delay);
+      }
+    }
+  }
+}
+
+std::vector<uint32_t>
+TopologyPartitioner::Partition(uint32_t nPartitions, double imbalance)
+{
+  uint32_t nNodes = m_weights.size();
+  std::vector<uint32_t> parts(nNodes, 0);
+
+  if (nPartitions <= 1 || nNodes == 0) {
+    ComputeStatistics(parts);
+    return parts;
+  }
+
+  if (nNodes <= nPartitions) {
+    for (uint32_t node = 0; node < nNodes; ++node) {
+      parts[node] = node;
+    }
+    ComputeStatistics(parts);
+    return parts;
+  }
+
+  ComputeLinkCosts();
+
+  std::fill(parts.begin(), parts.end(), UNASSIGNED);
+  GrowPartitions(nPartitions, parts);
+
+  double totalWeight = 0;
+  double maxNodeWeight = 0;
+  for (double weight : m_weights) {
+    totalWeight += weight;
+    maxNodeWeight = std::max(maxNodeWeight, weight);
+  }
+  double average = totalWeight / nPartitions;
+  double maxWeight = std::max(average * (1 + imbalance), average + maxNodeWeight);
+  Refine(nPartitions, maxWeight, parts);
+
+  ComputeStatistics(parts);
+  NS_LOG_INFO("Partitioned " << nNodes << " nodes into " << nPartitions << " partitions with "
+                             << m_nCutLinks << " cut links, lookahead " << m_lookahead);
+  return parts;
+}
+
+} // namespace ns3
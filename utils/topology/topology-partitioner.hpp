@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TOPOLOGY_PARTITIONER_H
+#define NDN_TOPOLOGY_PARTITIONER_H
+
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Assigns nodes of a topology to MPI logical processes (system IDs)
+ *
+ * The partitioner balances node weights (e.g., the expected number of packets a node
+ * processes) across partitions and minimizes the cost of links between partitions.  A cut link
+ * costs more the shorter its delay is, because the lookahead of the distributed simulator,
+ * and thus how far logical processes can advance without synchronizing, is bounded by the
+ * smallest delay of the cut links.
+ *
+ * Partitions are first grown greedily from pseudo-peripheral seed nodes and then refined by
+ * moving boundary nodes while the cut cost decreases.  The result depends only on the input,
+ * so every MPI rank computes the same partitioning independently.
+ */
+class TopologyPartitioner {
+public:
+  TopologyPartitioner();
+
+  /**
+   * \brief Add a node
+   * \param weight relative amount of work of the node
+   * \return index of the node, assigned consecutively from 0
+   */
+  uint32_t
+  AddNode(double weight = 1.0);
+
+  /**
+   * \brief Change weight of a previously added node
+   */
+  void
+  SetNodeWeight(uint32_t node, double weight);
+
+  /**
+   * \brief Add a bidirectional link
+   * \param delay propagation delay of the link
+   */
+  void
+  AddLink(uint32_t from, uint32_t to, Time delay);
+
+  uint32_t
+  GetNNodes() const
+  {
+    return m_weights.size();
+  }
+
+  /**
+   * \brief Split the topology into \p nPartitions parts
+   * \param nPartitions number of partitions, e.g., MpiInterface::GetSize ()
+   * \param imbalance allowed excess of a partition weight over the average, as a fraction
+   * \return partition (system ID) of every node, indexed by node index
+   *
+   * Each partition gets at least one node, unless there are fewer nodes than partitions.
+   */
+  std::vector<uint32_t>
+  Partition(uint32_t nPartitions, double imbalance = 0.05);
+
+  /**
+   * \brief Number of links between different partitions in the last Partition result
+   */
+  uint32_t
+  GetNCutLinks() const
+  {
+    return m_nCutLinks;
+  }
+
+  /**
+   * \brief Smallest delay of the links between different partitions in the last Partition
+   *        result, or Time::Max () if there are no such links
+   */
+  Time
+  GetLookahead() const
+  {
+    return m_lookahead;
+  }
+
+private:
+  struct Link {
+    uint32_t to;
+    Time delay;
+    double cost;
+  };
+
+  void
+  ComputeLinkCosts();
+
+  uint32_t
+  FindPeripheralNode(uint32_t start, const std::vector<uint32_t>& parts) const;
+
+  void
+  GrowPartitions(uint32_t nPartitions, std::vector<uint32_t>& parts) const;
+
+  void
+  Refine(uint32_t nPartitions, double maxWeight, std::vector<uint32_t>& parts) const;
+
+  void
+  ComputeStatistics(const std::vector<uint32_t>& parts);
+
+private:
+  std::vector<double> m_weights;
+  std::vector<std::vector<Link>> m_links;
+
+  uint32_t m_nCutLinks;
+  Time m_lookahead;
+};
+
+} // namespace ns3
+
+#endif // NDN_TOPOLOGY_PARTITIONER_H
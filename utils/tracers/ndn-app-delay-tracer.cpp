@@ -32,6 +32,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
+#include <algorithm>
 #include <fstream>
 
 NS_LOG_COMPONENT_DEFINE("ndn.AppDelayTracer");
@@ -49,7 +50,7 @@ AppDelayTracer::Destroy()
 }
 
 void
-AppDelayTracer::InstallAll(const std::string& file)
+AppDelayTracer::InstallAll(const std::string& file, Time averagingPeriod)
 {
   using namespace boost;
   using namespace std;
@@ -72,7 +73,7 @@ AppDelayTracer::InstallAll(const std::string& file)
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    Ptr<AppDelayTracer> trace = Install(*node, outputStream, averagingPeriod);
     tracers.push_back(trace);
   }
 
@@ -86,7 +87,7 @@ AppDelayTracer::InstallAll(const std::string& file)
 }
 
 void
-AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
+AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod)
 {
   using namespace boost;
   using namespace std;
@@ -109,7 +110,7 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    Ptr<AppDelayTracer> trace = Install(*node, outputStream, averagingPeriod);
     tracers.push_back(trace);
   }
 
@@ -123,7 +124,7 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
 }
 
 void
-AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
+AppDelayTracer::Install(Ptr<Node> node, const std::string& file, Time averagingPeriod)
 {
   using namespace boost;
   using namespace std;
@@ -145,7 +146,7 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
-  Ptr<AppDelayTracer> trace = Install(node, outputStream);
+  Ptr<AppDelayTracer> trace = Install(node, outputStream, averagingPeriod);
   tracers.push_back(trace);
 
   if (tracers.size() > 0) {
@@ -158,11 +159,15 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
 }
 
 Ptr<AppDelayTracer>
-AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                        Time averagingPeriod)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
   Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(outputStream, node);
+  if (!averagingPeriod.IsZero()) {
+    trace->SetAveragingPeriod(averagingPeriod);
+  }
 
   return trace;
 }
@@ -192,7 +197,10 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& n
   Connect();
 }
 
-AppDelayTracer::~AppDelayTracer(){};
+AppDelayTracer::~AppDelayTracer()
+{
+  m_printEvent.Cancel();
+}
 
 void
 AppDelayTracer::Connect()
@@ -206,9 +214,70 @@ AppDelayTracer::Connect()
                                 MakeCallback(&AppDelayTracer::FirstInterestDataDelay, this));
 }
 
+void
+AppDelayTracer::SetAveragingPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayTracer::PeriodicPrinter()
+{
+  Print(*m_os);
+  Reset();
+
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayTracer::Reset()
+{
+  for (auto& app : m_stats) {
+    for (auto& stats : app.second) {
+      stats.Reset();
+    }
+  }
+}
+
 void
 AppDelayTracer::PrintHeader(std::ostream& os) const
 {
+  if (!m_period.IsZero()) {
+    os << "Time"
+       << "\t"
+       << "Node"
+       << "\t"
+       << "AppId"
+       << "\t"
+       << "Type"
+       << "\t"
+       << "Samples"
+       << "\t"
+       << "MeanDelayUS"
+       << "\t"
+       << "P50DelayUS"
+       << "\t"
+       << "P90DelayUS"
+       << "\t"
+       << "P99DelayUS"
+       << "\t"
+       << "MaxDelayUS"
+       << "\t"
+       << "MeanRetxCount"
+       << "\t"
+       << "MeanHopCount"
+       << "\t"
+       << "P50HopCount"
+       << "\t"
+       << "P90HopCount"
+       << "\t"
+       << "MaxHopCount"
+       << "";
+    return;
+  }
+
   os << "Time"
      << "\t"
      << "Node"
@@ -230,10 +299,80 @@ AppDelayTracer::PrintHeader(std::ostream& os) const
      << "";
 }
 
+/** @brief Prints aggregated statistics of one delay type
+ *
+ *  LastRetransmittedInterestDataDelay does not report retransmission counts, so MeanRetxCount
+ *  is printed as NA for LastDelay.
+ */
+static void
+PrintStats(std::ostream& os, Time time, const std::string& node, const std::string& appId,
+           app_delay::DelayType type, const app_delay::Stats& stats)
+{
+  static const char* const TYPE_NAMES[app_delay::N_DELAY_TYPES] = {"LastDelay", "FullDelay"};
+
+  if (stats.m_delays.GetCount() == 0) {
+    return;
+  }
+
+  const HdrHistogram& delays = stats.m_delays;
+  const HdrHistogram& hopCounts = stats.m_hopCounts;
+  os << time.ToDouble(Time::S) << "\t" << node << "\t" << appId << "\t" << TYPE_NAMES[type] << "\t"
+     << delays.GetCount() << "\t" << delays.GetMean() << "\t" << delays.GetQuantile(0.5) << "\t"
+     << delays.GetQuantile(0.9) << "\t" << delays.GetQuantile(0.99) << "\t" << delays.GetMax()
+     << "\t";
+  if (type == app_delay::FULL_DELAY) {
+    os << static_cast<double>(stats.m_retxCount) / delays.GetCount();
+  }
+  else {
+    os << "NA";
+  }
+  os << "\t" << hopCounts.GetMean() << "\t" << hopCounts.GetQuantile(0.5) << "\t"
+     << hopCounts.GetQuantile(0.9) << "\t" << hopCounts.GetMax() << "\n";
+}
+
+void
+AppDelayTracer::Print(std::ostream& os) const
+{
+  if (m_period.IsZero()) {
+    return;
+  }
+
+  Time time = Simulator::Now();
+  std::array<app_delay::Stats, app_delay::N_DELAY_TYPES> total;
+  for (const auto& app : m_stats) {
+    std::string appId = boost::lexical_cast<std::string>(app.first);
+    for (int type = 0; type < app_delay::N_DELAY_TYPES; ++type) {
+      PrintStats(os, time, m_node, appId, static_cast<app_delay::DelayType>(type), app.second[type]);
+      total[type].Merge(app.second[type]);
+    }
+  }
+
+  for (int type = 0; type < app_delay::N_DELAY_TYPES; ++type) {
+    PrintStats(os, time, m_node, "*", static_cast<app_delay::DelayType>(type), total[type]);
+  }
+}
+
+void
+AppDelayTracer::Aggregate(Ptr<App> app, app_delay::DelayType type, Time delay,
+                          uint32_t retxCount, int32_t hopCount)
+{
+  app_delay::Stats& stats = m_stats[app->GetId()][type];
+  stats.m_delays.Add(std::max<int64_t>(delay.GetMicroSeconds(), 0));
+  if (hopCount >= 0) {
+    stats.m_hopCounts.Add(hopCount);
+  }
+  stats.m_retxCount += retxCount;
+}
+
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
+  if (!m_period.IsZero()) {
+    Aggregate(app, app_delay::LAST_DELAY, delay, 0, hopCount);
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "LastDelay"
@@ -245,6 +384,11 @@ void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
+  if (!m_period.IsZero()) {
+    Aggregate(app, app_delay::FULL_DELAY, delay, retxCount, hopCount);
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "FullDelay"
@@ -21,6 +21,7 @@
 #define CCNX_APP_DELAY_TRACER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-hdr-histogram.hpp"
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -28,7 +29,9 @@
 #include <ns3/event-id.h>
 #include <ns3/node-container.h>
 
+#include <array>
 #include <tuple>
+#include <map>
 #include <list>
 
 namespace ns3 {
@@ -40,9 +43,49 @@ namespace ndn {
 
 class App;
 
+namespace app_delay {
+
+/// @cond include_hidden
+struct Stats {
+  void
+  Reset()
+  {
+    m_delays.Reset();
+    m_hopCounts.Reset();
+    m_retxCount = 0;
+  }
+
+  void
+  Merge(const Stats& other)
+  {
+    m_delays.Merge(other.m_delays);
+    m_hopCounts.Merge(other.m_hopCounts);
+    m_retxCount += other.m_retxCount;
+  }
+
+  HdrHistogram m_delays; ///< delays in microseconds
+  HdrHistogram m_hopCounts;
+  uint64_t m_retxCount = 0;
+};
+
+enum DelayType {
+  LAST_DELAY,
+  FULL_DELAY,
+  N_DELAY_TYPES
+};
+/// @endcond
+}
+
 /**
  * @ingroup ndn-tracers
  * @brief Tracer to obtain application-level delays
+ *
+ * By default, one line is written for every Data packet received by an application.  When an
+ * averaging period is given, samples are instead collected into histograms and, once per
+ * period, one line with the sample count and delay and hop count percentiles is written for
+ * every application and delay type, followed by a line for all applications on the node
+ * (AppId "*").  The output size then depends on the number of applications, not on the number
+ * of Data packets.
  */
 class AppDelayTracer : public SimpleRefCount<AppDelayTracer> {
 public:
@@ -50,46 +93,49 @@ public:
    * @brief Helper method to install tracers on all simulation nodes
    *
    * @param file File to which traces will be written.  If filename is -, then std::out is used
-   *
+   * @param averagingPeriod How often aggregated delays will be written into the trace file
+   *        (default, zero, writes one line per Data packet)
    */
   static void
-  InstallAll(const std::string& file);
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0));
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
    * @param file File to which traces will be written.  If filename is -, then std::out is used
-   *
+   * @param averagingPeriod How often aggregated delays will be written into the trace file
+   *        (default, zero, writes one line per Data packet)
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file);
+  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0));
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
    * @param file File to which traces will be written.  If filename is -, then std::out is used
-   * @param averagingPeriod How often data will be written into the trace file (default, every half
-   *        second)
+   * @param averagingPeriod How often aggregated delays will be written into the trace file
+   *        (default, zero, writes one line per Data packet)
    */
   static void
-  Install(Ptr<Node> node, const std::string& file);
+  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0));
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
    * @param outputStream Smart pointer to a stream
-   * @param averagingPeriod How often data will be written into the trace file (default, every half
-   *        second)
+   * @param averagingPeriod How often aggregated delays will be written into the trace file
+   *        (default, zero, writes one line per Data packet)
    *
    * @returns a tuple of reference to output stream and list of tracers.
    *          !!! Attention !!! This tuple needs to be preserved for the lifetime of simulation,
    *          otherwise SEGFAULTs are inevitable
    */
   static Ptr<AppDelayTracer>
-  Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
+  Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+          Time averagingPeriod = Seconds(0));
 
   /**
    * @brief Explicit request to remove all statically created tracers
@@ -127,6 +173,16 @@ public:
   void
   PrintHeader(std::ostream& os) const;
 
+  /**
+   * @brief Print delays aggregated since the last period
+   *
+   * Nothing is printed unless an averaging period is set.
+   *
+   * @param os reference to output stream
+   */
+  void
+  Print(std::ostream& os) const;
+
 private:
   void
   Connect();
@@ -138,11 +194,30 @@ private:
   FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t rextCount,
                          int32_t hopCount);
 
+  void
+  Aggregate(Ptr<App> app, app_delay::DelayType type, Time delay, uint32_t retxCount,
+            int32_t hopCount);
+
+private:
+  void
+  SetAveragingPeriod(const Time& period);
+
+  void
+  Reset();
+
+  void
+  PeriodicPrinter();
+
 private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+
+  Time m_period; ///< zero if every Data packet is printed
+  EventId m_printEvent;
+  /// per-application statistics, indexed by app id and delay type
+  std::map<uint32_t, std::array<app_delay::Stats, app_delay::N_DELAY_TYPES>> m_stats;
 };
 
 } // namespace ndn
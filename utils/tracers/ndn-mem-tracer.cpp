@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-mem-tracer.hpp"
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.MemTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<MemTracer>>>> g_tracers;
+
+static shared_ptr<std::ostream>
+openOutputStream(const std::string& file)
+{
+  if (file == "-") {
+    return shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  auto os = make_shared<std::ofstream>();
+  os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+  if (!os->is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return nullptr;
+  }
+  return os;
+}
+
+static void
+addTracers(shared_ptr<std::ostream> outputStream, std::list<Ptr<MemTracer>> tracers)
+{
+  if (tracers.size() > 0) {
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+MemTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+MemTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  shared_ptr<std::ostream> outputStream = openOutputStream(file);
+  if (outputStream == nullptr) {
+    return;
+  }
+
+  std::list<Ptr<MemTracer>> tracers;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    tracers.push_back(Install(*node, outputStream, averagingPeriod));
+  }
+  addTracers(outputStream, tracers);
+}
+
+void
+MemTracer::Install(const NodeContainer& nodes, const std::string& file,
+                        Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  shared_ptr<std::ostream> outputStream = openOutputStream(file);
+  if (outputStream == nullptr) {
+    return;
+  }
+
+  std::list<Ptr<MemTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    tracers.push_back(Install(*node, outputStream, averagingPeriod));
+  }
+  addTracers(outputStream, tracers);
+}
+
+void
+MemTracer::Install(Ptr<Node> node, const std::string& file,
+                        Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  shared_ptr<std::ostream> outputStream = openOutputStream(file);
+  if (outputStream == nullptr) {
+    return;
+  }
+
+  addTracers(outputStream, {Install(node, outputStream, averagingPeriod)});
+}
+
+Ptr<MemTracer>
+MemTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                        Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<MemTracer> trace = Create<MemTracer>(outputStream, node);
+  trace->SetAveragingPeriod(averagingPeriod);
+
+  return trace;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+MemTracer::MemTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_os(os)
+{
+  NS_ASSERT_MSG(node->GetObject<L3Protocol>() != nullptr,
+                "NDN stack should be installed on the node");
+
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
+MemTracer::~MemTracer()
+{
+  m_printEvent.Cancel();
+}
+
+void
+MemTracer::SetAveragingPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &MemTracer::PeriodicPrinter, this);
+}
+
+void
+MemTracer::PeriodicPrinter()
+{
+  Print(*m_os);
+
+  m_printEvent = Simulator::Schedule(m_period, &MemTracer::PeriodicPrinter, this);
+}
+
+void
+MemTracer::PrintHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+
+     << "Node"
+     << "\t"
+
+     << "Table"
+     << "\t"
+     << "Entries"
+     << "\t"
+     << "Bytes";
+}
+
+#define PRINTER(printName, nEntries, nBytes)                                                       \
+  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t" << nEntries << "\t" \
+     << nBytes << "\n";
+
+void
+MemTracer::Print(std::ostream& os) const
+{
+  Time time = Simulator::Now();
+  nfd::Forwarder& forwarder = *m_nodePtr->GetObject<L3Protocol>()->getForwarder();
+
+  const nfd::NameTree& nameTree = forwarder.getNameTree();
+  PRINTER("NameTree", nameTree.size(), nameTree.getMemoryUsage());
+
+  const nfd::Pit& pit = forwarder.getPit();
+  PRINTER("Pit", pit.size(), pit.getMemoryUsage());
+
+  const nfd::Fib& fib = forwarder.getFib();
+  PRINTER("Fib", fib.size(), fib.getMemoryUsage());
+
+  const nfd::Cs& cs = forwarder.getCs();
+  PRINTER("Cs", cs.size(), cs.getMemoryUsage());
+  PRINTER("CsPolicy", cs.size(), cs.getPolicy()->getMemoryUsage());
+
+  const nfd::DeadNonceList& dnl = forwarder.getDeadNonceList();
+  PRINTER("DeadNonceList", dnl.size(), dnl.getMemoryUsage());
+
+  const nfd::Measurements& measurements = forwarder.getMeasurements();
+  PRINTER("Measurements", measurements.size(), measurements.getMemoryUsage());
+}
+
+} // namespace ndn
+} // namespace ns3
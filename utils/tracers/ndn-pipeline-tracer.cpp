@@ -0,0 +1,244 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-pipeline-tracer.hpp"
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.PipelineTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<PipelineTracer>>>> g_tracers;
+
+static shared_ptr<std::ostream>
+openOutputStream(const std::string& file)
+{
+  if (file == "-") {
+    return shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  auto os = make_shared<std::ofstream>();
+  os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+  if (!os->is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return nullptr;
+  }
+  return os;
+}
+
+static void
+addTracers(shared_ptr<std::ostream> outputStream, std::list<Ptr<PipelineTracer>> tracers)
+{
+  if (tracers.size() > 0) {
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+PipelineTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+PipelineTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  shared_ptr<std::ostream> outputStream = openOutputStream(file);
+  if (outputStream == nullptr) {
+    return;
+  }
+
+  std::list<Ptr<PipelineTracer>> tracers;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    tracers.push_back(Install(*node, outputStream, averagingPeriod));
+  }
+  addTracers(outputStream, tracers);
+}
+
+void
+PipelineTracer::Install(const NodeContainer& nodes, const std::string& file,
+                        Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  shared_ptr<std::ostream> outputStream = openOutputStream(file);
+  if (outputStream == nullptr) {
+    return;
+  }
+
+  std::list<Ptr<PipelineTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    tracers.push_back(Install(*node, outputStream, averagingPeriod));
+  }
+  addTracers(outputStream, tracers);
+}
+
+void
+PipelineTracer::Install(Ptr<Node> node, const std::string& file,
+                        Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  shared_ptr<std::ostream> outputStream = openOutputStream(file);
+  if (outputStream == nullptr) {
+    return;
+  }
+
+  addTracers(outputStream, {Install(node, outputStream, averagingPeriod)});
+}
+
+Ptr<PipelineTracer>
+PipelineTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                        Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<PipelineTracer> trace = Create<PipelineTracer>(outputStream, node);
+  trace->SetAveragingPeriod(averagingPeriod);
+
+  return trace;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+PipelineTracer::PipelineTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_os(os)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  Connect();
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
+PipelineTracer::~PipelineTracer()
+{
+  m_printEvent.Cancel();
+  auto forwarder = m_forwarder.lock();
+  if (forwarder != nullptr) {
+    forwarder->getProfiler().setEnabled(false);
+  }
+}
+
+void
+PipelineTracer::Connect()
+{
+  Ptr<L3Protocol> ndn = m_nodePtr->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != nullptr, "NDN stack should be installed on the node");
+
+  m_forwarder = ndn->getForwarder();
+  ndn->getForwarder()->getProfiler().setEnabled(true);
+
+  Reset();
+}
+
+void
+PipelineTracer::SetAveragingPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &PipelineTracer::PeriodicPrinter, this);
+}
+
+void
+PipelineTracer::PeriodicPrinter()
+{
+  Print(*m_os);
+  Reset();
+
+  m_printEvent = Simulator::Schedule(m_period, &PipelineTracer::PeriodicPrinter, this);
+}
+
+void
+PipelineTracer::PrintHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+
+     << "Node"
+     << "\t"
+
+     << "Stage"
+     << "\t"
+     << "Samples"
+     << "\t"
+     << "MeanCycles"
+     << "\t"
+     << "P50Cycles"
+     << "\t"
+     << "P90Cycles"
+     << "\t"
+     << "P99Cycles"
+     << "\t"
+     << "MaxCycles";
+}
+
+void
+PipelineTracer::Reset()
+{
+  auto forwarder = m_forwarder.lock();
+  if (forwarder != nullptr) {
+    forwarder->getProfiler().reset();
+  }
+}
+
+void
+PipelineTracer::Print(std::ostream& os) const
+{
+  auto forwarder = m_forwarder.lock();
+  if (forwarder == nullptr) {
+    return;
+  }
+
+  Time time = Simulator::Now();
+
+  for (size_t i = 0; i < nfd::PipelineProfiler::N_STAGES; ++i) {
+    auto stage = static_cast<nfd::PipelineStage>(i);
+    const nfd::LatencyHistogram& histogram = forwarder->getProfiler().get(stage);
+    uint64_t nSamples = histogram.getNSamples();
+
+    os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << stage << "\t"
+       << nSamples << "\t"
+       << (nSamples == 0 ? 0.0 : static_cast<double>(histogram.getSum()) / nSamples) << "\t"
+       << histogram.getQuantile(0.5) << "\t"
+       << histogram.getQuantile(0.9) << "\t"
+       << histogram.getQuantile(0.99) << "\t"
+       << histogram.getMax() << "\n";
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
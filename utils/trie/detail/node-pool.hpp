@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NODE_POOL_H_
+#define NODE_POOL_H_
+
+/// @cond include_hidden
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+namespace detail {
+
+/**
+ * @brief Allocator of fixed-size chunks, carved out of large blocks
+ *
+ * Chunks of consecutively created nodes are adjacent in memory, and freed chunks are reused
+ * before a new block is allocated.  Memory is returned to the system only when the pool is
+ * destroyed, so all chunks must be deallocated (or abandoned) by then.
+ */
+class node_pool : boost::noncopyable {
+public:
+  explicit node_pool(size_t chunkSize, size_t chunksPerBlock = 256)
+    : chunkSize_(round_up(chunkSize < sizeof(free_chunk) ? sizeof(free_chunk) : chunkSize))
+    , chunksPerBlock_(chunksPerBlock)
+    , free_(nullptr)
+    , nextInBlock_(nullptr)
+    , endOfBlock_(nullptr)
+  {
+  }
+
+  ~node_pool()
+  {
+    for (char* block : blocks_) {
+      ::operator delete(block);
+    }
+  }
+
+  void*
+  allocate()
+  {
+    if (free_ != nullptr) {
+      free_chunk* chunk = free_;
+      free_ = chunk->next;
+      return chunk;
+    }
+
+    if (nextInBlock_ == endOfBlock_) {
+      char* block = static_cast<char*>(::operator new(chunkSize_ * chunksPerBlock_));
+      blocks_.push_back(block);
+      nextInBlock_ = block;
+      endOfBlock_ = block + chunkSize_ * chunksPerBlock_;
+    }
+
+    void* chunk = nextInBlock_;
+    nextInBlock_ += chunkSize_;
+    return chunk;
+  }
+
+  void
+  deallocate(void* chunk)
+  {
+    free_chunk* freed = static_cast<free_chunk*>(chunk);
+    freed->next = free_;
+    free_ = freed;
+  }
+
+  /**
+   * @brief Number of bytes allocated from the system
+   */
+  size_t
+  capacity_bytes() const
+  {
+    return blocks_.size() * chunkSize_ * chunksPerBlock_;
+  }
+
+private:
+  struct free_chunk {
+    free_chunk* next;
+  };
+
+  static size_t
+  round_up(size_t size)
+  {
+    const size_t alignment = alignof(std::max_align_t);
+    return (size + alignment - 1) / alignment * alignment;
+  }
+
+private:
+  const size_t chunkSize_;
+  const size_t chunksPerBlock_;
+
+  std::vector<char*> blocks_;
+  free_chunk* free_;
+  char* nextInBlock_;
+  char* endOfBlock_;
+};
+
+} // detail
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // NODE_POOL_H_
@@ -26,11 +26,13 @@
 
 #include "ns3/ptr.h"
 
-#include <boost/intrusive/unordered_set.hpp>
+#include "detail/node-pool.hpp"
+
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/functional/hash.hpp>
-#include <boost/interprocess/smart_ptr/unique_ptr.hpp>
+#include <algorithm>
+#include <memory>
 #include <tuple>
 #include <boost/foreach.hpp>
 #include <boost/mpl/if.hpp>
@@ -142,30 +144,36 @@ public:
 
   typedef PayloadTraits payload_traits;
 
-  inline trie(const Key& key, size_t bucketSize = 1, size_t bucketIncrement = 1)
-    : key_(key)
-    , initialBucketSize_(bucketSize)
-    , bucketIncrement_(bucketIncrement)
-    , bucketSize_(initialBucketSize_)
-    , buckets_(new bucket_type[bucketSize_]) // cannot use normal pointer, because lifetime of
-                                             // buckets should be larger than lifetime of the
-                                             // container
-    , children_(bucket_traits(buckets_.get(), bucketSize_))
-    , payload_(PayloadTraits::empty_payload)
-    , parent_(nullptr)
+  /**
+   * @brief Create the root of a trie
+   *
+   * All nodes of the trie are allocated from a pool owned by the root, so that nodes
+   * created together (e.g., components of one name) are close in memory.
+   */
+  inline explicit trie(const Key& key)
+    : trie(key, 0, nullptr, new detail::node_pool(sizeof(trie)))
   {
+    ownPool_.reset(pool_);
   }
 
   inline ~trie()
   {
     payload_ = PayloadTraits::empty_payload; // necessary for smart pointers...
-    children_.clear_and_dispose(trie_delete_disposer());
+    clear();
+    if (children_ != inlineChildren_) {
+      delete[] children_;
+    }
   }
 
   void
   clear()
   {
-    children_.clear_and_dispose(trie_delete_disposer());
+    for (uint32_t i = 0; i < nChildren_; ++i) {
+      dispose(children_[i]);
+    }
+    nChildren_ = 0;
+    childIndex_.reset();
+    childIndexMask_ = 0;
   }
 
   template<class Predicate>
@@ -196,28 +204,11 @@ public:
     trie* trieNode = this;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
-      if (item == trieNode->children_.end()) {
-        trie* newNode = new trie(subkey, initialBucketSize_, bucketIncrement_);
-        // std::cout << "new " << newNode << "\n";
-        newNode->parent_ = trieNode;
-
-        if (trieNode->children_.size() >= trieNode->bucketSize_) {
-          trieNode->bucketSize_ += trieNode->bucketIncrement_;
-          trieNode->bucketIncrement_ *= 2; // increase bucketIncrement exponentially
-
-          buckets_array newBuckets(new bucket_type[trieNode->bucketSize_]);
-          trieNode->children_.rehash(bucket_traits(newBuckets.get(), trieNode->bucketSize_));
-          trieNode->buckets_.swap(newBuckets);
-        }
-
-        std::pair<typename unordered_set::iterator, bool> ret =
-          trieNode->children_.insert(*newNode);
-
-        trieNode = &(*ret.first);
+      trie* child = trieNode->find_child(subkey);
+      if (child == nullptr) {
+        child = trieNode->create_child(subkey);
       }
-      else
-        trieNode = &(*item);
+      trieNode = child;
     }
 
     if (trieNode->payload_ == PayloadTraits::empty_payload) {
@@ -244,14 +235,13 @@ public:
   inline iterator
   prune()
   {
-    if (payload_ == PayloadTraits::empty_payload && children_.size() == 0) {
+    if (payload_ == PayloadTraits::empty_payload && nChildren_ == 0) {
       if (parent_ == 0)
         return this;
 
       trie* parent = parent_;
-      parent->children_
-        .erase_and_dispose(*this,
-                           trie_delete_disposer()); // delete this; basically, committing a suicide
+      parent->remove_child(this);
+      dispose(this); // basically, committing a suicide
 
       return parent->prune();
     }
@@ -264,14 +254,12 @@ public:
   inline void
   prune_node()
   {
-    if (payload_ == PayloadTraits::empty_payload && children_.size() == 0) {
+    if (payload_ == PayloadTraits::empty_payload && nChildren_ == 0) {
       if (parent_ == 0)
         return;
 
-      trie* parent = parent_;
-      parent->children_
-        .erase_and_dispose(*this,
-                           trie_delete_disposer()); // delete this; basically, committing a suicide
+      parent_->remove_child(this);
+      dispose(this); // basically, committing a suicide
     }
   }
 
@@ -295,13 +283,13 @@ public:
     bool reachLast = true;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
-      if (item == trieNode->children_.end()) {
+      trie* child = trieNode->find_child(subkey);
+      if (child == nullptr) {
         reachLast = false;
         break;
       }
       else {
-        trieNode = &(*item);
+        trieNode = child;
 
         if (trieNode->payload_ != PayloadTraits::empty_payload)
           foundNode = trieNode;
@@ -326,13 +314,13 @@ public:
     bool reachLast = true;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
-      if (item == trieNode->children_.end()) {
+      trie* child = trieNode->find_child(subkey);
+      if (child == nullptr) {
         reachLast = false;
         break;
       }
       else {
-        trieNode = &(*item);
+        trieNode = child;
 
         if (trieNode->payload_ != PayloadTraits::empty_payload && pred(trieNode->payload_)) {
           foundNode = trieNode;
@@ -354,12 +342,8 @@ public:
     if (payload_ != PayloadTraits::empty_payload)
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
-         subnode != children_.end(); subnode++)
-    // BOOST_FOREACH (trie &subnode, children_)
-    {
-      iterator value = subnode->find();
+    for (uint32_t i = 0; i < nChildren_; ++i) {
+      iterator value = children_[i]->find();
       if (value != 0)
         return value;
     }
@@ -380,12 +364,8 @@ public:
     if (payload_ != PayloadTraits::empty_payload && pred(payload_))
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
-         subnode != children_.end(); subnode++)
-    // BOOST_FOREACH (const trie &subnode, children_)
-    {
-      iterator value = subnode->find_if(pred);
+    for (uint32_t i = 0; i < nChildren_; ++i) {
+      iterator value = children_[i]->find_if(pred);
       if (value != 0)
         return value;
     }
@@ -406,11 +386,9 @@ public:
   inline const iterator
   find_if_next_level(Predicate pred)
   {
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
-         subnode != children_.end(); subnode++) {
-      if (pred(subnode->key())) {
-        return subnode->find();
+    for (uint32_t i = 0; i < nChildren_; ++i) {
+      if (pred(children_[i]->key())) {
+        return children_[i]->find();
       }
     }
 
@@ -457,23 +435,179 @@ public:
   PrintStat(std::ostream& os) const;
 
 private:
-  // The disposer object function
-  struct trie_delete_disposer {
-    void
-    operator()(trie* delete_this)
-    {
-      delete delete_this;
+  /**
+   * @brief Children are searched linearly until there are more than this many of them
+   */
+  static const uint32_t MAX_LINEAR_CHILDREN = 8;
+
+  /**
+   * @brief Number of children kept in the node itself, without a separate allocation
+   */
+  static const uint32_t INLINE_CHILDREN = 2;
+
+  static const uint32_t NO_CHILD = 0; ///< empty slot of the child index
+
+  inline trie(const Key& key, size_t hash, trie* parent, detail::node_pool* pool)
+    : key_(key)
+    , hash_(hash)
+    , payload_(PayloadTraits::empty_payload)
+    , parent_(parent)
+    , pool_(pool)
+    , children_(inlineChildren_)
+    , nChildren_(0)
+    , childrenCapacity_(INLINE_CHILDREN)
+    , positionInParent_(0)
+    , childIndexMask_(0)
+  {
+  }
+
+  static size_t
+  hash_key(const Key& key)
+  {
+    return boost::hash_value(key);
+  }
+
+  static void
+  dispose(trie* node)
+  {
+    detail::node_pool* pool = node->pool_;
+    node->~trie();
+    pool->deallocate(node);
+  }
+
+  trie*
+  find_child(const Key& subkey) const
+  {
+    if (childIndex_ == nullptr) {
+      for (uint32_t i = 0; i < nChildren_; ++i) {
+        if (children_[i]->key_ == subkey) {
+          return children_[i];
+        }
+      }
+      return nullptr;
+    }
+
+    size_t hash = hash_key(subkey);
+    for (size_t slot = hash & childIndexMask_; childIndex_[slot] != NO_CHILD;
+         slot = (slot + 1) & childIndexMask_) {
+      trie* child = children_[childIndex_[slot] - 1];
+      if (child->hash_ == hash && child->key_ == subkey) {
+        return child;
+      }
+    }
+    return nullptr;
+  }
+
+  trie*
+  create_child(const Key& subkey)
+  {
+    trie* child = new (pool_->allocate()) trie(subkey, hash_key(subkey), this, pool_);
+
+    if (nChildren_ == childrenCapacity_) {
+      uint32_t newCapacity = childrenCapacity_ * 2;
+      trie** newChildren = new trie*[newCapacity];
+      std::copy(children_, children_ + nChildren_, newChildren);
+      if (children_ != inlineChildren_) {
+        delete[] children_;
+      }
+      children_ = newChildren;
+      childrenCapacity_ = newCapacity;
+    }
+
+    child->positionInParent_ = nChildren_;
+    children_[nChildren_++] = child;
+
+    if (childIndex_ != nullptr && nChildren_ * 2 <= childIndexMask_ + 1) {
+      index_child(nChildren_ - 1);
+    }
+    else if (nChildren_ > MAX_LINEAR_CHILDREN) {
+      rebuild_child_index();
+    }
+
+    return child;
+  }
+
+  void
+  remove_child(trie* child)
+  {
+    uint32_t position = child->positionInParent_;
+    uint32_t last = nChildren_ - 1;
+
+    if (childIndex_ != nullptr) {
+      unindex_child(position);
+      if (position != last) {
+        // the last child moves into the vacated position
+        *find_index_slot(last) = position + 1;
+      }
+    }
+
+    if (position != last) {
+      children_[position] = children_[last];
+      children_[position]->positionInParent_ = position;
+    }
+    --nChildren_;
+
+    if (childIndex_ != nullptr && nChildren_ <= MAX_LINEAR_CHILDREN / 2) {
+      childIndex_.reset();
+      childIndexMask_ = 0;
+    }
+  }
+
+  /**
+   * @brief Rebuild the child index with at least twice as many slots as children
+   */
+  void
+  rebuild_child_index()
+  {
+    size_t nSlots = 1;
+    while (nSlots < nChildren_ * 4) {
+      nSlots *= 2;
     }
-  };
-
-  template<class D>
-  struct array_disposer {
-    void
-    operator()(D* array)
-    {
-      delete[] array;
+
+    childIndex_.reset(new uint32_t[nSlots]());
+    childIndexMask_ = nSlots - 1;
+    for (uint32_t i = 0; i < nChildren_; ++i) {
+      index_child(i);
     }
-  };
+  }
+
+  void
+  index_child(uint32_t position)
+  {
+    size_t slot = children_[position]->hash_ & childIndexMask_;
+    while (childIndex_[slot] != NO_CHILD) {
+      slot = (slot + 1) & childIndexMask_;
+    }
+    childIndex_[slot] = position + 1;
+  }
+
+  uint32_t*
+  find_index_slot(uint32_t position)
+  {
+    size_t slot = children_[position]->hash_ & childIndexMask_;
+    while (childIndex_[slot] != position + 1) {
+      slot = (slot + 1) & childIndexMask_;
+    }
+    return &childIndex_[slot];
+  }
+
+  /**
+   * @brief Remove the child from the index, shifting back later entries of its probe sequence
+   */
+  void
+  unindex_child(uint32_t position)
+  {
+    size_t hole = find_index_slot(position) - childIndex_.get();
+    for (size_t slot = (hole + 1) & childIndexMask_; childIndex_[slot] != NO_CHILD;
+         slot = (slot + 1) & childIndexMask_) {
+      size_t home = children_[childIndex_[slot] - 1]->hash_ & childIndexMask_;
+      if (((slot - home) & childIndexMask_) >= ((slot - hole) & childIndexMask_)) {
+        childIndex_[hole] = childIndex_[slot];
+        hole = slot;
+      }
+    }
+    childIndex_[hole] = NO_CHILD;
+  }
 
   friend std::ostream& operator<<<>(std::ostream& os, const trie& trie_node);
 
@@ -481,17 +615,6 @@ public:
   PolicyHook policy_hook_;
 
 private:
-  boost::intrusive::unordered_set_member_hook<> unordered_set_member_hook_;
-
-  // necessary typedefs
-  typedef trie self_type;
-  typedef boost::intrusive::member_hook<trie, boost::intrusive::unordered_set_member_hook<>,
-                                        &trie::unordered_set_member_hook_> member_hook;
-
-  typedef boost::intrusive::unordered_set<trie, member_hook> unordered_set;
-  typedef typename unordered_set::bucket_type bucket_type;
-  typedef typename unordered_set::bucket_traits bucket_traits;
-
   template<class T, class NonConstT>
   friend class trie_iterator;
 
@@ -503,17 +626,31 @@ private:
   ////////////////////////////////////////////////
 
   Key key_; ///< name component
-
-  size_t initialBucketSize_;
-  size_t bucketIncrement_;
-
-  size_t bucketSize_;
-  typedef boost::interprocess::unique_ptr<bucket_type, array_disposer<bucket_type>> buckets_array;
-  buckets_array buckets_;
-  unordered_set children_;
+  size_t hash_; ///< hash of key_, to look up and re-index children of wide nodes
 
   typename PayloadTraits::storage_type payload_;
   trie* parent_; // to make cleaning effective
+  detail::node_pool* pool_;
+  std::unique_ptr<detail::node_pool> ownPool_; ///< set only in the root
+
+  /**
+   * @brief Children in no particular order
+   *
+   * Points to inlineChildren_ until there are more than INLINE_CHILDREN children.
+   */
+  trie** children_;
+  uint32_t nChildren_;
+  uint32_t childrenCapacity_;
+  uint32_t positionInParent_;
+  trie* inlineChildren_[INLINE_CHILDREN];
+
+  /**
+   * @brief Open addressing index of children, for nodes with more than MAX_LINEAR_CHILDREN
+   *
+   * Each slot is NO_CHILD or the position of a child in children_ plus one.
+   */
+  std::unique_ptr<uint32_t[]> childIndex_;
+  size_t childIndexMask_;
 };
 
 template<typename FullKey, typename PayloadTraits, typename PolicyHook>
@@ -522,25 +659,22 @@ operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& tri
 {
   os << "# " << trie_node.key_ << ((trie_node.payload_ != PayloadTraits::empty_payload) ? "*" : "")
      << std::endl;
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
 
-  for (typename trie::unordered_set::const_iterator subnode = trie_node.children_.begin();
-       subnode != trie_node.children_.end(); subnode++)
-  // BOOST_FOREACH (const trie &subnode, trie_node.children_)
-  {
+  for (uint32_t i = 0; i < trie_node.nChildren_; ++i) {
+    const auto& subnode = *trie_node.children_[i];
     os << "\"" << &trie_node << "\""
        << " [label=\"" << trie_node.key_
        << ((trie_node.payload_ != PayloadTraits::empty_payload) ? "*" : "") << "\"]\n";
-    os << "\"" << &(*subnode) << "\""
-       << " [label=\"" << subnode->key_
-       << ((subnode->payload_ != PayloadTraits::empty_payload) ? "*" : "") << "\"]"
-                                                                              "\n";
+    os << "\"" << &subnode << "\""
+       << " [label=\"" << subnode.key_
+       << ((subnode.payload_ != PayloadTraits::empty_payload) ? "*" : "") << "\"]"
+                                                                            "\n";
 
     os << "\"" << &trie_node << "\""
        << " -> "
-       << "\"" << &(*subnode) << "\""
+       << "\"" << &subnode << "\""
        << "\n";
-    os << *subnode;
+    os << subnode;
   }
 
   return os;
@@ -551,18 +685,14 @@ inline void
 trie<FullKey, PayloadTraits, PolicyHook>::PrintStat(std::ostream& os) const
 {
   os << "# " << key_ << ((payload_ != PayloadTraits::empty_payload) ? "*" : "") << ": "
-     << children_.size() << " children" << std::endl;
-  for (size_t bucket = 0, maxbucket = children_.bucket_count(); bucket < maxbucket; bucket++) {
-    os << " " << children_.bucket_size(bucket);
+     << nChildren_ << " children";
+  if (childIndex_ != nullptr) {
+    os << ", " << (childIndexMask_ + 1) << " index slots";
   }
-  os << "\n";
+  os << std::endl;
 
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-  for (typename trie::unordered_set::const_iterator subnode = children_.begin();
-       subnode != children_.end(); subnode++)
-  // BOOST_FOREACH (const trie &subnode, children_)
-  {
-    subnode->PrintStat(os);
+  for (uint32_t i = 0; i < nChildren_; ++i) {
+    children_[i]->PrintStat(os);
   }
 }
 
@@ -578,7 +708,7 @@ template<typename FullKey, typename PayloadTraits, typename PolicyHook>
 inline std::size_t
 hash_value(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node)
 {
-  return boost::hash_value(trie_node.key_);
+  return trie_node.hash_;
 }
 
 template<class Trie, class NonConstTrie> // hack for boost < 1.47
@@ -637,8 +767,8 @@ public:
   trie_iterator<Trie, NonConstTrie>&
   operator++(int)
   {
-    if (trie_->children_.size() > 0)
-      trie_ = &(*trie_->children_.begin());
+    if (trie_->nChildren_ > 0)
+      trie_ = trie_->children_[0];
     else
       trie_ = goUp();
     return *this;
@@ -652,20 +782,13 @@ public:
   }
 
 private:
-  typedef typename boost::mpl::if_<boost::is_same<Trie, NonConstTrie>,
-                                   typename Trie::unordered_set::iterator,
-                                   typename Trie::unordered_set::const_iterator>::type set_iterator;
-
   Trie*
   goUp()
   {
     if (trie_->parent_ != 0) {
-      // typename Trie::unordered_set::iterator item =
-      set_iterator item = const_cast<NonConstTrie*>(trie_)
-                            ->parent_->children_.iterator_to(const_cast<NonConstTrie&>(*trie_));
-      item++;
-      if (item != trie_->parent_->children_.end()) {
-        return &(*item);
+      uint32_t next = trie_->positionInParent_ + 1;
+      if (next < trie_->parent_->nChildren_) {
+        return trie_->parent_->children_[next];
       }
       else {
         trie_ = trie_->parent_;
@@ -682,11 +805,6 @@ private:
 
 template<class Trie>
 class trie_point_iterator {
-private:
-  typedef typename boost::mpl::if_<boost::is_same<Trie, const Trie>,
-                                   typename Trie::unordered_set::const_iterator,
-                                   typename Trie::unordered_set::iterator>::type set_iterator;
-
 public:
   trie_point_iterator()
     : trie_(0)
@@ -698,8 +816,8 @@ public:
   }
   trie_point_iterator(Trie& item)
   {
-    if (item.children_.size() != 0)
-      trie_ = &*item.children_.begin();
+    if (item.nChildren_ != 0)
+      trie_ = item.children_[0];
     else
       trie_ = 0;
   }
@@ -745,12 +863,11 @@ public:
   operator++(int)
   {
     if (trie_->parent_ != 0) {
-      set_iterator item = trie_->parent_->children_.iterator_to(*trie_);
-      item++;
-      if (item == trie_->parent_->children_.end())
+      uint32_t next = trie_->positionInParent_ + 1;
+      if (next == trie_->parent_->nChildren_)
         trie_ = 0;
       else
-        trie_ = &*item;
+        trie_ = trie_->parent_->children_[next];
     }
     else {
       trie_ = 0;